@@ -224,6 +224,25 @@ typedef int (*traverser_t) (Intercept const *intercept, void *context);
 typedef void *MapElementPtr;
 typedef void const *MapElementPtrConst;
 
+/**
+ * One property of a map element, for reading or writing several properties in
+ * a single call (see P_GetPropsp() and P_SetPropsp()).
+ */
+typedef struct dmu_propvalue_s {
+    uint prop;          ///< DMU property, optionally with a DMU_*_OF_* modifier.
+    valuetype_t type;   ///< Type of the value(s) (DDVT_*).
+    void *value;        ///< Value(s) to read or write.
+} dmu_propvalue_t;
+
+/**
+ * Map object found by an area query (see Mobj_AreaQuery()).
+ */
+typedef struct mobjcandidate_s {
+    struct mobj_s *mobj;
+    coord_t distance;   ///< Larger of the X and Y axis distances from the query point
+                        ///< to the origin of the mobj, minus the radius of the mobj.
+} mobjcandidate_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -675,6 +694,47 @@ DENG_API_TYPEDEF(Map)
     void            (*GetFloatpv)(MapElementPtr ptr, uint prop, float *params);
     void            (*GetDoublepv)(MapElementPtr ptr, uint prop, double *params);
     void            (*GetPtrpv)(MapElementPtr ptr, uint prop, void *params);
+
+    /*
+     * Typed accessors for frequently used properties. These bypass the generic
+     * property dispatch and can be used in performance critical code. Like the
+     * P_Get*p() functions, they return zero/NULL if the element is NULL (e.g.,
+     * the back sector of a one-sided line).
+     */
+
+    coord_t         (*S_FloorHeight)(Sector const *sector);
+    coord_t         (*S_CeilingHeight)(Sector const *sector);
+
+    Sector         *(*L_FrontSector)(Line const *line);
+    Sector         *(*L_BackSector)(Line const *line);
+
+    /*
+     * Bulk property access. All the properties are read from/written to the
+     * same map element, which is resolved only once.
+     */
+
+    void            (*GetPropsp)(MapElementPtr ptr, dmu_propvalue_t *props, int count);
+    void            (*SetPropsp)(MapElementPtr ptr, dmu_propvalue_t const *props, int count);
+
+    /**
+     * Collects the mobjs linked in the blockmap cells that intersect @a box,
+     * and whose distance from @a point (see mobjcandidate_t) is less than
+     * @a range, into a contiguous buffer. The mobjs are collected in the same
+     * order as MO_BoxIterator visits them. Mobjs are marked with the current
+     * validCount, so it should be incremented before calling this.
+     *
+     * @param box       Map space area whose blockmap cells are searched.
+     * @param point     Map space point the distances are measured from.
+     * @param range     Maximum distance (exclusive).
+     * @param buffer    Candidates are written here.
+     * @param maxCount  Size of @a buffer.
+     *
+     * @return  Total number of candidates. If this is larger than @a maxCount,
+     * only the first @a maxCount were written and the query should be repeated
+     * with a larger buffer (and a new validCount).
+     */
+    int             (*MO_AreaQuery)(AABoxd const *box, coord_t const point[2], coord_t range,
+                                    mobjcandidate_t *buffer, int maxCount);
 }
 DENG_API_T(Map);
 
@@ -807,6 +867,14 @@ DENG_API_T(Map);
 #define P_GetFloatpv                        _api_Map.GetFloatpv
 #define P_GetDoublepv                       _api_Map.GetDoublepv
 #define P_GetPtrpv                          _api_Map.GetPtrpv
+
+#define Sector_FloorHeight                  _api_Map.S_FloorHeight
+#define Sector_CeilingHeight                _api_Map.S_CeilingHeight
+#define Line_FrontSector                    _api_Map.L_FrontSector
+#define Line_BackSector                     _api_Map.L_BackSector
+#define P_GetPropsp                         _api_Map.GetPropsp
+#define P_SetPropsp                         _api_Map.SetPropsp
+#define Mobj_AreaQuery                      _api_Map.MO_AreaQuery
 #endif
 
 #ifdef __DOOMSDAY__
@@ -291,6 +291,7 @@ int Mus_StartCDTrack(int cdTrack, bool looped);
 
 extern int soundMinDist, soundMaxDist;
 extern int sfxBits, sfxRate;
+extern int sfxResampleFilter;  ///< 0: linear, 1: cubic.
 
 #ifdef __CLIENT__
 extern int sfxVolume, musVolume;
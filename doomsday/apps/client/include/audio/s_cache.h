@@ -44,7 +44,7 @@ public:
 
     struct CacheItem
     {
-        CacheItem *next, *prev;
+        CacheItem *next, *prev;  ///< Neighbors in the order of use (next is less recent).
 
         int hits;            ///< Number of cache hits.
         int lastUsed;        ///< Tic the sample was last hit.
@@ -76,8 +76,9 @@ public:
     void clear();
 
     /**
-     * Call this periodically to perform a cache purge. If the cache is too large,
-     * stopped samples with the lowest hitcount will be uncached.
+     * Call this periodically to perform a cache purge. Samples that have not been
+     * used in a long time are uncached. If the cache is still too large, the least
+     * recently used stopped samples are uncached.
      */
     void maybeRunPurge();
 
@@ -93,8 +94,8 @@ public:
     /**
      * Register a cache hit on the sound sample associated with @a id.
      *
-     * Hits keep count of how many times the cached sound has been played. The purger
-     * will remove samples with the lowest hitcount first.
+     * Hits keep count of how many times the cached sound has been played. A hit also
+     * makes the sample the most recently used one, so the purger will remove it last.
      *
      * @param soundId  Sound sample identifier.
      */
@@ -108,6 +109,11 @@ public:
      */
     void info(uint *cacheBytes, uint *sampleCount);
 
+    /**
+     * Register the console commands and variables of this module.
+     */
+    static void consoleRegister();
+
 private:
     DENG2_PRIVATE(d)
 };
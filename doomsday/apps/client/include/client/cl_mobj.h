@@ -21,6 +21,8 @@
 #ifndef DENG_CLIENT_WORLD_MOBJ_H
 #define DENG_CLIENT_WORLD_MOBJ_H
 
+#include <de/writer.h>
+#include <de/PackedReader>
 #include "world/p_object.h"
 #include "world/clientmobjthinkerdata.h"
 
@@ -61,19 +63,29 @@ void ClMobj_Link(mobj_t *cmo); // needed?
 void ClMobj_SetState(mobj_t *mo, int stnum); // needed?
 
 /**
- * Reads a single mobj delta (inside PSV_FRAME2 packet) from the message buffer
- * and applies it to the client mobj in question.
+ * Reads a single mobj delta (inside PSV_FRAME2 packet) from @a reader and
+ * applies it to the client mobj in question.
  *
  * For client mobjs that belong to players, updates the real player mobj
  * accordingly.
  */
-void ClMobj_ReadDelta();
+void ClMobj_ReadDelta(de::PackedReader &reader);
+
+/**
+ * Writes a delta that describes the current state of the client mobj @a mob in its
+ * entirety, in the format expected by ClMobj_ReadDelta(). Used for composing demo
+ * keyframes.
+ *
+ * @param writer  Destination. The delta type byte is @em not included.
+ * @param mob     Client mobj to describe.
+ */
+void ClMobj_WriteDelta(writer_s *writer, mobj_t const &mob);
 
 /**
  * Null mobjs deltas have their own type in a PSV_FRAME2 packet.
  * Here we remove the mobj in question.
  */
-void ClMobj_ReadNullDelta();
+void ClMobj_ReadNullDelta(de::PackedReader &reader);
 
 /**
  * Determines whether a mobj is a client mobj.
@@ -55,10 +55,10 @@ void ClPlayer_HandleFix();
 void ClPlayer_ApplyPendingFixes(int plrNum);
 
 /**
- * Reads a single PSV_FRAME2 player delta from the message buffer and
- * applies it to the player in question.
+ * Reads a single PSV_FRAME2 player delta from @a reader and applies it to
+ * the player in question.
  */
-void ClPlayer_ReadDelta();
+void ClPlayer_ReadDelta(de::PackedReader &reader);
 
 clplayerstate_t *ClPlayer_State(int plrNum);
 
@@ -20,13 +20,14 @@
 #ifndef DENG_CLIENT_SOUND_H
 #define DENG_CLIENT_SOUND_H
 
+#include <de/PackedReader>
 #include "network/protocol.h"
 
 /**
- * Read a sound delta from the message buffer and play it.
+ * Read a sound delta from @a reader and play it.
  * Only used with PSV_FRAME2 packets.
  */
-void Cl_ReadSoundDelta(deltatype_t type);
+void Cl_ReadSoundDelta(de::PackedReader &reader, deltatype_t type);
 
 /**
  * Called when a PSV_FRAME sound packet is received.
@@ -20,6 +20,13 @@
 #ifndef DENG_CLIENT_WORLD_MAP_H
 #define DENG_CLIENT_WORLD_MAP_H
 
+#include <de/writer.h>
+#include <de/PackedReader>
+#include <doomsday/world/Material>
+#include "Line"
+#include "Polyobj"
+#include "Sector"
+
 void Cl_InitTransTables();
 void Cl_ResetTransTables();
 
@@ -43,18 +50,55 @@ int Cl_LocalMobjType(int serverMobjType);
 int Cl_LocalMobjState(int serverMobjState);
 
 /**
- * Reads a sector delta from the PSV_FRAME2 message buffer and applies it to the world.
+ * Translates a local mobj type/state back to the server's numbering. This is the
+ * inverse of Cl_LocalMobjType()/Cl_LocalMobjState(); returns -1 if the server did
+ * not send an identifier that maps to @a localMobjType/@a localMobjState.
+ */
+int Cl_ServerMobjType(int localMobjType);
+int Cl_ServerMobjState(int localMobjState);
+
+/**
+ * Determines the server's material archive serial id for a local @a material.
+ * Returns zero if the material is not in the server's archive.
+ */
+int Cl_ServerMaterial(world::Material *material);
+
+/**
+ * Reads a sector delta of a PSV_FRAME2 message from @a reader and applies it to the world.
+ */
+void Cl_ReadSectorDelta(de::PackedReader &reader, int deltaType);
+
+/**
+ * Reads a side delta from @a reader and applies it to the world.
+ */
+void Cl_ReadSideDelta(de::PackedReader &reader, int deltaType);
+
+/**
+ * Reads a poly delta from @a reader and applies it to the world.
+ */
+void Cl_ReadPolyDelta(de::PackedReader &reader);
+
+/**
+ * Writes a delta that describes the current state of @a sector in its entirety,
+ * in the format expected by Cl_ReadSectorDelta(). Used for composing demo keyframes.
+ *
+ * @param writer  Destination. The delta type byte is @em not included.
+ * @param sector  Sector to describe.
+ * @param moving  @c true= describe the plane movers (target/speed) instead of the
+ *                current plane heights.
  */
-void Cl_ReadSectorDelta(int deltaType);
+void Cl_WriteSectorDelta(writer_s *writer, Sector const &sector, bool moving = false);
 
 /**
- * Reads a side delta from the message buffer and applies it to the world.
+ * Writes a delta that describes the current state of @a side in its entirety, in
+ * the format expected by Cl_ReadSideDelta().
  */
-void Cl_ReadSideDelta(int deltaType);
+void Cl_WriteSideDelta(writer_s *writer, LineSide const &side);
 
 /**
- * Reads a poly delta from the message buffer and applies it to the world.
+ * Writes a delta that describes the current movement of @a pob in the format
+ * expected by Cl_ReadPolyDelta().
  */
-void Cl_ReadPolyDelta();
+void Cl_WritePolyDelta(writer_s *writer, Polyobj const &pob);
 
 #endif // DENG_CLIENT_WORLD_MAP_H
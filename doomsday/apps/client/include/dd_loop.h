@@ -45,6 +45,13 @@ void DD_RegisterLoop(void);
  */
 void Loop_RunTics(void);
 
+/**
+ * Runs @a count tics back to back, without regard to how much real time has
+ * passed. Incoming network messages are not processed. Used for benchmarking the
+ * world simulation.
+ */
+void Loop_RunFixedTics(int count);
+
 /**
  * Waits until it's time to show the drawn frame on screen. The frame must be
  * ready before this is called. Ideally the updates would appear at a fixed
@@ -0,0 +1,165 @@
+/** @file demofile.h  Seekable, indexed demo container.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef CLIENT_NETWORK_DEMOFILE_H
+#define CLIENT_NETWORK_DEMOFILE_H
+
+#include <de/Block>
+#include <de/ByteArrayFile>
+#include <de/Error>
+#include <QList>
+
+/**
+ * Demo file container. @ingroup network
+ *
+ * A demo is a sequence of chunks following a short header:
+ *
+ * - @em Packet chunks contain a batch of recorded packets (one second's worth at
+ *   most). The batch is compressed as a whole and decompressed in one go when
+ *   played back.
+ * - @em Keyframe chunks contain the packets needed to bring the client's world to
+ *   the state it was in at the keyframe's tic (translation tables and a frame that
+ *   describes all sectors, sides, polyobjs and client mobjs).
+ * - The @em index chunk is written last. It maps keyframe tics to file offsets so
+ *   that a playback position can be found with a binary search.
+ *
+ * Packet chunks that begin with a handshake start a new @em segment, i.e., a map.
+ * Each keyframe remembers the segment it belongs to so that a seek to another map
+ * can first replay the map setup packets.
+ */
+class DemoFile
+{
+public:
+    /// The file is not a demo or it is damaged. @ingroup errors
+    DENG2_ERROR(FormatError);
+
+    struct Packet
+    {
+        de::duint32 tic = 0; ///< Relative to the beginning of the demo.
+        de::dbyte type = 0;
+        de::Block data;
+    };
+    typedef QList<Packet> Packets;
+
+    struct Keyframe
+    {
+        de::duint32 tic = 0;
+        de::dsize offset = 0;        ///< Offset of the keyframe chunk.
+        de::dsize segmentOffset = 0; ///< Offset of the chunk where the segment begins.
+    };
+    typedef QList<Keyframe> Keyframes;
+
+    /**
+     * Writes a new demo.
+     */
+    class Writer
+    {
+    public:
+        /**
+         * @param file  Destination. Should be empty. Must exist as long as the writer.
+         */
+        Writer(de::File &file);
+
+        /**
+         * Completes the demo by writing out pending packets and the index.
+         */
+        ~Writer();
+
+        void setKeyframeInterval(de::duint32 tics);
+
+        /**
+         * Determines if enough time has passed since the previous keyframe.
+         */
+        bool isKeyframeDue(de::duint32 tic) const;
+
+        /**
+         * Appends a packet. Packets are buffered and written to the file in
+         * compressed batches.
+         */
+        void writePacket(Packet const &packet);
+
+        /**
+         * Starts a new segment. Pending packets are flushed so that the next
+         * packet begins a new chunk.
+         */
+        void beginSegment();
+
+        /**
+         * Flushes pending packets and writes a keyframe chunk.
+         */
+        void writeKeyframe(de::duint32 tic, Packets const &packets);
+
+        void flush();
+
+    private:
+        DENG2_PRIVATE(d)
+    };
+
+    /**
+     * Reads an existing demo.
+     */
+    class Reader
+    {
+    public:
+        /**
+         * @param file  Source. Must exist as long as the reader.
+         */
+        Reader(de::ByteArrayFile const &file);
+
+        Keyframes const &keyframes() const;
+
+        /**
+         * Finds the last keyframe at or before @a tic with a binary search.
+         *
+         * @return Keyframe, or @c nullptr if there are no keyframes before @a tic.
+         */
+        Keyframe const *keyframeAt(de::duint32 tic) const;
+
+        /**
+         * Reads the contents of a keyframe. Does not change the playback position.
+         */
+        Packets keyframePackets(Keyframe const &keyframe) const;
+
+        /**
+         * Continues sequential reading from a chunk boundary.
+         *
+         * @param offset  Offset of a chunk. Keyframe and segment offsets are valid.
+         */
+        void seek(de::dsize offset);
+
+        /// Sequential reading continues from the chunk after @a keyframe.
+        void seekPast(Keyframe const &keyframe);
+
+        /**
+         * Returns the next packet in sequence without consuming it, or @c nullptr
+         * if the end of the demo has been reached. Keyframes are skipped.
+         */
+        Packet const *peek();
+
+        /// Consumes the packet returned by peek().
+        Packet take();
+
+        /// Offset of the segment of the chunk currently being read.
+        de::dsize currentSegment() const;
+
+    private:
+        DENG2_PRIVATE(d)
+    };
+};
+
+#endif // CLIENT_NETWORK_DEMOFILE_H
@@ -51,6 +51,19 @@ dd_bool         Demo_BeginPlayback(const char* filename);
 dd_bool         Demo_ReadPacket(void);
 void            Demo_StopPlayback(void);
 
+/**
+ * Moves the playback position. The nearest earlier keyframe is restored and the
+ * packets that follow it are read without delay until @a tic is reached.
+ *
+ * @param tic  Playback position, in tics from the beginning of the demo.
+ */
+dd_bool         Demo_Seek(int tic);
+
+/**
+ * Determines if playback is fast-forwarding to a seek position.
+ */
+dd_bool         Demo_IsSeeking(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
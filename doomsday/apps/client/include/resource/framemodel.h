@@ -64,16 +64,16 @@ public:
 
     /**
      * Animation key-frame.
+     *
+     * Vertex positions and normals are stored in separate arrays so that each can be
+     * processed as one contiguous array of floats.
      */
     struct Frame
     {
         FrameModel &model;
-        struct Vertex {
-            de::Vector3f pos;
-            de::Vector3f norm;
-        };
-        typedef QVector<Vertex> VertexBuf;
-        VertexBuf vertices;
+        typedef QVector<de::Vector3f> VertexBuf;
+        VertexBuf positions;
+        VertexBuf normals;  ///< Same order as the positions.
         de::Vector3f min;
         de::Vector3f max;
         de::String name;
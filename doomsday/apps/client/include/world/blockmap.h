@@ -25,6 +25,7 @@
 #include <functional>
 #include <de/aabox.h>
 #include <de/Vector>
+#include <QVector>
 
 #ifdef WIN32
 #  undef max
@@ -157,6 +158,17 @@ public:
      */
     de::LoopResult forAllInBox(AABoxd const &box, std::function<de::LoopResult (void *object)> func) const;
 
+    /**
+     * Appends all objects in all cells which intercept the given map space,
+     * axis-aligned bounding @a box to @a objects. The objects are appended in
+     * the same order as forAllInBox() visits them. This is faster than
+     * iterating when all the objects are needed, or when the caller needs to
+     * modify the blockmap while processing them.
+     *
+     * @return  Number of objects appended.
+     */
+    de::dint collectInBox(AABoxd const &box, QVector<void *> &objects) const;
+
     /**
      * Iterate over all objects in cells which intercept the line specified by
      * the two map space points @a from and @a to. Note that if an object is
@@ -27,8 +27,9 @@
 /**
  * Provides a mechanism for tracing line / world map object/element interception.
  *
- * Note: For technical reasons it is not presently possible to nest one or more
- * interceptor traces.
+ * The intercepts are first collected into an array, which is then sorted by
+ * distance along the trace and processed in order. A trace may be started from
+ * the callback of another trace.
  */
 class Interceptor
 {
@@ -63,8 +63,6 @@ public:
 
 DENG_EXTERN_C de::dint useSRVO, useSRVOAngle;
 
-void P_InitUnusedMobjList();
-
 /**
  * To be called to register the commands and variables of this module.
  */
@@ -73,8 +71,6 @@ void Mobj_ConsoleRegister();
 mobj_t *P_MobjCreate(thinkfunc_t function, de::Vector3d const &origin, angle_t angle,
     coord_t radius, coord_t height, de::dint ddflags);
 
-void P_MobjRecycle(mobj_t *mob);
-
 /**
  * Returns the map in which the map-object exists. Note that a map-object may exist in a
  * map while not being @em linked into data structures such as the blockmap and sectors.
@@ -24,6 +24,7 @@
 #include <functional>
 #include <de/Error>
 #include <de/Id>
+#include <de/String>
 #include "api_thinker.h"
 
 namespace world {
@@ -66,6 +67,25 @@ public:
      */
     void remove(thinker_t &thinker);
 
+    /**
+     * Allocates memory for a new (public) mobj. Mobjs are allocated from a pool
+     * specific to the thinker function, so that mobjs of the same type are stored
+     * close together and iterated in allocation order. Removed mobjs are returned
+     * to the pool when their thinking turn comes up.
+     *
+     * The returned mobj is zeroed except for the thinker function. It should be
+     * added to the collection with add().
+     *
+     * @param function  Thinker function of the mobj.
+     */
+    struct mobj_s *newMobj(thinkfunc_t function);
+
+    /**
+     * Runs all the thinkers that are not in stasis, and frees or recycles the ones
+     * that have been removed.
+     */
+    void think();
+
     /**
      * Iterate the list of thinkers making a callback for each.
      *
@@ -119,6 +139,11 @@ public:
      */
     de::dint count(de::dint *numInStasis = nullptr) const;
 
+    /**
+     * Composes a description of the thinker pools (for debug).
+     */
+    de::String poolInfo() const;
+
 private:
     DENG2_PRIVATE(d)
 };
@@ -1388,6 +1388,92 @@ void P_GetPtrpv(void *ptr, uint prop, void *params)
     }
 }
 
+/**
+ * Points the value array of @a args matching @a valueType to @a values.
+ */
+static void setArgsValues(DmuArgs &args, valuetype_t valueType, void *values)
+{
+    args.valueType = valueType;
+    switch(valueType)
+    {
+    case DDVT_BOOL:   args.booleanValues = (dd_bool *)values; break;
+    case DDVT_BYTE:   args.byteValues    = (byte *)values;    break;
+    case DDVT_INT:    args.intValues     = (int *)values;     break;
+    case DDVT_FIXED:  args.fixedValues   = (fixed_t *)values; break;
+    case DDVT_ANGLE:  args.angleValues   = (angle_t *)values; break;
+    case DDVT_FLOAT:  args.floatValues   = (float *)values;   break;
+    case DDVT_DOUBLE: args.doubleValues  = (double *)values;  break;
+    case DDVT_PTR:    args.ptrValues     = (void **)values;   break;
+
+    default: {
+        /// @todo Throw exception.
+        QByteArray msg = String("setArgsValues: Value type %1 not supported.")
+                .arg(valueType).toUtf8();
+        App_FatalError(msg.constData());
+        break; }
+    }
+}
+
+#undef P_GetPropsp
+void P_GetPropsp(void *ptr, dmu_propvalue_t *props, int count)
+{
+    if(!ptr || !props) return;
+
+    // The element is resolved once for all the properties.
+    MapElement const *elem = IN_ELEM_CONST(ptr);
+    int const type = DMU_GetType(ptr);
+    DENG2_ASSERT(type == elem->type());
+
+    for(int i = 0; i < count; ++i)
+    {
+        DmuArgs args(type, props[i].prop);
+        setArgsValues(args, props[i].type, props[i].value);
+        getProperty(elem, args);
+    }
+}
+
+#undef P_SetPropsp
+void P_SetPropsp(void *ptr, dmu_propvalue_t const *props, int count)
+{
+    if(!ptr || !props) return;
+
+    // The element is resolved once for all the properties.
+    MapElement *elem = IN_ELEM(ptr);
+    int const type = DMU_GetType(ptr);
+    DENG2_ASSERT(type == elem->type());
+
+    for(int i = 0; i < count; ++i)
+    {
+        DmuArgs args(type, props[i].prop);
+        setArgsValues(args, props[i].type, props[i].value);
+        setProperty(elem, args);
+    }
+}
+
+#undef Sector_FloorHeight
+DENG_EXTERN_C coord_t Sector_FloorHeight(Sector const *sector)
+{
+    return sector? sector->floor().height() : 0;
+}
+
+#undef Sector_CeilingHeight
+DENG_EXTERN_C coord_t Sector_CeilingHeight(Sector const *sector)
+{
+    return sector? sector->ceiling().height() : 0;
+}
+
+#undef Line_FrontSector
+DENG_EXTERN_C Sector *Line_FrontSector(Line const *line)
+{
+    return line? line->front().sectorPtr() : nullptr;
+}
+
+#undef Line_BackSector
+DENG_EXTERN_C Sector *Line_BackSector(Line const *line)
+{
+    return line? line->back().sectorPtr() : nullptr;
+}
+
 #undef P_MapExists
 DENG_EXTERN_C dd_bool P_MapExists(char const *uriCString)
 {
@@ -1547,6 +1633,45 @@ DENG_EXTERN_C int Mobj_BoxIterator(AABoxd const *box,
     return result;
 }
 
+#undef Mobj_AreaQuery
+DENG_EXTERN_C int Mobj_AreaQuery(AABoxd const *box, coord_t const point[2], coord_t range,
+    mobjcandidate_t *buffer, int maxCount)
+{
+    DENG2_ASSERT(box && point);
+    DENG2_ASSERT(buffer || maxCount <= 0);
+
+    if(!App_World().hasMap()) return 0;
+
+    // Reused between calls to avoid allocating memory for every query.
+    static QVector<void *> found;
+    found.clear();
+
+    Map const &map = App_World().map();
+    map.mobjBlockmap().collectInBox(*box, found);
+
+    int const localValidCount = validCount;
+    int count = 0;
+    for(void *object : found)
+    {
+        mobj_t &mob = *(mobj_t *)object;
+        if(mob.validCount == localValidCount) continue; // Already processed.
+        mob.validCount = localValidCount;
+
+        coord_t const dx   = de::abs(mob.origin[0] - point[0]);
+        coord_t const dy   = de::abs(mob.origin[1] - point[1]);
+        coord_t const dist = de::max(dx, dy) - mob.radius;
+        if(dist >= range) continue;
+
+        if(count < maxCount)
+        {
+            buffer[count].mobj     = &mob;
+            buffer[count].distance = dist;
+        }
+        count++;
+    }
+    return count;
+}
+
 #undef Polyobj_BoxIterator
 DENG_EXTERN_C int Polyobj_BoxIterator(AABoxd const *box,
     int (*callback) (struct polyobj_s *, void *), void *context)
@@ -1937,5 +2062,13 @@ DENG_DECLARE_API(Map) =
     P_GetAnglepv,
     P_GetFloatpv,
     P_GetDoublepv,
-    P_GetPtrpv
+    P_GetPtrpv,
+
+    Sector_FloorHeight,
+    Sector_CeilingHeight,
+    Line_FrontSector,
+    Line_BackSector,
+    P_GetPropsp,
+    P_SetPropsp,
+    Mobj_AreaQuery
 };
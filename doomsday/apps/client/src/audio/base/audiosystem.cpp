@@ -78,6 +78,7 @@ dint musVolume = 255 * 2/3;
 
 dint sfxBits = 8;
 dint sfxRate = 11025;
+dint sfxResampleFilter = 0;  // Linear.
 
 #ifdef __CLIENT__
 #  if defined(MACOSX) && defined(MACOS_HAVE_QTKIT)
@@ -2682,6 +2683,7 @@ void AudioSystem::consoleRegister()  // static
     C_VAR_BYTE    ("sound-overlap-stop",  &sfxOneSoundPerEmitter, 0, 0, 1);
 #ifdef __CLIENT__
     //C_VAR_INT     ("sound-rate",          &sfxSampleRate,         0, 11025, 44100);
+    C_VAR_INT     ("sound-resample-filter", &sfxResampleFilter,   0, 0, 1);
     C_VAR_FLOAT2  ("sound-reverb-volume", &sfxReverbStrength,     0, 0, 1.5f, sfxReverbStrengthChanged);
     C_VAR_INT     ("sound-volume",        &sfxVolume,             0, 0, 255);
 
@@ -2698,6 +2700,8 @@ void AudioSystem::consoleRegister()  // static
 
     C_CMD("reverbparams", "ffff", ReverbParameters);
 
+    audio::SfxSampleCache::consoleRegister();
+
     // Debug:
     C_VAR_INT     ("sound-info",          &showSoundInfo,         0, 0, 1);
 #endif
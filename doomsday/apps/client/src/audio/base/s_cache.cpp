@@ -24,9 +24,13 @@
 #include "def_main.h"  // Def_Get*()
 #include "audio/audiosystem.h"
 
+#include <doomsday/console/cmd.h>
 #include <doomsday/filesys/fs_main.h>
 #include <doomsday/resource/wav.h>
 #include <de/timer.h>
+#include <de/Time>
+#include <QHash>
+#include <QVector>
 #include <cstring>
 
 using namespace de;
@@ -38,10 +42,6 @@ using namespace de;
 
 namespace audio {
 
-// The cached samples are stored in a hash. When a sample is purged, its data will stay
-// in the hash (sample lengths needed by the Logical Sound Manager).
-static dint const CACHE_HASH_SIZE  = 64;
-
 static timespan_t const PURGE_TIME = 10 * TICSPERSEC;
 
 // 1 Mb = about 12 sec of 44KHz 16bit sound in the cache.
@@ -50,18 +50,29 @@ static dint const MAX_CACHE_KB     = 4096;
 // Even one minute of silence is quite a long time during gameplay.
 static dint const MAX_CACHE_TICS   = TICSPERSEC * 60 * 4;  // 4 minutes.
 
-#if 0
 /**
- * Determines the necessary upsample factor for the given sample @a rate.
+ * Samples are only converted when the configured format ("sound-16bit" and
+ * "sound-rate") differs from the default 8-bit 11025 Hz. Otherwise they are cached
+ * in their original format.
+ */
+static bool sampleConversionEnabled()
+{
+    return ::sfxBits != 8 || ::sfxRate != 11025;
+}
+
+/**
+ * Determines the necessary upsample factor for the given sample @a rate. Only 2x and
+ * 4x upsampling is supported.
  */
 static dint upsampleFactor(dint rate)
 {
     dint factor = 1;
 #ifdef __CLIENT__
     // The (up)sampling factor.
-    if (App_AudioSystem().mustUpsampleToSfxRate())
+    if (App_AudioSystem().mustUpsampleToSfxRate() && rate > 0)
     {
-        factor = de::max(1, ::sfxRate / rate);
+        dint const ratio = ::sfxRate / rate;
+        factor = (ratio >= 4? 4 : ratio >= 2? 2 : 1);
     }
 #else
     DENG2_UNUSED(rate);
@@ -69,197 +80,215 @@ static dint upsampleFactor(dint rate)
     return factor;
 }
 
-// Utility for converting an unsigned byte to signed short (for resampling).
-static dshort inline U8_S16(duchar b)
+/*
+ * Sample conversion kernels. The loops are kept free of branches and work on
+ * contiguous arrays so that the compiler is able to vectorize them.
+ */
+
+enum ResampleFilter { LinearFilter, CubicFilter };
+
+/// Utility for converting unsigned bytes to signed shorts (for resampling).
+static void convertU8ToS16(dshort *dst, duchar const *src, dint count)
 {
-    return (b - 0x80) << 8;
+    for (dint i = 0; i < count; ++i)
+    {
+        dst[i] = dshort((dint(src[i]) - 0x80) * 256);
+    }
+}
+
+template <typename SampleType>
+inline SampleType clampSample(dint value);
+
+template <>
+inline duchar clampSample<duchar>(dint value)
+{
+    return duchar(de::clamp(0, value, 255));
+}
+
+template <>
+inline dshort clampSample<dshort>(dint value)
+{
+    return dshort(de::clamp(-32768, value, 32767));
 }
 
 /**
- * Simple linear resampling with possible conversion to 16 bits. The destination sample
- * must be initialized and it must have a large enough buffer. We won't reduce rate or
- * bits here.
+ * Simple linear interpolation. The last source sample is repeated at the end.
  *
- * @note This is not a clean way to resample a sound. If you read about DSP a bit, you'll
- * find out that interpolation adds a lot of extra frequencies in the sample. It should
- * be low-pass filtered after the interpolation.
+ * @note Interpolation adds a lot of extra frequencies in the sample. CubicFilter
+ * sounds cleaner.
  */
-static void resample(void *dst, dint dstBytesPer, dint dstRate, void const *src,
-    dint srcBytesPer, dint srcRate, dint srcNumSamples, duint srcSize)
+template <typename SampleType, dint Factor>
+static void upsampleLinear(SampleType *dst, SampleType const *src, dint count)
 {
-    DENG2_ASSERT(src && dst);
-
-    // Let's first check for the easy cases.
-    if (dstRate == srcRate)
+    for (dint i = 0; i < count - 1; ++i)
     {
-        if (srcBytesPer == dstBytesPer)
+        dint const first = src[i];
+        dint const last  = src[i + 1];
+        dint const mid   = (first + last) >> 1;
+
+        SampleType *out = dst + i * Factor;
+        out[0] = SampleType(first);
+        if (Factor == 2)
         {
-            // A simple copy will suffice.
-            std::memcpy(dst, src, srcSize);
+            out[1] = SampleType(mid);
         }
-        else if (srcBytesPer == 1 && dstBytesPer == 2)
+        else
         {
-            // Just changing the bytes won't do much good...
-            duchar const *sp = (duchar const *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples; ++i)
-            {
-                *dp++ = (*sp++ - 0x80) << 8;
-            }
+            out[1] = SampleType((first + mid) >> 1);
+            out[2] = SampleType(mid);
+            out[3] = SampleType((mid + last) >> 1);
         }
-        return;
     }
 
-    // 2x resampling.
-    if (dstRate == 2 * srcRate)
+    // Fill in the last ones as well.
+    for (dint k = 0; k < Factor; ++k)
     {
-        if (dstBytesPer == 1)
-        {
-            // The source has a byte per sample as well.
-            duchar const *sp = (duchar const *) src;
-            duchar *dp       = (duchar *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
-            }
-
-            // Fill in the last two as well.
-            dp[0] = dp[1] = *sp;
-        }
-        else if (srcBytesPer == 1)
-        {
-            // Destination is signed 16bit. Source is 8bit.
-            duchar const *sp = (duchar const *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                dshort const first = U8_S16(*sp);
+        dst[(count - 1) * Factor + k] = src[count - 1];
+    }
+}
 
-                *dp++ = first;
-                *dp++ = (first + U8_S16(sp[1])) >> 1;
-            }
+/**
+ * Catmull-Rom interpolation using fixed-point weights (1/128ths) at quarter positions
+ * between two source samples.
+ */
+static dint const cubicWeights[4][4] = {
+    {  0, 128,   0,  0 },
+    { -9, 111,  29, -3 },
+    { -8,  72,  72, -8 },
+    { -3,  29, 111, -9 },
+};
 
-            // Fill in the last two as well.
-            dp[0] = dp[1] = U8_S16(*sp);
-        }
-        else if (srcBytesPer == 2)
-        {
-            // Destination is signed 16bit. Source is 16bit.
-            dshort const *sp = (dshort const *) src;
-            dshort *dp       = (dshort *) dst;
+template <typename SampleType, dint Factor>
+static inline void interpolateCubic(SampleType *out, dint p0, dint p1, dint p2, dint p3)
+{
+    for (dint k = 0; k < Factor; ++k)
+    {
+        dint const *w = cubicWeights[k * (4 / Factor)];
+        out[k] = clampSample<SampleType>((w[0] * p0 + w[1] * p1 + w[2] * p2 + w[3] * p3 + 64) >> 7);
+    }
+}
 
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
-            }
+template <typename SampleType, dint Factor>
+static void upsampleCubic(SampleType *dst, SampleType const *src, dint count)
+{
+    auto edge = [src, count, dst] (dint i)
+    {
+        auto at = [src, count] (dint n) { return dint(src[de::clamp(0, n, count - 1)]); };
+        interpolateCubic<SampleType, Factor>(dst + i * Factor, at(i - 1), at(i), at(i + 1), at(i + 2));
+    };
 
-            dp[0] = dp[1] = *sp;
-        }
+    if (count < 4)
+    {
+        for (dint i = 0; i < count; ++i) edge(i);
         return;
     }
 
-    // 4x resampling (11Khz => 44KHz only).
-    if (dstRate == 4 * srcRate)
+    edge(0);
+    for (dint i = 1; i < count - 2; ++i)
     {
-        if (dstBytesPer == 1)
-        {
-            // The source has a byte per sample as well.
-            duchar const *sp = (duchar const *) src;
-            duchar *dp       = (duchar *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                duchar const mid = (*sp + sp[1]) >> 1;
+        interpolateCubic<SampleType, Factor>(dst + i * Factor, src[i - 1], src[i], src[i + 1], src[i + 2]);
+    }
+    edge(count - 2);
+    edge(count - 1);
+}
 
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
+template <typename SampleType>
+static void upsample(SampleType *dst, SampleType const *src, dint count, dint factor,
+                     ResampleFilter filter)
+{
+    if (count <= 0) return;
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
-        else if (srcBytesPer == 1)
-        {
-            // Destination is signed 16bit. Source is 8bit.
-            duchar const *sp = (duchar const *) src;
-            dshort *dp       = (dshort *) dst;
+    if (filter == CubicFilter)
+    {
+        if (factor == 2) upsampleCubic<SampleType, 2>(dst, src, count);
+        else             upsampleCubic<SampleType, 4>(dst, src, count);
+    }
+    else
+    {
+        if (factor == 2) upsampleLinear<SampleType, 2>(dst, src, count);
+        else             upsampleLinear<SampleType, 4>(dst, src, count);
+    }
+}
 
-            for (int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                dshort const first = U8_S16(*sp);
-                dshort const last  = U8_S16(sp[1]);
-                dshort const mid   = (first + last) >> 1;
-
-                *dp++ = first;
-                *dp++ = (first + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + last) >> 1;
-            }
+/**
+ * Resampling with possible conversion to 16 bits. The destination sample must be
+ * initialized and it must have a large enough buffer. We won't reduce rate or bits
+ * here, and only 2x and 4x upsampling is supported.
+ */
+static void resample(void *dst, dint dstBytesPer, dint dstRate, void const *src,
+    dint srcBytesPer, dint srcRate, dint srcNumSamples, duint srcSize, ResampleFilter filter)
+{
+    DENG2_ASSERT(src && dst);
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = U8_S16(*sp);
+    // Let's first check for the easy cases.
+    if (dstRate == srcRate)
+    {
+        if (srcBytesPer == dstBytesPer)
+        {
+            // A simple copy will suffice.
+            std::memcpy(dst, src, srcSize);
         }
-        else if (srcBytesPer == 2)
+        else if (srcBytesPer == 1 && dstBytesPer == 2)
         {
-            // Destination is signed 16bit. Source is 16bit.
-            dshort const *sp = (dshort const *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                dshort const mid = (*sp + sp[1]) >> 1;
+            // Just changing the bytes won't do much good...
+            convertU8ToS16((dshort *) dst, (duchar const *) src, srcNumSamples);
+        }
+        return;
+    }
 
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
+    dint const factor = dstRate / srcRate;
+    DENG2_ASSERT(factor == 2 || factor == 4);
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
+    if (dstBytesPer == 1)
+    {
+        // The source has a byte per sample as well.
+        upsample((duchar *) dst, (duchar const *) src, srcNumSamples, factor, filter);
+    }
+    else if (srcBytesPer == 1)
+    {
+        // Destination is signed 16bit. Source is 8bit.
+        QVector<dshort> converted(srcNumSamples);
+        convertU8ToS16(converted.data(), (duchar const *) src, srcNumSamples);
+        upsample((dshort *) dst, converted.constData(), srcNumSamples, factor, filter);
+    }
+    else
+    {
+        // Destination is signed 16bit. Source is 16bit.
+        upsample((dshort *) dst, (dshort const *) src, srcNumSamples, factor, filter);
     }
 }
+
+static ResampleFilter resampleFilter()
+{
+#ifdef __CLIENT__
+    return ::sfxResampleFilter? CubicFilter : LinearFilter;
+#else
+    return LinearFilter;
 #endif
+}
 
 /**
  * Prepare the given sound sample @a smp for caching.
  *
- * If the sample @a data is already in the right format, just make a copy of it.
- *
- * If necessary, resample the sound @a data upwards to the minimum resolution and
- * bits (specified in the user Config). (You can play higher resolution sounds
- * than the current setting, but not lower resolution ones.)
+ * If necessary, the sound will be resampled upwards to the minimum resolution and
+ * bits (specified in the user Config). (You can play higher resolution sounds than
+ * the current setting, but not lower resolution ones.) With the default settings the
+ * sample is used as is (see sampleConversionEnabled()).
  *
- * Converts the sample @a data and writes it to the (M_Malloc() allocated) buffer in @a smp
- * (ownership is given to the sfxsample_t).
- *
- * @param data        Actual sample data.
- * @param size        Size in bytes.
  * @param numSamples  Number of samples.
  * @param bytesPer    Bytes per sample (1 or 2).
  * @param rate        Samples per second.
  */
-void configureSample(sfxsample_t &smp, void const *data, duint size,
-                     dint numSamples, dint bytesPer, dint rate)
+static void configureSample(sfxsample_t &smp, dint numSamples, dint bytesPer, dint rate)
 {
-    DENG2_UNUSED(data);
-    DENG2_UNUSED(size);
-
     zap(smp);
     smp.bytesPer   = bytesPer;
     smp.size       = numSamples * bytesPer;
     smp.rate       = rate;
     smp.numSamples = numSamples;
 
-#if 0
+    if (!sampleConversionEnabled()) return;
+
     // Apply the upsample factor.
     dint const rsfactor = upsampleFactor(rate);
     smp.rate       *= rsfactor;
@@ -272,7 +301,137 @@ void configureSample(sfxsample_t &smp, void const *data, duint size,
         smp.bytesPer = 2;
         smp.size     *= 2;
     }
-#endif
+}
+
+/**
+ * Sample data in its original format, as loaded from a file or a lump.
+ */
+struct LoadedSample
+{
+    void const *data = nullptr;
+    dint bytesPer    = 0;
+    dint rate        = 0;
+    dint numSamples  = 0;
+
+    void *zoneData   = nullptr;  ///< Loaded WAV data (owned).
+    File1 *lump      = nullptr;  ///< Lump whose cache holds the data (locked).
+
+    LoadedSample() {}
+    ~LoadedSample()
+    {
+        if (zoneData) Z_Free(zoneData);
+        if (lump) lump->unlock();
+    }
+    DENG2_NO_ASSIGN(LoadedSample)
+    DENG2_NO_COPY  (LoadedSample)
+};
+
+/**
+ * Figure out where to get the sample data for a sound, and load it. It might be from a
+ * data file such as a WAD or external sound resources. The definition and the
+ * configuration settings will help us in making the decision.
+ *
+ * @return  @c true if the sample was loaded.
+ */
+static bool loadSample(sfxinfo_t const &info, LoadedSample &loaded)
+{
+    /// Has an external sound file been defined?
+    /// @note Path is relative to the base path.
+    if (!Str_IsEmpty(&info.external))
+    {
+        String searchPath = App_BasePath() / String(Str_Text(&info.external));
+        // Try loading.
+        loaded.zoneData = WAV_Load(searchPath.toUtf8().constData(), &loaded.bytesPer,
+                                   &loaded.rate, &loaded.numSamples);
+    }
+
+    // If external didn't succeed, let's try the default resource dir.
+    if (!loaded.zoneData)
+    {
+        /**
+         * If the sound has an invalid lumpname, search external anyway. If the
+         * original sound is from a PWAD, we won't look for an external resource
+         * (probably a custom sound).
+         *
+         * @todo should be a cvar.
+         */
+        if (info.lumpNum < 0 || !App_FileSystem().lump(info.lumpNum).container().hasCustom())
+        {
+            try
+            {
+                String foundPath = App_FileSystem().findPath(de::Uri(info.lumpName, RC_SOUND),
+                                                             RLF_DEFAULT, App_ResourceClass(RC_SOUND));
+                foundPath = App_BasePath() / foundPath;  // Ensure the path is absolute.
+
+                loaded.zoneData = WAV_Load(foundPath.toUtf8().constData(), &loaded.bytesPer,
+                                           &loaded.rate, &loaded.numSamples);
+            }
+            catch (FS1::NotFoundError const &)
+            {}  // Ignore this error.
+        }
+    }
+
+    // No sample loaded yet?
+    if (!loaded.zoneData)
+    {
+        // Try loading from the lump.
+        if (info.lumpNum < 0)
+        {
+            LOG_AUDIO_WARNING("Failed to locate lump resource '%s' for sample '%s'")
+                << info.lumpName << info.id;
+            return false;
+        }
+
+        File1 &lump = App_FileSystem().lump(info.lumpNum);
+        if (lump.size() <= 8) return false;
+
+        char hdr[12];
+        lump.read((duint8 *)hdr, 0, 12);
+
+        // Is this perhaps a WAV sound?
+        if (WAV_CheckFormat(hdr))
+        {
+            // Load as WAV, then.
+            duint8 const *sp = lump.cache();
+            loaded.zoneData = WAV_MemoryLoad((byte const *) sp, lump.size(), &loaded.bytesPer,
+                                             &loaded.rate, &loaded.numSamples);
+            lump.unlock();
+
+            if (!loaded.zoneData)
+            {
+                // Abort...
+                LOG_AUDIO_WARNING("Unknown WAV format in lump '%s'") << info.lumpName;
+                return false;
+            }
+        }
+    }
+
+    if (loaded.zoneData)  // Loaded!
+    {
+        loaded.data      = loaded.zoneData;
+        loaded.bytesPer /= 8;  // Was returned as bits.
+        return true;
+    }
+
+    // Probably an old-fashioned DOOM sample.
+    File1 &lump = App_FileSystem().lump(info.lumpNum);
+    duint8 hdr[8];
+    lump.read(hdr, 0, 8);
+    dint head         = DD_SHORT(*(dshort const *) (hdr));
+    loaded.rate       = DD_SHORT(*(dshort const *) (hdr + 2));
+    loaded.numSamples = de::max(0, DD_LONG(*(dint const *) (hdr + 4)));
+    loaded.bytesPer   = 1; // 8-bit.
+
+    if (head == 3 && loaded.numSamples > 0 && (unsigned) loaded.numSamples <= lump.size() - 8)
+    {
+        // The sample data can be used as-is - load directly from the lump cache.
+        loaded.data = lump.cache() + 8;  // Skip the header.
+        loaded.lump = &lump;
+        return true;
+    }
+
+    LOG_AUDIO_WARNING("Unknown lump '%s' sound format") << info.lumpName;
+    return false;
 }
 
 SfxSampleCache::CacheItem::CacheItem()
@@ -310,64 +469,62 @@ void SfxSampleCache::CacheItem::replaceSample(sfxsample_t &newSample)
 
 DENG2_PIMPL(SfxSampleCache)
 {
-    /**
-     * Cached samples are placed in a hash (key: sound id).
-     */
-    struct Hash {
-        CacheItem *first = nullptr;
-        CacheItem *last  = nullptr;
-    } hash[CACHE_HASH_SIZE];
+    QHash<dint, CacheItem *> items;  ///< Cached samples (key: sound id).
 
+    /// Cached samples in the order of use (most recently used first).
+    CacheItem *mostRecent  = nullptr;
+    CacheItem *leastRecent = nullptr;
+
+    dint totalSize = 0;  ///< Total size of the cache (in bytes).
     dint lastPurge = 0;  ///< Time of the last purge (in game ticks).
 
     Impl(Public *i) : Base(i) {}
     ~Impl() { removeAll(); }
 
     /**
-     * Find the appropriate hash for the given @a soundId.
+     * Lookup a CacheItem with the given @a soundId.
      */
-    Hash &hashFor(dint soundId)
+    CacheItem *tryFind(dint soundId) const
     {
-        return hash[duint( soundId ) % CACHE_HASH_SIZE];
+        return items.value(soundId, nullptr);
     }
 
-    Hash const &hashFor(dint soundId) const
+    void linkAsMostRecent(CacheItem &item)
     {
-        return const_cast<Impl *>(this)->hashFor(soundId);
+        item.prev = nullptr;
+        item.next = mostRecent;
+        if (mostRecent) mostRecent->prev = &item;
+        mostRecent = &item;
+        if (!leastRecent) leastRecent = &item;
     }
 
-    /**
-     * Lookup a CacheItem with the given @a soundId.
-     */
-    CacheItem *tryFind(dint soundId) const
+    void unlink(CacheItem &item)
     {
-        for (CacheItem *it = hashFor(soundId).first; it; it = it->next)
-        {
-            if (it->sample.id == soundId)
-                return it;
-        }
-        return nullptr;  // Not found.
+        if (mostRecent  == &item) mostRecent  = item.next;
+        if (leastRecent == &item) leastRecent = item.prev;
+        if (item.next) item.next->prev = item.prev;
+        if (item.prev) item.prev->next = item.next;
+        item.next = item.prev = nullptr;
+    }
+
+    void touch(CacheItem &item)
+    {
+        if (mostRecent == &item) return;
+        unlink(item);
+        linkAsMostRecent(item);
     }
 
     /**
-     * Add a new CacheItem with the given @a soundId to the hash and return
-     * it (ownership is retained).
+     * Add a new CacheItem with the given @a soundId and return it (ownership is
+     * retained).
      */
     CacheItem &insertCacheItem(dint soundId)
     {
         auto *item = new CacheItem;
-
-        Hash &hash = hashFor(soundId);
-        if (hash.last)
-        {
-            hash.last->next = item;
-            item->prev = hash.last;
-        }
-        hash.last = item;
-
-        if (!hash.first)
-            hash.first = item;
-
+        item->lastUsed = Timer_Ticks();
+        items.insert(soundId, item);
+        linkAsMostRecent(*item);
+        totalSize += sizeof(*item);
         return *item;
     }
 
@@ -379,18 +536,9 @@ DENG2_PIMPL(SfxSampleCache)
 
         notifyRemove(item);
 
-        Hash &hash = hashFor(item.sample.id);
-
-        // Unlink the item.
-        if (hash.last == &item)
-            hash.last = item.prev;
-        if (hash.first == &item)
-            hash.first = item.next;
-
-        if (item.next)
-            item.next->prev = item.prev;
-        if (item.prev)
-            item.prev->next = item.next;
+        unlink(item);
+        items.remove(item.sample.id);
+        totalSize -= item.sample.size + sizeof(CacheItem);
 
 #ifdef __CLIENT__
         App_AudioSystem().allowSfxRefresh(true);
@@ -399,6 +547,7 @@ DENG2_PIMPL(SfxSampleCache)
         // Free all memory allocated for the item.
         delete &item;
     }
+
     /**
      * Caches a copy of the given sample. If it's already in the cache and has the
      * same format, nothing is done.
@@ -417,7 +566,7 @@ DENG2_PIMPL(SfxSampleCache)
         dint bytesPer, dint rate, dint group)
     {
         sfxsample_t cached;
-        configureSample(cached, data, size, numSamples, bytesPer, rate);
+        configureSample(cached, numSamples, bytesPer, rate);
 
         // Have we already cached a comparable sample?
         CacheItem *item = tryFind(soundId);
@@ -441,15 +590,12 @@ DENG2_PIMPL(SfxSampleCache)
         cached.id    = soundId;
         cached.group = group;
 
-#if 0
         // Perform resampling if necessary.
         resample(cached.data = M_Malloc(cached.size), cached.bytesPer, cached.rate,
-                 data, bytesPer, rate, numSamples, size);
-#endif
-        cached.data = M_Malloc(cached.size);
-        std::memcpy(cached.data, data, size);
+                 data, bytesPer, rate, numSamples, size, resampleFilter());
 
         // Replace the cached sample.
+        totalSize += dint(cached.size) - dint(item->sample.size);
         item->replaceSample(cached);
 
         return *item;
@@ -460,12 +606,9 @@ DENG2_PIMPL(SfxSampleCache)
      */
     void removeAll()
     {
-        for (Hash &hl : hash)
+        while (mostRecent)
         {
-            while(hl.first)
-            {
-                removeCacheItem(*hl.first);
-            }
+            removeCacheItem(*mostRecent);
         }
     }
 
@@ -510,76 +653,44 @@ void SfxSampleCache::maybeRunPurge()
 
     d->lastPurge = nowTime;
 
-    // Count the total size of the cache.
-    // Also get rid of all sounds that have timed out.
-    dint totalSize  = 0;
-    CacheItem *next = nullptr;
-    for (Impl::Hash &hash : d->hash)
-    for (CacheItem *it = hash.first; it; it = next)
+    // Get rid of all sounds that have timed out. These are at the end of the list.
+    while (d->leastRecent && nowTime - d->leastRecent->lastUsed > MAX_CACHE_TICS)
     {
-        next = it->next;
-        if (nowTime - it->lastUsed > MAX_CACHE_TICS)
-        {
-            // This sound hasn't been used in a looong time.
-            d->removeCacheItem(*it);
-            continue;
-        }
-
-        totalSize += it->sample.size + sizeof(*it);
+        // This sound hasn't been used in a looong time.
+        d->removeCacheItem(*d->leastRecent);
     }
 
+    /*
+     * If the cache is too large, get rid of the least recently used stopped samples
+     * until the cache size is within limits or there are no more stopped sounds.
+     */
     dint const maxSize = MAX_CACHE_KB * 1024;
-    dint lowHits = 0;
-    CacheItem *lowest;
-    while(totalSize > maxSize)
-    {
-        /*
-         * The cache is too large! Find the stopped sample with the lowest hitcount
-         * and get rid of it. Repeat until cache size is within limits or there are
-         * no more stopped sounds.
-         */
-        lowest = 0;
-        for (Impl::Hash &hash : d->hash)
-        {
-            for (CacheItem *it = hash.first; it; it = it->next)
-            {
+    CacheItem *it = d->leastRecent;
+    while (it && d->totalSize > maxSize)
+    {
+        CacheItem *moreRecent = it->prev;
 #ifdef __CLIENT__
-                // If the sample is playing we won't remove it now.
-                if (App_AudioSystem().sfxChannels().isPlaying(it->sample.id))
-                    continue;
+        // If the sample is playing we won't remove it now.
+        if (!App_AudioSystem().sfxChannels().isPlaying(it->sample.id))
 #endif
-
-                // This sample could be removed, let's check the hits.
-                if (!lowest || it->hits < lowHits)
-                {
-                    lowest  = it;
-                    lowHits = it->hits;
-                }
-            }
+        {
+            // Stop and uncache this cached sample.
+            d->removeCacheItem(*it);
         }
-
-        // No more samples to remove?
-        if (!lowest) break;
-
-        // Stop and uncache this cached sample.
-        totalSize -= lowest->sample.size + sizeof(*lowest);
-        d->removeCacheItem(*lowest);
+        it = moreRecent;
     }
 }
 
 void SfxSampleCache::info(duint *cacheBytes, duint *sampleCount)
 {
-    duint size  = 0;
-    duint count = 0;
-    for (Impl::Hash &hash : d->hash)
-    for (CacheItem *it = hash.first; it; it = it->next)
+    duint size = 0;
+    for (CacheItem const *it = d->mostRecent; it; it = it->next)
     {
-        size  += it->sample.size;
-        count += 1;
+        size += it->sample.size;
     }
 
     if (cacheBytes)  *cacheBytes  = size;
-    if (sampleCount) *sampleCount = count;
+    if (sampleCount) *sampleCount = duint(d->items.size());
 }
 
 void SfxSampleCache::hit(dint soundId)
@@ -587,6 +698,7 @@ void SfxSampleCache::hit(dint soundId)
     if (CacheItem *found = d->tryFind(soundId))
     {
         found->hit();
+        d->touch(*found);
     }
 }
 
@@ -619,138 +731,87 @@ sfxsample_t *SfxSampleCache::cache(dint soundId)
     // Attempt to cache this now.
     LOG_AUDIO_VERBOSE("Caching sample '%s' (id:%i)...") << info->id << soundId;
 
-    dint bytesPer = 0;
-    dint rate = 0;
-    dint numSamples = 0;
+    LoadedSample loaded;
+    if (!loadSample(*info, loaded)) return nullptr;
 
-    /**
-     * Figure out where to get the sample data for this sound. It might be from a
-     * data file such as a WAD or external sound resources. The definition and the
-     * configuration settings will help us in making the decision.
-     */
-    void *data = nullptr;
+    // Insert a copy of this into the cache.
+    CacheItem &item = d->insert(soundId, loaded.data, loaded.bytesPer * loaded.numSamples,
+                                loaded.numSamples, loaded.bytesPer, loaded.rate, info->group);
+    return &item.sample;
+}
 
-    /// Has an external sound file been defined?
-    /// @note Path is relative to the base path.
-    if (!Str_IsEmpty(&info->external))
-    {
-        String searchPath = App_BasePath() / String(Str_Text(&info->external));
-        // Try loading.
-        data = WAV_Load(searchPath.toUtf8().constData(), &bytesPer, &rate, &numSamples);
-        if (data)
-        {
-            bytesPer /= 8; // Was returned as bits.
-        }
-    }
+#ifdef __CLIENT__
+/**
+ * Converts all the defined sounds using each of the resampling kernels, and reports
+ * the time taken. Samples are loaded beforehand so that only the conversion is timed.
+ */
+D_CMD(BenchmarkSfxResample)
+{
+    DENG2_UNUSED3(src, argc, argv);
 
-    // If external didn't succeed, let's try the default resource dir.
-    if (!data)
+    struct Source
     {
-        /**
-         * If the sound has an invalid lumpname, search external anyway. If the
-         * original sound is from a PWAD, we won't look for an external resource
-         * (probably a custom sound).
-         *
-         * @todo should be a cvar.
-         */
-        if (info->lumpNum < 0 || !App_FileSystem().lump(info->lumpNum).container().hasCustom())
-        {
-            try
-            {
-                String foundPath = App_FileSystem().findPath(de::Uri(info->lumpName, RC_SOUND),
-                                                             RLF_DEFAULT, App_ResourceClass(RC_SOUND));
-                foundPath = App_BasePath() / foundPath;  // Ensure the path is absolute.
-
-                data = WAV_Load(foundPath.toUtf8().constData(), &bytesPer, &rate, &numSamples);
-                if (data)
-                {
-                    // Loading was successful.
-                    bytesPer /= 8;  // Was returned as bits.
-                }
-            }
-            catch (FS1::NotFoundError const &)
-            {}  // Ignore this error.
-        }
-    }
-
-    // No sample loaded yet?
-    if (!data)
+        Block data;
+        dint bytesPer;
+        dint rate;
+        dint numSamples;
+    };
+    QList<Source> sources;
+    dint64 totalSamples = 0;
+    for (dint i = 1; i < ::runtimeDefs.sounds.size(); ++i)
     {
-        // Try loading from the lump.
-        if (info->lumpNum < 0)
-        {
-            LOG_AUDIO_WARNING("Failed to locate lump resource '%s' for sample '%s'")
-                << info->lumpName << info->id;
-            return nullptr;
-        }
-
-        File1 &lump = App_FileSystem().lump(info->lumpNum);
-        if (lump.size() <= 8) return nullptr;
-
-        char hdr[12];
-        lump.read((duint8 *)hdr, 0, 12);
-
-        // Is this perhaps a WAV sound?
-        if (WAV_CheckFormat(hdr))
-        {
-            // Load as WAV, then.
-            duint8 const *sp = lump.cache();
-            data = WAV_MemoryLoad((byte const *) sp, lump.size(), &bytesPer, &rate, &numSamples);
-            lump.unlock();
-
-            if (!data)
-            {
-                // Abort...
-                LOG_AUDIO_WARNING("Unknown WAV format in lump '%s'") << info->lumpName;
-                return nullptr;
-            }
+        LoadedSample loaded;
+        if (!loadSample(::runtimeDefs.sounds[i], loaded)) continue;
 
-            bytesPer /= 8;
-        }
+        dsize const size = dsize(loaded.bytesPer) * loaded.numSamples;
+        sources << Source{ Block(loaded.data, size), loaded.bytesPer, loaded.rate, loaded.numSamples };
+        totalSamples += loaded.numSamples;
     }
+    LOG_SCR_MSG("Loaded %i samples (%i sample frames)") << sources.size() << totalSamples;
 
-    if (data)  // Loaded!
+    struct Test
     {
-        // Insert a copy of this into the cache.
-        CacheItem &item = d->insert(soundId, data, bytesPer * numSamples, numSamples,
-                                    bytesPer, rate, info->group);
-        Z_Free(data);
-        return &item.sample;
-    }
-
-    // Probably an old-fashioned DOOM sample.
-    dsize lumpLength = 0;
-    if (info->lumpNum >= 0)
+        char const *label;
+        dint bits;
+        dint factor;
+        ResampleFilter filter;
+    };
+    static Test const tests[] = {
+        { "8-bit to 16-bit",        16, 1, LinearFilter },
+        { "2x linear (8-bit)",       8, 2, LinearFilter },
+        { "2x linear (16-bit)",     16, 2, LinearFilter },
+        { "4x linear (16-bit)",     16, 4, LinearFilter },
+        { "2x cubic (16-bit)",      16, 2, CubicFilter  },
+        { "4x cubic (16-bit)",      16, 4, CubicFilter  },
+    };
+    for (Test const &test : tests)
     {
-        File1 &lump = App_FileSystem().lump(info->lumpNum);
-
-        if (lump.size() > 8)
+        Time startedAt;
+        dint64 produced = 0;
+        for (Source const &source : sources)
         {
-            duint8 hdr[8];
-            lump.read(hdr, 0, 8);
-            dint head  = DD_SHORT(*(dshort const *) (hdr));
-            rate       = DD_SHORT(*(dshort const *) (hdr + 2));
-            numSamples = de::max(0, DD_LONG(*(dint const *) (hdr + 4)));
-            bytesPer   = 1; // 8-bit.
-
-            if (head == 3 && numSamples > 0 && (unsigned) numSamples <= lumpLength - 8)
-            {
-                // The sample data can be used as-is - load directly from the lump cache.
-                duint8 const *data = lump.cache() + 8;  // Skip the header.
-
-                // Insert a copy of this into the cache.
-                CacheItem &item = d->insert(soundId, data, bytesPer * numSamples, numSamples,
-                                            bytesPer, rate, info->group);
-
-                lump.unlock();
-
-                return &item.sample;
-            }
+            dint const dstBytesPer = de::max(source.bytesPer, test.bits / 8);
+            dint const dstSamples  = source.numSamples * test.factor;
+            QVector<duint8> dst(dstSamples * dstBytesPer);
+            resample(dst.data(), dstBytesPer, source.rate * test.factor, source.data.constData(),
+                     source.bytesPer, source.rate, source.numSamples, duint(source.data.size()),
+                     test.filter);
+            produced += dstSamples;
         }
+        ddouble const elapsed = startedAt.since();
+        LOG_SCR_MSG("%s: %.2f ms (%.1f Msamples/s)")
+                << test.label << elapsed * 1000
+                << (elapsed > 0? ddouble(produced) / elapsed / 1.0e6 : 0.0);
     }
+    return true;
+}
+#endif
 
-    LOG_AUDIO_WARNING("Unknown lump '%s' sound format") << info->lumpName;
-    return nullptr;
+void SfxSampleCache::consoleRegister()  // static
+{
+#ifdef __CLIENT__
+    C_CMD("benchsfxresample", "", BenchmarkSfxResample);
+#endif
 }
 
 }  // namespace audio
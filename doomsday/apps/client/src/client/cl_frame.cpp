@@ -110,8 +110,13 @@ float Cl_FrameGameTime()
 
 void Cl_Frame2Received(int packetType)
 {
+    // The frame is read directly from the message buffer.
+    de::dsize const start = Reader_Pos(msgReader);
+    de::PackedReader frame(netBuffer.msg.data + start, netBuffer.length - start);
+    Reader_SetPos(msgReader, netBuffer.length);
+
     // The first thing in the frame is the gameTime.
-    frameGameTime = Reader_ReadFloat(msgReader);
+    frameGameTime = frame.readFloat();
 
     // All frames that arrive before the first frame are ignored.
     // They are most likely from the wrong map.
@@ -127,42 +132,42 @@ void Cl_Frame2Received(int packetType)
     }
 
     // Read and process the message.
-    while (!Reader_AtEnd(msgReader))
+    while (!frame.atEnd())
     {
-        byte const deltaType = Reader_ReadByte(msgReader);
+        byte const deltaType = frame.readByte();
 
         switch (deltaType)
         {
         case DT_CREATE_MOBJ:
             // The mobj will be created/shown.
-            ClMobj_ReadDelta();
+            ClMobj_ReadDelta(frame);
             break;
 
         case DT_MOBJ:
             // The mobj will be hidden if it's not yet Created.
-            ClMobj_ReadDelta();
+            ClMobj_ReadDelta(frame);
             break;
 
         case DT_NULL_MOBJ:
             // The mobj will be removed.
-            ClMobj_ReadNullDelta();
+            ClMobj_ReadNullDelta(frame);
             break;
 
         case DT_PLAYER:
-            ClPlayer_ReadDelta();
+            ClPlayer_ReadDelta(frame);
             break;
 
         case DT_SECTOR:
-            Cl_ReadSectorDelta(deltaType);
+            Cl_ReadSectorDelta(frame, deltaType);
             break;
 
         //case DT_SIDE_R6: // Old format.
         case DT_SIDE:
-            Cl_ReadSideDelta(deltaType);
+            Cl_ReadSideDelta(frame, deltaType);
             break;
 
         case DT_POLY:
-            Cl_ReadPolyDelta();
+            Cl_ReadPolyDelta(frame);
             break;
 
         case DT_SOUND:
@@ -170,7 +175,7 @@ void Cl_Frame2Received(int packetType)
         case DT_SECTOR_SOUND:
         case DT_SIDE_SOUND:
         case DT_POLY_SOUND:
-            Cl_ReadSoundDelta((deltatype_t) deltaType);
+            Cl_ReadSoundDelta(frame, (deltatype_t) deltaType);
             break;
 
         default:
@@ -178,6 +183,17 @@ void Cl_Frame2Received(int packetType)
                     << deltaType << netBuffer.length;
             return;
         }
+
+        if (frame.hasUnderflowed())
+        {
+            // The rest of the frame is missing.
+            break;
+        }
+    }
+
+    if (frame.hasUnderflowed())
+    {
+        LOG_NET_ERROR("Received a truncated frame (message size: %i bytes)") << netBuffer.length;
     }
 
     if (!gotFrame)
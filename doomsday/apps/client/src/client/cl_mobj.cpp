@@ -48,6 +48,13 @@ using namespace world;
 #define UNFIXED8_8(x)   (((x) << 16) / 256)
 #define UNFIXED10_6(x)  (((x) << 16) / 64)
 
+/// Convert 16.16 fixed point to 8.8/10.6.
+#define FIXED8_8(x)     (((x) * 256) >> 16)
+#define FIXED10_6(x)    (((x) * 64) >> 16)
+
+/// If movement is faster than this, momentum is written with 10.6 bits.
+#define MOM_FAST_LIMIT  (127)
+
 #if 0
 ClMobjInfo::ClMobjInfo()
     : startMagic(CLM_MAGIC1)
@@ -329,19 +336,30 @@ static dd_bool ClMobj_IsStuckInsideLocalPlayer(mobj_t *mo)
     return false; // Not stuck.
 }
 
-void ClMobj_ReadDelta()
+/**
+ * Reads a map coordinate sent with three bytes (16.8 fixed-point).
+ */
+static coord_t readOriginCoord(PackedReader &reader)
+{
+    // The integer part comes first.
+    dint const integer  = reader.readInt16();
+    dint const fraction = reader.readByte();
+    return FIX2FLT((integer << FRACBITS) | (fraction << 8));
+}
+
+void ClMobj_ReadDelta(PackedReader &reader)
 {
     /// @todo Do not assume the CURRENT map.
     world::Map &map = App_World().map();
 
-    thid_t const id = Reader_ReadUInt16(msgReader); // Read the ID.
-    dint const df   = Reader_ReadUInt16(msgReader); // Flags.
+    thid_t const id = reader.readUInt16(); // Read the ID.
+    dint const df   = reader.readUInt16(); // Flags.
 
     // More flags?
     byte moreFlags = 0, fastMom = false;
     if (df & MDF_MORE_FLAGS)
     {
-        moreFlags = Reader_ReadByte(msgReader);
+        moreFlags = reader.readByte();
 
         // Fast momentum uses 10.6 fixed point instead of the normal 8.8.
         if (moreFlags & MDFE_FAST_MOM)
@@ -403,13 +421,13 @@ void ClMobj_ReadDelta()
     // Coordinates with three bytes.
     if (df & MDF_ORIGIN_X)
     {
-        d->origin[VX] = FIX2FLT((Reader_ReadInt16(msgReader) << FRACBITS) | (Reader_ReadByte(msgReader) << 8));
+        d->origin[VX] = readOriginCoord(reader);
         if (info)
             info->flags |= CLMF_KNOWN_X;
     }
     if (df & MDF_ORIGIN_Y)
     {
-        d->origin[VY] = FIX2FLT((Reader_ReadInt16(msgReader) << FRACBITS) | (Reader_ReadByte(msgReader) << 8));
+        d->origin[VY] = readOriginCoord(reader);
         if (info)
             info->flags |= CLMF_KNOWN_Y;
     }
@@ -417,7 +435,7 @@ void ClMobj_ReadDelta()
     {
         if (!(moreFlags & MDFE_Z_FLOOR))
         {
-            d->origin[VZ] = FIX2FLT((Reader_ReadInt16(msgReader) << FRACBITS) | (Reader_ReadByte(msgReader) << 8));
+            d->origin[VZ] = readOriginCoord(reader);
             if (info)
             {
                 info->flags |= CLMF_KNOWN_Z;
@@ -425,54 +443,54 @@ void ClMobj_ReadDelta()
                 // The mobj won't stick if an explicit coordinate is supplied.
                 info->flags &= ~(CLMF_STICK_FLOOR | CLMF_STICK_CEILING);
             }
-            d->floorZ = Reader_ReadFloat(msgReader);
+            d->floorZ = reader.readFloat();
         }
         else
         {
             onFloor = true;
 
             // Ignore these.
-            Reader_ReadInt16(msgReader);
-            Reader_ReadByte(msgReader);
-            Reader_ReadFloat(msgReader);
+            reader.readInt16();
+            reader.readByte();
+            reader.readFloat();
 
             info->flags |= CLMF_KNOWN_Z;
             //d->pos[VZ] = d->floorZ;
         }
 
-        d->ceilingZ = Reader_ReadFloat(msgReader);
+        d->ceilingZ = reader.readFloat();
     }
 
     // Momentum using 8.8 fixed point.
     if (df & MDF_MOM_X)
     {
-        short mom = Reader_ReadInt16(msgReader);
+        short mom = reader.readInt16();
         d->mom[MX] = FIX2FLT(fastMom? UNFIXED10_6(mom) : UNFIXED8_8(mom));
     }
     if (df & MDF_MOM_Y)
     {
-        short mom = Reader_ReadInt16(msgReader);
+        short mom = reader.readInt16();
         d->mom[MY] = FIX2FLT(fastMom ? UNFIXED10_6(mom) : UNFIXED8_8(mom));
     }
     if (df & MDF_MOM_Z)
     {
-        short mom = Reader_ReadInt16(msgReader);
+        short mom = reader.readInt16();
         d->mom[MZ] = FIX2FLT(fastMom ? UNFIXED10_6(mom) : UNFIXED8_8(mom));
     }
 
     // Angles with 16-bit accuracy.
     if (df & MDF_ANGLE)
-        d->angle = Reader_ReadInt16(msgReader) << 16;
+        d->angle = reader.readInt16() << 16;
 
     // MDF_SELSPEC is never used without MDF_SELECTOR.
     if (df & MDF_SELECTOR)
-        d->selector = Reader_ReadPackedUInt16(msgReader);
+        d->selector = reader.readPackedUInt16();
     if (df & MDF_SELSPEC)
-        d->selector |= Reader_ReadByte(msgReader) << 24;
+        d->selector |= reader.readByte() << 24;
 
     if (df & MDF_STATE)
     {
-        int stateIdx = Reader_ReadPackedUInt16(msgReader);
+        int stateIdx = reader.readPackedUInt16();
 
         // Translate.
         stateIdx = Cl_LocalMobjState(stateIdx);
@@ -490,34 +508,34 @@ void ClMobj_ReadDelta()
     {
         // Only the flags in the pack mask are affected.
         d->ddFlags &= ~DDMF_PACK_MASK;
-        d->ddFlags |= DDMF_REMOTE | (Reader_ReadUInt32(msgReader) & DDMF_PACK_MASK);
+        d->ddFlags |= DDMF_REMOTE | (reader.readUInt32() & DDMF_PACK_MASK);
 
-        d->flags  = Reader_ReadUInt32(msgReader);
-        d->flags2 = Reader_ReadUInt32(msgReader);
-        d->flags3 = Reader_ReadUInt32(msgReader);
+        d->flags  = reader.readUInt32();
+        d->flags2 = reader.readUInt32();
+        d->flags3 = reader.readUInt32();
     }
 
     if (df & MDF_HEALTH)
-        d->health = Reader_ReadInt32(msgReader);
+        d->health = reader.readInt32();
 
     if (df & MDF_RADIUS)
-        d->radius = Reader_ReadFloat(msgReader);
+        d->radius = reader.readFloat();
 
     if (df & MDF_HEIGHT)
-        d->height = Reader_ReadFloat(msgReader);
+        d->height = reader.readFloat();
 
     if (df & MDF_FLOORCLIP)
-        d->floorClip = Reader_ReadFloat(msgReader);
+        d->floorClip = reader.readFloat();
 
     if (moreFlags & MDFE_TRANSLUCENCY)
-        d->translucency = Reader_ReadByte(msgReader);
+        d->translucency = reader.readByte();
 
     if (moreFlags & MDFE_FADETARGET)
-        d->visTarget = ((short)Reader_ReadByte(msgReader)) - 1;
+        d->visTarget = ((short)reader.readByte()) - 1;
 
     if (moreFlags & MDFE_TYPE)
     {
-        d->type = Cl_LocalMobjType(Reader_ReadInt32(msgReader));
+        d->type = Cl_LocalMobjType(reader.readInt32());
         d->info = &runtimeDefs.mobjInfo[d->type];
     }
 
@@ -577,7 +595,81 @@ void ClMobj_ReadDelta()
     }
 }
 
-void ClMobj_ReadNullDelta()
+void ClMobj_WriteDelta(writer_s *writer, mobj_t const &mob)
+{
+    dint const serverState = (mob.state? Cl_ServerMobjState(runtimeDefs.states.indexOf(mob.state)) : -1);
+    dint const serverType  = Cl_ServerMobjType(mob.type);
+
+    dint df = MDF_EVERYTHING | MDF_MORE_FLAGS;
+    byte moreFlags = MDFE_TRANSLUCENCY | MDFE_FADETARGET;
+
+    if (std::fabs(mob.mom[MX]) >= MOM_FAST_LIMIT ||
+        std::fabs(mob.mom[MY]) >= MOM_FAST_LIMIT ||
+        std::fabs(mob.mom[MZ]) >= MOM_FAST_LIMIT)
+    {
+        moreFlags |= MDFE_FAST_MOM;
+    }
+    if (serverType >= 0)
+    {
+        moreFlags |= MDFE_TYPE;
+    }
+    if (serverState < 0)
+    {
+        df &= ~MDF_STATE;
+    }
+    if (mob.selector & ~DDMOBJ_SELECTOR_MASK)
+    {
+        df |= MDF_SELSPEC;
+    }
+
+    Writer_WriteUInt16(writer, mob.thinker.id);
+    Writer_WriteUInt16(writer, df & 0xffff);
+    Writer_WriteByte(writer, moreFlags);
+
+    // Coordinates with three bytes.
+    for (dint i = 0; i < 3; ++i)
+    {
+        fixed_t const pos = FLT2FIX(mob.origin[i]);
+        Writer_WriteInt16(writer, pos >> FRACBITS);
+        Writer_WriteByte(writer, pos >> 8);
+    }
+    Writer_WriteFloat(writer, mob.floorZ);
+    Writer_WriteFloat(writer, mob.ceilingZ);
+
+    for (dint i = 0; i < 3; ++i)
+    {
+        fixed_t const mom = FLT2FIX(mob.mom[i]);
+        Writer_WriteInt16(writer, moreFlags & MDFE_FAST_MOM? FIXED10_6(mom) : FIXED8_8(mom));
+    }
+
+    Writer_WriteInt16(writer, mob.angle >> 16);
+    Writer_WritePackedUInt16(writer, mob.selector);
+    if (df & MDF_SELSPEC)
+    {
+        Writer_WriteByte(writer, mob.selector >> 24);
+    }
+    if (df & MDF_STATE)
+    {
+        Writer_WritePackedUInt16(writer, serverState);
+    }
+
+    Writer_WriteUInt32(writer, mob.ddFlags & DDMF_PACK_MASK);
+    Writer_WriteUInt32(writer, mob.flags);
+    Writer_WriteUInt32(writer, mob.flags2);
+    Writer_WriteUInt32(writer, mob.flags3);
+    Writer_WriteInt32(writer, mob.health);
+    Writer_WriteFloat(writer, mob.radius);
+    Writer_WriteFloat(writer, mob.height);
+    Writer_WriteFloat(writer, mob.floorClip);
+    Writer_WriteByte(writer, mob.translucency);
+    Writer_WriteByte(writer, byte(mob.visTarget + 1));
+    if (moreFlags & MDFE_TYPE)
+    {
+        Writer_WriteInt32(writer, serverType);
+    }
+}
+
+void ClMobj_ReadNullDelta(PackedReader &reader)
 {
     LOG_AS("ClMobj_ReadNullDelta");
 
@@ -585,7 +677,7 @@ void ClMobj_ReadNullDelta()
     Map &map = App_World().map();
 
     // The delta only contains an ID.
-    thid_t id = Reader_ReadUInt16(msgReader);
+    thid_t id = reader.readUInt16();
     LOGDEV_NET_XVERBOSE("Null %i", id);
 
     mobj_t *mo = map.clMobjFor(id);
@@ -25,6 +25,7 @@
 
 #include "api_sound.h"
 
+#include "network/net_demo.h"
 #include "network/net_msg.h"
 
 #include "world/map.h"
@@ -35,7 +36,7 @@
 
 using namespace de;
 
-void Cl_ReadSoundDelta(deltatype_t type)
+void Cl_ReadSoundDelta(PackedReader &reader, deltatype_t type)
 {
     LOG_AS("Cl_ReadSoundDelta");
 
@@ -50,8 +51,8 @@ void Cl_ReadSoundDelta(deltatype_t type)
     LineSide *side = 0;
     mobj_t *emitter = 0;
 
-    duint16 const deltaId = Reader_ReadUInt16(::msgReader);
-    byte const flags      = Reader_ReadByte(::msgReader);
+    duint16 const deltaId = reader.readUInt16();
+    byte const flags      = reader.readByte();
 
     bool skip = false;
     if (type == DT_SOUND)
@@ -112,7 +113,7 @@ void Cl_ReadSoundDelta(deltatype_t type)
     if (type != DT_SOUND)
     {
         // The sound ID.
-        sound = Reader_ReadUInt16(::msgReader);
+        sound = reader.readUInt16();
     }
 
     if (type == DT_SECTOR_SOUND && !skip)
@@ -146,7 +147,7 @@ void Cl_ReadSoundDelta(deltatype_t type)
     dfloat volume = 1;
     if (flags & SNDDF_VOLUME)
     {
-        byte b = Reader_ReadByte(::msgReader);
+        byte b = reader.readByte();
 
         if (b == 255)
         {
@@ -165,7 +166,8 @@ void Cl_ReadSoundDelta(deltatype_t type)
     }
 
     // The delta has been read. Are we skipping?
-    if (skip) return;
+    // Sounds are not played while a demo is being fast-forwarded.
+    if (skip || Demo_IsSeeking()) return;
 
     // Now the entire delta has been read.
     // Should we start or stop a sound?
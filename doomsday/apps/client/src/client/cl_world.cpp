@@ -150,7 +150,27 @@ int Cl_LocalMobjState(int serverMobjState)
     return xlatMobjState[serverMobjState];
 }
 
-void Cl_ReadSectorDelta(dint /*deltaType*/)
+int Cl_ServerMobjType(int localMobjType)
+{
+    return xlatMobjType.indexOf(localMobjType);
+}
+
+int Cl_ServerMobjState(int localMobjState)
+{
+    return xlatMobjState.indexOf(localMobjState);
+}
+
+int Cl_ServerMaterial(world::Material *material)
+{
+    if (!serverMaterials || !material) return 0;
+
+    materialarchive_serialid_t const serialId = serverMaterials->findUniqueSerialId(material);
+    // A new serial id is returned for materials the server doesn't know about.
+    if (serverMaterials->find(serialId, 0) != material) return 0;
+    return serialId;
+}
+
+void Cl_ReadSectorDelta(PackedReader &reader, dint /*deltaType*/)
 {
     /// @todo Do not assume the CURRENT map.
     world::Map &map = App_World().map();
@@ -163,48 +183,48 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
     dfloat speed[2]  = { 0, 0 };
 
     // Sector index number.
-    Sector *sec = map.sectorPtr(Reader_ReadUInt16(msgReader));
+    Sector *sec = map.sectorPtr(reader.readUInt16());
     DENG2_ASSERT(sec);
 
     // Flags.
-    dint df = Reader_ReadPackedUInt32(msgReader);
+    dint df = reader.readPackedUInt32();
 
     if (df & SDF_FLOOR_MATERIAL)
     {
         P_SetPtrp(sec, DMU_FLOOR_OF_SECTOR | DMU_MATERIAL,
-                  Cl_LocalMaterial(Reader_ReadPackedUInt16(msgReader)));
+                  Cl_LocalMaterial(reader.readPackedUInt16()));
     }
     if (df & SDF_CEILING_MATERIAL)
     {
         P_SetPtrp(sec, DMU_CEILING_OF_SECTOR | DMU_MATERIAL,
-                  Cl_LocalMaterial(Reader_ReadPackedUInt16(msgReader)));
+                  Cl_LocalMaterial(reader.readPackedUInt16()));
     }
 
     if (df & SDF_LIGHT)
-        P_SetFloatp(sec, DMU_LIGHT_LEVEL, Reader_ReadByte(msgReader) / 255.0f);
+        P_SetFloatp(sec, DMU_LIGHT_LEVEL, reader.readByte() / 255.0f);
 
     if (df & SDF_FLOOR_HEIGHT)
-        height[PLN_FLOOR] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        height[PLN_FLOOR] = FIX2FLT(reader.readInt16() << 16);
     if (df & SDF_CEILING_HEIGHT)
-        height[PLN_CEILING] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        height[PLN_CEILING] = FIX2FLT(reader.readInt16() << 16);
     if (df & SDF_FLOOR_TARGET)
-        target[PLN_FLOOR] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        target[PLN_FLOOR] = FIX2FLT(reader.readInt16() << 16);
     if (df & SDF_FLOOR_SPEED)
-        speed[PLN_FLOOR] = FIX2FLT(Reader_ReadByte(msgReader) << (df & SDF_FLOOR_SPEED_44 ? 12 : 15));
+        speed[PLN_FLOOR] = FIX2FLT(reader.readByte() << (df & SDF_FLOOR_SPEED_44 ? 12 : 15));
     if (df & SDF_CEILING_TARGET)
-        target[PLN_CEILING] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        target[PLN_CEILING] = FIX2FLT(reader.readInt16() << 16);
     if (df & SDF_CEILING_SPEED)
-        speed[PLN_CEILING] = FIX2FLT(Reader_ReadByte(msgReader) << (df & SDF_CEILING_SPEED_44 ? 12 : 15));
+        speed[PLN_CEILING] = FIX2FLT(reader.readByte() << (df & SDF_CEILING_SPEED_44 ? 12 : 15));
 
     if (df & (SDF_COLOR_RED | SDF_COLOR_GREEN | SDF_COLOR_BLUE))
     {
         Vector3f newColor = sec->lightColor();
         if (df & SDF_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = reader.readByte() / 255.f;
         if (df & SDF_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = reader.readByte() / 255.f;
         if (df & SDF_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = reader.readByte() / 255.f;
         sec->setLightColor(newColor);
     }
 
@@ -212,11 +232,11 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
     {
         Vector3f newColor = sec->floor().surface().color();
         if (df & SDF_FLOOR_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = reader.readByte() / 255.f;
         if (df & SDF_FLOOR_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = reader.readByte() / 255.f;
         if (df & SDF_FLOOR_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = reader.readByte() / 255.f;
         sec->floor().surface().setColor(newColor);
     }
 
@@ -224,11 +244,11 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
     {
         Vector3f newColor = sec->ceiling().surface().color();
         if (df & SDF_CEIL_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = reader.readByte() / 255.f;
         if (df & SDF_CEIL_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = reader.readByte() / 255.f;
         if (df & SDF_CEIL_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = reader.readByte() / 255.f;
         sec->ceiling().surface().setColor(newColor);
     }
 
@@ -257,39 +277,39 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
 #undef PLN_FLOOR
 }
 
-void Cl_ReadSideDelta(dint /*deltaType*/)
+void Cl_ReadSideDelta(PackedReader &reader, dint /*deltaType*/)
 {
     /// @todo Do not assume the CURRENT map.
     world::Map &map = App_World().map();
 
-    dint const index = Reader_ReadUInt16(msgReader);
-    dint const df    = Reader_ReadPackedUInt32(msgReader); // Flags.
+    dint const index = reader.readUInt16();
+    dint const df    = reader.readPackedUInt32(); // Flags.
 
     LineSide *side = map.sidePtr(index);
     DENG2_ASSERT(side != 0);
 
     if (df & SIDF_TOP_MATERIAL)
     {
-        dint matIndex = Reader_ReadPackedUInt16(msgReader);
+        dint matIndex = reader.readPackedUInt16();
         side->top().setMaterial(Cl_LocalMaterial(matIndex));
     }
 
     if (df & SIDF_MID_MATERIAL)
     {
-        dint matIndex = Reader_ReadPackedUInt16(msgReader);
+        dint matIndex = reader.readPackedUInt16();
         side->middle().setMaterial(Cl_LocalMaterial(matIndex));
     }
 
     if (df & SIDF_BOTTOM_MATERIAL)
     {
-        dint matIndex = Reader_ReadPackedUInt16(msgReader);
+        dint matIndex = reader.readPackedUInt16();
         side->bottom().setMaterial(Cl_LocalMaterial(matIndex));
     }
 
     if (df & SIDF_LINE_FLAGS)
     {
         // The delta includes the entire lowest byte.
-        dint lineFlags = Reader_ReadByte(msgReader);
+        dint lineFlags = reader.readByte();
         Line &line = side->line();
         line.setFlags((line.flags() & ~0xff) | lineFlags, de::ReplaceFlags);
     }
@@ -298,11 +318,11 @@ void Cl_ReadSideDelta(dint /*deltaType*/)
     {
         Vector3f newColor = side->top().color();
         if (df & SIDF_TOP_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = reader.readByte() / 255.f;
         if (df & SIDF_TOP_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = reader.readByte() / 255.f;
         if (df & SIDF_TOP_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = reader.readByte() / 255.f;
         side->top().setColor(newColor);
     }
 
@@ -310,73 +330,73 @@ void Cl_ReadSideDelta(dint /*deltaType*/)
     {
         Vector3f newColor = side->middle().color();
         if (df & SIDF_MID_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = reader.readByte() / 255.f;
         if (df & SIDF_MID_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = reader.readByte() / 255.f;
         if (df & SIDF_MID_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = reader.readByte() / 255.f;
         side->middle().setColor(newColor);
     }
     if (df & SIDF_MID_COLOR_ALPHA)
     {
-        side->middle().setOpacity(Reader_ReadByte(msgReader) / 255.f);
+        side->middle().setOpacity(reader.readByte() / 255.f);
     }
 
     if (df & (SIDF_BOTTOM_COLOR_RED | SIDF_BOTTOM_COLOR_GREEN | SIDF_BOTTOM_COLOR_BLUE))
     {
         Vector3f newColor = side->bottom().color();
         if (df & SIDF_BOTTOM_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = reader.readByte() / 255.f;
         if (df & SIDF_BOTTOM_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = reader.readByte() / 255.f;
         if (df & SIDF_BOTTOM_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = reader.readByte() / 255.f;
         side->bottom().setColor(newColor);
     }
 
     if (df & SIDF_MID_BLENDMODE)
     {
-        side->middle().setBlendMode(blendmode_t(Reader_ReadInt32(msgReader)));
+        side->middle().setBlendMode(blendmode_t(reader.readInt32()));
     }
 
     if (df & SIDF_FLAGS)
     {
         // The delta includes the entire lowest byte.
-        dint sideFlags = Reader_ReadByte(msgReader);
+        dint sideFlags = reader.readByte();
         side->setFlags((side->flags() & ~0xff) | sideFlags, de::ReplaceFlags);
     }
 }
 
-void Cl_ReadPolyDelta()
+void Cl_ReadPolyDelta(PackedReader &reader)
 {
     /// @todo Do not assume the CURRENT map.
     world::Map &map = App_World().map();
-    Polyobj &pob    = map.polyobj(Reader_ReadPackedUInt16(msgReader));
+    Polyobj &pob    = map.polyobj(reader.readPackedUInt16());
 
-    dint const df = Reader_ReadByte(msgReader); // Flags.
+    dint const df = reader.readByte(); // Flags.
     if (df & PODF_DEST_X)
     {
-        pob.dest[VX] = Reader_ReadFloat(msgReader);
+        pob.dest[VX] = reader.readFloat();
     }
 
     if (df & PODF_DEST_Y)
     {
-        pob.dest[VY] = Reader_ReadFloat(msgReader);
+        pob.dest[VY] = reader.readFloat();
     }
 
     if (df & PODF_SPEED)
     {
-        pob.speed = Reader_ReadFloat(msgReader);
+        pob.speed = reader.readFloat();
     }
 
     if (df & PODF_DEST_ANGLE)
     {
-        pob.destAngle = ((angle_t)Reader_ReadInt16(msgReader)) << 16;
+        pob.destAngle = ((angle_t)reader.readInt16()) << 16;
     }
 
     if (df & PODF_ANGSPEED)
     {
-        pob.angleSpeed = ((angle_t)Reader_ReadInt16(msgReader)) << 16;
+        pob.angleSpeed = ((angle_t)reader.readInt16()) << 16;
     }
 
     if (df & PODF_PERPETUAL_ROTATE)
@@ -389,3 +409,154 @@ void Cl_ReadPolyDelta()
             /* move: */   CPP_BOOL(df & (PODF_DEST_X | PODF_DEST_Y | PODF_SPEED)),
             /* rotate: */ CPP_BOOL(df & (PODF_DEST_ANGLE | PODF_ANGSPEED | PODF_PERPETUAL_ROTATE)));
 }
+
+/// Converts a color component to the byte representation used in deltas.
+static inline byte colorByte(dfloat component)
+{
+    return byte(de::clamp(0, dint(component * 255), 255));
+}
+
+/// Plane speeds are sent as 4.4 fixed point when they fit, otherwise 1.7.
+static void writePlaneSpeed(writer_s *writer, ddouble speed, dint &df, dint flag44)
+{
+    fixed_t const fixedSpeed = FLT2FIX(dfloat(de::abs(speed)));
+    if ((fixedSpeed >> 12) <= 0xff)
+    {
+        df |= flag44;
+        Writer_WriteByte(writer, fixedSpeed >> 12);
+    }
+    else
+    {
+        Writer_WriteByte(writer, de::min(fixedSpeed >> 15, 0xff));
+    }
+}
+
+void Cl_WriteSectorDelta(writer_s *writer, Sector const &sector, bool moving)
+{
+    Plane const &floor   = sector.floor();
+    Plane const &ceiling = sector.ceiling();
+
+    dint const floorMat   = Cl_ServerMaterial(floor.surface().materialPtr());
+    dint const ceilingMat = Cl_ServerMaterial(ceiling.surface().materialPtr());
+
+    dint df = SDF_LIGHT | SDF_COLOR_RED | SDF_COLOR_GREEN | SDF_COLOR_BLUE
+            | SDF_FLOOR_COLOR_RED | SDF_FLOOR_COLOR_GREEN | SDF_FLOOR_COLOR_BLUE
+            | SDF_CEIL_COLOR_RED  | SDF_CEIL_COLOR_GREEN  | SDF_CEIL_COLOR_BLUE;
+    if (floorMat)   df |= SDF_FLOOR_MATERIAL;
+    if (ceilingMat) df |= SDF_CEILING_MATERIAL;
+    if (moving)
+    {
+        df = SDF_FLOOR_TARGET | SDF_FLOOR_SPEED | SDF_CEILING_TARGET | SDF_CEILING_SPEED;
+    }
+    else
+    {
+        df |= SDF_FLOOR_HEIGHT | SDF_CEILING_HEIGHT;
+    }
+
+    // The speed precision flags are only known after the speeds have been encoded,
+    // so the delta body is composed separately.
+    writer_s *body = Writer_NewWithDynamicBuffer(0);
+
+    if (df & SDF_FLOOR_MATERIAL)   Writer_WritePackedUInt16(body, floorMat);
+    if (df & SDF_CEILING_MATERIAL) Writer_WritePackedUInt16(body, ceilingMat);
+    if (df & SDF_LIGHT)            Writer_WriteByte(body, colorByte(sector.lightLevel()));
+
+    if (df & SDF_FLOOR_HEIGHT)   Writer_WriteInt16(body, FLT2FIX(dfloat(floor.height())) >> 16);
+    if (df & SDF_CEILING_HEIGHT) Writer_WriteInt16(body, FLT2FIX(dfloat(ceiling.height())) >> 16);
+    if (df & SDF_FLOOR_TARGET)   Writer_WriteInt16(body, FLT2FIX(dfloat(floor.heightTarget())) >> 16);
+    if (df & SDF_FLOOR_SPEED)    writePlaneSpeed(body, floor.speed(), df, SDF_FLOOR_SPEED_44);
+    if (df & SDF_CEILING_TARGET) Writer_WriteInt16(body, FLT2FIX(dfloat(ceiling.heightTarget())) >> 16);
+    if (df & SDF_CEILING_SPEED)  writePlaneSpeed(body, ceiling.speed(), df, SDF_CEILING_SPEED_44);
+
+    if (df & SDF_COLOR_RED)
+    {
+        Vector3f const &color = sector.lightColor();
+        Writer_WriteByte(body, colorByte(color.x));
+        Writer_WriteByte(body, colorByte(color.y));
+        Writer_WriteByte(body, colorByte(color.z));
+    }
+    if (df & SDF_FLOOR_COLOR_RED)
+    {
+        Vector3f const &color = floor.surface().color();
+        Writer_WriteByte(body, colorByte(color.x));
+        Writer_WriteByte(body, colorByte(color.y));
+        Writer_WriteByte(body, colorByte(color.z));
+    }
+    if (df & SDF_CEIL_COLOR_RED)
+    {
+        Vector3f const &color = ceiling.surface().color();
+        Writer_WriteByte(body, colorByte(color.x));
+        Writer_WriteByte(body, colorByte(color.y));
+        Writer_WriteByte(body, colorByte(color.z));
+    }
+
+    Writer_WriteUInt16(writer, sector.indexInMap());
+    Writer_WritePackedUInt32(writer, df);
+    Writer_Write(writer, Writer_Data(body), Writer_Size(body));
+    Writer_Delete(body);
+}
+
+void Cl_WriteSideDelta(writer_s *writer, LineSide const &side)
+{
+    dint const topMat    = Cl_ServerMaterial(side.top().materialPtr());
+    dint const middleMat = Cl_ServerMaterial(side.middle().materialPtr());
+    dint const bottomMat = Cl_ServerMaterial(side.bottom().materialPtr());
+
+    dint df = SIDF_LINE_FLAGS | SIDF_FLAGS | SIDF_MID_BLENDMODE | SIDF_MID_COLOR_ALPHA
+            | SIDF_TOP_COLOR_RED    | SIDF_TOP_COLOR_GREEN    | SIDF_TOP_COLOR_BLUE
+            | SIDF_MID_COLOR_RED    | SIDF_MID_COLOR_GREEN    | SIDF_MID_COLOR_BLUE
+            | SIDF_BOTTOM_COLOR_RED | SIDF_BOTTOM_COLOR_GREEN | SIDF_BOTTOM_COLOR_BLUE;
+    if (topMat)    df |= SIDF_TOP_MATERIAL;
+    if (middleMat) df |= SIDF_MID_MATERIAL;
+    if (bottomMat) df |= SIDF_BOTTOM_MATERIAL;
+
+    Writer_WriteUInt16(writer, world::Map::toSideIndex(side.line().indexInMap(), side.sideId()));
+    Writer_WritePackedUInt32(writer, df);
+
+    if (df & SIDF_TOP_MATERIAL)    Writer_WritePackedUInt16(writer, topMat);
+    if (df & SIDF_MID_MATERIAL)    Writer_WritePackedUInt16(writer, middleMat);
+    if (df & SIDF_BOTTOM_MATERIAL) Writer_WritePackedUInt16(writer, bottomMat);
+
+    Writer_WriteByte(writer, side.line().flags() & 0xff);
+
+    Surface const *surfaces[3] = { &side.top(), &side.middle(), &side.bottom() };
+    for (dint i = 0; i < 3; ++i)
+    {
+        Vector3f const &color = surfaces[i]->color();
+        Writer_WriteByte(writer, colorByte(color.x));
+        Writer_WriteByte(writer, colorByte(color.y));
+        Writer_WriteByte(writer, colorByte(color.z));
+        if (i == 1)
+        {
+            // The middle surface also has an opacity.
+            Writer_WriteByte(writer, colorByte(side.middle().opacity()));
+        }
+    }
+
+    Writer_WriteInt32(writer, side.middle().blendMode());
+    Writer_WriteByte(writer, side.flags() & 0xff);
+}
+
+void Cl_WritePolyDelta(writer_s *writer, Polyobj const &pob)
+{
+    dint df = PODF_DEST_X | PODF_DEST_Y | PODF_SPEED | PODF_ANGSPEED;
+    if (pob.destAngle == angle_t(-1))
+    {
+        df |= PODF_PERPETUAL_ROTATE;
+    }
+    else
+    {
+        df |= PODF_DEST_ANGLE;
+    }
+
+    Writer_WritePackedUInt16(writer, pob.indexInMap());
+    Writer_WriteByte(writer, df);
+    Writer_WriteFloat(writer, dfloat(pob.dest[VX]));
+    Writer_WriteFloat(writer, dfloat(pob.dest[VY]));
+    Writer_WriteFloat(writer, dfloat(pob.speed));
+    if (df & PODF_DEST_ANGLE)
+    {
+        Writer_WriteInt16(writer, pob.destAngle >> 16);
+    }
+    Writer_WriteInt16(writer, pob.angleSpeed >> 16);
+}
@@ -438,6 +438,18 @@ void Loop_RunTics()
     }
 }
 
+void Loop_RunFixedTics(dint count)
+{
+    ::ticLength = 1.0 / TICSPERSEC;
+
+    for (dint i = 0; i < count; ++i)
+    {
+        checkSharpTick(::ticLength);
+        baseTicker(::ticLength);
+        advanceTime(::ticLength);
+    }
+}
+
 void DD_RegisterLoop()
 {
     C_VAR_BYTE("input-sharp-lateprocessing", &::processSharpEventsAfterTickers, 0, 0, 1);
@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <de/concurrency.h>
+#include <de/BatchCompiler>
 #include <de/GLInfo>
 #include <de/GLBuffer>
 #include <de/GLState>
@@ -40,11 +41,18 @@ using namespace de;
 constexpr uint MAX_TEX_COORDS = 2;
 constexpr int  MAX_BATCH      = 16;
 
-static unsigned s_drawCallCount = 0;
-static unsigned s_primSwitchCount = 0;
-static unsigned s_minBatchLength = 0;
-static unsigned s_maxBatchLength = 0;
-static unsigned s_totalBatchCount = 0;
+/// Counters describing how DGL drawing was submitted to OpenGL during a frame.
+static struct
+{
+    duint drawCalls;        ///< Number of GL draw calls.
+    duint primSwitches;     ///< Flushes caused by an incompatible primitive.
+    duint batches;          ///< Batches drawn (each with its own uniform slot).
+    duint mergedBatches;    ///< Begin/End sections merged with the previous batch.
+    duint minBatchLength;
+    duint maxBatchLength;
+    duint vertices;         ///< Vertices uploaded.
+    duint indices;          ///< Indices drawn.
+} s_stats;
 
 struct DGLDrawState
 {
@@ -57,6 +65,35 @@ struct DGLDrawState
         float   batchIndex;
     };
 
+    /// Values of the batched uniforms and the bound textures of one batch.
+    struct BatchState
+    {
+        Matrix4f mvpMatrix;
+        Matrix4f texMatrix0;
+        Matrix4f texMatrix1;
+        int      texEnabled;
+        int      texMode;
+        Vector4f texModeColor;
+        float    alphaLimit;
+        int      texture0;
+        int      texture1;
+
+        bool operator == (BatchState const &other) const
+        {
+            return texture0     == other.texture0     &&
+                   texture1     == other.texture1     &&
+                   texEnabled   == other.texEnabled   &&
+                   texMode      == other.texMode      &&
+                   fequal(alphaLimit, other.alphaLimit) &&
+                   texModeColor == other.texModeColor &&
+                   !std::memcmp(mvpMatrix.values(),  other.mvpMatrix.values(),  sizeof(float) * 16) &&
+                   !std::memcmp(texMatrix0.values(), other.texMatrix0.values(), sizeof(float) * 16) &&
+                   !std::memcmp(texMatrix1.values(), other.texMatrix1.values(), sizeof(float) * 16);
+        }
+    };
+
+    typedef BatchCompiler<Vertex, BatchState> Compiler;
+
     // Indices for vertex attribute arrays.
     enum {
         VAA_VERTEX,
@@ -73,7 +110,6 @@ struct DGLDrawState
     int             primIndex     = 0;
     duint           batchMaxSize;
     duint           currentBatchIndex;
-    bool            resetPrimitive = false;
     Vertex          currentVertex  = {
         {0.f, 0.f, 0.f},
         {255, 255, 255, 255},
@@ -81,7 +117,7 @@ struct DGLDrawState
         {0.f, 0.f},
         0.f};
     Vertex          primVertices[4];
-    QVector<Vertex> vertices;
+    Compiler        batches;
 
     struct GLData
     {
@@ -95,8 +131,6 @@ struct DGLDrawState
         int      batchTexMode[MAX_BATCH];
         Vector4f batchTexModeColor[MAX_BATCH];
         float    batchAlphaLimit[MAX_BATCH];
-        int      batchTexture0[MAX_BATCH];
-        int      batchTexture1[MAX_BATCH];
 
         // Batched uniforms:
         GLUniform uMvpMatrix;
@@ -115,6 +149,7 @@ struct DGLDrawState
         {
             GLuint   vertexArray = 0;
             GLBuffer arrayData;
+            GLBuffer indexData;
 
             void release()
             {
@@ -122,6 +157,7 @@ struct DGLDrawState
                 LIBGUI_GL.glDeleteVertexArrays(1, &vertexArray);
 #endif
                 arrayData.clear();
+                indexData.clear();
             }
         };
 
@@ -148,54 +184,32 @@ struct DGLDrawState
         clearVertices();
     }
 
-    void checkPrimitiveReset()
-    {
-        if (resetPrimitive)
-        {
-            DENG2_ASSERT(!vertices.empty());
-            DENG2_ASSERT(glPrimitive(batchPrimType) == GL_TRIANGLE_STRIP);
-
-            // When committing multiple triangle strips, add a disconnection
-            // between batches.
-            vertices.push_back(vertices.back());
-            vertices.push_back(currentVertex);
-            resetPrimitive = false;
-        }
-    }
-
     void commitLine(Vertex start, Vertex end)
     {
         const Vector2f lineDir = (Vector2f(end.vertex) - Vector2f(start.vertex)).normalize();
         const Vector2f lineNormal{-lineDir.y, lineDir.x};
 
-        const bool disjoint = !vertices.empty();
-        if (disjoint)
-        {
-            vertices.push_back(vertices.back());
-        }
+        // Each line is a separate strip of two triangles.
+        batches.beginPrimitive(Compiler::TriangleStrip);
 
         // Start cap.
         {
             start.fragOffset[0] = -lineNormal.x;
             start.fragOffset[1] = -lineNormal.y;
-            vertices.push_back(start);
-            if (disjoint)
-            {
-                vertices.push_back(start);
-            }
+            batches.add(start);
             start.fragOffset[0] = lineNormal.x;
             start.fragOffset[1] = lineNormal.y;
-            vertices.push_back(start);
+            batches.add(start);
         }
 
         // End cap.
         {
             end.fragOffset[0] = -lineNormal.x;
             end.fragOffset[1] = -lineNormal.y;
-            vertices.push_back(end);
+            batches.add(end);
             end.fragOffset[0] = lineNormal.x;
             end.fragOffset[1] = lineNormal.y;
-            vertices.push_back(end);
+            batches.add(end);
         }
     }
 
@@ -206,29 +220,6 @@ struct DGLDrawState
 
         switch (primType)
         {
-            case DGL_QUADS:
-                primVertices[primIndex - 1] = currentVertex;
-                if (primIndex == 4)
-                {
-                    /* 4 vertices become 6:
-
-                       0--1     0--1   5
-                       |  |      \ |   |\
-                       |  |  =>   \|   | \
-                       3--2        2   4--3  */
-
-                    vertices.push_back(primVertices[0]);
-                    vertices.push_back(primVertices[1]);
-                    vertices.push_back(primVertices[2]);
-
-                    vertices.push_back(primVertices[0]);
-                    vertices.push_back(primVertices[2]);
-                    vertices.push_back(primVertices[3]);
-
-                    primIndex = 0;
-                }
-                break;
-
             case DGL_LINES:
                 primVertices[primIndex - 1] = currentVertex;
                 if (primIndex == 2)
@@ -253,28 +244,9 @@ struct DGLDrawState
                 primVertices[1] = currentVertex;
                 break;
 
-            case DGL_TRIANGLE_FAN:
-                if (primIndex == 1)
-                {
-                    if (!vertices.empty())
-                    {
-                        resetPrimitive = true;
-                    }
-                    checkPrimitiveReset();
-
-                    // Fan origin.
-                    primVertices[0] = currentVertex;
-                }
-                else if (primIndex > 2)
-                {
-                    vertices.push_back(primVertices[0]);
-                }
-                vertices.push_back(currentVertex);
-                break;
-
             default:
-                checkPrimitiveReset();
-                vertices.push_back(currentVertex);
+                // The compiler converts the primitive to indexed triangles.
+                batches.add(currentVertex);
                 break;
         }
     }
@@ -288,15 +260,14 @@ struct DGLDrawState
     void clearVertices()
     {
         // currentVertex is unaffected.
-        vertices.clear();
+        batches.clear();
         clearPrimitive();
         currentBatchIndex = 0;
-        resetPrimitive    = false;
     }
 
     inline int numVertices() const
     {
-        return vertices.size();
+        return batches.vertices().size();
     }
 
     static Vector4ub colorFromFloat(const Vector4f &color)
@@ -314,37 +285,35 @@ struct DGLDrawState
 
         DENG2_ASSERT(primType == DGL_NO_PRIMITIVE);
 
+        BatchState const state = currentBatchState();
+
         if (batchPrimType != DGL_NO_PRIMITIVE && !isCompatible(batchPrimType, primitive))
         {
-            ++s_primSwitchCount;
+            ++s_stats.primSwitches;
             flushBatches();
         }
-        else
+        else if (!batches.canBegin(state))
         {
-            if (currentBatchIndex == MAX_BATCH - 1)
-            {
-                flushBatches();
-            }
+            flushBatches();
         }
 
         // We enter a Begin/End section.
         batchPrimType = primType = primitive;
 
-        beginBatch();
+        beginBatch(state);
+
+        if (!isLinePrimitive(primitive))
+        {
+            batches.beginPrimitive(compilerPrimitive(primitive));
+        }
     }
 
     void endPrimitive()
     {
-        if (primType != DGL_NO_PRIMITIVE && !vertices.empty())
+        if (primType == DGL_LINE_LOOP && primIndex > 1)
         {
-            if (primType == DGL_LINE_LOOP)
-            {
-                // Close the loop.
-                commitLine(currentVertex, primVertices[0]);
-            }
-            resetPrimitive = true;
-            DENG2_ASSERT(!vertices.empty());
-            endBatch();
+            // Close the loop.
+            commitLine(currentVertex, primVertices[0]);
         }
         clearPrimitive();
     }
@@ -375,17 +344,47 @@ struct DGLDrawState
         return glPrimitive(p1) == glPrimitive(p2);
     }
 
-    void beginBatch()
+    static Compiler::Primitive compilerPrimitive(DGLenum primitive)
     {
-        const duint idx = currentBatchIndex;
+        switch (primitive)
+        {
+        case DGL_POINTS:            return Compiler::Points;
+        case DGL_TRIANGLE_FAN:      return Compiler::TriangleFan;
+        case DGL_TRIANGLE_STRIP:    return Compiler::TriangleStrip;
+        case DGL_QUADS:             return Compiler::Quads;
+        default:                    break;
+        }
+        return Compiler::Triangles;
+    }
+
+    BatchState currentBatchState()
+    {
+        auto &dynamicState = GLState::current();
+
+        BatchState state;
+        state.mvpMatrix  = DGL_Matrix(DGL_PROJECTION) * DGL_Matrix(DGL_MODELVIEW);
+        state.texMatrix0 = DGL_Matrix(DGL_TEXTURE0);
+        state.texMatrix1 = DGL_Matrix(DGL_TEXTURE1);
+        state.texEnabled =
+            (DGL_GetInteger(DGL_TEXTURE0) ? 0x1 : 0) | (DGL_GetInteger(DGL_TEXTURE1) ? 0x2 : 0);
+        state.texMode      = DGL_GetInteger(DGL_MODULATE_TEXTURE);
+        state.texModeColor = DGL_ModulationColor();
+        state.alphaLimit   = (dynamicState.alphaTest() ? dynamicState.alphaLimit() : -1.f);
+
+        // TODO: There is no need to use OpenGL to remember the bound textures.
+        // However, all DGL textures must be bound via DGL_Bind and not directly via OpenGL.
 
+        getBoundTextures(state.texture0, state.texture1);
+        return state;
+    }
+
+    void beginBatch(BatchState const &state)
+    {
         auto &dynamicState = GLState::current();
 
-        if (idx == 0)
+        if (batches.isEmpty())
         {
             gl->batchState = dynamicState;
-            zap(gl->batchTexture0);
-            zap(gl->batchTexture1);
         }
         else
         {
@@ -403,27 +402,12 @@ struct DGLDrawState
 #endif
         }
 
-        gl->batchMvpMatrix[idx]  = DGL_Matrix(DGL_PROJECTION) * DGL_Matrix(DGL_MODELVIEW);
-        gl->batchTexMatrix0[idx] = DGL_Matrix(DGL_TEXTURE0);
-        gl->batchTexMatrix1[idx] = DGL_Matrix(DGL_TEXTURE1);
-        gl->batchTexEnabled[idx] =
-            (DGL_GetInteger(DGL_TEXTURE0) ? 0x1 : 0) | (DGL_GetInteger(DGL_TEXTURE1) ? 0x2 : 0);
-        gl->batchTexMode[idx]      = DGL_GetInteger(DGL_MODULATE_TEXTURE);
-        gl->batchTexModeColor[idx] = DGL_ModulationColor();
-        gl->batchAlphaLimit[idx]   = (dynamicState.alphaTest() ? dynamicState.alphaLimit() : -1.f);
-
-        // TODO: There is no need to use OpenGL to remember the bound textures.
-        // However, all DGL textures must be bound via DGL_Bind and not directly via OpenGL.
-
-        getBoundTextures(gl->batchTexture0[idx], gl->batchTexture1[idx]);
-    }
-
-    void endBatch()
-    {
-        currentBatchIndex++;
-        if (currentBatchIndex == batchMaxSize)
+        // Consecutive sections with identical state share the same batch.
+        const int count = batches.batchCount();
+        currentBatchIndex = duint(batches.beginBatch(state));
+        if (batches.batchCount() == count)
         {
-            flushBatches();
+            ++s_stats.mergedBatches;
         }
     }
 
@@ -435,7 +419,7 @@ struct DGLDrawState
             DENG2_PRINT_BACKTRACE();
         }
 #endif
-        if (currentBatchIndex > 0)
+        if (!batches.indices().isEmpty())
         {
             drawBatches();
         }
@@ -449,6 +433,7 @@ struct DGLDrawState
         if (!gl)
         {
             batchMaxSize = DGL_BatchMaxSize();
+            batches.setMaxBatches(int(batchMaxSize));
 
             gl.reset(new GLData(batchMaxSize));
 
@@ -530,9 +515,13 @@ struct DGLDrawState
         const uint stride = sizeof(Vertex);
         auto &GL = LIBGUI_GL;
 
-        // Upload the vertex data.
+        // Upload the vertex and index data.
         GLData::DrawBuffer &buf = nextBuffer();
-        buf.arrayData.setData(&vertices[0], sizeof(Vertex) * vertices.size(), gl::Dynamic);
+        buf.arrayData.setData(batches.vertices().constData(),
+                              sizeof(Vertex) * batches.vertices().size(), gl::Dynamic);
+        // The primitive is only recorded; drawBatches() issues the draw itself.
+        buf.indexData.setIndices(gl::Triangles, dsize(batches.indices().size()),
+                                 batches.indices().constData(), gl::Dynamic);
 
 #if defined (DENG_HAVE_VAOS)
         GL.glBindVertexArray(buf.vertexArray);
@@ -557,6 +546,10 @@ struct DGLDrawState
         LIBGUI_ASSERT_GL_OK();
 
         GL.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // The element array binding is part of the vertex array object's state.
+        GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf.indexData.glIndexName());
+        LIBGUI_ASSERT_GL_OK();
     }
 
     void glUnbindArrays()
@@ -566,6 +559,7 @@ struct DGLDrawState
 #if defined (DENG_HAVE_VAOS)
         GL.glBindVertexArray(0);
 #else
+        GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         for (uint i = 0; i < NUM_VERTEX_ATTRIB_ARRAYS; ++i)
         {
             GL.glDisableVertexAttribArray(i);
@@ -579,24 +573,29 @@ struct DGLDrawState
         auto &GL = LIBGUI_GL;
         for (duint i = 0; i < count; ++i)
         {
+            BatchState const &state = batches.batchState(int(i));
             GL.glActiveTexture(GLenum(GL_TEXTURE0 + i));
-            GL.glBindTexture(GL_TEXTURE_2D, GLuint(gl->batchTexture0[i]));
+            GL.glBindTexture(GL_TEXTURE_2D, GLuint(state.texture0));
             GL.glActiveTexture(GLenum(GL_TEXTURE0 + batchMaxSize + i));
-            GL.glBindTexture(GL_TEXTURE_2D, GLuint(gl->batchTexture1[i]));
+            GL.glBindTexture(GL_TEXTURE_2D, GLuint(state.texture1));
         }
     }
 
+    /**
+     * Returns the OpenGL primitive used for drawing the indexed triangles or
+     * points of a DGL primitive.
+     */
     static GLenum glPrimitive(DGLenum primitive)
     {
         switch (primitive)
         {
         case DGL_POINTS:            return GL_POINTS;
-        case DGL_LINES:             return GL_TRIANGLE_STRIP;
-        case DGL_LINE_LOOP:         return GL_TRIANGLE_STRIP;
-        case DGL_LINE_STRIP:        return GL_TRIANGLE_STRIP;
+        case DGL_LINES:             return GL_TRIANGLES;
+        case DGL_LINE_LOOP:         return GL_TRIANGLES;
+        case DGL_LINE_STRIP:        return GL_TRIANGLES;
         case DGL_TRIANGLES:         return GL_TRIANGLES;
-        case DGL_TRIANGLE_FAN:      return GL_TRIANGLE_STRIP;
-        case DGL_TRIANGLE_STRIP:    return GL_TRIANGLE_STRIP;
+        case DGL_TRIANGLE_FAN:      return GL_TRIANGLES;
+        case DGL_TRIANGLE_STRIP:    return GL_TRIANGLES;
         case DGL_QUADS:             return GL_TRIANGLES;
 
         case DGL_NO_PRIMITIVE:      /*DENG2_ASSERT(!"No primitive type specified");*/ break;
@@ -609,11 +608,14 @@ struct DGLDrawState
      */
     void drawBatches()
     {
-        const auto batchLength = duint(currentBatchIndex);
+        const auto batchLength = duint(batches.batchCount());
+        const auto indexCount  = batches.indices().size();
 
-        s_minBatchLength = de::min(s_minBatchLength, batchLength);
-        s_maxBatchLength = de::max(s_maxBatchLength, batchLength);
-        s_totalBatchCount += batchLength;
+        s_stats.minBatchLength = de::min(s_stats.minBatchLength, batchLength);
+        s_stats.maxBatchLength = de::max(s_stats.maxBatchLength, batchLength);
+        s_stats.batches  += batchLength;
+        s_stats.vertices += duint(numVertices());
+        s_stats.indices  += duint(indexCount);
 
         int oldTex[2];
         getBoundTextures(oldTex[0], oldTex[1]);
@@ -621,6 +623,17 @@ struct DGLDrawState
         glBindBatchTextures(batchLength);
 
         // Batched uniforms.
+        for (duint i = 0; i < batchLength; ++i)
+        {
+            BatchState const &state = batches.batchState(int(i));
+            gl->batchMvpMatrix[i]    = state.mvpMatrix;
+            gl->batchTexMatrix0[i]   = state.texMatrix0;
+            gl->batchTexMatrix1[i]   = state.texMatrix1;
+            gl->batchTexEnabled[i]   = state.texEnabled;
+            gl->batchTexMode[i]      = state.texMode;
+            gl->batchTexModeColor[i] = state.texModeColor;
+            gl->batchAlphaLimit[i]   = state.alphaLimit;
+        }
         gl->uMvpMatrix.set(gl->batchMvpMatrix, batchLength);
         gl->uTexMatrix0.set(gl->batchTexMatrix0, batchLength);
         gl->uTexMatrix1.set(gl->batchTexMatrix1, batchLength);
@@ -651,7 +664,8 @@ struct DGLDrawState
         glBindArrays();
         gl->shader.beginUse();
         DENG2_ASSERT(gl->shader.validate());
-        GL.glDrawArrays(glPrimitive(batchPrimType), 0, numVertices()); ++s_drawCallCount;
+        GL.glDrawElements(glPrimitive(batchPrimType), GLsizei(indexCount), GL_UNSIGNED_INT, nullptr);
+        ++s_stats.drawCalls;
         gl->shader.endUse();
         LIBGUI_ASSERT_GL_OK();
         glUnbindArrays();
@@ -687,15 +701,13 @@ void DGL_Shutdown()
 
 void DGL_BeginFrame()
 {
-//    qDebug() << "draw calls:" << s_drawCallCount << "prim switch:" << s_primSwitchCount
-//             << "batch min/max/avg:" << s_minBatchLength << s_maxBatchLength
-//             << (s_drawCallCount ? float(s_totalBatchCount) / float(s_drawCallCount) : 0.f);
-
-    s_drawCallCount   = 0;
-    s_totalBatchCount = 0;
-    s_primSwitchCount = 0;
-    s_maxBatchLength  = 0;
-    s_minBatchLength  = std::numeric_limits<decltype(s_minBatchLength)>::max();
+//    qDebug() << "draw calls:" << s_stats.drawCalls << "prim switch:" << s_stats.primSwitches
+//             << "batch min/max/avg:" << s_stats.minBatchLength << s_stats.maxBatchLength
+//             << (s_stats.drawCalls ? float(s_stats.batches) / float(s_stats.drawCalls) : 0.f)
+//             << "merged:" << s_stats.mergedBatches << "vertices:" << s_stats.vertices;
+
+    zap(s_stats);
+    s_stats.minBatchLength = std::numeric_limits<decltype(s_stats.minBatchLength)>::max();
 
     if (dglDraw.gl)
     {
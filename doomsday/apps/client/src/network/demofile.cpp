@@ -0,0 +1,447 @@
+/** @file demofile.cpp  Seekable, indexed demo container.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de_base.h"
+#include "network/demofile.h"
+
+#include <de/LogBuffer>
+#include <de/Reader>
+#include <de/Writer>
+#include <algorithm>
+
+using namespace de;
+
+static duint32 const DEMO_MAGIC   = 0x6d654444; // "DDem"
+static duint32 const INDEX_MAGIC  = 0x496d4444; // "DDmI"
+static duint32 const DEMO_VERSION = 2;
+
+/// Pending packets are written out when they span this many tics...
+static duint32 const BATCH_TICS = 35;
+/// ...or when this many bytes have accumulated.
+static dsize const BATCH_SIZE = 256 * 1024;
+
+/// Default number of tics between keyframes (10 seconds).
+static duint32 const DEFAULT_KEYFRAME_INTERVAL = 35 * 10;
+
+enum ChunkType
+{
+    PacketChunk        = 1,
+    SegmentPacketChunk = 2, ///< Packets that begin a new segment.
+    KeyframeChunk      = 3,
+    IndexChunk         = 4,
+};
+
+static dsize const HEADER_SIZE       = 4 + 4 + 4; // magic, version, tic rate
+static dsize const CHUNK_HEADER_SIZE = 1 + 4 + 4; // type, tic, payload size
+static dsize const FOOTER_SIZE       = 8 + 4;     // index offset, magic
+
+static Block serializePackets(DemoFile::Packets const &packets)
+{
+    Block data;
+    de::Writer writer(data);
+    writer << duint32(packets.size());
+    for (auto const &packet : packets)
+    {
+        writer << packet.tic << packet.type << packet.data;
+    }
+    return data.compressed();
+}
+
+static DemoFile::Packets deserializePackets(Block const &payload)
+{
+    // Each packet has at least the tic, type and data size.
+    dsize const MIN_PACKET_SIZE = 4 + 1 + 4;
+
+    Block const data = payload.decompressed();
+    de::Reader reader(data);
+    duint32 count;
+    reader >> count;
+    if (count > (data.size() - reader.offset()) / MIN_PACKET_SIZE)
+    {
+        throw DemoFile::FormatError("deserializePackets",
+                                    String("Invalid packet count %1").arg(count));
+    }
+    DemoFile::Packets packets;
+    packets.reserve(count);
+    while (count-- > 0)
+    {
+        DemoFile::Packet packet;
+        reader >> packet.tic >> packet.type >> packet.data;
+        packets.append(packet);
+    }
+    return packets;
+}
+
+DENG2_PIMPL_NOREF(DemoFile::Writer)
+{
+    File *file;
+    duint32 keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+    dint64 lastKeyframeTic   = -1;
+    Packets pending;
+    dsize pendingSize    = 0;
+    bool beginsSegment   = true;
+    dsize segmentOffset  = HEADER_SIZE;
+    Keyframes index;
+
+    Impl(File &destination) : file(&destination)
+    {
+        Block header;
+        de::Writer writer(header);
+        writer << DEMO_MAGIC << DEMO_VERSION << duint32(TICSPERSEC);
+        *file << header;
+    }
+
+    ~Impl()
+    {
+        try
+        {
+            flushPending();
+            writeIndex();
+            file->flush();
+        }
+        catch (Error const &er)
+        {
+            LOG_NET_ERROR("Demo \"%s\" could not be completed: %s")
+                    << file->description() << er.asText();
+        }
+    }
+
+    void writeIndex()
+    {
+        // The index is placed at the end so that it can be found via the footer.
+        dsize const indexOffset = file->size();
+        Block payload;
+        de::Writer writer(payload);
+        writer << duint32(index.size());
+        for (Keyframe const &key : index)
+        {
+            writer << key.tic << duint64(key.offset) << duint64(key.segmentOffset);
+        }
+        writeChunk(IndexChunk, 0, payload);
+
+        Block footer;
+        de::Writer footerWriter(footer);
+        footerWriter << duint64(indexOffset) << INDEX_MAGIC;
+        *file << footer;
+    }
+
+    /// @return Offset of the written chunk.
+    dsize writeChunk(ChunkType type, duint32 tic, Block const &payload)
+    {
+        dsize const offset = file->size();
+        Block chunk;
+        de::Writer writer(chunk);
+        writer << dbyte(type) << tic << duint32(payload.size());
+        chunk += payload;
+        *file << chunk;
+        return offset;
+    }
+
+    void flushPending()
+    {
+        if (pending.isEmpty()) return;
+
+        dsize const offset = writeChunk(beginsSegment? SegmentPacketChunk : PacketChunk,
+                                        pending.first().tic, serializePackets(pending));
+        if (beginsSegment)
+        {
+            segmentOffset = offset;
+            beginsSegment = false;
+        }
+        pending.clear();
+        pendingSize = 0;
+    }
+};
+
+DemoFile::Writer::Writer(File &file) : d(new Impl(file))
+{}
+
+DemoFile::Writer::~Writer()
+{}
+
+void DemoFile::Writer::setKeyframeInterval(duint32 tics)
+{
+    d->keyframeInterval = tics;
+}
+
+bool DemoFile::Writer::isKeyframeDue(duint32 tic) const
+{
+    return d->lastKeyframeTic < 0 || dint64(tic) - d->lastKeyframeTic >= d->keyframeInterval;
+}
+
+void DemoFile::Writer::writePacket(Packet const &packet)
+{
+    if (!d->pending.isEmpty() &&
+        (packet.tic - d->pending.first().tic >= BATCH_TICS || d->pendingSize >= BATCH_SIZE))
+    {
+        d->flushPending();
+    }
+    d->pending.append(packet);
+    d->pendingSize += packet.data.size();
+}
+
+void DemoFile::Writer::beginSegment()
+{
+    d->flushPending();
+    d->beginsSegment   = true;
+    d->lastKeyframeTic = -1; // A new map should get a keyframe as soon as possible.
+}
+
+void DemoFile::Writer::writeKeyframe(duint32 tic, Packets const &packets)
+{
+    d->flushPending();
+
+    Keyframe key;
+    key.tic           = tic;
+    key.offset        = d->writeChunk(KeyframeChunk, tic, serializePackets(packets));
+    key.segmentOffset = d->segmentOffset;
+    d->index.append(key);
+
+    d->lastKeyframeTic = tic;
+}
+
+void DemoFile::Writer::flush()
+{
+    d->flushPending();
+    d->file->flush();
+}
+
+//---------------------------------------------------------------------------------------
+
+DENG2_PIMPL_NOREF(DemoFile::Reader)
+{
+    ByteArrayFile const *file;
+    dsize endOffset;         ///< Chunks end here (index or end of file).
+    Keyframes index;
+
+    dsize pos = HEADER_SIZE; ///< Next chunk to read.
+    dsize segment = 0;
+    Packets current;         ///< Decompressed packets of the current chunk.
+    dint currentIndex = 0;
+
+    struct ChunkHeader
+    {
+        dbyte type;
+        duint32 tic;
+        duint32 size;
+    };
+
+    Impl(ByteArrayFile const &source) : file(&source), endOffset(source.size())
+    {
+        if (file->size() < HEADER_SIZE)
+        {
+            throw FormatError("DemoFile::Reader", file->description() + " is too short");
+        }
+
+        duint32 magic, version, ticRate;
+        de::Reader reader(bytes());
+        reader >> magic >> version >> ticRate;
+        if (magic != DEMO_MAGIC || version != DEMO_VERSION)
+        {
+            throw FormatError("DemoFile::Reader", file->description() + " is not a demo");
+        }
+        if (ticRate != TICSPERSEC)
+        {
+            throw FormatError("DemoFile::Reader", file->description() +
+                              String(" was recorded at %1 tics per second").arg(ticRate));
+        }
+
+        if (!readIndex())
+        {
+            // The recording was not finished properly. The keyframes can still
+            // be located by walking through the chunk headers.
+            rebuildIndex();
+        }
+    }
+
+    /// The file is also an input stream; it is read here via random access.
+    IByteArray const &bytes() const
+    {
+        return *file;
+    }
+
+    ChunkHeader readChunkHeader(dsize offset) const
+    {
+        ChunkHeader header;
+        de::Reader reader(bytes(), littleEndianByteOrder, offset);
+        reader >> header.type >> header.tic >> header.size;
+        return header;
+    }
+
+    Block readChunkPayload(dsize offset, ChunkHeader const &header) const
+    {
+        Block payload;
+        de::Reader reader(bytes(), littleEndianByteOrder, offset + CHUNK_HEADER_SIZE);
+        reader.readBytes(header.size, payload);
+        return payload;
+    }
+
+    bool readIndex()
+    {
+        if (file->size() < HEADER_SIZE + FOOTER_SIZE) return false;
+
+        duint64 indexOffset;
+        duint32 magic;
+        de::Reader footer(bytes(), littleEndianByteOrder, file->size() - FOOTER_SIZE);
+        footer >> indexOffset >> magic;
+        if (magic != INDEX_MAGIC || indexOffset < HEADER_SIZE ||
+            indexOffset + CHUNK_HEADER_SIZE > file->size() - FOOTER_SIZE)
+        {
+            return false;
+        }
+
+        ChunkHeader const header = readChunkHeader(indexOffset);
+        if (header.type != IndexChunk) return false;
+
+        de::Reader reader(bytes(), littleEndianByteOrder, indexOffset + CHUNK_HEADER_SIZE);
+        duint32 count;
+        reader >> count;
+        index.reserve(count);
+        while (count-- > 0)
+        {
+            Keyframe key;
+            duint64 offset, segmentOffset;
+            reader >> key.tic >> offset >> segmentOffset;
+            key.offset        = offset;
+            key.segmentOffset = segmentOffset;
+            index.append(key);
+        }
+        endOffset = indexOffset;
+        return true;
+    }
+
+    void rebuildIndex()
+    {
+        dsize offset = HEADER_SIZE;
+        dsize segmentOffset = HEADER_SIZE;
+        while (offset + CHUNK_HEADER_SIZE <= file->size())
+        {
+            ChunkHeader const header = readChunkHeader(offset);
+            dsize const next = offset + CHUNK_HEADER_SIZE + header.size;
+            if (next > file->size()) break; // Truncated.
+
+            if (header.type == SegmentPacketChunk)
+            {
+                segmentOffset = offset;
+            }
+            else if (header.type == KeyframeChunk)
+            {
+                Keyframe key;
+                key.tic           = header.tic;
+                key.offset        = offset;
+                key.segmentOffset = segmentOffset;
+                index.append(key);
+            }
+            offset = next;
+        }
+        endOffset = offset;
+    }
+
+    /**
+     * Reads and decompresses the next packet chunk.
+     * @return @c false, if there are no more packets.
+     */
+    bool readNextChunk()
+    {
+        while (pos + CHUNK_HEADER_SIZE <= endOffset)
+        {
+            ChunkHeader const header = readChunkHeader(pos);
+            dsize const offset = pos;
+            pos += CHUNK_HEADER_SIZE + header.size;
+
+            if (header.type == PacketChunk || header.type == SegmentPacketChunk)
+            {
+                if (header.type == SegmentPacketChunk) segment = offset;
+                current      = deserializePackets(readChunkPayload(offset, header));
+                currentIndex = 0;
+                if (!current.isEmpty()) return true;
+            }
+            else if (header.type == IndexChunk)
+            {
+                break;
+            }
+            // Keyframes are only used when seeking.
+        }
+        current.clear();
+        currentIndex = 0;
+        return false;
+    }
+};
+
+DemoFile::Reader::Reader(ByteArrayFile const &file) : d(new Impl(file))
+{}
+
+DemoFile::Keyframes const &DemoFile::Reader::keyframes() const
+{
+    return d->index;
+}
+
+DemoFile::Keyframe const *DemoFile::Reader::keyframeAt(duint32 tic) const
+{
+    // Keyframes are in ascending tic order.
+    auto found = std::upper_bound(d->index.constBegin(), d->index.constEnd(), tic,
+                                  [] (duint32 tic, Keyframe const &key) {
+        return tic < key.tic;
+    });
+    if (found == d->index.constBegin()) return nullptr;
+    return &*(found - 1);
+}
+
+DemoFile::Packets DemoFile::Reader::keyframePackets(Keyframe const &keyframe) const
+{
+    Impl::ChunkHeader const header = d->readChunkHeader(keyframe.offset);
+    if (header.type != KeyframeChunk)
+    {
+        throw FormatError("DemoFile::Reader::keyframePackets",
+                          String("No keyframe at offset %1").arg(keyframe.offset));
+    }
+    return deserializePackets(d->readChunkPayload(keyframe.offset, header));
+}
+
+void DemoFile::Reader::seek(dsize offset)
+{
+    d->pos = de::max(offset, HEADER_SIZE);
+    d->current.clear();
+    d->currentIndex = 0;
+}
+
+void DemoFile::Reader::seekPast(Keyframe const &keyframe)
+{
+    seek(keyframe.offset + CHUNK_HEADER_SIZE + d->readChunkHeader(keyframe.offset).size);
+    d->segment = keyframe.segmentOffset;
+}
+
+DemoFile::Packet const *DemoFile::Reader::peek()
+{
+    if (d->currentIndex >= d->current.size())
+    {
+        if (!d->readNextChunk()) return nullptr;
+    }
+    return &d->current.at(d->currentIndex);
+}
+
+DemoFile::Packet DemoFile::Reader::take()
+{
+    DENG2_ASSERT(peek() != nullptr);
+    return d->current.at(d->currentIndex++);
+}
+
+dsize DemoFile::Reader::currentSegment() const
+{
+    return d->segment;
+}
@@ -22,23 +22,36 @@
 #include "de_base.h"
 #include "network/net_demo.h"
 
+#include <de/App>
+#include <de/FileSystem>
 #include <doomsday/doomsdayapp.h>
 #include <doomsday/console/cmd.h>
 #include <doomsday/filesys/fs_util.h>
 
+#include "client/cl_def.h"
+#include "client/cl_frame.h"
+#include "client/cl_mobj.h"
 #include "client/cl_player.h"
+#include "client/cl_world.h"
 
 #include "api_filesys.h"
 #include "api_player.h"
 
+#include "network/demofile.h"
 #include "network/net_main.h"
 #include "network/net_buf.h"
 
 #include "render/rend_main.h"
 #include "render/viewports.h"
 
+#include "sys_system.h"
+
+#include "world/map.h"
 #include "world/p_object.h"
 #include "world/p_players.h"
+#include "Polyobj"
+
+#include <memory>
 
 using namespace de;
 
@@ -49,20 +62,14 @@ using namespace de;
 #define LCAMF_FOV           0x2  ///< FOV has changed (short).
 #define LCAMF_CAMERA        0x4  ///< Camera mode.
 
-#pragma pack(1)
-struct demopacket_header_t
-{
-    dushort length;
-};
-#pragma pack()
+/// Keyframe frames are split into packets of roughly this size.
+#define KEYFRAME_PACKET_SIZE    (64 * 1024)
 
 extern dfloat netConnectTime;
+extern dd_bool gotFirstFrame;
 
 static char const *demoPath = "/home/demo/";
 
-#if 0
-LZFILE *playdemo;
-#endif
 dint playback;
 dint viewangleDelta;
 dfloat lookdirDelta;
@@ -74,8 +81,46 @@ static DemoTimer readInfo;
 static dfloat startFOV;
 static dint demoStartTic;
 
+/**
+ * Demo being recorded for a player.
+ */
+struct DemoRecording
+{
+    std::unique_ptr<DemoFile::Writer> writer;
+    DemoFile::Packets tables;        ///< Latest translation tables sent by the server.
+    DemoFile::Packet camera;         ///< Latest local camera packet (type zero if none).
+};
+static DemoRecording recordings[DDMAXPLAYERS];
+
+static std::unique_ptr<DemoFile::Reader> demoReader;
+
+/**
+ * State of an ongoing seek during playback.
+ */
+struct DemoSeek
+{
+    dint64 targetTic = -1;           ///< Packets are read without delay until here.
+    bool awaitingMap = false;        ///< Map setup packets are being replayed.
+    bool handshakeRead = false;
+    bool hasKeyframe = false;
+    DemoFile::Keyframe keyframe;     ///< Restored after the map has been set up.
+    DemoFile::Packets queue;         ///< Keyframe packets waiting to be read.
+    bool sweepPending = false;       ///< Remove mobjs not present in the keyframe.
+};
+static DemoSeek seek;
+
 void Demo_WriteLocalCamera(dint plrNum);
 
+/**
+ * Composes a demo file path. Relative names are placed in the demo folder.
+ */
+static String demoFilePath(char const *fileName)
+{
+    String const name = NativePath(fileName).withSeparators('/');
+    if (name.startsWith("/")) return name;
+    return String(demoPath) / name;
+}
+
 void Demo_Init()
 {
     // Make sure the demo path is there.
@@ -86,60 +131,46 @@ void Demo_Init()
  * Open a demo file and begin recording.
  * Returns @c false if the recording can't be begun.
  */
-dd_bool Demo_BeginRecording(char const * /*fileName*/, dint /*plrNum*/)
+dd_bool Demo_BeginRecording(char const *fileName, dint plrNum)
 {
-    return false;
-
-#if 0
-    client_t *cl  = &::clients[plrNum];
-    player_t *plr = &DD_Player(plrNum);
+    DENG2_ASSERT(plrNum >= 0 && plrNum < DDMAXPLAYERS);
+    auto &cl = *DD_Player(plrNum);
 
     // Is a demo already being recorded for this client?
-    if(cl->recording || ::playback || (::isDedicated && !plrNum) || !plr->shared.inGame)
+    // Only the packets received from a server can be recorded.
+    if (cl.recording || ::playback || !::isClient || plrNum != ::consolePlayer ||
+        !cl.publicData().inGame)
         return false;
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Appendf(Str_InitStd(&buf), "%s%s", ::demoPath, fileName);
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
-
-    // Open the demo file.
-    cl->demo = lzOpen(Str_Text(&buf), "wp");
-    Str_Free(&buf);
-    if(!cl->demo)
+    String const path = demoFilePath(fileName);
+    try
+    {
+        FS::get().makeFolder(path.fileNamePath());
+        recordings[plrNum].writer.reset(new DemoFile::Writer(App::rootFolder().replaceFile(path)));
+    }
+    catch (Error const &er)
     {
-        return false;  // Couldn't open it!
+        LOG_NET_ERROR("Failed to begin recording \"%s\": %s") << path << er.asText();
+        return false;
     }
+    recordings[plrNum].tables.clear();
+    recordings[plrNum].camera = DemoFile::Packet();
 
-    cl->recording    = true;
-    cl->recordPaused = false;
+    cl.recording    = true;
+    cl.recordPaused = false;
 
-    ::writeInfo[plrNum].first       = true;
-    ::writeInfo[plrNum].canwrite    = false;
-    ::writeInfo[plrNum].cameratimer = 0;
-    ::writeInfo[plrNum].fov         = -1;  // Must be written in the first packet.
+    DemoTimer &inf = cl.demoTimer();
+    inf.first       = true;
+    inf.canwrite    = false;
+    inf.cameratimer = 0;
+    inf.fov         = -1;  // Must be written in the first packet.
 
-    if(::isServer)
-    {
-        // Playing demos alters gametic. This'll make sure we're going to get updates.
-        ::clients[0].lastTransmit = -1;
-        // Servers need to send a handshake packet.
-        // It only needs to recorded in the demo file, though.
-        ::allowSending = false;
-        Sv_Handshake(plrNum, false);
-        // Enable sending to network.
-        ::allowSending = true;
-    }
-    else
-    {
-        // Clients need a Handshake packet.
-        // Request a new one from the server.
-        Cl_SendHello();
-    }
+    // Clients need a Handshake packet.
+    // Request a new one from the server.
+    Cl_SendHello();
 
     // The operation is a success.
     return true;
-#endif
 }
 
 void Demo_PauseRecording(dint playerNum)
@@ -187,15 +218,118 @@ void Demo_StopRecording(dint playerNum)
     // A demo is not being recorded?
     if(!cl.recording) return;
 
-    // Close demo file.
-    //lzClose(cl.demo); cl.demo = nullptr;
+    // Close demo file. The index of keyframes is written at the end.
+    recordings[playerNum].writer.reset();
+    recordings[playerNum].tables.clear();
     cl.recording = false;
 }
 
+/**
+ * Determines whether the client's world is in a state that can be described with
+ * a keyframe.
+ */
+static bool canWriteKeyframe()
+{
+    return Cl_GameReady() && ::gotFirstFrame && App_World().hasMap();
+}
+
+/**
+ * Describes the current state of the client's world as a set of frame packets.
+ * The frames contain the same information the server tracks in its world register:
+ * all sectors, sides and polyobjs, and all client mobjs.
+ */
+static DemoFile::Packets composeWorldFrames(duint32 tic)
+{
+    world::Map &map = App_World().map();
+
+    DemoFile::Packets frames;
+    writer_s *writer = nullptr;
+
+    auto endFrame = [&] ()
+    {
+        DemoFile::Packet frame;
+        frame.tic  = tic;
+        frame.type = (frames.isEmpty()? PSV_FIRST_FRAME2 : PSV_FRAME2);
+        frame.data = Block(Writer_Data(writer), Writer_Size(writer));
+        frames.append(frame);
+        Writer_Delete(writer);
+        writer = nullptr;
+    };
+    auto beginDelta = [&] (deltatype_t type) -> writer_s *
+    {
+        if (writer && Writer_Size(writer) >= KEYFRAME_PACKET_SIZE)
+        {
+            endFrame();
+        }
+        if (!writer)
+        {
+            writer = Writer_NewWithDynamicBuffer(NETBUFFER_MAXSIZE);
+            Writer_WriteFloat(writer, Cl_FrameGameTime());
+        }
+        Writer_WriteByte(writer, type);
+        return writer;
+    };
+
+    map.forAllSectors([&] (Sector &sector)
+    {
+        Cl_WriteSectorDelta(beginDelta(DT_SECTOR), sector);
+        if (!de::fequal(sector.floor().speed(), 0.0) || !de::fequal(sector.ceiling().speed(), 0.0))
+        {
+            // Keep the planes moving.
+            Cl_WriteSectorDelta(beginDelta(DT_SECTOR), sector, true /*movers*/);
+        }
+        return LoopContinue;
+    });
+
+    for (dint i = 0; i < map.sideCount(); ++i)
+    {
+        LineSide const &side = *map.sidePtr(i);
+        if (!side.hasSections()) continue;
+        Cl_WriteSideDelta(beginDelta(DT_SIDE), side);
+    }
+
+    map.forAllPolyobjs([&] (Polyobj &pob)
+    {
+        // Polyobjs the server has never moved have no destination.
+        if (pob.dest[VX] || pob.dest[VY] || pob.destAngle || pob.speed || pob.angleSpeed)
+        {
+            Cl_WritePolyDelta(beginDelta(DT_POLY), pob);
+        }
+        return LoopContinue;
+    });
+
+    for (mobj_t *mob : map.clMobjHash())
+    {
+        ClientMobjThinkerData::RemoteSync const *info = ClMobj_GetInfo(mob);
+        if (info->flags & (CLMF_HIDDEN | CLMF_NULLED)) continue;
+        ClMobj_WriteDelta(beginDelta(DT_CREATE_MOBJ), *mob);
+    }
+
+    if (writer) endFrame();
+    return frames;
+}
+
+static void writeKeyframe(DemoRecording &rec, duint32 tic)
+{
+    DemoFile::Packets packets;
+    for (DemoFile::Packet packet : rec.tables)
+    {
+        packet.tic = tic;
+        packets.append(packet);
+    }
+    packets.append(composeWorldFrames(tic));
+    if (rec.camera.type)
+    {
+        DemoFile::Packet camera = rec.camera;
+        camera.tic  = tic;
+        camera.type = PKT_DEMOCAM_RESUME; // Moves the camera immediately.
+        packets.append(camera);
+    }
+    rec.writer->writeKeyframe(tic, packets);
+}
+
 void Demo_WritePacket(dint playerNum)
 {
-    DENG_UNUSED(playerNum);
-#if 0
     if(playerNum < 0)
     {
         Demo_BroadcastPacket();
@@ -227,37 +361,61 @@ void Demo_WritePacket(dint playerNum)
             return;
     }
 
-    // This counts as an update. (We know the client is alive.)
-    //::clients[playerNum].updateCount = UPDATECOUNT;
+    DemoRecording &rec = recordings[playerNum];
+    DENG2_ASSERT(rec.writer);
 
-    LZFILE *file = cl.demo;
-    if(!file) App_Error("Demo_WritePacket: No demo file!\n");
-
-    byte ptime;
+    DemoFile::Packet packet;
     if(!inf.first)
     {
-        ptime = (cl.recordPaused ? inf.pausetime : DEMOTIC)
-              - inf.begintime;
+        packet.tic = (cl.recordPaused ? inf.pausetime : DEMOTIC) - inf.begintime;
     }
     else
     {
-        ptime = 0;
+        packet.tic    = 0;
         inf.first     = false;
         inf.begintime = DEMOTIC;
     }
-    lzWrite(&ptime, 1, file);
+    packet.type = ::netBuffer.msg.type;
+    packet.data = Block(::netBuffer.msg.data, ::netBuffer.length);
+
+    switch(packet.type)
+    {
+    case PSV_HANDSHAKE:
+        // A new map begins a new segment of the demo.
+        rec.writer->beginSegment();
+        rec.tables.clear();
+        rec.camera = DemoFile::Packet();
+        break;
+
+    case PSV_MATERIAL_ARCHIVE:
+    case PSV_MOBJ_TYPE_ID_LIST:
+    case PSV_MOBJ_STATE_ID_LIST:
+        // Keyframes need the translation tables.
+        for(dint i = 0; i < rec.tables.size(); ++i)
+        {
+            if(rec.tables.at(i).type == packet.type)
+            {
+                rec.tables.removeAt(i--);
+            }
+        }
+        rec.tables.append(packet);
+        break;
 
-    demopacket_header_t hdr;  // The header.
-    if(::netBuffer.length >= sizeof(hdr.length))
-        App_Error("Demo_WritePacket: Write buffer too large!\n");
+    case PKT_DEMOCAM:
+    case PKT_DEMOCAM_RESUME:
+        rec.camera = packet;
+        break;
 
-    hdr.length = (dushort) 1 + ::netBuffer.length;
-    lzWrite(&hdr, sizeof(hdr), file);
+    default:
+        // The keyframe describes the world as it was before this packet.
+        if(rec.writer->isKeyframeDue(packet.tic) && canWriteKeyframe())
+        {
+            writeKeyframe(rec, packet.tic);
+        }
+        break;
+    }
 
-    // Write the packet itself.
-    lzPutC(::netBuffer.msg.type, file);
-    lzWrite(::netBuffer.msg.data, (long) netBuffer.length, file);
-#endif
+    rec.writer->writePacket(packet);
 }
 
 void Demo_BroadcastPacket()
@@ -283,25 +441,19 @@ dd_bool Demo_BeginPlayback(char const *fileName)
             return false;
     }
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Set(Str_InitStd(&buf), fileName);
-    if(!F_IsAbsolute(&buf))
+    // Open the demo file.
+    String const path = demoFilePath(fileName);
+    try
     {
-        Str_Prepend(&buf, demoPath);
+        demoReader.reset(new DemoFile::Reader(App::rootFolder().locate<ByteArrayFile const>(path)));
     }
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
-
-    // Open the demo file.
-#if 0
-    playdemo = lzOpen(Str_Text(&buf), "rp");
-#endif
-    Str_Free(&buf);
-
-#if 0
-    if(!playdemo)
-#endif
+    catch(Error const &er)
+    {
+        LOG_NET_ERROR("Cannot play demo \"%s\": %s") << path << er.asText();
         return false;
+    }
+
+    LOG_NET_VERBOSE("Demo \"%s\" has %i keyframes") << path << demoReader->keyframes().size();
 
     // OK, let's begin the demo.
     ::playback       = true;
@@ -315,6 +467,7 @@ dd_bool Demo_BeginPlayback(char const *fileName)
     ::startFOV       = 95; //Rend_FieldOfView();
     ::demoStartTic   = DEMOTIC;
     std::memset(::posDelta, 0, sizeof(::posDelta));
+    ::seek           = DemoSeek();
 
     // Start counting frames from here.
     /*if(ArgCheck("-timedemo"))
@@ -329,13 +482,13 @@ void Demo_StopPlayback()
 {
     if(!::playback) return;
 
-#if 0
     LOG_MSG("Demo was %.2f seconds (%i tics) long.")
         << ((DEMOTIC - ::demoStartTic) / dfloat( TICSPERSEC ))
         << (DEMOTIC - ::demoStartTic);
 
     ::playback = false;
-    lzClose(::playdemo); playdemo = nullptr;
+    demoReader.reset();
+    ::seek = DemoSeek();
     //::fieldOfView = ::startFOV;
     Net_StopGame();
 
@@ -353,54 +506,196 @@ void Demo_StopPlayback()
     // "Play demo once" mode?
     if(CommandLine_Check("-playdemo"))
         Sys_Quit();
-#endif
 }
 
-dd_bool Demo_ReadPacket()
+dd_bool Demo_IsSeeking()
 {
-    return false;
-#if 0
-    static byte ptime;
-    dint nowtime = DEMOTIC;
+    return ::playback && ::seek.targetTic >= 0;
+}
 
-    if(!playback)
-        return false;
+/**
+ * Prepares the client mobjs for a keyframe. Everything the keyframe does not
+ * mention is removed afterwards (see sweepClientMobjs()).
+ */
+static void prepareClientMobjs()
+{
+    for(mobj_t *mob : App_World().map().clMobjHash())
+    {
+        if(mob->dPlayer) continue;
+
+        ClientMobjThinkerData::RemoteSync *info = ClMobj_GetInfo(mob);
+        info->flags &= ~CLMF_NULLED; // Can be updated by the keyframe.
+        info->time = 0;
+    }
+}
 
-    if(lzEOF(::playdemo))
+static void sweepClientMobjs()
+{
+    // Destroying removes mobjs from the hash.
+    QList<mobj_t *> const mobs = App_World().map().clMobjHash().values();
+    for(mobj_t *mob : mobs)
     {
-        Demo_StopPlayback();
-        // Any interested parties?
-        DoomsdayApp::plugins().callAllHooks(HOOK_DEMO_STOP);
+        if(mob->dPlayer || mob->thinker.function == (thinkfunc_t) -1) continue;
+
+        if(!ClMobj_GetInfo(mob)->time)
+        {
+            Mobj_Destroy(mob);
+        }
+    }
+}
+
+static void restoreKeyframe(DemoFile::Keyframe const &keyframe)
+{
+    LOGDEV_NET_VERBOSE("Restoring demo keyframe at tic %i") << keyframe.tic;
+
+    prepareClientMobjs();
+    ::seek.queue        = demoReader->keyframePackets(keyframe);
+    ::seek.sweepPending = true;
+    ::seek.awaitingMap  = false;
+    demoReader->seekPast(keyframe);
+}
+
+dd_bool Demo_Seek(dint tic)
+{
+    if(!::playback || !demoReader) return false;
+
+    tic = de::max(tic, 0);
+    LOG_MSG("Seeking to %.2f seconds in the demo") << (tic / dfloat( TICSPERSEC ));
+
+    ::seek = DemoSeek();
+    ::seek.targetTic = tic;
+    ::demoFrameZ     = 1; // The camera moves immediately.
+
+    try
+    {
+        DemoFile::Keyframe const *keyframe = demoReader->keyframeAt(tic);
+        if(keyframe && keyframe->segmentOffset == demoReader->currentSegment() && Cl_GameReady())
+        {
+            // Same map, so the keyframe can be restored right away.
+            restoreKeyframe(*keyframe);
+        }
+        else
+        {
+            // The map of the keyframe must be set up first.
+            ::seek.awaitingMap = true;
+            if(keyframe)
+            {
+                ::seek.hasKeyframe = true;
+                ::seek.keyframe    = *keyframe;
+                demoReader->seek(keyframe->segmentOffset);
+            }
+            else
+            {
+                demoReader->seek(0);
+            }
+        }
+    }
+    catch(Error const &er)
+    {
+        LOG_NET_ERROR("Demo seek failed: %s") << er.asText();
+        ::seek = DemoSeek();
         return false;
     }
+    return true;
+}
+
+static void readIntoNetBuffer(DemoFile::Packet const &packet)
+{
+    if(packet.data.size() > NETBUFFER_MAXSIZE)
+    {
+        throw DemoFile::FormatError("readIntoNetBuffer",
+                                    String("Packet is too large (%1 bytes)").arg(packet.data.size()));
+    }
+    ::netBuffer.length   = packet.data.size();
+    ::netBuffer.player   = 0; // From the server.
+    ::netBuffer.msg.type = packet.type;
+    std::memcpy(::netBuffer.msg.data, packet.data.constData(), packet.data.size());
+}
+
+dd_bool Demo_ReadPacket()
+{
+    if(!::playback)
+        return false;
 
+    dint const nowtime = DEMOTIC;
     if(::readInfo.first)
     {
         ::readInfo.first = false;
         ::readInfo.begintime = nowtime;
-        ptime = lzGetC(::playdemo);
     }
 
-    // Check if the packet can be read.
-    if(Net_TimeDelta(nowtime - ::readInfo.begintime, ptime) < 0)
-        return false;  // Can't read yet.
+    try
+    {
+        // Keyframe being restored?
+        if(!::seek.queue.isEmpty())
+        {
+            readIntoNetBuffer(::seek.queue.takeFirst());
+            return true;
+        }
+        if(::seek.sweepPending)
+        {
+            ::seek.sweepPending = false;
+            sweepClientMobjs();
+        }
 
-    // Read the packet.
-    demopacket_header_t hdr;
-    lzRead(&hdr, sizeof(hdr), ::playdemo);
+        if(::seek.awaitingMap && ::seek.handshakeRead)
+        {
+            // Wait for the map to be set up.
+            if(!Cl_GameReady()) return false;
 
-    // Get the packet.
-    ::netBuffer.length = hdr.length - 1;
-    ::netBuffer.player = 0; // From the server.
-    ::netBuffer.msg.type = lzGetC(::playdemo);
-    lzRead(::netBuffer.msg.data, (long) ::netBuffer.length, ::playdemo);
-    //::netBuffer.cursor = ::netBuffer.msg.data;
+            if(::seek.hasKeyframe)
+            {
+                restoreKeyframe(::seek.keyframe);
+                readIntoNetBuffer(::seek.queue.takeFirst());
+                return true;
+            }
+            ::seek.awaitingMap = false;
+        }
 
-    // Read the next packet time.
-    ptime = lzGetC(::playdemo);
+        for(;;)
+        {
+            DemoFile::Packet const *next = demoReader->peek();
+            if(!next)
+            {
+                Demo_StopPlayback();
+                // Any interested parties?
+                DoomsdayApp::plugins().callAllHooks(HOOK_DEMO_STOP);
+                return false;
+            }
 
-    return true;
-#endif
+            if(::seek.targetTic >= 0)
+            {
+                if(::seek.awaitingMap || dint64(next->tic) <= ::seek.targetTic)
+                {
+                    // Fast-forward: sounds would only be noise.
+                    DemoFile::Packet const packet = demoReader->take();
+                    if(packet.type == PSV_SOUND) continue;
+                    if(packet.type == PSV_HANDSHAKE) ::seek.handshakeRead = true;
+                    readIntoNetBuffer(packet);
+                    return true;
+                }
+
+                // The target has been reached. Continue in real time from here.
+                ::readInfo.begintime = nowtime - dint(::seek.targetTic);
+                ::seek = DemoSeek();
+                R_ResetViewer();
+            }
+
+            // Check if the packet can be read.
+            if(nowtime - ::readInfo.begintime < dint(next->tic))
+                return false;  // Can't read yet.
+
+            readIntoNetBuffer(demoReader->take());
+            return true;
+        }
+    }
+    catch(Error const &er)
+    {
+        LOG_NET_ERROR("Demo playback failed: %s") << er.asText();
+        Demo_StopPlayback();
+        DoomsdayApp::plugins().callAllHooks(HOOK_DEMO_STOP);
+        return false;
+    }
 }
 
 /**
@@ -586,6 +881,31 @@ D_CMD(PlayDemo)
     return Demo_BeginPlayback(argv[1]);
 }
 
+D_CMD(SeekDemo)
+{
+    DENG2_UNUSED(src);
+
+    if(argc != 2)
+    {
+        LOG_SCR_NOTE("Usage: %s (seconds)") << argv[0];
+        LOG_SCR_MSG("Prefix with + or - to seek relative to the current position.");
+        return true;
+    }
+    if(!::playback)
+    {
+        LOG_SCR_ERROR("No demo is being played");
+        return false;
+    }
+
+    String const arg(argv[1]);
+    dint tic = dint(arg.toFloat() * TICSPERSEC);
+    if(arg.startsWith("+") || arg.startsWith("-"))
+    {
+        tic += DEMOTIC - ::readInfo.begintime;
+    }
+    return Demo_Seek(tic);
+}
+
 D_CMD(RecordDemo)
 {
     DENG2_UNUSED(src);
@@ -717,5 +1037,6 @@ void Demo_Register()
     C_CMD_FLAGS("pausedemo",    nullptr,    PauseDemo,  CMDF_NO_NULLGAME);
     C_CMD_FLAGS("playdemo",     "s",        PlayDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("recorddemo",   nullptr,    RecordDemo, CMDF_NO_NULLGAME);
+    C_CMD_FLAGS("seekdemo",     nullptr,    SeekDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("stopdemo",     nullptr,    StopDemo,   CMDF_NO_NULLGAME);
 }
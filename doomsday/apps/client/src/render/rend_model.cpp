@@ -42,6 +42,7 @@
 #include "ClientTexture"
 #include "ClientMaterial"
 
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/var.h>
 #include <doomsday/world/Materials>
 #include <de/Log>
@@ -50,6 +51,11 @@
 #include <de/binangle.h>
 #include <de/memory.h>
 #include <de/concurrency.h>
+#include <de/TaskPool>
+#include <de/Time>
+#include <QSet>
+#include <QThread>
+#include <QVarLengthArray>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
@@ -87,6 +93,8 @@ byte precacheSkins     = true;
 
 static bool inited;
 
+D_CMD(BenchmarkModels);
+
 struct array_t
 {
     bool enabled;
@@ -129,6 +137,8 @@ void Rend_ModelRegister()
     C_VAR_FLOAT("rend-model-spin-speed",     &modelSpinSpeed,       CVF_NO_MAX | CVF_NO_MIN, 0, 0);
     //C_VAR_INT  ("rend-model-shiny-multitex", &modelShinyMultitex,   0, 0, 1);
     C_VAR_FLOAT("rend-model-shiny-strength", &modelShinyFactor,     0, 0, 10);
+
+    C_CMD("benchmodels", nullptr, BenchmarkModels);
 }
 
 void Rend_ModelInit()
@@ -465,6 +475,57 @@ static void drawPrimitives(rendcmd_t mode,
     DGL_End();
 }
 
+/*
+ * Vertex processing kernels. Positions and normals are processed as flat arrays of
+ * floats so that the compiler is able to vectorize the loops. All vertices are
+ * processed regardless of the detail level, as this is cheaper than testing each
+ * vertex separately (except when lighting).
+ */
+
+/// Vertex counts above this are processed using multiple threads.
+static dint const PARALLEL_VERTEX_WORK = 16384;
+
+/**
+ * Calls @a work for consecutive ranges of vertices. When there is enough work, the
+ * ranges are processed in parallel in background threads.
+ *
+ * @param count     Number of vertices.
+ * @param costPer   Relative cost of processing one vertex.
+ * @param work      Function that processes the vertices [start, end).
+ */
+static void processVertices(dint count, dint costPer, std::function<void (dint, dint)> const &work)
+{
+    if (count * costPer < PARALLEL_VERTEX_WORK)
+    {
+        work(0, count);
+        return;
+    }
+    dint const chunks = de::min(dint(QThread::idealThreadCount()),
+                                count * costPer / (PARALLEL_VERTEX_WORK / 2));
+    dint const perChunk = (count + chunks - 1) / chunks;
+
+    TaskPool tasks;
+    for (dint start = perChunk; start < count; start += perChunk)
+    {
+        dint const end = de::min(count, start + perChunk);
+        tasks.start([&work, start, end] () { work(start, end); }, TaskPool::HighPriority);
+    }
+    work(0, de::min(count, perChunk));
+    tasks.waitForDone();
+}
+
+static inline dfloat const *floats(Vector3f const *vecs) { return reinterpret_cast<dfloat const *>(vecs); }
+static inline dfloat *floats(Vector3f *vecs) { return reinterpret_cast<dfloat *>(vecs); }
+
+static void lerpFloats(dfloat *out, dfloat const *from, dfloat const *to, dint count, dfloat inter)
+{
+    dfloat const fromFactor = 1.f - inter;
+    for (dint i = 0; i < count; ++i)
+    {
+        out[i] = to[i] * inter + from[i] * fromFactor;
+    }
+}
+
 /**
  * Interpolate linearly between two sets of vertices.
  */
@@ -472,42 +533,33 @@ static void Mod_LerpVertices(float inter, int count, FrameModelFrame const &from
     FrameModelFrame const &to, Vector3f *posOut, Vector3f *normOut)
 {
     DENG2_ASSERT(&from.model == &to.model); // sanity check.
-    DENG2_ASSERT(!activeLod || &activeLod->model == &from.model); // sanity check.
-    DENG2_ASSERT(from.vertices.count() == to.vertices.count()); // sanity check.
-
-    FrameModelFrame::VertexBuf::const_iterator startIt = from.vertices.begin();
-    FrameModelFrame::VertexBuf::const_iterator endIt   = to.vertices.begin();
+    DENG2_ASSERT(from.positions.count() == to.positions.count()); // sanity check.
+    DENG2_ASSERT(count <= from.positions.count());
 
     if (&from == &to || de::fequal(inter, 0))
     {
-        for (int i = 0; i < count; ++i, startIt++, posOut++, normOut++)
-        {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = startIt->pos;
-                *normOut = startIt->norm;
-            }
-        }
+        std::memcpy(posOut,  from.positions.constData(), sizeof(Vector3f) * count);
+        std::memcpy(normOut, from.normals  .constData(), sizeof(Vector3f) * count);
     }
     else
     {
-        for (int i = 0; i < count; ++i, startIt++, endIt++, posOut++, normOut++)
+        processVertices(count, 1, [&] (dint start, dint end)
         {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = de::lerp(startIt->pos,  endIt->pos,  inter);
-                *normOut = de::lerp(startIt->norm, endIt->norm, inter);
-            }
-        }
+            lerpFloats(floats(posOut + start), floats(from.positions.constData() + start),
+                       floats(to.positions.constData() + start), 3 * (end - start), inter);
+            lerpFloats(floats(normOut + start), floats(from.normals.constData() + start),
+                       floats(to.normals.constData() + start), 3 * (end - start), inter);
+        });
     }
 }
 
 static void Mod_MirrorCoords(dint count, Vector3f *coords, dint axis)
 {
     DENG2_ASSERT(coords);
-    for (; count-- > 0; coords++)
+    dfloat *comps = floats(coords) + axis;
+    for (dint i = 0; i < count; ++i)
     {
-        (*coords)[axis] = -(*coords)[axis];
+        comps[3 * i] = -comps[3 * i];
     }
 }
 
@@ -518,8 +570,6 @@ static void Mod_MirrorCoords(dint count, Vector3f *coords, dint axis)
  * @param yaw     Yaw rotation angle.
  * @param pitch   Pitch rotation angle.
  * @param invert  @c true= flip light normal (for use with inverted models).
- *
- * @todo Construct a rotation matrix once and use it for all lights.
  */
 static Vector3f rotateLightVector(VectorLightData const &vlight, dfloat yaw, dfloat pitch,
     bool invert = false)
@@ -537,54 +587,82 @@ static Vector3f rotateLightVector(VectorLightData const &vlight, dfloat yaw, dfl
     return Vector3f(rotated);
 }
 
+/**
+ * Vector light in model space.
+ */
+struct ModelLight
+{
+    Vector3f direction;
+    Vector3f color;
+    dfloat offset;
+    dfloat lightSide;
+    dfloat darkSide;
+    dint accumIndex;  ///< 0: affected by ambient, 1: not affected.
+};
+typedef QVarLengthArray<ModelLight, 16> ModelLights;
+
+/**
+ * Collects the lights affecting a model and transforms them to model space.
+ */
+static ModelLights Mod_ModelLights(duint lightListIdx, duint maxLights, bool invert,
+    dfloat rotateYaw, dfloat rotatePitch)
+{
+    ModelLights lights;
+    ClientApp::renderSystem().forAllVectorLights(lightListIdx, [&] (VectorLightData const &vlight)
+    {
+        ModelLight light;
+        // We must transform the light vector to model space.
+        light.direction  = rotateLightVector(vlight, rotateYaw, rotatePitch, invert);
+        light.color      = vlight.color;
+        light.offset     = vlight.offset;
+        light.lightSide  = vlight.lightSide;
+        light.darkSide   = vlight.darkSide;
+        light.accumIndex = (vlight.affectedByAmbient? 0 : 1);
+        lights.append(light);
+
+        // Time to stop?
+        return (maxLights && duint(lights.size()) == maxLights);
+    });
+    return lights;
+}
+
 /**
  * Calculate vertex lighting.
  */
 static void Mod_VertexColors(Vector4ub *out, dint count, Vector3f const *normCoords,
-    duint lightListIdx, duint maxLights, Vector4f const &ambient, bool invert,
-    dfloat rotateYaw, dfloat rotatePitch)
+    ModelLights const &lights, Vector4f const &ambient, FrameModelLOD const *lod)
 {
     Vector4f const saturated(1, 1, 1, 1);
 
-    for (dint i = 0; i < count; ++i, out++, normCoords++)
+    processVertices(count, 1 + lights.size(), [&] (dint start, dint end)
     {
-        if (activeLod && !activeLod->hasVertex(i))
-            continue;
-
-        Vector3f const &normal = *normCoords;
-
-        // Accumulate contributions from all affecting lights.
-        dint numProcessed = 0;
-        Vector3f accum[2];  // Begin with total darkness [color, extra].
-        ClientApp::renderSystem().forAllVectorLights(lightListIdx, [&maxLights, &invert, &rotateYaw
-                                                      , &rotatePitch, &normal
-                                                      , &accum, &numProcessed] (VectorLightData const &vlight)
+        for (dint i = start; i < end; ++i)
         {
-            numProcessed += 1;
+            if (lod && !lod->hasVertex(i))
+                continue;
 
-            // We must transform the light vector to model space.
-            Vector3f const lightDirection
-                    = rotateLightVector(vlight, rotateYaw, rotatePitch, invert);
+            Vector3f const &normal = normCoords[i];
 
-            dfloat strength = lightDirection.dot(normal)
-                            + vlight.offset;  // Shift a bit towards the light.
-
-            // Ability to both light and shade.
-            if (strength > 0) strength *= vlight.lightSide;
-            else             strength *= vlight.darkSide;
+            // Accumulate contributions from all affecting lights.
+            Vector3f accum[2];  // Begin with total darkness [color, extra].
+            for (ModelLight const &light : lights)
+            {
+                dfloat strength = light.direction.dot(normal)
+                                + light.offset;  // Shift a bit towards the light.
 
-            accum[vlight.affectedByAmbient? 0 : 1]
-                += vlight.color * de::clamp(-1.f, strength, 1.f);
+                // Ability to both light and shade.
+                if (strength > 0) strength *= light.lightSide;
+                else             strength *= light.darkSide;
 
-            // Time to stop?
-            return (maxLights && duint(numProcessed) == maxLights);
-        });
+                accum[light.accumIndex] += light.color * de::clamp(-1.f, strength, 1.f);
+            }
 
-        // Check for ambient and convert to ubyte.
-        Vector4f color(accum[0].max(ambient) + accum[1], ambient[3]);
+            // Check for ambient and convert to ubyte.
+            Vector4f color(accum[0].max(ambient) + accum[1], ambient[3]);
 
-        *out = (color.min(saturated) * 255).toVector4ub();
-    }
+            out[i] = (color.min(saturated) * 255).toVector4ub();
+        }
+    });
 }
 
 /**
@@ -617,20 +695,25 @@ static void Mod_FixedVertexColors(dint count, Vector4ub *colorCoords, Vector4ub
 static void Mod_ShinyCoords(Vector2f *out, int count, Vector3f const *normCoords,
     float normYaw, float normPitch, float shinyAng, float shinyPnt, float reactSpeed)
 {
-    for (int i = 0; i < count; ++i, out++, normCoords++)
+    // Rotate the normal vectors so that they approximate the model's orientation
+    // compared to the viewer. The rotation is the same as with M_RotateVector(),
+    // but the sines and cosines are only calculated once.
+    float const radYaw   = (shinyPnt + normYaw) * 360 * reactSpeed / 180 * DD_PI;
+    float const radPitch = (shinyAng + normPitch - .5f) * 180 * reactSpeed / 180 * DD_PI;
+    float const cosYaw   = float(std::cos(radYaw));
+    float const sinYaw   = float(std::sin(radYaw));
+    float const cosPitch = float(std::cos(radPitch));
+    float const sinPitch = float(std::sin(radPitch));
+
+    float const *norm = floats(normCoords);
+    float *coords = reinterpret_cast<float *>(out);
+    for (int i = 0; i < count; ++i)
     {
-        if (activeLod && !activeLod->hasVertex(i))
-            continue;
-
-        float rotatedNormal[3] = { normCoords->x, normCoords->y, normCoords->z };
-
-        // Rotate the normal vector so that it approximates the
-        // model's orientation compared to the viewer.
-        M_RotateVector(rotatedNormal,
-                       (shinyPnt + normYaw) * 360 * reactSpeed,
-                       (shinyAng + normPitch - .5f) * 180 * reactSpeed);
+        float const x = norm[3*i] * cosYaw + norm[3*i + 1] * sinYaw;
+        float const z = norm[3*i + 2];
 
-        *out = Vector2f(rotatedNormal[0] + 1, rotatedNormal[2]);
+        coords[2*i]     = z * -sinPitch + x * cosPitch + 1;
+        coords[2*i + 1] = z * cosPitch + x * sinPitch;
     }
 }
 
@@ -885,9 +968,10 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         // Lit normally.
         ambient = Vector4f(spr.light.ambientColor, alpha);
 
-        Mod_VertexColors(modelColorCoords, numVerts,
-                         modelNormCoords, spr.light.vLightListIdx, modelLight + 1,
-                         ambient, (mf->scale[VY] < 0), -spr.pose.yaw, -spr.pose.pitch);
+        Mod_VertexColors(modelColorCoords, numVerts, modelNormCoords,
+                         Mod_ModelLights(spr.light.vLightListIdx, modelLight + 1,
+                                         (mf->scale[VY] < 0), -spr.pose.yaw, -spr.pose.pitch),
+                         ambient, activeLod);
     }
 
     TextureVariant *shinyTexture = 0;
@@ -1175,3 +1259,83 @@ TextureVariantSpec const &Rend_ModelShinyTextureSpec()
         TSF_NO_COMPRESSION, 0, 0, 0, GL_REPEAT, GL_REPEAT, 1, -2, -1, false,
         false, false, false);
 }
+
+/**
+ * Animates all the loaded frame models with the vertex processing kernels, without
+ * drawing anything. The lights are fixed, so the light list is not needed either.
+ */
+D_CMD(BenchmarkModels)
+{
+    DENG2_UNUSED(src);
+
+    dint const instances = (argc > 1? de::max(1, String(argv[1]).toInt()) : 100);
+
+    // Collect the models in use.
+    QSet<modelid_t> ids;
+    for (dint i = 0; i < App_Resources().modelDefCount(); ++i)
+    {
+        FrameModelDef &modef = App_Resources().modelDef(i);
+        for (duint k = 0; k < modef.subCount(); ++k)
+        {
+            if (modef.subModelId(k)) ids.insert(modef.subModelId(k));
+        }
+    }
+    if (ids.isEmpty())
+    {
+        LOG_SCR_ERROR("No models have been loaded");
+        return false;
+    }
+
+    // A few lights from different directions.
+    ModelLights lights;
+    for (dint i = 0; i < 3; ++i)
+    {
+        ModelLight light;
+        light.direction  = Vector3f(i == 0, i == 1, i == 2);
+        light.color      = Vector3f(.5f, .5f, .5f);
+        light.offset     = .3f;
+        light.lightSide  = 1;
+        light.darkSide   = 0;
+        light.accumIndex = 0;
+        lights.append(light);
+    }
+    Vector4f const ambient(.2f, .2f, .2f, 1);
+
+    QVector<Vector3f> posCoords, normCoords;
+    QVector<Vector4ub> colorCoords;
+    QVector<Vector2f> texCoords;
+    dint64 totalVerts = 0;
+
+    Time startedAt;
+    for (modelid_t id : ids)
+    {
+        FrameModel &mdl = App_Resources().model(id);
+        dint const numVerts = mdl.vertexCount();
+        if (!numVerts || !mdl.frameCount()) continue;
+
+        posCoords  .resize(numVerts);
+        normCoords .resize(numVerts);
+        colorCoords.resize(numVerts);
+        texCoords  .resize(numVerts);
+
+        for (dint i = 0; i < instances; ++i)
+        {
+            FrameModelFrame const &from = mdl.frame(i % mdl.frameCount());
+            FrameModelFrame const &to   = mdl.frame((i + 1) % mdl.frameCount());
+            float const inter = (i % 8) / 8.f;
+
+            Mod_LerpVertices(inter, numVerts, from, to, posCoords.data(), normCoords.data());
+            Mod_VertexColors(colorCoords.data(), numVerts, normCoords.constData(), lights,
+                             ambient, nullptr);
+            Mod_ShinyCoords(texCoords.data(), numVerts, normCoords.constData(),
+                            inter, .25f, .5f, .5f, 1);
+            totalVerts += numVerts;
+        }
+    }
+    ddouble const elapsed = startedAt.since();
+
+    LOG_SCR_MSG("Animated %i models %i times: %i vertices in %.2f ms (%.1f Mverts/s)")
+            << ids.size() << instances << totalVerts << elapsed * 1000
+            << (elapsed > 0? totalVerts / elapsed / 1.0e6 : 0.0);
+    return true;
+}
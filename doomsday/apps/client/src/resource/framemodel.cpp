@@ -208,29 +208,29 @@ DENG2_PIMPL(FrameModel)
             String const frameName = pfr->name;
 
             FrameModelFrame *frame = new FrameModelFrame(*mdl, frameName);
-            frame->vertices.reserve(hdr.numVertices);
+            frame->positions.resize(hdr.numVertices);
+            frame->normals.resize(hdr.numVertices);
 
             // Scale and translate each vertex.
             md2_triangleVertex_t const *pVtx = pfr->vertices;
             for(int k = 0; k < hdr.numVertices; ++k, pVtx++)
             {
-                frame->vertices.append(FrameModelFrame::Vertex());
-                FrameModelFrame::Vertex &vtx = frame->vertices.last();
+                Vector3f &pos = frame->positions[k];
 
-                vtx.pos = Vector3f(pVtx->vertex[0], pVtx->vertex[2], pVtx->vertex[1])
-                              * scale + translation;
-                vtx.pos.y *= aspectScale; // Aspect undoing.
+                pos = Vector3f(pVtx->vertex[0], pVtx->vertex[2], pVtx->vertex[1])
+                          * scale + translation;
+                pos.y *= aspectScale; // Aspect undoing.
 
-                vtx.norm = Vector3f(avertexnormals[pVtx->normalIndex]);
+                frame->normals[k] = Vector3f(avertexnormals[pVtx->normalIndex]);
 
                 if(!k)
                 {
-                    frame->min = frame->max = vtx.pos;
+                    frame->min = frame->max = pos;
                 }
                 else
                 {
-                    frame->min = vtx.pos.min(frame->min);
-                    frame->max = vtx.pos.max(frame->max);
+                    frame->min = pos.min(frame->min);
+                    frame->max = pos.max(frame->max);
                 }
             }
 
@@ -417,29 +417,29 @@ DENG2_PIMPL(FrameModel)
             String const frameName = pfr->name;
 
             Frame *frame = new Frame(*mdl, frameName);
-            frame->vertices.reserve(info.numVertices);
+            frame->positions.resize(info.numVertices);
+            frame->normals.resize(info.numVertices);
 
             // Scale and translate each vertex.
             dmd_packedVertex_t const *pVtx = pfr->vertices;
             for(int k = 0; k < info.numVertices; ++k, ++pVtx)
             {
-                frame->vertices.append(Frame::Vertex());
-                Frame::Vertex &vtx = frame->vertices.last();
+                Vector3f &pos = frame->positions[k];
 
-                vtx.pos = Vector3f(pVtx->vertex[0], pVtx->vertex[2], pVtx->vertex[1])
-                              * scale + translation;
-                vtx.pos.y *= aspectScale; // Aspect undo.
+                pos = Vector3f(pVtx->vertex[0], pVtx->vertex[2], pVtx->vertex[1])
+                          * scale + translation;
+                pos.y *= aspectScale; // Aspect undo.
 
-                vtx.norm = unpackVector(DD_USHORT(pVtx->normal));
+                frame->normals[k] = unpackVector(DD_USHORT(pVtx->normal));
 
                 if(!k)
                 {
-                    frame->min = frame->max = vtx.pos;
+                    frame->min = frame->max = pos;
                 }
                 else
                 {
-                    frame->min = vtx.pos.min(frame->min);
-                    frame->max = vtx.pos.max(frame->max);
+                    frame->min = pos.min(frame->min);
+                    frame->max = pos.max(frame->max);
                 }
             }
 
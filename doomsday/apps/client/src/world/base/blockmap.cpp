@@ -569,6 +569,27 @@ LoopResult Blockmap::forAllInBox(AABoxd const &box, std::function<LoopResult (vo
     return LoopContinue;
 }
 
+dint Blockmap::collectInBox(AABoxd const &box, QVector<void *> &objects) const
+{
+    CellBlock cellBlock = toCellBlock(box);
+    d->clipBlock(cellBlock);
+
+    dint const oldSize = objects.size();
+    Cell cell;
+    for(cell.y = cellBlock.min.y; cell.y < cellBlock.max.y; ++cell.y)
+    for(cell.x = cellBlock.min.x; cell.x < cellBlock.max.x; ++cell.x)
+    {
+        if(auto *cellData = d->cellData(cell))
+        {
+            for(RingNode *node = cellData->ringNodes; node; node = node->next)
+            {
+                if(node->elem) objects.append(node->elem);
+            }
+        }
+    }
+    return objects.size() - oldSize;
+}
+
 LoopResult Blockmap::forAllInPath(Vector2d const &from_, Vector2d const &to_,
     std::function<LoopResult (void *object)> func) const
 {
@@ -527,9 +527,6 @@ DENG2_PIMPL(ClientServerWorld)
         // Init the thinker lists (public and private).
         map->thinkers().initLists(0x1 | 0x2);
 
-        // Must be called before we go any further.
-        P_InitUnusedMobjList();
-
         // Must be called before any mobjs are spawned.
         map->initNodePiles();
 
@@ -21,8 +21,9 @@
 
 #include "world/interceptor.h"
 
-#include <de/memoryzone.h>
 #include <de/vector1.h>
+#include <algorithm>
+#include <vector>
 #include "world/blockmap.h"
 #include "world/lineblockmap.h"
 #include "world/p_object.h"
@@ -30,11 +31,8 @@
 
 using namespace de;
 
-struct ListNode
+struct InterceptNode
 {
-    ListNode *next;
-    ListNode *prev;
-
     intercepttype_t type;
     void *object;
     dfloat distance;
@@ -44,17 +42,17 @@ struct ListNode
         DENG2_ASSERT(object);
         return *static_cast<ObjectType *>(object);
     }
+
+    bool operator < (InterceptNode const &other) const {
+        return distance < other.distance;
+    }
 };
 
-// Blockset from which intercepts are allocated.
-static zblockset_t *interceptNodeSet;
-// Head of the used intercept list.
-static ListNode *interceptFirst;
+typedef std::vector<InterceptNode> InterceptNodes;
 
-// Trace nodes.
-static ListNode head;
-static ListNode tail;
-static ListNode *mru;
+/// Intercept storage reused by successive traces. A trace takes it for the
+/// duration of the trace, so a nested trace will use a storage of its own.
+static InterceptNodes spareIntercepts;
 
 DENG2_PIMPL_NOREF(Interceptor)
 {
@@ -66,6 +64,7 @@ DENG2_PIMPL_NOREF(Interceptor)
 
     world::Map *map = nullptr;
     LineOpening opening;
+    InterceptNodes intercepts;
 
     // Array representation for ray geometry (used with legacy code).
     vec2d_t fromV1;
@@ -83,56 +82,9 @@ DENG2_PIMPL_NOREF(Interceptor)
         V2d_Set(directionV1, to.x - from.x, to.y - from.y);
     }
 
-    inline bool isSentinel(ListNode const &node)
-    {
-        return &node == &tail || &node == &head;
-    }
-
     /**
-     * Empties the intercepts array and makes sure it has been allocated.
-     */
-    void clearIntercepts()
-    {
-#define MININTERCEPTS       128
-
-        if(!interceptNodeSet)
-        {
-            interceptNodeSet = ZBlockSet_New(sizeof(ListNode), MININTERCEPTS, PU_APPSTATIC);
-
-            // Configure the static head and tail.
-            head.distance = 0.0f;
-            head.next     = &tail;
-            head.prev     = nullptr;
-
-            tail.distance = 1.0f;
-            tail.prev     = &head;
-            tail.next     = nullptr;
-        }
-
-        // Start reusing intercepts (may point to a sentinel but that is Ok).
-        if(!interceptFirst)
-        {
-            interceptFirst = head.next;
-        }
-        else if(head.next != &tail)
-        {
-            ListNode *existing = interceptFirst;
-            interceptFirst = head.next;
-            tail.prev->next = existing;
-        }
-
-        // Reset the trace.
-        head.next = &tail;
-        tail.prev = &head;
-
-        mru = nullptr;
-
-#undef MININTERCEPTS
-    }
-
-    /**
-     * You must clear intercepts before the first time this is called.
-     * The intercepts array grows if necessary.
+     * Collects an intercept. The intercepts are put in order along the trace
+     * only after all of them have been collected (see sortIntercepts()).
      *
      * @param type      Type of interception.
      * @param distance  Distance along the trace vector that the interception occured [0...1].
@@ -142,49 +94,19 @@ DENG2_PIMPL_NOREF(Interceptor)
     {
         DENG2_ASSERT(object);
 
-        // First reject vs our sentinels
-        if(distance < head.distance) return;
-        if(distance > tail.distance) return;
-
-        // Find the new intercept's ordered place along the trace.
-        ListNode *before;
-        if(mru && mru->distance <= distance)
-        {
-            before = mru->next;
-        }
-        else
-        {
-            before = head.next;
-        }
-
-        while(before->next && distance >= before->distance)
-        {
-            before = before->next;
-        }
-
-        ListNode *icpt;
-        // Can we reuse an existing intercept?
-        if(!isSentinel(*interceptFirst))
-        {
-            icpt = interceptFirst;
-            interceptFirst = icpt->next;
-        }
-        else
-        {
-            icpt = (ListNode *) ZBlockSet_Allocate(interceptNodeSet);
-        }
-        icpt->type     = type;
-        icpt->object   = object;
-        icpt->distance = distance;
-
-        // Link it in.
-        icpt->next = before;
-        icpt->prev = before->prev;
+        // Only intercepts along the trace vector are of interest.
+        if(distance < 0 || distance > 1) return;
 
-        icpt->prev->next = icpt;
-        icpt->next->prev = icpt;
+        intercepts.push_back(InterceptNode{ type, object, distance });
+    }
 
-        mru = icpt;
+    /**
+     * Orders the collected intercepts by distance along the trace. Intercepts at
+     * the same distance remain in the order they were found in.
+     */
+    void sortIntercepts()
+    {
+        std::stable_sort(intercepts.begin(), intercepts.end());
     }
 
     void intercept(Line &line)
@@ -269,7 +191,7 @@ DENG2_PIMPL_NOREF(Interceptor)
 
     void runTrace()
     {
-        clearIntercepts();
+        intercepts.clear();
         dint const localValidCount = ++validCount;
 
         if(flags & PTF_LINE)
@@ -365,28 +287,34 @@ bool Interceptor::adjustOpening(Line const *line)
 
 dint Interceptor::trace(world::Map const &map)
 {
+    // Reuse the storage of earlier traces.
+    d->intercepts.swap(spareIntercepts);
+
     // Step #1: Collect and sort intercepts.
     d->map = const_cast<world::Map *>(&map);
     d->runTrace();
+    d->sortIntercepts();
 
     // Step #2: Process intercepts.
-    for(ListNode *node = head.next; !d->isSentinel(*node); node = node->next)
+    dint result = false; // Intercept traversal completed wholly.
+    for(InterceptNode const &node : d->intercepts)
     {
         // Prepare the intercept info.
         Intercept icpt;
         icpt.trace    = this;
-        icpt.distance = node->distance;
-        icpt.type     = node->type;
-        switch(node->type)
+        icpt.distance = node.distance;
+        icpt.type     = node.type;
+        switch(node.type)
         {
-        case ICPT_MOBJ: icpt.mobj = &node->objectAs<mobj_t>(); break;
-        case ICPT_LINE: icpt.line = &node->objectAs<Line>();   break;
+        case ICPT_MOBJ: icpt.mobj = &node.objectAs<mobj_t>(); break;
+        case ICPT_LINE: icpt.line = &node.objectAs<Line>();   break;
         }
 
         // Make the callback.
-        if(int result = d->callback(&icpt, d->context))
-            return result;
+        if((result = d->callback(&icpt, d->context)) != 0)
+            break;
     }
 
-    return false; // Intercept traversal completed wholly.
+    d->intercepts.swap(spareIntercepts);
+    return result;
 }
@@ -71,8 +71,6 @@ using namespace world;
 
 static String const VAR_MATERIAL("material");
 
-static mobj_t *unusedMobjs;
-
 /*
  * Console variables:
  */
@@ -83,15 +81,6 @@ dint useSRVOAngle = 1;
 static byte mobjAutoLights = true;
 #endif
 
-/**
- * Called during map loading.
- */
-void P_InitUnusedMobjList()
-{
-    // Any zone memory allocated for the mobjs will have already been purged.
-    ::unusedMobjs = nullptr;
-}
-
 /**
  * All mobjs must be allocated through this routine. Part of the public API.
  */
@@ -109,18 +98,9 @@ mobj_t *P_MobjCreate(thinkfunc_t function, Vector3d const &origin, angle_t angle
     }
 #endif
 
-    // Do we have any unused mobjs we can reuse?
-    mobj_t *mob;
-    if (::unusedMobjs)
-    {
-        mob = ::unusedMobjs;
-        ::unusedMobjs = ::unusedMobjs->sNext;
-    }
-    else
-    {
-        // No, we need to allocate another.
-        mob = MobjThinker(Thinker::AllocateMemoryZone).take();
-    }
+    // Allocate from the pool of mobjs of this type (possibly reusing a removed mobj).
+    /// @todo fixme: Do not assume the current map.
+    mobj_t *mob = App_World().map().thinkers().newMobj(function);
 
     V3d_Set(mob->origin, origin.x, origin.y, origin.z);
     mob->angle    = angle;
@@ -160,20 +140,6 @@ DENG_EXTERN_C void Mobj_Destroy(mobj_t *mo)
     Mobj_Map(*mo).thinkers().remove(reinterpret_cast<thinker_t &>(*mo));
 }
 
-/**
- * Called when a mobj is actually removed (when it's thinking turn comes around).
- * The mobj is moved to the unused list to be reused later.
- */
-void P_MobjRecycle(mobj_t* mo)
-{
-    // Release the private data.
-    MobjThinker::zap(*mo);
-
-    // The sector next link is used as the unused mobj list links.
-    mo->sNext = unusedMobjs;
-    unusedMobjs = mo;
-}
-
 bool Mobj_IsSectorLinked(mobj_t const &mob)
 {
     return (mob._bspLeaf != nullptr && mob.sPrev != nullptr);
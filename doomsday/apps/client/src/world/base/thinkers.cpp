@@ -38,7 +38,9 @@
 
 #include <de/memoryzone.h>
 #include <QList>
+#include <QVector>
 #include <QtAlgorithms>
+#include <cstring>
 
 using namespace de;
 
@@ -60,11 +62,93 @@ world::Map &Thinker_Map(thinker_t const & /*th*/)
 
 namespace world {
 
+/**
+ * Pool of equally sized thinkers allocated from the memory zone. The thinkers are
+ * carved out of larger slabs so that thinkers of the same type are near each other
+ * in memory. Removed thinkers are returned to the pool and reused.
+ *
+ * The slabs are never freed individually: they are purged along with the rest of
+ * the map's zone memory.
+ */
+struct ThinkerPool
+{
+    static dint const SLAB_SIZE = 128;  ///< Number of thinkers per slab.
+
+    dsize elementSize  = 0;
+    duint8 *slab       = nullptr;  ///< Current slab.
+    dint slabUsed      = SLAB_SIZE;
+    dint unusedCount   = 0;
+    thinker_t *unused  = nullptr;  ///< Recycled thinkers (linked via @c next).
+    QVector<duint8 const *> slabs;  ///< All the slabs of the pool, in allocation order.
+
+    thinker_t *allocate(dsize sizeInBytes)
+    {
+        if (!elementSize)
+        {
+            // Keep the elements aligned.
+            elementSize = (sizeInBytes + 15) & ~dsize(15);
+        }
+        DENG2_ASSERT(sizeInBytes <= elementSize);
+
+        thinker_t *th;
+        if (unused)
+        {
+            // Recycled thinkers have already been cleared.
+            th = unused;
+            unused = th->next;
+            th->next = nullptr;
+            unusedCount -= 1;
+            return th;
+        }
+        if (slabUsed == SLAB_SIZE)
+        {
+            slab = reinterpret_cast<duint8 *>(Z_Malloc(elementSize * SLAB_SIZE, PU_MAP, nullptr));
+            slabUsed = 0;
+            slabs << slab;
+        }
+        th = reinterpret_cast<thinker_t *>(slab + elementSize * slabUsed++);
+        std::memset(th, 0, elementSize);
+        return th;
+    }
+
+    /**
+     * Determines whether @a th was allocated from the pool. Other thinkers in the
+     * same list (e.g., client mobjs) are allocated from the zone individually.
+     */
+    bool owns(thinker_t const &th) const
+    {
+        auto const *ptr = reinterpret_cast<duint8 const *>(&th);
+        for (duint8 const *begin : slabs)
+        {
+            if (ptr >= begin && ptr < begin + elementSize * SLAB_SIZE) return true;
+        }
+        return false;
+    }
+
+    void recycle(thinker_t &th)
+    {
+        DENG2_ASSERT(owns(th));
+
+        // Release the private data.
+        Thinker::zap(th, elementSize);
+
+        th.next = unused;
+        unused = &th;
+        unusedCount += 1;
+    }
+
+    dint allocatedCount() const
+    {
+        return de::max(0, slabs.size() - 1) * SLAB_SIZE + (slabs.isEmpty()? 0 : slabUsed);
+    }
+};
+
 struct ThinkerList
 {
     bool isPublic; ///< All thinkers in this list are visible publically.
 
     Thinker sentinel;
+    ThinkerPool pool;  ///< Mobjs of this type are allocated here.
 
     ThinkerList(thinkfunc_t func, bool isPublic) : isPublic(isPublic)
     {
@@ -76,6 +160,7 @@ struct ThinkerList
 
     void reinit()
     {
+        // Note that the pool is kept: the thinkers in it are not linked anywhere.
         sentinel.prev = sentinel.next = sentinel;
     }
 
@@ -128,8 +213,13 @@ DENG2_PIMPL(Thinkers)
     dushort iddealer = 0;
 
     QList<ThinkerList *> lists;
-    QHash<thid_t, mobj_t *> mobjIdLookup;  ///< public only
-    QHash<thid_t, thinker_t *> thinkerIdLookup; ///< all thinkers with ID
+
+    struct IdSlot
+    {
+        thinker_t *thinker = nullptr;  ///< Any thinker with the ID.
+        mobj_t *mobj = nullptr;        ///< Public mobj with the ID.
+    };
+    QVector<IdSlot> idLookup;  ///< Indexed by thinker ID (grown on demand).
 
     bool inited = false;
 
@@ -151,7 +241,10 @@ DENG2_PIMPL(Thinkers)
 
     void releaseAllThinkers()
     {
-        thinkerIdLookup.clear();
+        for (IdSlot &slot : idLookup)
+        {
+            slot.thinker = nullptr;
+        }
         for (ThinkerList *list : lists)
         {
             list->releaseAll();
@@ -163,8 +256,23 @@ DENG2_PIMPL(Thinkers)
         de::zap(idtable);
         idtable[0] |= 1;  // ID zero is always "used" (it's not a valid ID).
 
-        mobjIdLookup.clear();
-        thinkerIdLookup.clear();
+        idLookup.clear();
+    }
+
+    IdSlot const *idSlot(dint id) const
+    {
+        if (id <= 0 || id >= idLookup.size()) return nullptr;
+        return &idLookup.at(id);
+    }
+
+    IdSlot &idSlotForInsert(thid_t id)
+    {
+        if (id >= idLookup.size())
+        {
+            // Grow in large steps; there can be at most 65536 IDs.
+            idLookup.resize(de::min(0x10000, de::max(dint(id) + 1, idLookup.size() * 2)));
+        }
+        return idLookup[id];
     }
 
     thid_t newMobjId()
@@ -215,24 +323,36 @@ void Thinkers::setMobjId(thid_t id, bool inUse)
 
 struct mobj_s *Thinkers::mobjById(dint id)
 {
-    auto found = d->mobjIdLookup.constFind(id);
-    if (found != d->mobjIdLookup.constEnd())
+    if (auto const *slot = d->idSlot(id))
     {
-        return found.value();
+        return slot->mobj;
     }
     return nullptr;
 }
 
 thinker_t *Thinkers::find(thid_t id)
 {
-    auto found = d->thinkerIdLookup.constFind(id);
-    if (found != d->thinkerIdLookup.constEnd())
+    if (auto const *slot = d->idSlot(id))
     {
-        return found.value();
+        return slot->thinker;
     }
     return nullptr;
 }
 
+mobj_t *Thinkers::newMobj(thinkfunc_t function)
+{
+    if (!function)
+        throw Error("Thinkers::newMobj", "Invalid thinker function");
+
+    ThinkerList *list = d->listForThinkFunc(function, true /*public*/, true /*can create*/);
+    auto *mob = reinterpret_cast<mobj_t *>(list->pool.allocate(MOBJ_SIZE));
+    mob->thinker.function = function;
+
+    // Pooled mobjs are cleared, so the private data must be created again.
+    Thinker_InitPrivateData(&mob->thinker);
+    return mob;
+}
+
 void Thinkers::add(thinker_t &th, bool makePublic)
 {
     if (!th.function)
@@ -252,7 +372,7 @@ void Thinkers::add(thinker_t &th, bool makePublic)
 
         if (makePublic && th.id)
         {
-            d->mobjIdLookup.insert(th.id, reinterpret_cast<mobj_t *>(&th));
+            d->idSlotForInsert(th.id).mobj = reinterpret_cast<mobj_t *>(&th);
         }
     }
     else
@@ -262,7 +382,7 @@ void Thinkers::add(thinker_t &th, bool makePublic)
 
     if (th.id)
     {
-        d->thinkerIdLookup.insert(th.id, &th);
+        d->idSlotForInsert(th.id).thinker = &th;
     }
 
     // Link the thinker to the thinker list.
@@ -278,8 +398,10 @@ void Thinkers::remove(thinker_t &th)
         // Flag the identifier as free.
         setMobjId(th.id, false);
 
-        d->mobjIdLookup.remove(th.id);
-        d->thinkerIdLookup.remove(th.id);
+        if (th.id < d->idLookup.size())
+        {
+            d->idLookup[th.id] = Impl::IdSlot();
+        }
 
 #ifdef __SERVER__
         // Then it must be a mobj.
@@ -431,6 +553,85 @@ static void unlinkThinkerFromList(thinker_t *th)
     th->prev->next = th->next;
 }
 
+void Thinkers::think()
+{
+    if (!d->inited) return;
+
+    for (dint i = 0; i < d->lists.count(); ++i)
+    {
+        ThinkerList *list = d->lists[i];
+
+        thinker_t *th = list->sentinel.next;
+        while (th != &list->sentinel.base() && th)
+        {
+#ifdef LIBDENG_FAKE_MEMORY_ZONE
+            DENG2_ASSERT(th->next);
+            DENG2_ASSERT(th->prev);
+#endif
+            thinker_t *next = th->next;
+
+            try
+            {
+                if (Thinker_InStasis(th))
+                {
+                    // Skip.
+                }
+                // Time to remove it?
+                else if (th->function == (thinkfunc_t) -1)
+                {
+                    unlinkThinkerFromList(th);
+
+                    if (th->id && list->pool.owns(*th))
+                    {
+                        // Mobjs are returned to the pool they were allocated from.
+                        list->pool.recycle(*th);
+                    }
+                    else
+                    {
+                        // Non-mobjs and individually allocated mobjs (e.g., client
+                        // mobjs) are just deleted right away.
+                        Thinker::destroy(th);
+                    }
+                }
+                else if (th->function)
+                {
+                    // Create a private data instance of appropriate type.
+                    if (!th->d) Thinker_InitPrivateData(th);
+
+                    // Public thinker callback.
+                    th->function(th);
+
+                    // Private thinking.
+                    if (th->d) THINKER_DATA(*th, Thinker::IData).think();
+                }
+            }
+            catch (Error const &er)
+            {
+                LOG_MAP_WARNING("Thinker %i: %s") << th->id << er.asText();
+            }
+
+            th = next;
+        }
+    }
+}
+
+String Thinkers::poolInfo() const
+{
+    String info;
+    for (ThinkerList const *list : d->lists)
+    {
+        if (list->pool.slabs.isEmpty()) continue;
+
+        if (!info.isEmpty()) info += "\n";
+        info += String("%1 thinker(s) of %2 bytes in %3 slab(s), %4 unused")
+                .arg(list->pool.allocatedCount())
+                .arg(list->pool.elementSize)
+                .arg(list->pool.slabs.size())
+                .arg(list->pool.unusedCount);
+    }
+    return info;
+}
+
 }  // namespace world
 using namespace world;
 
@@ -496,46 +697,7 @@ void Thinker_Run()
     /// @todo fixme: Do not assume the current map.
     if (!App_World().hasMap()) return;
 
-    App_World().map().thinkers().forAll(0x1 | 0x2, [] (thinker_t *th)
-    {
-        try
-        {
-            if (Thinker_InStasis(th)) return LoopContinue; // Skip.
-
-            // Time to remove it?
-            if (th->function == (thinkfunc_t) -1)
-            {
-                unlinkThinkerFromList(th);
-
-                if (th->id)
-                {
-                    // Recycle for reduced allocation overhead.
-                    P_MobjRecycle((mobj_t *) th);
-                }
-                else
-                {
-                    // Non-mobjs are just deleted right away.
-                    Thinker::destroy(th);
-                }
-            }
-            else if (th->function)
-            {
-                // Create a private data instance of appropriate type.
-                if (!th->d) Thinker_InitPrivateData(th);
-
-                // Public thinker callback.
-                th->function(th);
-
-                // Private thinking.
-                if (th->d) THINKER_DATA(*th, Thinker::IData).think();
-            }
-        }
-        catch (const Error &er)
-        {
-            LOG_MAP_WARNING("Thinker %i: %s") << th->id << er.asText();
-        }
-        return LoopContinue;
-    });
+    App_World().map().thinkers().think();
 }
 
 #undef Thinker_Add
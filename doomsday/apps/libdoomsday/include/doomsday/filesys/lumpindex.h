@@ -255,16 +255,16 @@ public:
     bool catalogues(File1 &file);
 
     /**
-     * Append a lump to the index.
-     *
-     * @post Lump name hashes may be invalidated (will be rebuilt upon next search).
+     * Append a lump to the index. The path hash is updated immediately; if paths
+     * must be unique, a lump with the same path is pruned.
      *
      * @param lump  Lump to be being added.
      */
     void catalogLump(File1 &lump);
 
     /**
-     * Prune all lumps catalogued from @a file.
+     * Prune all lumps catalogued from @a file. Lumps catalogued after the ones in
+     * @a file are renumbered.
      *
      * @param file  File containing the lumps to prune
      *
@@ -83,6 +83,14 @@ public:
      */
     bool identifyPackages() const;
 
+    /**
+     * Fetches the bundle's metadata from the metadata bank, or analyzes the contents
+     * of the bundle if the metadata has not been cached. Bundles that are not nested
+     * inside other bundles or packages can be prepared in parallel before they are
+     * identified. Does nothing for nested bundles.
+     */
+    void prepareMetadata() const;
+
     /**
      * Determines if the data bundle has been identified and now available as a package
      * link.
@@ -0,0 +1,92 @@
+/** @file tickprofiler.h  Timing of world simulation subsystems.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_WORLD_TICKPROFILER_H
+#define LIBDOOMSDAY_WORLD_TICKPROFILER_H
+
+#include "../libdoomsday.h"
+
+#include <de/Record>
+#include <chrono>
+
+namespace world {
+
+/**
+ * Accumulates the time spent in subsystems of the world simulation. Both the
+ * engine and the game plugins report their sections here, so that the cost of
+ * game tics can be benchmarked without rendering.
+ *
+ * Profiling is disabled by default. While disabled, a measured section only
+ * checks a flag. The game tics are run in the main thread.
+ */
+class LIBDOOMSDAY_PUBLIC TickProfiler
+{
+public:
+    enum Section
+    {
+        Thinkers,   ///< All thinkers; includes the other game sections.
+        Movement,   ///< Moving map objects (P_TryMove).
+        Sight,      ///< Line of sight checks.
+        XG,         ///< XG line and sector thinkers.
+        ACS,        ///< ACS script interpreters.
+        Planes,     ///< Adjusting mobjs to sector plane height changes.
+        Deltas,     ///< Generating server frame deltas.
+
+        SectionCount
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /// Clears all the accumulated times.
+    static void reset();
+
+    static char const *sectionName(Section section);
+
+    /// Total time spent in a section, in seconds.
+    static double seconds(Section section);
+
+    /// Number of times a section has been entered.
+    static de::duint64 count(Section section);
+
+    /**
+     * Composes a record of the results, with one subrecord per section.
+     */
+    static de::Record results();
+
+    /**
+     * Measures the time spent in a section during the lifetime of the object.
+     * Nested measurements of the same section are counted only once.
+     */
+    class LIBDOOMSDAY_PUBLIC Scope
+    {
+    public:
+        Scope(Section section);
+        ~Scope();
+
+    private:
+        Section _section;
+        bool _counted;  ///< Included in the nesting depth.
+        bool _active;   ///< Outermost measurement of the section.
+        std::chrono::steady_clock::time_point _startedAt;
+    };
+};
+
+} // namespace world
+
+#endif // LIBDOOMSDAY_WORLD_TICKPROFILER_H
@@ -24,7 +24,6 @@
  */
 
 #include "doomsday/filesys/lumpindex.h"
-#include <QBitArray>
 #include <QHash>
 #include <QVector>
 #include <de/LogBuffer>
@@ -32,28 +31,14 @@
 namespace de {
 namespace internal
 {
-    struct LumpSortInfo
+    static inline File1 const *containerOf(File1 const &lump)
     {
-        File1 const *lump;
-        String path;
-        int origIndex;
-    };
+        return lump.isContained()? &lump.container() : nullptr;
+    }
 
-    static int lumpSorter(void const *a, void const *b)
+    static inline uint loadOrderOf(File1 const &lump)
     {
-        LumpSortInfo const *infoA = (LumpSortInfo const *)a;
-        LumpSortInfo const *infoB = (LumpSortInfo const *)b;
-
-        if (int delta = infoA->path.compare(infoB->path, Qt::CaseInsensitive))
-            return delta;
-
-        // Still matched; try the file load order indexes.
-        if (int delta = (infoA->lump->container().loadOrderIndex() -
-                         infoB->lump->container().loadOrderIndex()))
-            return delta;
-
-        // Still matched (i.e., present in the same package); use the original indexes.
-        return (infoB->origIndex - infoA->origIndex);
+        return lump.isContained()? lump.container().loadOrderIndex() : 0;
     }
 
 } // namespace internal
@@ -323,171 +308,229 @@ DENG2_PIMPL(LumpIndex)
     bool pathsAreUnique;
 
     Lumps lumps;
-    bool needPruneDuplicateLumps;
 
-    /// Stores indexes into records forming a chain of PathTree::Node fragment
-    /// hashes. For ultra-fast lookup by path.
-    struct PathHashRecord
+    /// Consecutive lumps catalogued from the same container.
+    struct LumpRange
+    {
+        lumpnum_t first;
+        int count;
+    };
+    typedef QList<LumpRange> LumpRanges;
+    QHash<File1 const *, LumpRanges> lumpsByFile;
+
+    /// Open-addressed (linear probing) hash of lump name hashes, for ultra-fast
+    /// lookup by path. Maintained incrementally as lumps come and go.
+    struct PathHashSlot
     {
-        lumpnum_t head, nextInLoadOrder;
+        Path::hash_type key;
+        lumpnum_t lumpNum; ///< @c -1 if the slot is empty.
     };
-    typedef QVector<PathHashRecord> PathHash;
-    QScopedPointer<PathHash> lumpsByPath;
+    typedef QVector<PathHashSlot> PathHash;
+    PathHash lumpsByPath;  ///< Size is a power of two.
+    int lumpsByPathCount;
 
     Impl(Public *i)
         : Base(i)
-        , pathsAreUnique         (false)
-        , needPruneDuplicateLumps(false)
+        , pathsAreUnique  (false)
+        , lumpsByPathCount(0)
     {}
 
     ~Impl() { self().clear(); }
 
-    void buildLumpsByPathIfNeeded()
+    static inline Path::hash_type keyFor(File1 const &lump)
     {
-        if (!lumpsByPath.isNull()) return;
+        return lump.directoryNode().hash();
+    }
 
-        int const numElements = lumps.size();
-        lumpsByPath.reset(new PathHash(numElements));
+    inline int hashMask() const
+    {
+        return lumpsByPath.size() - 1;
+    }
 
-        // Clear the chains.
-        DENG2_FOR_EACH(PathHash, i, *lumpsByPath)
-        {
-            i->head = -1;
-        }
+    void rebuildLumpsByPath()
+    {
+        int capacity = 64;
+        while (capacity < lumps.size() * 2) capacity <<= 1;
 
-        // Prepend nodes to each chain, in first-to-last load order, so that
-        // the last lump with a given name appears first in the chain.
-        for (int i = 0; i < numElements; ++i)
+        lumpsByPath.fill(PathHashSlot{0, -1}, capacity);
+        lumpsByPathCount = 0;
+        for (int i = 0; i < lumps.size(); ++i)
         {
-            File1 const &lump          = *(lumps[i]);
-            PathTree::Node const &node = lump.directoryNode();
-            ushort k = node.hash() % (unsigned)numElements;
-
-            (*lumpsByPath)[i].nextInLoadOrder = (*lumpsByPath)[k].head;
-            (*lumpsByPath)[k].head = i;
+            insertIntoHash(i, keyFor(*lumps[i]));
         }
 
         LOG_RES_XVERBOSE("Rebuilt hashMap for LumpIndex %p", thisPublic);
     }
 
-    /**
-     * @param pruneFlags  Passed by reference to avoid deep copy on value-write.
-     * @param file        Flag only those lumps contained by this file.
-     *
-     * @return Number of lumps newly flagged during this op.
-     */
-    int flagContainedLumps(QBitArray &pruneFlags, File1 &file)
+    void insertIntoHash(lumpnum_t lumpNum, Path::hash_type key)
     {
-        DENG2_ASSERT(pruneFlags.size() == lumps.size());
+        int const mask = hashMask();
+        int slot = key & mask;
+        while (lumpsByPath[slot].lumpNum >= 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        lumpsByPath[slot] = PathHashSlot{key, lumpNum};
+        lumpsByPathCount += 1;
+    }
 
-        int const numRecords = lumps.size();
-        int numFlagged = 0;
-        for (int i = 0; i < numRecords; ++i)
+    void removeFromHash(lumpnum_t lumpNum, Path::hash_type key)
+    {
+        int const mask = hashMask();
+        int slot = key & mask;
+        while (lumpsByPath[slot].lumpNum != lumpNum)
         {
-            File1 *lump = lumps[i];
-            if (pruneFlags.testBit(i)) continue;
-            if (!lump->isContained() || &lump->container() != &file) continue;
-            pruneFlags.setBit(i, true);
-            numFlagged += 1;
+            DENG2_ASSERT(lumpsByPath[slot].lumpNum >= 0);
+            slot = (slot + 1) & mask;
         }
-        return numFlagged;
+
+        // Shift the following slots of the cluster backwards so that no probe
+        // sequence is broken by the resulting gap.
+        int gap = slot;
+        for (int next = (gap + 1) & mask; lumpsByPath[next].lumpNum >= 0; next = (next + 1) & mask)
+        {
+            int const home = lumpsByPath[next].key & mask;
+            // Can the entry be moved to the gap without passing its home slot?
+            if (((next - home) & mask) >= ((next - gap) & mask))
+            {
+                lumpsByPath[gap] = lumpsByPath[next];
+                gap = next;
+            }
+        }
+        lumpsByPath[gap].lumpNum = -1;
+        lumpsByPathCount -= 1;
     }
 
     /**
-     * @param pruneFlags  Passed by reference to avoid deep copy on value-write.
-     * @return Number of lumps newly flagged during this op.
+     * Calls @a func with the index of each lump whose path matches @a path, in no
+     * particular order.
      */
-    int flagDuplicateLumps(QBitArray &pruneFlags)
+    template <typename Func>
+    void forAllMatching(Path const &path, Func func) const
     {
-        DENG2_ASSERT(pruneFlags.size() == lumps.size());
+        if (lumpsByPath.isEmpty()) return;
 
-        // Any work to do?
-        if (!pathsAreUnique) return 0;
-        if (!needPruneDuplicateLumps) return 0;
+        Path::hash_type const key = path.lastSegment().hash();
+        int const mask = hashMask();
+        for (int slot = key & mask; lumpsByPath[slot].lumpNum >= 0; slot = (slot + 1) & mask)
+        {
+            PathHashSlot const &entry = lumpsByPath[slot];
+            if (entry.key != key) continue;
+            if (!lumps[entry.lumpNum]->directoryNode().comparePath(path, 0))
+            {
+                func(entry.lumpNum);
+            }
+        }
+    }
 
-        int const numRecords = lumps.size();
-        if (numRecords <= 1) return 0;
+    void appendLump(File1 &lump)
+    {
+        lumpnum_t const lumpNum = lumps.size();
+        lumps.append(&lump);
 
-        // Sort in descending load order for pruning.
-        LumpSortInfo *sortInfos = new LumpSortInfo[numRecords];
-        for (int i = 0; i < numRecords; ++i)
+        if ((lumpsByPathCount + 1) * 2 > lumpsByPath.size())
         {
-            LumpSortInfo &sortInfo = sortInfos[i];
-            File1 const *lump      = lumps[i];
-
-            sortInfo.lump      = lump;
-            sortInfo.path      = lump->composePath();
-            sortInfo.origIndex = i;
+            rebuildLumpsByPath(); // Includes the new lump.
         }
-        qsort(sortInfos, numRecords, sizeof(*sortInfos), lumpSorter);
-
-        // Flag the lumps we'll be pruning.
-        int numFlagged = 0;
-        for (int i = 1; i < numRecords; ++i)
+        else
         {
-            if (pruneFlags.testBit(i)) continue;
-            if (sortInfos[i - 1].path.compare(sortInfos[i].path, Qt::CaseInsensitive)) continue;
-            pruneFlags.setBit(sortInfos[i].origIndex, true);
-            numFlagged += 1;
+            insertIntoHash(lumpNum, keyFor(lump));
         }
 
-        // We're done with the sort info.
-        delete[] sortInfos;
-
-        return numFlagged;
+        LumpRanges &ranges = lumpsByFile[containerOf(lump)];
+        if (!ranges.isEmpty() && ranges.last().first + ranges.last().count == lumpNum)
+        {
+            ranges.last().count += 1;
+        }
+        else
+        {
+            ranges.append(LumpRange{lumpNum, 1});
+        }
     }
 
-    /// @return Number of pruned lumps.
-    int pruneFlaggedLumps(QBitArray flaggedLumps)
+    /**
+     * Removes a range of lumps from the list and the hash. The ranges of the files
+     * are not updated, except for moving the ranges that follow the removed lumps.
+     */
+    void removeLumps(lumpnum_t first, int count)
     {
-        DENG2_ASSERT(flaggedLumps.size() == lumps.size());
-
-        // Have we lumps to prune?
-        int const numFlaggedForPrune = flaggedLumps.count(true);
-        if (numFlaggedForPrune)
+        for (lumpnum_t i = first; i < first + count; ++i)
         {
-            // We'll need to rebuild the hash after this.
-            lumpsByPath.reset();
+            removeFromHash(i, keyFor(*lumps[i]));
+        }
+        lumps.erase(lumps.begin() + first, lumps.begin() + first + count);
 
-            int numRecords = lumps.size();
-            if (numRecords == numFlaggedForPrune)
+        // Usually the most recently loaded file is the one being removed. Otherwise
+        // the following lumps (and their ranges) move back.
+        if (first < lumps.size())
+        {
+            for (PathHashSlot &slot : lumpsByPath)
             {
-                lumps.clear();
+                if (slot.lumpNum >= first + count) slot.lumpNum -= count;
             }
-            else
+            for (LumpRanges &ranges : lumpsByFile)
             {
-                // Do this one lump at a time, respecting the possibly-sorted order.
-                for (int i = 0, newIdx = 0; i < numRecords; ++i)
+                for (LumpRange &range : ranges)
                 {
-                    if (!flaggedLumps.testBit(i))
-                    {
-                        ++newIdx;
-                        continue;
-                    }
-
-                    // Move the info for the lump to be pruned to the end.
-                    lumps.move(newIdx, lumps.size() - 1);
+                    if (range.first >= first + count) range.first -= count;
                 }
-
-                // Erase the pruned lumps from the end of the list.
-                int firstPruned = lumps.size() - numFlaggedForPrune;
-                lumps.erase(lumps.begin() + firstPruned, lumps.end());
             }
         }
-        return numFlaggedForPrune;
     }
 
-    void pruneDuplicatesIfNeeded()
+    /// @return Number of pruned lumps.
+    int pruneFile(File1 const &file)
     {
-        if (!needPruneDuplicateLumps) return;
-        needPruneDuplicateLumps = false;
+        auto found = lumpsByFile.find(&file);
+        if (found == lumpsByFile.end()) return 0;
 
-        int const numRecords = lumps.size();
-        if (numRecords <= 1) return;
+        LumpRanges const ranges = found.value();
+        lumpsByFile.erase(found);
 
-        QBitArray pruneFlags(numRecords);
-        flagDuplicateLumps(pruneFlags);
-        pruneFlaggedLumps(pruneFlags);
+        // From last to first, so that the earlier ranges don't move.
+        int numPruned = 0;
+        for (int i = ranges.size() - 1; i >= 0; --i)
+        {
+            removeLumps(ranges[i].first, ranges[i].count);
+            numPruned += ranges[i].count;
+        }
+        return numPruned;
+    }
+
+    void pruneLump(lumpnum_t lumpNum)
+    {
+        File1 const *container = containerOf(*lumps[lumpNum]);
+        LumpRanges &ranges = lumpsByFile[container];
+        for (int i = 0; i < ranges.size(); ++i)
+        {
+            LumpRange &range = ranges[i];
+            if (lumpNum >= range.first && lumpNum < range.first + range.count)
+            {
+                // The rest of the range moves back by one.
+                if (!--range.count) ranges.removeAt(i);
+                break;
+            }
+        }
+        if (ranges.isEmpty()) lumpsByFile.remove(container);
+
+        removeLumps(lumpNum, 1);
+    }
+
+    /**
+     * Finds a catalogued lump with the same path as @a lump.
+     */
+    lumpnum_t findDuplicate(File1 const &lump) const
+    {
+        String const path = lump.composePath();
+        lumpnum_t found = -1;
+        forAllMatching(Path(path), [this, &path, &found] (lumpnum_t i)
+        {
+            if (!lumps[i]->composePath().compare(path, Qt::CaseInsensitive))
+            {
+                found = i;
+            }
+        });
+        return found;
     }
 };
 
@@ -501,7 +544,6 @@ LumpIndex::~LumpIndex()
 
 bool LumpIndex::hasLump(lumpnum_t lumpNum) const
 {
-    d->pruneDuplicatesIfNeeded();
     return (lumpNum >= 0 && lumpNum < d->lumps.size());
 }
 
@@ -521,13 +563,11 @@ File1 &LumpIndex::lump(lumpnum_t lumpNum) const
 
 LumpIndex::Lumps const &LumpIndex::allLumps() const
 {
-    d->pruneDuplicatesIfNeeded();
     return d->lumps;
 }
 
 int LumpIndex::size() const
 {
-    d->pruneDuplicatesIfNeeded();
     return d->lumps.size();
 }
 
@@ -538,72 +578,47 @@ int LumpIndex::lastIndex() const
 
 int LumpIndex::pruneByFile(File1 &file)
 {
-    if (d->lumps.empty()) return 0;
-
-    int const numRecords = d->lumps.size();
-    QBitArray pruneFlags(numRecords);
-
-    // We may need to prune path-duplicate lumps. We'll fold those into this
-    // op as pruning may result in reallocations.
-    d->flagDuplicateLumps(pruneFlags);
-
-    // Flag the lumps we'll be pruning.
-    int numFlaggedForFile = d->flagContainedLumps(pruneFlags, file);
-
-    // Perform the prune.
-    d->pruneFlaggedLumps(pruneFlags);
-
-    d->needPruneDuplicateLumps = false;
-
-    return numFlaggedForFile;
+    return d->pruneFile(file);
 }
 
 bool LumpIndex::pruneLump(File1 &lump)
 {
-    if (d->lumps.empty()) return 0;
-
-    d->pruneDuplicatesIfNeeded();
-
-    // Prune this lump.
-    if (!d->lumps.removeOne(&lump)) return false;
-
-    // We'll need to rebuild the path hash chains.
-    d->lumpsByPath.reset();
+    lumpnum_t const lumpNum = d->lumps.indexOf(&lump);
+    if (lumpNum < 0) return false;
 
+    d->pruneLump(lumpNum);
     return true;
 }
 
 void LumpIndex::catalogLump(File1 &lump)
 {
-    d->lumps.push_back(&lump);
-    d->lumpsByPath.reset();    // We'll need to rebuild the path hash chains.
-
     if (d->pathsAreUnique)
     {
-        // We may need to prune duplicate paths.
-        d->needPruneDuplicateLumps = true;
+        lumpnum_t const duplicate = d->findDuplicate(lump);
+        if (duplicate >= 0)
+        {
+            // Lumps from files loaded earlier take precedence. Within the same file
+            // the one catalogued last is kept.
+            if (loadOrderOf(*d->lumps[duplicate]) < loadOrderOf(lump)) return;
+
+            d->pruneLump(duplicate);
+        }
     }
+
+    d->appendLump(lump);
 }
 
 void LumpIndex::clear()
 {
     d->lumps.clear();
-    d->lumpsByPath.reset();
-    d->needPruneDuplicateLumps = false;
+    d->lumpsByFile.clear();
+    d->lumpsByPath.clear();
+    d->lumpsByPathCount = 0;
 }
 
 bool LumpIndex::catalogues(File1 &file)
 {
-    d->pruneDuplicatesIfNeeded();
-
-    DENG2_FOR_EACH(Lumps, i, d->lumps)
-    {
-        File1 const &lump = **i;
-        if (&lump.container() == &file)
-            return true;
-    }
-
-    return false;
+    return d->lumpsByFile.contains(&file);
 }
 
 bool LumpIndex::contains(Path const &path) const
@@ -617,78 +632,38 @@ int LumpIndex::findAll(Path const &path, FoundIndices &found) const
 
     found.clear();
 
-    if (path.isEmpty() || d->lumps.empty()) return 0;
-
-    d->pruneDuplicatesIfNeeded();
-    d->buildLumpsByPathIfNeeded();
+    if (path.isEmpty()) return 0;
 
-    // Perform the search.
-    DENG2_ASSERT(!d->lumpsByPath.isNull());
-    ushort hash = path.lastSegment().hash() % d->lumpsByPath->size();
-    for (int idx = (*d->lumpsByPath)[hash].head; idx != -1;
-        idx = (*d->lumpsByPath)[idx].nextInLoadOrder)
+    d->forAllMatching(path, [&found] (lumpnum_t idx)
     {
-        File1 const &lump          = *d->lumps[idx];
-        PathTree::Node const &node = lump.directoryNode();
-
-        if (!node.comparePath(path, 0))
-        {
-            found.push_front(idx);
-        }
-    }
+        found.push_back(idx);
+    });
+    found.sort(); // In load order.
 
     return int(found.size());
 }
 
 lumpnum_t LumpIndex::findLast(Path const &path) const
 {
-    if (path.isEmpty() || d->lumps.empty()) return -1;
+    if (path.isEmpty()) return -1;
 
-    d->pruneDuplicatesIfNeeded();
-    d->buildLumpsByPathIfNeeded();
-
-    // Perform the search.
-    DENG2_ASSERT(!d->lumpsByPath.isNull());
-    ushort hash = path.lastSegment().hash() % d->lumpsByPath->size();
-    for (int idx = (*d->lumpsByPath)[hash].head; idx != -1;
-        idx = (*d->lumpsByPath)[idx].nextInLoadOrder)
+    lumpnum_t latest = -1; // Not found.
+    d->forAllMatching(path, [&latest] (lumpnum_t idx)
     {
-        File1 const &lump          = *d->lumps[idx];
-        PathTree::Node const &node = lump.directoryNode();
-
-        if (!node.comparePath(path, 0))
-        {
-            return idx; // This is the lump we are looking for.
-        }
-    }
-
-    return -1; // Not found.
+        latest = de::max(latest, idx);
+    });
+    return latest;
 }
 
 lumpnum_t LumpIndex::findFirst(Path const &path) const
 {
-    if (path.isEmpty() || d->lumps.empty()) return -1;
-
-    d->pruneDuplicatesIfNeeded();
-    d->buildLumpsByPathIfNeeded();
+    if (path.isEmpty()) return -1;
 
     lumpnum_t earliest = -1; // Not found.
-
-    // Perform the search.
-    DENG2_ASSERT(!d->lumpsByPath.isNull());
-    ushort hash = path.lastSegment().hash() % d->lumpsByPath->size();
-    for (int idx = (*d->lumpsByPath)[hash].head; idx != -1;
-        idx = (*d->lumpsByPath)[idx].nextInLoadOrder)
+    d->forAllMatching(path, [&earliest] (lumpnum_t idx)
     {
-        File1 const &lump          = *d->lumps[idx];
-        PathTree::Node const &node = lump.directoryNode();
-
-        if (!node.comparePath(path, 0))
-        {
-            earliest = idx; // This is now the first lump loaded.
-        }
-    }
-
+        if (earliest < 0 || idx < earliest) earliest = idx;
+    });
     return earliest;
 }
 
@@ -30,6 +30,8 @@
 
 #include <QList>
 #include <QSet>
+#include <QThread>
+#include <atomic>
 
 using namespace de;
 
@@ -103,6 +105,38 @@ DENG2_PIMPL(Bundles)
         return bundle;
     }
 
+    /**
+     * Prepares the metadata of the pending bundles in parallel. The calling thread
+     * participates so that progress is made even if no other threads are available.
+     */
+    void prepareAddedDataBundles()
+    {
+        QList<DataBundle const *> pending;
+        {
+            DENG2_GUARD(this);
+            pending = bundlesToIdentify.toList();
+        }
+        if (pending.isEmpty()) return;
+
+        std::atomic_int next(0);
+        auto prepare = [&pending, &next] ()
+        {
+            for (int i = next++; i < pending.size(); i = next++)
+            {
+                pending.at(i)->prepareMetadata();
+            }
+        };
+
+        TaskPool helpers;
+        int const helperCount = de::min(QThread::idealThreadCount() - 1, pending.size() - 1);
+        for (int i = 0; i < helperCount; ++i)
+        {
+            helpers.start(prepare, TaskPool::MediumPriority);
+        }
+        prepare();
+        helpers.waitForDone();
+    }
+
     bool identifyAddedDataBundles()
     {
         Folder::waitForPopulation();
@@ -113,6 +147,10 @@ DENG2_PIMPL(Bundles)
         int  count         = 0;
         Time startedAt;
 
+        // Analyzing the contents is the slow part. Linking the packages is then
+        // done one bundle at a time.
+        prepareAddedDataBundles();
+
         while (auto const *bundle = nextToIdentify())
         {
             ++count;
@@ -203,7 +241,8 @@ de::Info const &Bundles::identityRegistry() const
 Bundles::BlockElements Bundles::formatEntries(DataBundle::Format format) const
 {
     d->parseRegistry();
-    return d->formatEntries[format];
+    DENG2_GUARD(d);
+    return d->formatEntries.value(format);
 }
 
 void Bundles::identify()
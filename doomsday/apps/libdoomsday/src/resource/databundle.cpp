@@ -82,6 +82,8 @@ DENG2_PIMPL(DataBundle), public Lockable
     String packageId; // linked under /sys/bundles/
     String versionedPackageId;
     std::unique_ptr<res::LumpDirectory> lumpDir;
+    std::unique_ptr<Record> metadata; // fetched from cache or built
+    bool cacheChecked = false;
     SafePtr<LinkFile> pkgLink;
 
     Impl(Public *i, Format fmt) : Base(i), format(fmt)
@@ -114,30 +116,14 @@ DENG2_PIMPL(DataBundle), public Lockable
         // It is sufficient to identify each bundle only once.
         if (ignored || !packageId.isEmpty()) return false;
 
-        // Load the lump directory of WAD files.
-        if (format == Wad || format == Pwad || format == Iwad)
+        if (isWad())
         {
-            // The lump directory needs to be loaded before matching against known
-            // bundles because it can be used for identification.
-            lumpDir.reset(new res::LumpDirectory(source->as<ByteArrayFile>()));
-            if (!lumpDir->isValid())
+            // The WAD type is known if the metadata has been cached. Otherwise, the
+            // lump directory needs to be loaded to determine it.
+            if (!metadata && !fetchCachedMetadata() && !lumpDir)
             {
-                throw FormatError("DataBundle::identify",
-                                  dynamic_cast<File *>(thisPublic)->description() +
-                                  ": file contents may be corrupted " DENG2_CHAR_MDASH
-                                  " WAD lump directory was not found");
+                loadLumpDirectory();
             }
-
-            // Determine the WAD type, if unspecified.
-            format = (lumpDir->type() == res::LumpDirectory::Pwad? Pwad : Iwad);
-
-            /*
-            qDebug() << self().description()
-                     << "format:" << (lumpDir->type()==res::LumpDirectory::Pwad? "PWAD" : "IWAD")
-                     << "\nfileName:" << source->name()
-                     << "\nfileSize:" << source->size()
-                     << "\nlumpDirCRC32:" << QString::number(lumpDir->crc32(), 16).toLatin1();
-            */
         }
         else if (!self().containerPackageId().isEmpty())
         {
@@ -193,7 +179,7 @@ DENG2_PIMPL(DataBundle), public Lockable
             }
         }
 
-        Record const meta = cachedMetadata();
+        Record const &meta = cachedMetadata();
         packageId = meta.gets(Package::VAR_ID);
         versionedPackageId = packageId;
 
@@ -209,9 +195,9 @@ DENG2_PIMPL(DataBundle), public Lockable
             pkgLink.reset(&bundleFolder().add(LinkFile::newLinkToFile(self().asFile(), chosen.path)));
 
             // Set up package metadata in the link.
-            Record &metadata = Package::initializeMetadata(*pkgLink, packageId);
-            metadata.copyMembersFrom(meta);
-            metadata.set(VAR_VERSION, !chosen.version.isEmpty()? chosen.version : "0.0");
+            Record &pkgMeta = Package::initializeMetadata(*pkgLink, packageId);
+            pkgMeta.copyMembersFrom(meta);
+            pkgMeta.set(VAR_VERSION, !chosen.version.isEmpty()? chosen.version : "0.0");
 
             // Compose a versioned ID.
             if (!chosen.version.isEmpty())
@@ -219,7 +205,7 @@ DENG2_PIMPL(DataBundle), public Lockable
                 versionedPackageId += "_" + chosen.version;
             }
 
-            LOG_RES_VERBOSE("Generated package:\n%s") << metadata.asText();
+            LOG_RES_VERBOSE("Generated package:\n%s") << pkgMeta.asText();
 
             App::fileSystem().index(*pkgLink);
 
@@ -247,7 +233,7 @@ DENG2_PIMPL(DataBundle), public Lockable
                          << "(" << container->d->pkgLink->objectNamespace().gets("package.tags", "") << ") "
                          << subset << " "
                          << versionedPackageId
-                         << " (" << metadata.gets("tags", "") << ") from "
+                         << " (" << pkgMeta.gets("tags", "") << ") from "
                          << self().asFile().path();
                 */
                 //Package::addRequiredPackage(containerFile, versionedPackageId);
@@ -262,15 +248,76 @@ DENG2_PIMPL(DataBundle), public Lockable
     }
 
     /**
-     * Fetches cached data bundle metadata from the metadata bank, or rebuilds the
-     * metadata if the cached data is missing or invalid. Updated metadata is saved
-     * in the metadata bank.
-     *
-     * @return Bundle metadata.
+     * Prepares the metadata of a bundle that is not inside another bundle or
+     * package. This can be done in a background thread, independently of other
+     * bundles. identify() uses the prepared metadata.
      */
-    Record cachedMetadata()
+    void prepareMetadata()
+    {
+        DENG2_GUARD(this);
+
+        if (ignored || !packageId.isEmpty() || metadata) return;
+
+        // Nested bundles depend on their container being identified first.
+        if (self().containerBundle() || !self().containerPackageId().isEmpty() ||
+            isAutoLoaded())
+        {
+            return;
+        }
+        cachedMetadata();
+    }
+
+    bool isWad() const
+    {
+        return format == Wad || format == Pwad || format == Iwad;
+    }
+
+    void loadLumpDirectory()
+    {
+        // Only a valid directory is kept, so that a failed load is retried (and
+        // reported) by identify() instead of being mistaken for a loaded one.
+        std::unique_ptr<res::LumpDirectory> dir(new res::LumpDirectory(source->as<ByteArrayFile>()));
+        if (!dir->isValid())
+        {
+            throw FormatError("DataBundle::identify",
+                              dynamic_cast<File *>(thisPublic)->description() +
+                              ": file contents may be corrupted " DENG2_CHAR_MDASH
+                              " WAD lump directory was not found");
+        }
+
+        lumpDir = std::move(dir);
+
+        // Determine the WAD type, if unspecified.
+        format = (lumpDir->type() == res::LumpDirectory::Pwad? Pwad : Iwad);
+    }
+
+    /**
+     * Returns the WAD lump directory, loading it if necessary. The lump directory is
+     * not loaded during identification if the bundle's metadata was cached.
+     */
+    res::LumpDirectory const *lumpDirectory()
+    {
+        DENG2_GUARD(this);
+        if (!lumpDir && isWad())
+        {
+            try
+            {
+                loadLumpDirectory();
+            }
+            catch (Error const &er)
+            {
+                LOG_RES_WARNING("%s") << er.asText();
+            }
+        }
+        return lumpDir.get();
+    }
+
+    /**
+     * The metadata bank key of the bundle. The file's meta ID is based on its path,
+     * size, and modification time.
+     */
+    Block metadataId() const
     {
-        Record meta;
         Block metaId = self().asFile().metaId();
 
         // Include container in the meta ID.
@@ -278,39 +325,88 @@ DENG2_PIMPL(DataBundle), public Lockable
         {
             metaId = Block(metaId + container->asFile().metaId()).md5Hash();
         }
+        return metaId;
+    }
 
+    /**
+     * Looks up the bundle's metadata in the metadata bank. WAD types are cached
+     * along with the metadata so that the lump directory does not need to be read.
+     *
+     * @return @c true, if cached metadata was found.
+     */
+    bool fetchCachedMetadata()
+    {
+        cacheChecked = true;
         try
         {
             // Maybe we already have this?
-            if (Block cached = MetadataBank::get().check(CACHE_CATEGORY, metaId))
+            if (Block cached = MetadataBank::get().check(CACHE_CATEGORY, metadataId()))
             {
-                // Well, our work here has already been done.
                 cached = cached.decompressed();
-                Reader(cached).withHeader() >> meta;
-                return meta;
+
+                std::unique_ptr<Record> meta(new Record);
+                Reader reader(cached);
+                reader.withHeader() >> *meta;
+                if (reader.atEnd())
+                {
+                    // Cached with an older version, without the format.
+                    return false;
+                }
+                dbyte cachedFormat;
+                reader >> cachedFormat;
+                if (isWad())
+                {
+                    format = Format(cachedFormat);
+                }
+                // Well, our work here has already been done.
+                metadata.reset(meta.release());
+                return true;
             }
         }
         catch (Error const &er)
         {
             LOGDEV_RES_WARNING("Corrupt cached metadata: %s") << er.asText();
         }
+        return false;
+    }
 
-        meta = buildMetadata();
+    /**
+     * Fetches cached data bundle metadata from the metadata bank, or rebuilds the
+     * metadata if the cached data is missing or invalid. Updated metadata is saved
+     * in the metadata bank.
+     *
+     * @return Bundle metadata.
+     */
+    Record const &cachedMetadata()
+    {
+        if (metadata || (!cacheChecked && fetchCachedMetadata()))
+        {
+            return *metadata;
+        }
+
+        // The lump directory is used for matching against known bundles.
+        if (isWad() && !lumpDir)
+        {
+            loadLumpDirectory();
+        }
+
+        metadata.reset(new Record(buildMetadata()));
 
         // Now we can put it in the cache.
         {
             Block buf;
-            Writer(buf).withHeader() << meta;
-            MetadataBank::get().setMetadata(CACHE_CATEGORY, metaId, buf.compressed());
+            Writer(buf).withHeader() << *metadata << dbyte(format);
+            MetadataBank::get().setMetadata(CACHE_CATEGORY, metadataId(), buf.compressed());
         }
 
-        return meta;
+        return *metadata;
     }
 
     Record buildMetadata()
     {
         const String dataFilePath = self().asFile().path();
         const auto * container    = self().containerBundle();
+        String packageId;
 
         // Search for known data files in the bundle registry.
         res::Bundles::MatchResult matched = DoomsdayApp::bundles().match(self());
@@ -747,14 +843,15 @@ DENG2_PIMPL(DataBundle), public Lockable
         identifiedTag.clear();
 
         // Look for terms that refer to specific games.
-        static QList<std::pair<String, StringList>> terms;
-        if (terms.isEmpty())
-        {
+        // Bundles may be identified in parallel, so the list is initialized only once.
+        static QList<std::pair<String, StringList>> const terms = [] () {
+            QList<std::pair<String, StringList>> terms;
             terms << std::make_pair(String("doom2"),   StringList({ "\\b(doom2|doom 2|DoomII|Doom II|final\\s*doom|plutonia|tnt)\\b" }));
             terms << std::make_pair(String("doom"),    StringList({ "^doom$|\\bdoom[^ s2][^2d]\\b|\\bultimate\\s*doom\\b|\\budoom\\b" }));
             terms << std::make_pair(String("heretic"), StringList({ "\\b(jheretic|heretic)\\b", "\\b(d'sparil|serpent rider)\\b" }));
-            terms << std::make_pair(String("hexen"),   StringList({ "\\b(jhexen|hexen)\\b", "\\b(korax|mage|warrior|cleric)\\b" })); 
-        }
+            terms << std::make_pair(String("hexen"),   StringList({ "\\b(jhexen|hexen)\\b", "\\b(korax|mage|warrior|cleric)\\b" }));
+            return terms;
+        }();
         QHash<String, int> scores;
         for (auto i : terms) //= terms.constBegin(); i != terms.constEnd(); ++i)
         {
@@ -997,7 +1094,7 @@ DENG2_PIMPL(DataBundle), public Lockable
         return PathAndVersion();
     }
 
-    String guessCompatibleGame() const
+    String guessCompatibleGame()
     {
         if (!pkgLink) return String();
 
@@ -1022,6 +1119,7 @@ DENG2_PIMPL(DataBundle), public Lockable
             }
         }*/
 
+        auto const *lumpDir = lumpDirectory();
         res::LumpDirectory::MapType const mapType = lumpDir? lumpDir->mapType()
                                                            : res::LumpDirectory::None;
 
@@ -1219,6 +1317,21 @@ bool DataBundle::identifyPackages() const
     return false;
 }
 
+void DataBundle::prepareMetadata() const
+{
+    LOG_AS("DataBundle");
+    try
+    {
+        d->prepareMetadata();
+    }
+    catch (Error const &er)
+    {
+        // Will be retried (and reported) when identifying.
+        LOGDEV_RES_VERBOSE("Failed to prepare metadata for %s: %s")
+                << description() << er.asText();
+    }
+}
+
 bool DataBundle::isLinkedAsPackage() const
 {
     return bool(d->pkgLink);
@@ -1269,7 +1382,7 @@ String DataBundle::containerPackageId() const
 
 res::LumpDirectory const *DataBundle::lumpDirectory() const
 {
-    return d->lumpDir.get();
+    return d->lumpDirectory();
 }
 
 String DataBundle::guessCompatibleGame() const
@@ -0,0 +1,121 @@
+/** @file tickprofiler.cpp  Timing of world simulation subsystems.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "doomsday/world/tickprofiler.h"
+
+using namespace de;
+
+namespace world {
+
+static bool profilingEnabled = false;
+
+static struct SectionTimes
+{
+    duint64 nanoseconds = 0;
+    duint64 count       = 0;
+    int     depth       = 0;
+}
+sections[TickProfiler::SectionCount];
+
+void TickProfiler::setEnabled(bool enabled)
+{
+    profilingEnabled = enabled;
+}
+
+bool TickProfiler::isEnabled()
+{
+    return profilingEnabled;
+}
+
+void TickProfiler::reset()
+{
+    for (auto &sec : sections)
+    {
+        sec.nanoseconds = 0;
+        sec.count       = 0;
+    }
+}
+
+char const *TickProfiler::sectionName(Section section)
+{
+    static char const *names[SectionCount] = {
+        "thinkers",
+        "movement",
+        "sight",
+        "xg",
+        "acs",
+        "planes",
+        "deltas",
+    };
+    return names[section];
+}
+
+double TickProfiler::seconds(Section section)
+{
+    return double(sections[section].nanoseconds) / 1.0e9;
+}
+
+duint64 TickProfiler::count(Section section)
+{
+    return sections[section].count;
+}
+
+Record TickProfiler::results()
+{
+    Record rec;
+    for (int i = 0; i < SectionCount; ++i)
+    {
+        Section const sec = Section(i);
+        Record *result = new Record;
+        result->set("seconds", seconds(sec));
+        result->set("count", count(sec));
+        rec.add(sectionName(sec), result);
+    }
+    return rec;
+}
+
+TickProfiler::Scope::Scope(Section section)
+    : _section(section)
+    , _counted(profilingEnabled)
+    , _active(false)
+{
+    if (_counted)
+    {
+        _active = (sections[section].depth++ == 0);
+        if (_active)
+        {
+            _startedAt = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+TickProfiler::Scope::~Scope()
+{
+    if (!_counted) return;
+
+    auto &sec = sections[_section];
+    sec.depth--;
+    if (_active)
+    {
+        sec.nanoseconds += duint64(std::chrono::duration_cast<std::chrono::nanoseconds>
+                                   (std::chrono::steady_clock::now() - _startedAt).count());
+        sec.count++;
+    }
+}
+
+} // namespace world
@@ -165,6 +165,7 @@ typedef struct libcommon_config_s {
     byte            confirmQuickGameSave;
     byte            confirmRebornLoad;
     byte            loadLastSaveOnReborn;
+    byte            backgroundGameSave;
 
     // Multiplayer:
     char *          netEpisode;
@@ -0,0 +1,89 @@
+/** @file automapgeometry.h  Retained line geometry for AutomapWidget.
+ *
+ * @authors Copyright © 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef LIBCOMMON_UI_AUTOMAPGEOMETRY_H
+#define LIBCOMMON_UI_AUTOMAPGEOMETRY_H
+
+#include "doomsday.h"
+#include <QVector>
+#include <de/Vector>
+
+/**
+ * Vertex buffers for drawing the lines of an automap.
+ *
+ * Each line of the map is assigned an object list type (MOL_*) that determines
+ * its appearance. The lines of each type are collected into a buffer of
+ * DGL_LINES vertices that can be drawn with a single call. Lines can be
+ * updated individually; a buffer is rebuilt only when it is next requested
+ * after one of its lines has changed.
+ *
+ * AutomapGeometry does not access the map or GL, so it can be used headless.
+ * @ingroup ui
+ */
+class AutomapGeometry
+{
+public:
+    typedef QVector<dgl_ft2vertex_t> Vertices;
+
+public:
+    AutomapGeometry();
+
+    /**
+     * Removes all lines.
+     */
+    void clear();
+
+    /**
+     * Changes the number of lines. All lines are reset to not being drawn.
+     */
+    void resize(int lineCount);
+
+    int lineCount() const;
+
+    /**
+     * Updates a line.
+     *
+     * @param index       Index of the line.
+     * @param type        Object list type (MOL_*) of the line, or -1 if the line
+     *                    is not drawn.
+     * @param from        Start point of the line in map space.
+     * @param to          End point of the line in map space.
+     * @param withNormal  Also include a short tail showing the line's normal.
+     */
+    void setLine(int index, int type, de::Vector2d const &from, de::Vector2d const &to,
+                 bool withNormal = false);
+
+    /**
+     * Returns the object list type of a line, or -1 if the line is not drawn.
+     */
+    int lineType(int index) const;
+
+    /**
+     * Returns the DGL_LINES vertices of all the lines of an object list type.
+     * The texture coordinates of the vertices equal their map space positions.
+     *
+     * @param type  Object list type (MOL_*).
+     */
+    Vertices const &vertices(int type) const;
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+#endif  // LIBCOMMON_UI_AUTOMAPGEOMETRY_H
@@ -260,6 +260,18 @@ public:  /// @todo make private:
     void reset();
     void lineAutomapVisibilityChanged(Line const &line);
 
+    /**
+     * Notifies the automap that @a line may need to be drawn differently, for
+     * instance because its special has changed.
+     */
+    void lineAppearanceChanged(Line const &line);
+
+    /**
+     * Notifies the automap that the lines of @a sector may need to be drawn
+     * differently, for instance because the sector's floor height has changed.
+     */
+    void sectorAppearanceChanged(Sector &sector);
+
     void setMapBounds(coord_t lowX, coord_t hiX, coord_t lowY, coord_t hiY);
 
 // ---
@@ -133,6 +133,11 @@ void P_MobjInsertIntoTIDList(mobj_t *mo, int tid);
 
 mobj_t *P_FindMobjFromTID(int tid, int *searchPosition);
 
+/**
+ * Returns the number of mobjs that have the thing ID @a tid.
+ */
+int P_MobjCountWithTID(int tid);
+
 #endif // __JHEXEN__
 
 #ifdef __cplusplus
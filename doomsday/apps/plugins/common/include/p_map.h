@@ -158,6 +158,18 @@ void P_UseLines(player_t *player);
  */
 dd_bool P_ChangeSector(Sector *sector, int crush);
 
+/**
+ * Same as P_ChangeSector(), but only one plane of the sector has moved. Only
+ * the touching mobjs whose floor, ceiling, or dropoff may be affected by the
+ * move are adjusted; the outcome is otherwise the same.
+ *
+ * @param sector     The sector to check.
+ * @param crush      See P_ChangeSector().
+ * @param plane      The moved plane: PLN_FLOOR or PLN_CEILING.
+ * @param oldHeight  Height of the plane before it was moved.
+ */
+dd_bool P_ChangeSectorPlane(Sector *sector, int crush, int plane, coord_t oldHeight);
+
 /**
  * This is called by the engine when it needs to change sector heights without
  * consulting game logic first. Most commonly this occurs on clientside, where
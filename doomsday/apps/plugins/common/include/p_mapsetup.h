@@ -73,6 +73,18 @@ void P_SpawnAllMaterialOriginScrollers(void);
  */
 void P_SetLineAutomapVisibility(int player, int lineIdx, dd_bool visible);
 
+/**
+ * Notifies the automaps of all players that @a line may need to be drawn
+ * differently (e.g., its special has changed).
+ */
+void P_NotifyAutomapLineChanged(Line *line);
+
+/**
+ * Notifies the automaps of all players that the lines of @a sector may need to
+ * be drawn differently (e.g., its floor or ceiling height has changed).
+ */
+void P_NotifyAutomapSectorChanged(Sector *sector);
+
 struct xline_s *P_GetXLine(int idx);
 struct xline_s *P_ToXLine(Line *line);
 
@@ -25,6 +25,7 @@
 #ifdef __cplusplus
 #  include <de/Vector>
 #  include <doomsday/world/Material>
+#  include <set>
 #endif
 
 #ifdef __cplusplus
@@ -206,6 +207,12 @@ void XS_ChangePlaneMaterial(Sector &sector, bool ceiling, world_Material &newMat
 
 void XS_ChangePlaneColor(Sector &sector, bool ceiling, de::Vector3f const &newColor, bool isDelta = false);
 
+/**
+ * Returns the indices of the sectors whose XG type has the act tag @a tag, in
+ * ascending order. The index is kept up to date as sector types change.
+ */
+std::set<int> const &XS_SectorsWithActTag(int tag);
+
 #endif
 
 #endif // LIBCOMMON_XG_SECTORTYPE_H
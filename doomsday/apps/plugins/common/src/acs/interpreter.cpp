@@ -28,10 +28,13 @@
 #include "gamesession.h"
 #include "player.h"
 #include "p_map.h"
+#include "p_mapsetup.h"
 #include "p_saveg.h"
 #include "p_saveio.h"
 #include "p_sound.h"
 
+#include <doomsday/world/TickProfiler>
+
 using namespace de;
 
 namespace internal
@@ -728,6 +731,7 @@ namespace internal
         if(interp.line)
         {
             P_ToXLine(interp.line)->special = 0;
+            P_NotifyAutomapLineChanged(interp.line);
         }
         return Continue;
     }
@@ -1018,6 +1022,8 @@ namespace internal
                 xline->arg3 = arg3;
                 xline->arg4 = arg4;
                 xline->arg5 = arg5;
+
+                P_NotifyAutomapLineChanged(line);
             }
         }
 
@@ -1305,5 +1311,6 @@ int Interpreter::read(MapStateReader *msr)
 void acs_Interpreter_Think(acs_Interpreter *interp)
 {
     DENG2_ASSERT(interp);
+    world::TickProfiler::Scope profile(world::TickProfiler::ACS);
     reinterpret_cast<acs::Interpreter *>(interp)->think();
 }
@@ -23,9 +23,11 @@
 #include <de/App>
 #include <de/CommandLine>
 #include <de/ArrayValue>
+#include <de/Loop>
 #include <de/NumberValue>
 #include <de/RecordValue>
 #include <de/PackageLoader>
+#include <de/TaskPool>
 #include <de/Time>
 #include <de/TextValue>
 #include <de/ZipArchive>
@@ -51,6 +53,7 @@
 #include "p_sound.h"
 #include "p_tick.h"
 #include "r_common.h"
+#include <mutex>
 #if __JDOOM__
 #  include "doomv9mapstatereader.h"
 #endif
@@ -116,9 +119,35 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
 
     acs::System acscriptSys;  ///< The One acs::System instance.
 
+    /**
+     * Copy of the contents of a game state folder. The snapshot is taken on the game
+     * thread; packaging it into a .save happens in the background.
+     */
+    struct GameStateSnapshot
+    {
+        String path;                  ///< Destination .save package.
+        GameStateMetadata metadata;
+        QMap<String, Block> entries;  ///< Contents of the package, by path.
+        Block package;                ///< Serialized (compressed) package.
+        TimeSpan packagingTime;
+    };
+
+    /// Saves are double-buffered: one is packaged while the next one waits.
+    TaskPool saveTasks;
+    std::mutex saveMutex;
+    bool packaging = false;
+    GameStateSnapshot *pendingSave = nullptr;
+    QList<GameStateSnapshot *> packagedSaves;
+    LoopCallback mainCall;        ///< Pending calls are dropped if the session is deleted.
+
     Impl(Public *i) : Base(i)
     {}
 
+    ~Impl()
+    {
+        finishBackgroundSaves();
+    }
+
     inline String userSavePath(String const &fileName)
     {
         DENG_ASSERT(DoomsdayApp::currentGameProfile());
@@ -259,8 +288,12 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
     /**
      * Update/create a new GameStateFolder at the specified @a path from the current
      * game state.
+     *
+     * @param flush  Write the package to its source file. If @c false, the changes
+     *               only exist in memory until the package is flushed later.
      */
-    GameStateFolder &updateGameStateFolder(String const &path, GameStateMetadata const &metadata)
+    GameStateFolder &updateGameStateFolder(String const &path, GameStateMetadata const &metadata,
+                                           bool flush = true)
     {
         DENG2_ASSERT(self().hasBegun());
 
@@ -305,12 +338,178 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
         //DoomsdayApp::app().gameSessionWasSaved(self(), *saved);
         //self().setThinkerMapping(nullptr);
 
-        saved->flush();  // No need to populate; FS2 Files already in sync with source data.
+        if (flush)
+        {
+            saved->flush();  // No need to populate; FS2 Files already in sync with source data.
+        }
         saved->cacheMetadata(metadata);  // Avoid immediately reopening the .save package.
 
         return *saved;
     }
 
+    /**
+     * Copies the contents of @a folder into @a snapshot. Files recently written to the
+     * folder are still in memory, so this is little more than a memory copy.
+     */
+    static void copyContents(Folder const &folder, String const &prefix, GameStateSnapshot &snapshot)
+    {
+        folder.forContents([&prefix, &snapshot] (String name, File &file)
+        {
+            if (Folder const *sub = maybeAs<Folder>(file))
+            {
+                copyContents(*sub, prefix / name, snapshot);
+            }
+            else
+            {
+                Block data;
+                file >> data;
+                snapshot.entries.insert(prefix / name, data);
+            }
+            return LoopContinue;
+        });
+    }
+
+    /**
+     * Packages a snapshot into a .save archive. This is where the compression happens.
+     * Called in a background thread.
+     */
+    static void package(GameStateSnapshot &snapshot)
+    {
+        Time startedAt;
+        ZipArchive arch;
+        for (auto i = snapshot.entries.constBegin(); i != snapshot.entries.constEnd(); ++i)
+        {
+            arch.add(i.key(), i.value());
+        }
+        de::Writer(snapshot.package) << arch;
+        snapshot.entries.clear();
+        snapshot.packagingTime = startedAt.since();
+    }
+
+    /**
+     * Queues a snapshot for packaging. If a save to another destination is already
+     * waiting, the older saves are completed first; a waiting save to the same
+     * destination is superseded by the new one.
+     */
+    void beginBackgroundSave(GameStateSnapshot *snapshot)
+    {
+        std::unique_lock<std::mutex> lock(saveMutex);
+        if (pendingSave && pendingSave->path.compareWithoutCase(snapshot->path))
+        {
+            lock.unlock();
+            finishBackgroundSaves();
+            lock.lock();
+        }
+        delete pendingSave;
+        pendingSave = snapshot;
+        if (!packaging)
+        {
+            packaging = true;
+            saveTasks.start([this] () { packagePendingSaves(); }, TaskPool::MediumPriority);
+        }
+    }
+
+    /// Called in a background thread.
+    void packagePendingSaves()
+    {
+        for (;;)
+        {
+            GameStateSnapshot *snapshot;
+            {
+                std::lock_guard<std::mutex> g(saveMutex);
+                if (!pendingSave)
+                {
+                    packaging = false;
+                    return;
+                }
+                snapshot = pendingSave;
+                pendingSave = nullptr;
+            }
+            try
+            {
+                package(*snapshot);
+            }
+            catch (Error const &er)
+            {
+                LOG_RES_WARNING("Error packaging game state for \"%s\":\n")
+                        << snapshot->path << er.asText();
+                snapshot->package.clear();
+            }
+            {
+                std::lock_guard<std::mutex> g(saveMutex);
+                packagedSaves.append(snapshot);
+            }
+            // The file system is updated in the main thread.
+            if (!mainCall)
+            {
+                mainCall.enqueue([this] () { writePackagedSaves(); });
+            }
+        }
+    }
+
+    void writePackagedSaves()
+    {
+        QList<GameStateSnapshot *> packaged;
+        {
+            std::lock_guard<std::mutex> g(saveMutex);
+            packaged.swap(packagedSaves);
+        }
+        for (GameStateSnapshot *snapshot : packaged)
+        {
+            writePackage(*snapshot);
+            delete snapshot;
+        }
+    }
+
+    void writePackage(GameStateSnapshot const &snapshot)
+    {
+        LOG_AS("GameSession");
+
+        if (snapshot.package.isEmpty()) return; // Packaging failed.
+
+        try
+        {
+            Time startedAt;
+
+            AbstractSession::removeSaved(snapshot.path);
+
+            File &save = App::rootFolder().replaceFile(snapshot.path);
+            save << snapshot.package;
+            save.flush();
+
+            // We can now reinterpret and populate the contents of the archive.
+            auto &saved = save.reinterpret()->as<GameStateFolder>();
+            saved.populate();
+            saved.cacheMetadata(snapshot.metadata); // Avoid immediately reopening the .save package.
+
+            LOG_RES_VERBOSE("Saved \"%s\" (%i bytes): packaged in %.1f ms, written in %.1f ms")
+                    << snapshot.path << snapshot.package.size()
+                    << snapshot.packagingTime * 1000 << startedAt.since() * 1000;
+
+            P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
+
+            // Notify the engine that the game was saved.
+            /// @todo After the engine has the primary responsibility of saving the game,
+            /// this notification is unnecessary.
+            Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+        }
+        catch (Error const &er)
+        {
+            LOG_RES_WARNING("Error saving game session to '%s':\n")
+                    << snapshot.path << er.asText();
+        }
+    }
+
+    /**
+     * Blocks until all saves being written in the background have been completed.
+     * Must be called before accessing user .save packages.
+     */
+    void finishBackgroundSaves()
+    {
+        saveTasks.waitForDone();
+        writePackagedSaves();
+    }
+
 #if __JDOOM__ || __JDOOM64__
     /**
      * @todo fixme: (Kludge) Assumes the original mobj info tic timing values have
@@ -505,6 +704,9 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
 
     void loadSaved(String const &savePath)
     {
+        // The save may still be being written.
+        finishBackgroundSaves();
+
         ::briefDisabled = true;
 
         G_StopDemo();
@@ -1353,10 +1555,33 @@ void GameSession::save(String const &saveName, String const &userDescription)
 
     try
     {
+        Time startedAt;
+
         // Compose the session metadata.
         GameStateMetadata metadata = d->metadata();
         metadata.set("userDescription", chooseSaveDescription(savePath, userDescription));
 
+        if (cfg.common.backgroundGameSave)
+        {
+            // Update the existing internal .save package in memory only; it will be
+            // written when the package is next flushed.
+            GameStateFolder &saved = d->updateGameStateFolder(internalSavePath, metadata,
+                                                              false /*don't flush*/);
+
+            // In networked games the server tells the clients to save also.
+            NetSv_SaveGame(metadata.getui("sessionId"));
+
+            // The rest of the work is done in the background.
+            auto *snapshot = new Impl::GameStateSnapshot;
+            snapshot->path     = savePath;
+            snapshot->metadata = metadata;
+            Impl::copyContents(saved, "", *snapshot);
+            d->beginBackgroundSave(snapshot);
+
+            LOG_RES_VERBOSE("Game state snapshot took %.1f ms") << startedAt.since() * 1000;
+            return;
+        }
+
         // Update the existing internal .save package.
         d->updateGameStateFolder(internalSavePath, metadata);
 
@@ -1366,6 +1591,8 @@ void GameSession::save(String const &saveName, String const &userDescription)
         // Copy the internal saved session to the destination slot.
         AbstractSession::copySaved(savePath, internalSavePath);
 
+        LOG_RES_VERBOSE("Game saved in %.1f ms") << startedAt.since() * 1000;
+
         P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
 
         // Notify the engine that the game was saved.
@@ -1391,17 +1618,20 @@ void GameSession::load(String const &saveName)
 
 void GameSession::copySaved(String const &destName, String const &sourceName)
 {
+    d->finishBackgroundSaves();
     AbstractSession::copySaved(d->userSavePath(destName), d->userSavePath(sourceName));
     LOG_MSG("Copied savegame \"%s\" to \"%s\"") << sourceName << destName;
 }
 
 void GameSession::removeSaved(String const &saveName)
 {
+    d->finishBackgroundSaves();
     AbstractSession::removeSaved(d->userSavePath(saveName));
 }
 
 String GameSession::savedUserDescription(String const &saveName)
 {
+    d->finishBackgroundSaves();
     String const savePath = d->userSavePath(saveName);
     if (auto const *saved = App::rootFolder().tryLocate<GameStateFolder>(savePath))
     {
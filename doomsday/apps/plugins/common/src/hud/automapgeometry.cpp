@@ -0,0 +1,152 @@
+/** @file automapgeometry.cpp  Retained line geometry for AutomapWidget.
+ *
+ * @authors Copyright © 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "hud/automapgeometry.h"
+#include "hud/automapstyle.h"
+
+using namespace de;
+
+static dfloat const NORMAL_TAIL_LENGTH = 8;
+
+DENG2_PIMPL_NOREF(AutomapGeometry)
+{
+    struct LineData
+    {
+        dint type = -1;
+        Vector2f from;
+        Vector2f to;
+        bool withNormal = false;
+    };
+    QVector<LineData> lines;
+
+    struct Buffer
+    {
+        Vertices vertices;
+        bool needRebuild = false;
+    };
+    Buffer buffers[NUM_MAP_OBJECTLISTS];
+
+    void markForRebuild(dint type)
+    {
+        if (type >= 0 && type < NUM_MAP_OBJECTLISTS)
+        {
+            buffers[type].needRebuild = true;
+        }
+    }
+
+    static void addVertex(Vertices &verts, Vector2f const &pos)
+    {
+        dgl_ft2vertex_t vtx;
+        vtx.pos[0] = vtx.tex[0] = pos.x;
+        vtx.pos[1] = vtx.tex[1] = pos.y;
+        verts << vtx;
+    }
+
+    void rebuild(dint type)
+    {
+        Buffer &buf = buffers[type];
+        buf.vertices.clear();
+        for (LineData const &line : lines)
+        {
+            if (line.type != type) continue;
+
+            addVertex(buf.vertices, line.from);
+            addVertex(buf.vertices, line.to);
+
+            if (line.withNormal)
+            {
+                Vector2f const unit = (line.to - line.from).normalize();
+                Vector2f const normal(unit.y, -unit.x);
+                Vector2f const middle = (line.from + line.to) / 2;
+
+                addVertex(buf.vertices, middle);
+                addVertex(buf.vertices, middle + normal * NORMAL_TAIL_LENGTH);
+            }
+        }
+        buf.needRebuild = false;
+    }
+};
+
+AutomapGeometry::AutomapGeometry() : d(new Impl)
+{}
+
+void AutomapGeometry::clear()
+{
+    resize(0);
+}
+
+void AutomapGeometry::resize(dint lineCount)
+{
+    d->lines.clear();
+    d->lines.resize(lineCount);
+    for (dint i = 0; i < NUM_MAP_OBJECTLISTS; ++i)
+    {
+        d->buffers[i].vertices.clear();
+        d->buffers[i].needRebuild = false;
+    }
+}
+
+dint AutomapGeometry::lineCount() const
+{
+    return d->lines.size();
+}
+
+void AutomapGeometry::setLine(dint index, dint type, Vector2d const &from, Vector2d const &to,
+                              bool withNormal)
+{
+    DENG2_ASSERT(index >= 0 && index < d->lines.size());
+    DENG2_ASSERT(type >= -1 && type < NUM_MAP_OBJECTLISTS);
+
+    // Zero-length lines are not drawn.
+    if (from == to) type = -1;
+
+    Impl::LineData &line = d->lines[index];
+    if (line.type == -1 && type == -1) return;
+
+    Vector2f const fromf = from;
+    Vector2f const tof   = to;
+    if (line.type == type && line.from == fromf && line.to == tof && line.withNormal == withNormal)
+    {
+        return; // No change.
+    }
+
+    d->markForRebuild(line.type);
+    d->markForRebuild(type);
+
+    line.type       = type;
+    line.from       = fromf;
+    line.to         = tof;
+    line.withNormal = withNormal;
+}
+
+dint AutomapGeometry::lineType(dint index) const
+{
+    DENG2_ASSERT(index >= 0 && index < d->lines.size());
+    return d->lines.at(index).type;
+}
+
+AutomapGeometry::Vertices const &AutomapGeometry::vertices(dint type) const
+{
+    DENG2_ASSERT(type >= 0 && type < NUM_MAP_OBJECTLISTS);
+    if (d->buffers[type].needRebuild)
+    {
+        d->rebuild(type);
+    }
+    return d->buffers[type].vertices;
+}
@@ -21,7 +21,9 @@
 #include "common.h"
 #include "hud/widgets/automapwidget.h"
 
+#include <QBitArray>
 #include <QList>
+#include <QSet>
 #include <QtAlgorithms>
 #include <de/LogBuffer>
 #include <de/ScriptSystem>
@@ -31,6 +33,7 @@
 #include "g_common.h"
 #include "gamesession.h"
 #include "hu_stuff.h"
+#include "hud/automapgeometry.h"
 #include "hud/automapstyle.h"
 #include "p_mapsetup.h"
 #include "p_tick.h"
@@ -215,7 +218,9 @@ DENG2_PIMPL(AutomapWidget)
 
     float pixelRatio = 1.f; // DisplayMode.PIXEL_RATIO
 
-    //DGLuint lists[NUM_MAP_OBJECTLISTS];  ///< Each list contains one or more of given type of automap wi.
+    AutomapGeometry lineGeometry;        ///< Retained vertices of the map lines, per object list.
+    QBitArray subspaceLines;             ///< Lines of the map's subspaces (polyobj lines are excluded).
+    QSet<dint> changedLines;             ///< Lines whose geometry needs updating.
     bool needBuildLists = false;         ///< @c true= force a rebuild of all lists.
 
     dint flags = 0;
@@ -595,36 +600,37 @@ DENG2_PIMPL(AutomapWidget)
             //DGL_BlendMode(BM_NORMAL);
     }
 
-    void drawLine(Line *line) const
+    /**
+     * Determines the style of @a line in the automap.
+     *
+     * @param line          Map line.
+     * @param withDefaults  Include lines that have the default styles of the
+     *                      object lists. Otherwise only specially styled lines
+     *                      are considered.
+     *
+     * @return  Line style, or @c nullptr if the line is not drawn.
+     */
+    automapcfg_lineinfo_t const *lineStyle(Line *line, bool withDefaults) const
     {
         DENG2_ASSERT(line);
 
         xline_t *xline = P_ToXLine(line);
 
-        // Already drawn once?
-        if (xline->validCount == VALIDCOUNT)
-            return;
-
         // Is this line being drawn?
         if ((xline->flags & ML_DONTDRAW) && !(flags & AWF_SHOW_ALLLINES))
-            return;
+            return nullptr;
 
-        // We only want to draw twosided lines once.
-        auto *frontSector = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR);
-        if (frontSector && frontSector != (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR))
-        {
-            return;
-        }
+        Sector *frontSector = Line_FrontSector(line);
 
         automapcfg_lineinfo_t const *info = nullptr;
-        if ((flags & AWF_SHOW_ALLLINES) || xline->mapped[rs.plr - players])
+        if ((flags & AWF_SHOW_ALLLINES) || xline->mapped[self().player()])
         {
-            auto *backSector = reinterpret_cast<Sector *>(P_GetPtrp(line, DMU_BACK_SECTOR));
+            Sector *backSector = Line_BackSector(line);
 
             // Perhaps this is a specially colored line?
             info = style->tryFindLineInfo_special(xline->special, xline->flags,
                                                   frontSector, backSector, flags);
-            if (rs.obType != -1 && !info)
+            if (withDefaults && !info)
             {
                 // Perhaps a default colored line?
                 /// @todo Implement an option which changes the vanilla behavior of always
@@ -637,14 +643,14 @@ DENG2_PIMPL(AutomapWidget)
                 }
                 else
                 {
-                    if (!de::fequal(P_GetDoublep(backSector,  DMU_FLOOR_HEIGHT),
-                                    P_GetDoublep(frontSector, DMU_FLOOR_HEIGHT)))
+                    if (!de::fequal(Sector_FloorHeight(backSector),
+                                    Sector_FloorHeight(frontSector)))
                     {
                         // Floor level change.
                         info = style->tryFindLineInfo(AMO_FLOORCHANGELINE);
                     }
-                    else if (!de::fequal(P_GetDoublep(backSector,  DMU_CEILING_HEIGHT),
-                                         P_GetDoublep(frontSector, DMU_CEILING_HEIGHT)))
+                    else if (!de::fequal(Sector_CeilingHeight(backSector),
+                                         Sector_CeilingHeight(frontSector)))
                     {
                         // Ceiling level change.
                         info = style->tryFindLineInfo(AMO_CEILINGCHANGELINE);
@@ -656,7 +662,7 @@ DENG2_PIMPL(AutomapWidget)
                 }
             }
         }
-        else if (rs.obType != -1 && revealed)
+        else if (withDefaults && revealed)
         {
             if (!(xline->flags & ML_DONTDRAW))
             {
@@ -664,8 +670,23 @@ DENG2_PIMPL(AutomapWidget)
                 info = style->tryFindLineInfo(AMO_UNSEENLINE);
             }
         }
+        return info;
+    }
 
-        if (info && (rs.obType == -1 || info == &style->lineInfo(rs.obType)))
+    /**
+     * Draws the glow of @a line, if it has one.
+     */
+    void drawLineGlow(Line *line) const
+    {
+        DENG2_ASSERT(line);
+
+        xline_t *xline = P_ToXLine(line);
+
+        // Already drawn once?
+        if (xline->validCount == VALIDCOUNT)
+            return;
+
+        if (automapcfg_lineinfo_t const *info = lineStyle(line, false))
         {
             ddouble from[2]; P_GetDoublepv(P_GetPtrp(line, DMU_VERTEX0), DMU_XY, from);
             ddouble to  [2]; P_GetDoublepv(P_GetPtrp(line, DMU_VERTEX1), DMU_XY, to);
@@ -673,7 +694,7 @@ DENG2_PIMPL(AutomapWidget)
             drawLine2(Vector2d(from), Vector2d(to), Vector3f(info->rgba), info->rgba[3],
                       (xline->special && !cfg.common.automapShowDoors ? GLOW_NONE : info->glow),
                       info->glowStrength,
-                      info->glowSize, rs.glowOnly, info->scaleWithView,
+                      info->glowSize, true /*glow only*/, info->scaleWithView,
                       (info->glow && !(xline->special && !cfg.common.automapShowDoors)),
                       //(xline->special && !cfg.common.automapShowDoors ? BM_NORMAL : info->blendMode),
                       (flags & AWF_SHOW_LINE_NORMALS));
@@ -682,66 +703,131 @@ DENG2_PIMPL(AutomapWidget)
         }
     }
 
-    static int drawLineWorker(void *line, void *context)
+    /**
+     * Updates the retained geometry of the line with index @a lineIdx.
+     */
+    void updateLineGeometry(dint lineIdx)
     {
-        static_cast<Impl *>(context)->drawLine((Line *)line);
-        return false;  // Continue iteration.
+        if (!subspaceLines.testBit(lineIdx)) return;
+
+        auto *line = (Line *)P_ToPtr(DMU_LINE, lineIdx);
+
+        // Which object list does the line belong to, if any?
+        dint type = -1;
+        if (automapcfg_lineinfo_t const *info = lineStyle(line, true))
+        {
+            for (dint i = 0; i < NUM_MAP_OBJECTLISTS; ++i)
+            {
+                if (info == &style->lineInfo(i))
+                {
+                    type = i;
+                    break;
+                }
+            }
+        }
+
+        ddouble from[2]; P_GetDoublepv(P_GetPtrp(line, DMU_VERTEX0), DMU_XY, from);
+        ddouble to  [2]; P_GetDoublepv(P_GetPtrp(line, DMU_VERTEX1), DMU_XY, to);
+
+        lineGeometry.setLine(lineIdx, type, Vector2d(from), Vector2d(to),
+                             (flags & AWF_SHOW_LINE_NORMALS) != 0);
     }
 
-    static int drawLinesForSubspaceWorker(ConvexSubspace *subspace, void *context)
+    static int markSubspaceLineWorker(void *line, void *context)
     {
-        return P_Iteratep(subspace, DMU_LINE, drawLineWorker, context);
+        static_cast<Impl *>(context)->subspaceLines.setBit(P_ToIndex(line));
+        return false;  // Continue iteration.
     }
 
     /**
-     * Determines visible lines, draws them.
-     *
-     * @params objType  Type of map object being drawn.
+     * Brings the retained line geometry up to date. Everything is rebuilt if
+     * needed, otherwise only the changed lines are updated.
      */
-    void drawAllLines(dint obType, bool glowOnly = false) const
+    void updateAllLineGeometry()
     {
-        // VALIDCOUNT is used to track which lines have been drawn this frame.
-        VALIDCOUNT++;
-
-        // Configure render state:
-        rs.obType   = obType;
-        rs.glowOnly = glowOnly;
-
-        if (glowOnly)
+        if (needBuildLists || lineGeometry.lineCount() != numlines)
         {
-            rs.primType = DGL_QUADS;
-            DGL_Enable(DGL_TEXTURE0);
-            DGL_Bind(DGLuint(Get(DD_DYNLIGHT_TEXTURE)));
+            // Polyobj lines are drawn separately, so only the lines of the
+            // map's subspaces are included.
+            subspaceLines.fill(false, numlines);
+            dint const numSubspaces = P_Count(DMU_SUBSPACE);
+            for (dint i = 0; i < numSubspaces; ++i)
+            {
+                P_Iteratep(P_ToPtr(DMU_SUBSPACE, i), DMU_LINE, markSubspaceLineWorker, this);
+            }
+
+            lineGeometry.resize(numlines);
+            for (dint i = 0; i < numlines; ++i)
+            {
+                updateLineGeometry(i);
+            }
+            needBuildLists = false;
         }
         else
         {
-            rs.primType = DGL_LINES;
-            if (amMaskTexture)
+            for (dint lineIdx : changedLines)
             {
-                DGL_Enable(DGL_TEXTURE0);
-                DGL_Bind(amMaskTexture);
+                updateLineGeometry(lineIdx);
             }
         }
+        changedLines.clear();
+    }
 
-        DGL_Begin(rs.primType);
+    static int drawLineGlowWorker(void *line, void *context)
+    {
+        static_cast<Impl *>(context)->drawLineGlow((Line *)line);
+        return false;  // Continue iteration.
+    }
 
-        // Can we use the automap's in-view bounding box to cull out of view objects?
-        //if (!addToLists)
+    static int drawLineGlowsForSubspaceWorker(ConvexSubspace *subspace, void *context)
+    {
+        return P_Iteratep(subspace, DMU_LINE, drawLineGlowWorker, context);
+    }
+
+    /**
+     * Draws the lines of an object list using the retained geometry.
+     *
+     * @param obType  Object list type (MOL_*).
+     */
+    void drawAllLines(dint obType) const
+    {
+        if (amMaskTexture)
         {
-            AABoxd aaBox;
-            self().pvisibleBounds(&aaBox.minX, &aaBox.maxX, &aaBox.minY, &aaBox.maxY);
-            Subspace_BoxIterator(&aaBox, drawLinesForSubspaceWorker, const_cast<Impl *>(this));
+            DGL_Enable(DGL_TEXTURE0);
+            DGL_Bind(amMaskTexture);
         }
-        /*else
+
+        AutomapGeometry::Vertices const &verts = lineGeometry.vertices(obType);
+        if (!verts.isEmpty())
         {
-            // No. As the map lists are considered static we want them to contain all
-            // walls, not just those visible *now* (note rotation).
-            dint const numSubspaces = P_Count(DMU_SUBSPACE);
-            for (dint i = 0; i < numSubspaces; ++i)
-            {
-                P_Iteratep(P_ToPtr(DMU_SUBSPACE, i), DMU_LINE, drawLineWorker, const_cast<Impl *>(this));
-            }
-        }*/
+            DGL_Begin(DGL_LINES);
+            DGL_Vertices2ftv(verts.size(), verts.constData());
+            DGL_End();
+        }
+        DGL_Enable(DGL_TEXTURE0);
+    }
+
+    /**
+     * Determines visible lines, draws their glows.
+     */
+    void drawAllLineGlows() const
+    {
+        // VALIDCOUNT is used to track which lines have been drawn this frame.
+        VALIDCOUNT++;
+
+        // Configure render state:
+        rs.obType   = -1;
+        rs.glowOnly = true;
+        rs.primType = DGL_QUADS;
+        DGL_Enable(DGL_TEXTURE0);
+        DGL_Bind(DGLuint(Get(DD_DYNLIGHT_TEXTURE)));
+
+        DGL_Begin(rs.primType);
+
+        // Use the automap's in-view bounding box to cull out of view objects.
+        AABoxd aaBox;
+        self().pvisibleBounds(&aaBox.minX, &aaBox.maxX, &aaBox.minY, &aaBox.maxY);
+        Subspace_BoxIterator(&aaBox, drawLineGlowsForSubspaceWorker, const_cast<Impl *>(this));
 
         DGL_End();
         DGL_Enable(DGL_TEXTURE0);
@@ -1340,9 +1426,25 @@ void AutomapWidget::reset()
     d->rotate         = cfg.common.automapRotate;
 }
 
-void AutomapWidget::lineAutomapVisibilityChanged(Line const &)
+void AutomapWidget::lineAutomapVisibilityChanged(Line const &line)
 {
-    d->needBuildLists = true;
+    lineAppearanceChanged(line);
+}
+
+void AutomapWidget::lineAppearanceChanged(Line const &line)
+{
+    d->changedLines.insert(P_ToIndex(&line));
+}
+
+static int markLineChangedWorker(void *line, void *context)
+{
+    static_cast<AutomapWidget *>(context)->lineAppearanceChanged(*(Line *)line);
+    return false;  // Continue iteration.
+}
+
+void AutomapWidget::sectorAppearanceChanged(Sector &sector)
+{
+    P_Iteratep(&sector, DMU_LINE, markLineChangedWorker, this);
 }
 
 AutomapStyle *AutomapWidget::style() const
@@ -1426,10 +1528,11 @@ void AutomapWidget::draw(Vector2i const &offset) const
     }
 
     // Draw static map geometry.
+    d->updateAllLineGeometry();
     for (dint i = NUM_MAP_OBJECTLISTS-1; i >= 0; i--)
     {
         automapcfg_lineinfo_t const &info = d->style->lineInfo(i);
-        DGL_Color4f(info.rgba[0], info.rgba[1], info.rgba[2], info.rgba[3] * cfg.common.automapLineAlpha * alpha);
+        DGL_Color4f(info.rgba[0], info.rgba[1], info.rgba[2], info.rgba[3] * alpha);
         d->drawAllLines(i);
     }
 
@@ -1459,7 +1562,7 @@ void AutomapWidget::draw(Vector2i const &offset) const
     // Draw glows?
     if (cfg.common.automapShowDoors)
     {
-        d->drawAllLines(-1, true /*only glows*/);
+        d->drawAllLineGlows();
     }
 
     d->restoreGLStateFromMap();
@@ -86,26 +86,30 @@ void P_CopyLine(Line *dest, Line *src)
         if(!sidefrom || !sideto)
             continue;
 
-        float temp[4];
-        coord_t itemp[2];
-
-        P_SetPtrp    (sideto,   DMU_TOP_MATERIAL,               P_GetPtrp(sidefrom, DMU_TOP_MATERIAL));
-        P_GetDoublepv(sidefrom, DMU_TOP_MATERIAL_OFFSET_XY,     itemp);
-        P_SetDoublepv(sideto,   DMU_TOP_MATERIAL_OFFSET_XY,     itemp);
-        P_GetFloatpv (sidefrom, DMU_TOP_COLOR,                  temp);
-        P_SetFloatpv (sideto,   DMU_TOP_COLOR,                  temp);
-
-        P_SetPtrp    (sideto,   DMU_MIDDLE_MATERIAL,            P_GetPtrp(sidefrom, DMU_MIDDLE_MATERIAL));
-        P_GetDoublepv(sidefrom, DMU_MIDDLE_MATERIAL_OFFSET_XY,  itemp);
-        P_SetDoublepv(sideto,   DMU_MIDDLE_MATERIAL_OFFSET_XY,  itemp);
-        P_SetFloatpv (sideto,   DMU_MIDDLE_COLOR,               temp);
-        P_SetIntp    (sideto,   DMU_MIDDLE_BLENDMODE,           P_GetIntp(sidefrom, DMU_MIDDLE_BLENDMODE));
-
-        P_SetPtrp    (sideto,   DMU_BOTTOM_MATERIAL,            P_GetPtrp(sidefrom, DMU_BOTTOM_MATERIAL));
-        P_GetDoublepv(sidefrom, DMU_BOTTOM_MATERIAL_OFFSET_XY,  itemp);
-        P_SetDoublepv(sideto,   DMU_BOTTOM_MATERIAL_OFFSET_XY,  itemp);
-        P_GetFloatpv (sidefrom, DMU_BOTTOM_COLOR,               temp);
-        P_SetFloatpv (sideto,   DMU_BOTTOM_COLOR,               temp);
+        world_Material *materials[3];
+        coord_t offsets[3][2];
+        float colors[3][4];
+        int blendMode;
+
+        // All the properties are copied with one bulk read and write.
+        dmu_propvalue_t props[] = {
+            { DMU_TOP_MATERIAL,              DDVT_PTR,    &materials[0] },
+            { DMU_TOP_MATERIAL_OFFSET_XY,    DDVT_DOUBLE, offsets[0]    },
+            { DMU_TOP_COLOR,                 DDVT_FLOAT,  colors[0]     },
+
+            { DMU_MIDDLE_MATERIAL,           DDVT_PTR,    &materials[1] },
+            { DMU_MIDDLE_MATERIAL_OFFSET_XY, DDVT_DOUBLE, offsets[1]    },
+            { DMU_MIDDLE_COLOR,              DDVT_FLOAT,  colors[1]     },
+            { DMU_MIDDLE_BLENDMODE,          DDVT_INT,    &blendMode    },
+
+            { DMU_BOTTOM_MATERIAL,           DDVT_PTR,    &materials[2] },
+            { DMU_BOTTOM_MATERIAL_OFFSET_XY, DDVT_DOUBLE, offsets[2]    },
+            { DMU_BOTTOM_COLOR,              DDVT_FLOAT,  colors[2]     },
+        };
+        int const propCount = int(sizeof(props) / sizeof(props[0]));
+
+        P_GetPropsp(sidefrom, props, propCount);
+        P_SetPropsp(sideto,   props, propCount);
     }
 
     // Copy the extended properties too
@@ -20,6 +20,9 @@
 
 #include <cstdio>
 #include <cstring>
+#include <set>
+#include <QHash>
+#include <QVector>
 
 #include "common.h"
 #include "gamesession.h"
@@ -489,27 +492,90 @@ void P_PurgeDeferredSpawns()
 
 #ifdef __JHEXEN__
 
-/// @todo Remove fixed limit.
-#define MAX_TID_COUNT           200
+/**
+ * Registry of mobjs that have a thing ID (TID).
+ *
+ * Each registered mobj occupies a numbered slot. The search positions used by
+ * P_FindMobjFromTID() are slot numbers; they may be stored in mobjs (and thus in
+ * saved games), so slots are allocated exactly like in the original fixed-size
+ * list: the lowest free slot is reused, otherwise a new slot is appended. The
+ * registry is rebuilt in thinker order after a map is set up or a game is loaded.
+ */
+static struct TIDRegistry
+{
+    QVector<mobj_t *> slots;              ///< nullptr for free slots.
+    std::set<int> freeSlots;
+    QHash<mobj_t const *, int> slotOf;
+    QHash<int, std::set<int>> slotsByTid; ///< Ordered for searching.
 
-static int TIDList[MAX_TID_COUNT + 1];  // +1 for termination marker
-static mobj_t *TIDMobj[MAX_TID_COUNT];
+    void clear()
+    {
+        slots.clear();
+        freeSlots.clear();
+        slotOf.clear();
+        slotsByTid.clear();
+    }
 
-static int insertThinkerInIdListWorker(thinker_t *th, void *context)
-{
-    mobj_t *mo = (mobj_t *)th;
-    int *count = (int *) context;
+    void insert(mobj_t *mo)
+    {
+        int slot;
+        if(!freeSlots.empty())
+        {
+            slot = *freeSlots.begin();
+            freeSlots.erase(freeSlots.begin());
+            slots[slot] = mo;
+        }
+        else
+        {
+            slot = slots.size();
+            slots.append(mo);
+        }
+        slotOf.insert(mo, slot);
+        slotsByTid[mo->tid].insert(slot);
+    }
 
-    if(mo->tid != 0)
+    bool remove(mobj_t const *mo)
     {
-        // Add to list.
-        if(*count == MAX_TID_COUNT)
+        auto found = slotOf.find(mo);
+        if(found == slotOf.end()) return false;
+
+        int const slot = found.value();
+        slotOf.erase(found);
+
+        auto tidSlots = slotsByTid.find(mo->tid);
+        if(tidSlots != slotsByTid.end())
+        {
+            tidSlots.value().erase(slot);
+            if(tidSlots.value().empty()) slotsByTid.erase(tidSlots);
+        }
+
+        if(slot == slots.size() - 1)
+        {
+            // Trailing free slots are not kept.
+            slots.removeLast();
+            while(!slots.isEmpty() && !slots.last())
+            {
+                freeSlots.erase(slots.size() - 1);
+                slots.removeLast();
+            }
+        }
+        else
         {
-            Con_Error("P_CreateTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
+            slots[slot] = nullptr;
+            freeSlots.insert(slot);
         }
+        return true;
+    }
+}
+tids;
 
-        TIDList[*count] = mo->tid;
-        TIDMobj[(*count)++] = mo;
+static int insertThinkerInIdListWorker(thinker_t *th, void *)
+{
+    mobj_t *mo = (mobj_t *)th;
+
+    if(mo->tid != 0)
+    {
+        tids.insert(mo);
     }
 
     return false; // Continue iteration.
@@ -517,43 +583,22 @@ static int insertThinkerInIdListWorker(thinker_t *th, void *context)
 
 void P_CreateTIDList()
 {
-    int count = 0;
-    Thinker_Iterate(P_MobjThinker, insertThinkerInIdListWorker, &count);
-
-    // Add termination marker
-    TIDList[count] = 0;
+    tids.clear();
+    Thinker_Iterate(P_MobjThinker, insertThinkerInIdListWorker, nullptr);
 }
 
 void P_MobjInsertIntoTIDList(mobj_t *mo, int tid)
 {
     DENG_ASSERT(mo != 0);
 
-    int index = -1;
-    int i = 0;
-    for(; TIDList[i] != 0; ++i)
-    {
-        if(TIDList[i] == -1)
-        {
-            // Found empty slot
-            index = i;
-            break;
-        }
-    }
+    // A mobj is listed only once.
+    tids.remove(mo);
 
-    if(index == -1)
+    mo->tid = tid;
+    if(tid != 0)
     {
-        // Append required
-        if(i == MAX_TID_COUNT)
-        {
-            Con_Error("P_MobjInsertIntoTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
-        }
-        index = i;
-        TIDList[index + 1] = 0;
+        tids.insert(mo);
     }
-
-    mo->tid = tid;
-    TIDList[index] = tid;
-    TIDMobj[index] = mo;
 }
 
 void P_MobjRemoveFromTIDList(mobj_t *mo)
@@ -561,17 +606,7 @@ void P_MobjRemoveFromTIDList(mobj_t *mo)
     if(!mo || !mo->tid)
         return;
 
-    for(int i = 0; TIDList[i] != 0; ++i)
-    {
-        if(TIDMobj[i] == mo)
-        {
-            TIDList[i] = -1;
-            TIDMobj[i] = 0;
-            mo->tid = 0;
-            return;
-        }
-    }
-
+    tids.remove(mo);
     mo->tid = 0;
 }
 
@@ -579,12 +614,14 @@ mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
 {
     DENG_ASSERT(searchPosition != 0);
 
-    for(int i = *searchPosition + 1; TIDList[i] != 0; ++i)
+    auto found = tids.slotsByTid.constFind(tid);
+    if(found != tids.slotsByTid.constEnd())
     {
-        if(TIDList[i] == tid)
+        auto next = found.value().upper_bound(*searchPosition);
+        if(next != found.value().end())
         {
-            *searchPosition = i;
-            return TIDMobj[i];
+            *searchPosition = *next;
+            return tids.slots.at(*next);
         }
     }
 
@@ -592,4 +629,11 @@ mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
     return 0;
 }
 
+int P_MobjCountWithTID(int tid)
+{
+    auto found = tids.slotsByTid.constFind(tid);
+    if(found == tids.slotsByTid.constEnd()) return 0;
+    return int(found.value().size());
+}
+
 #endif // __JHEXEN__
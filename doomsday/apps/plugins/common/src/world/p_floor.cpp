@@ -78,6 +78,18 @@ static int stairQueueHead;
 static int stairQueueTail;
 #endif
 
+/**
+ * Changes the height of a plane and adjusts the mobjs touching the sector.
+ *
+ * @return  @c true if something didn't fit (see P_ChangeSector()).
+ */
+static dd_bool changePlaneHeight(Sector *sector, dd_bool isCeiling, coord_t height, int crush)
+{
+    coord_t const oldHeight = (isCeiling? Sector_CeilingHeight(sector) : Sector_FloorHeight(sector));
+    P_SetDoublep(sector, isCeiling? DMU_CEILING_HEIGHT : DMU_FLOOR_HEIGHT, height);
+    return P_ChangeSectorPlane(sector, crush, isCeiling? PLN_CEILING : PLN_FLOOR, oldHeight);
+}
+
 result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
     int isCeiling, int direction)
 {
@@ -91,8 +103,8 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
     P_SetDoublep(sector, ptarget, dest);
     P_SetFloatp(sector, pspeed, speed);
 
-    floorheight = P_GetDoublep(sector, DMU_FLOOR_HEIGHT);
-    ceilingheight = P_GetDoublep(sector, DMU_CEILING_HEIGHT);
+    floorheight = Sector_FloorHeight(sector);
+    ceilingheight = Sector_CeilingHeight(sector);
 
     switch(isCeiling)
     {
@@ -106,14 +118,12 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, dest);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, false, dest, crush);
                 if(flag)
                 {
                     // Oh no, the move failed.
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, false, lastpos, crush);
                 }
 #if __JHEXEN__
                 P_SetFloatp(sector, pspeed, 0);
@@ -123,16 +133,14 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             else
             {
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, floorheight - speed);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, false, floorheight - speed, crush);
                 if(flag)
                 {
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
 #if __JHEXEN__
                     P_SetFloatp(sector, pspeed, 0);
 #endif
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, false, lastpos, crush);
                     return crushed;
                 }
             }
@@ -144,14 +152,12 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, dest);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, false, dest, crush);
                 if(flag)
                 {
                     // Oh no, the move failed.
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, false, lastpos, crush);
                 }
 #if __JHEXEN__
                 P_SetFloatp(sector, pspeed, 0);
@@ -162,20 +168,18 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // COULD GET CRUSHED
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, floorheight + speed);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, false, floorheight + speed, crush);
                 if(flag)
                 {
 #if !__JHEXEN__
                     if(crush)
                         return crushed;
 #endif
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
 #if __JHEXEN__
                     P_SetFloatp(sector, pspeed, 0);
 #endif
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, false, lastpos, crush);
                     return crushed;
                 }
             }
@@ -196,13 +200,11 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, dest);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, true, dest, crush);
                 if(flag)
                 {
-                    P_SetDoublep(sector, DMU_CEILING_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, true, lastpos, crush);
                 }
 #if __JHEXEN__
                 P_SetFloatp(sector, pspeed, 0);
@@ -213,20 +215,18 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // COULD GET CRUSHED
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, ceilingheight - speed);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, true, ceilingheight - speed, crush);
                 if(flag)
                 {
 #if !__JHEXEN__
                     if(crush)
                         return crushed;
 #endif
-                    P_SetDoublep(sector, DMU_CEILING_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
 #if __JHEXEN__
                     P_SetFloatp(sector, pspeed, 0);
 #endif
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, true, lastpos, crush);
                     return crushed;
                 }
             }
@@ -238,13 +238,11 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, dest);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, true, dest, crush);
                 if(flag)
                 {
-                    P_SetDoublep(sector, DMU_CEILING_HEIGHT, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
-                    P_ChangeSector(sector, crush);
+                    changePlaneHeight(sector, true, lastpos, crush);
                 }
 #if __JHEXEN__
                 P_SetFloatp(sector, pspeed, 0);
@@ -254,8 +252,7 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             else
             {
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, ceilingheight + speed);
-                flag = P_ChangeSector(sector, crush);
+                flag = changePlaneHeight(sector, true, ceilingheight + speed, crush);
             }
             break;
 
@@ -311,9 +308,9 @@ void T_MoveFloor(void *floorThinkerPtr)
     if(floor->type == FT_RAISEBUILDSTEP)
     {
         if((floor->state == FS_UP &&
-            P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) >= floor->stairsDelayHeight) ||
+            Sector_FloorHeight(floor->sector) >= floor->stairsDelayHeight) ||
            (floor->state == FS_DOWN &&
-            P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) <= floor->stairsDelayHeight))
+            Sector_FloorHeight(floor->sector) <= floor->stairsDelayHeight))
         {
             floor->delayCount = floor->delayTotal;
             floor->stairsDelayHeight += floor->stairsDelayHeightDelta;
@@ -531,8 +528,8 @@ int findLineInSectorSmallestBottomMaterial(void *ptr, void *context)
     Line *li = (Line *) ptr;
     findlineinsectorsmallestbottommaterialparams_t *params = (findlineinsectorsmallestbottommaterialparams_t *) context;
 
-    Sector *frontSec = (Sector *)P_GetPtrp(li, DMU_FRONT_SECTOR);
-    Sector *backSec  = (Sector *)P_GetPtrp(li, DMU_BACK_SECTOR);
+    Sector *frontSec = Line_FrontSector(li);
+    Sector *backSec  = Line_BackSector(li);
 
     if(frontSec && backSec)
     {
@@ -628,7 +625,7 @@ static int findFirstNeighbourAtFloorHeight(void* ptr, void* context)
 
     other = P_GetNextSector(ln, params->baseSec);
 # if __JDOOM__ || __JDOOM64__
-    if(other && FEQUAL(P_GetDoublep(other, DMU_FLOOR_HEIGHT), params->height))
+    if(other && FEQUAL(Sector_FloorHeight(other), params->height))
 # elif __JHERETIC__
     if(other)
 # endif
@@ -737,14 +734,14 @@ int EV_DoFloor(Line *line, floortype_e floortype)
 # endif
 #endif
             P_FindSectorSurroundingLowestFloor(sec,
-                P_GetDoublep(sec, DMU_FLOOR_HEIGHT), &floor->floorDestHeight);
+                Sector_FloorHeight(sec), &floor->floorDestHeight);
             break;
 #if __JHEXEN__
         case FT_LOWERBYVALUE:
             floor->state = FS_DOWN;
             floor->sector = sec;
             floor->floorDestHeight =
-                P_GetDoublep(sec, DMU_FLOOR_HEIGHT) - (coord_t) args[2];
+                Sector_FloorHeight(sec) - (coord_t) args[2];
             break;
 
         case FT_LOWERMUL8INSTANT:
@@ -752,7 +749,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->state = FS_DOWN;
             floor->sector = sec;
             floor->floorDestHeight =
-                P_GetDoublep(sec, DMU_FLOOR_HEIGHT) - (coord_t) args[2] * 8;
+                Sector_FloorHeight(sec) - (coord_t) args[2] * 8;
             break;
 #endif
 #if !__JHEXEN__
@@ -764,7 +761,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
 # if __JHERETIC__
             floor->floorDestHeight += 8;
 # else
-            if(!FEQUAL(floor->floorDestHeight, P_GetDoublep(sec, DMU_FLOOR_HEIGHT)))
+            if(!FEQUAL(floor->floorDestHeight, Sector_FloorHeight(sec)))
                 floor->floorDestHeight += 8;
 # endif
             break;
@@ -775,7 +772,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->sector = sec;
             floor->speed = FLOORSPEED;
             P_FindSectorSurroundingHighestFloor(sec, -500, &floor->floorDestHeight);
-            if(!FEQUAL(floor->floorDestHeight, P_GetDoublep(sec, DMU_FLOOR_HEIGHT)))
+            if(!FEQUAL(floor->floorDestHeight, Sector_FloorHeight(sec)))
                 floor->floorDestHeight += 8;
             break;
 
@@ -787,7 +784,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
                 floor->speed = FLOORSPEED * bitmipL;
                 P_FindSectorSurroundingHighestFloor(sec, -500, &floor->floorDestHeight);
 
-                if(!FEQUAL(floor->floorDestHeight, P_GetDoublep(sec, DMU_FLOOR_HEIGHT)))
+                if(!FEQUAL(floor->floorDestHeight, Sector_FloorHeight(sec)))
                     floor->floorDestHeight += bitmipR;
             }
             else
@@ -796,7 +793,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
                 floor->sector = sec;
                 floor->speed = FLOORSPEED * bitmipL;
                 floor->floorDestHeight =
-                    P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) - bitmipR;
+                    Sector_FloorHeight(floor->sector) - bitmipR;
             }
             break;
 
@@ -804,7 +801,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->state = FS_UP;
             floor->sector = sec;
             floor->speed = FLOORSPEED * 16;
-            floor->floorDestHeight = P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT);
+            floor->floorDestHeight = Sector_FloorHeight(floor->sector);
 
             /// @fixme Should not clear the special like this!
             P_ToXSector(sec)->special = bitmipR;
@@ -825,12 +822,12 @@ int EV_DoFloor(Line *line, floortype_e floortype)
 # endif
 #endif
 #if __JHEXEN__
-            floor->floorDestHeight = P_GetDoublep(sec, DMU_CEILING_HEIGHT)-8;
+            floor->floorDestHeight = Sector_CeilingHeight(sec)-8;
 #else
             P_FindSectorSurroundingLowestCeiling(sec, (coord_t) MAXINT, &floor->floorDestHeight);
 
-            if(floor->floorDestHeight > P_GetDoublep(sec, DMU_CEILING_HEIGHT))
-                floor->floorDestHeight = P_GetDoublep(sec, DMU_CEILING_HEIGHT);
+            if(floor->floorDestHeight > Sector_CeilingHeight(sec))
+                floor->floorDestHeight = Sector_CeilingHeight(sec);
 
             floor->floorDestHeight -= 8 * (floortype == FT_RAISEFLOORCRUSH);
 #endif
@@ -847,8 +844,8 @@ int EV_DoFloor(Line *line, floortype_e floortype)
 #endif
             P_FindSectorSurroundingLowestCeiling(sec, (coord_t) MAXINT, &floor->floorDestHeight);
 
-            if(floor->floorDestHeight > P_GetDoublep(sec, DMU_CEILING_HEIGHT))
-                floor->floorDestHeight = P_GetDoublep(sec, DMU_CEILING_HEIGHT);
+            if(floor->floorDestHeight > Sector_CeilingHeight(sec))
+                floor->floorDestHeight = Sector_CeilingHeight(sec);
 
 #if !__JHEXEN__
             floor->floorDestHeight -= 8 * (floortype == FT_RAISEFLOORCRUSH);
@@ -866,7 +863,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             {
             coord_t floorHeight, nextFloor;
 
-            floorHeight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT);
+            floorHeight = Sector_FloorHeight(sec);
             if(P_FindSectorSurroundingNextHighestFloor(sec, floorHeight, &nextFloor))
                 floor->floorDestHeight = nextFloor;
             else
@@ -887,7 +884,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             {
             coord_t floorHeight, nextFloor;
 
-            floorHeight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT);
+            floorHeight = Sector_FloorHeight(sec);
             if(P_FindSectorSurroundingNextHighestFloor(sec, floorHeight, &nextFloor))
                 floor->floorDestHeight = nextFloor;
             else
@@ -900,7 +897,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->state = FS_UP;
             floor->sector = sec;
             floor->floorDestHeight =
-                P_GetDoublep(sec, DMU_FLOOR_HEIGHT) + (coord_t) args[2];
+                Sector_FloorHeight(sec) + (coord_t) args[2];
             break;
 
         case FT_RAISEMUL8INSTANT:
@@ -908,7 +905,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->state = FS_UP;
             floor->sector = sec;
             floor->floorDestHeight =
-                P_GetDoublep(sec, DMU_FLOOR_HEIGHT) + (coord_t) args[2] * 8;
+                Sector_FloorHeight(sec) + (coord_t) args[2] * 8;
             break;
 
         case FT_TOVALUEMUL8:
@@ -917,9 +914,9 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             if(args[3])
                 floor->floorDestHeight = -floor->floorDestHeight;
 
-            if(floor->floorDestHeight > P_GetDoublep(sec, DMU_FLOOR_HEIGHT))
+            if(floor->floorDestHeight > Sector_FloorHeight(sec))
                 floor->state = FS_UP;
-            else if(floor->floorDestHeight < P_GetDoublep(sec, DMU_FLOOR_HEIGHT))
+            else if(floor->floorDestHeight < Sector_FloorHeight(sec))
                 floor->state = FS_DOWN;
             else
                 rtn = 0; // Already at lowest position.
@@ -935,7 +932,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->speed *= 8;
 # endif
             floor->floorDestHeight =
-                P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) + 24;
+                Sector_FloorHeight(floor->sector) + 24;
             break;
 #endif
 #if !__JHEXEN__
@@ -947,9 +944,9 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->speed *= 8;
 # endif
             floor->floorDestHeight =
-                P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) + 24;
+                Sector_FloorHeight(floor->sector) + 24;
 
-            frontsector = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR);
+            frontsector = Line_FrontSector(line);
 
             P_SetPtrp(sec, DMU_FLOOR_MATERIAL,
                       P_GetPtrp(frontsector, DMU_FLOOR_MATERIAL));
@@ -963,7 +960,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->sector = sec;
             floor->speed = FLOORSPEED;
             floor->floorDestHeight =
-                P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) + 512;
+                Sector_FloorHeight(floor->sector) + 512;
             break;
 #endif
 
@@ -973,7 +970,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->sector = sec;
             floor->speed = FLOORSPEED * 8;
             floor->floorDestHeight =
-                P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) + 32;
+                Sector_FloorHeight(floor->sector) + 32;
             break;
 # endif
         case FT_RAISETOTEXTURE:
@@ -985,7 +982,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->speed = FLOORSPEED;
             P_FindLineInSectorSmallestBottomMaterial(sec, &minSize);
             floor->floorDestHeight =
-                P_GetDoublep(floor->sector, DMU_FLOOR_HEIGHT) +
+                Sector_FloorHeight(floor->sector) +
                     (coord_t) minSize;
             }
             break;
@@ -995,7 +992,7 @@ int EV_DoFloor(Line *line, floortype_e floortype)
             floor->sector = sec;
             floor->speed = FLOORSPEED;
             P_FindSectorSurroundingLowestFloor(sec,
-                P_GetDoublep(sec, DMU_FLOOR_HEIGHT), &floor->floorDestHeight);
+                Sector_FloorHeight(sec), &floor->floorDestHeight);
             floor->material = (world_Material *)P_GetPtrp(sec, DMU_FLOOR_MATERIAL);
 
             {
@@ -1042,10 +1039,10 @@ static int findSectorNeighborsForStairBuild(void *ptr, void *context)
     Line *li = (Line *) ptr;
     findsectorneighborsforstairbuildparams_t *params = (findsectorneighborsforstairbuildparams_t *) context;
 
-    Sector *frontSec = (Sector *)P_GetPtrp(li, DMU_FRONT_SECTOR);
+    Sector *frontSec = Line_FrontSector(li);
     if(!frontSec) return false;
 
-    Sector *backSec = (Sector *)P_GetPtrp(li, DMU_BACK_SECTOR);
+    Sector *backSec = Line_BackSector(li);
     if(!backSec) return false;
 
     xsector_t *xsec = P_ToXSector(frontSec);
@@ -1096,13 +1093,13 @@ static int findAdjacentSectorForSpread(void *ptr, void *context)
     if(!(P_ToXLine(li)->flags & ML_TWOSIDED))
         return false;
 
-    Sector *frontSec = (Sector *)P_GetPtrp(li, DMU_FRONT_SECTOR);
+    Sector *frontSec = Line_FrontSector(li);
     if(!frontSec) return false;
 
     if(params->baseSec != frontSec)
         return false;
 
-    Sector *backSec = (Sector *)P_GetPtrp(li, DMU_BACK_SECTOR);
+    Sector *backSec = Line_BackSector(li);
     if(!backSec) return false;
 
     if(P_GetPtrp(backSec, DMU_FLOOR_MATERIAL) != params->material)
@@ -1188,7 +1185,7 @@ int EV_BuildStairs(Line *line, stair_e type)
 #else
         floor->speed = speed;
 #endif
-        height = P_GetDoublep(sec, DMU_FLOOR_HEIGHT) + stairsize;
+        height = Sector_FloorHeight(sec) + stairsize;
         floor->floorDestHeight = height;
 
         // Find next sector to raise.
@@ -1280,12 +1277,12 @@ static void processStairSector(Sector *sec, int type, coord_t height,
         if(delay)
         {
             floor->delayTotal = delay;
-            floor->stairsDelayHeight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT) + stairData.stepDelta;
+            floor->stairsDelayHeight = Sector_FloorHeight(sec) + stairData.stepDelta;
             floor->stairsDelayHeightDelta = stairData.stepDelta;
         }
         floor->resetDelay = resetDelay;
         floor->resetDelayCount = resetDelay;
-        floor->resetHeight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT);
+        floor->resetHeight = Sector_FloorHeight(sec);
         break;
 
     case STAIRS_SYNC:
@@ -1293,7 +1290,7 @@ static void processStairSector(Sector *sec, int type, coord_t height,
             stairData.speed * ((height - stairData.startHeight) / stairData.stepDelta);
         floor->resetDelay = delay; //arg4
         floor->resetDelayCount = delay;
-        floor->resetHeight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT);
+        floor->resetHeight = Sector_FloorHeight(sec);
         break;
 
     default:
@@ -1346,13 +1343,13 @@ int EV_BuildStairs(Line * /*line*/, byte *args, int direction, stairs_e stairsTy
     while((sec = (Sector *)IterList_MoveIterator(list)))
     {
         stairData.material    = (world_Material *)P_GetPtrp(sec, DMU_FLOOR_MATERIAL);
-        stairData.startHeight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT);
+        stairData.startHeight = Sector_FloorHeight(sec);
 
         // ALREADY MOVING?  IF SO, KEEP GOING...
         if(P_ToXSector(sec)->specialData)
             continue; // Already moving, so keep going...
 
-        enqueueStairSector(sec, 0, P_GetDoublep(sec, DMU_FLOOR_HEIGHT));
+        enqueueStairSector(sec, 0, Sector_FloorHeight(sec));
         P_ToXSector(sec)->special = 0;
     }
 
@@ -1379,7 +1376,7 @@ static int findFirstTwosided(void *ptr, void *context)
     Line *li = (Line *) ptr;
     findfirsttwosidedparams_t *params = (findfirsttwosidedparams_t *) context;
 
-    Sector *backSec = (Sector *)P_GetPtrp(li, DMU_BACK_SECTOR);
+    Sector *backSec = Line_BackSector(li);
 
     if(!(P_ToXLine(li)->flags & ML_TWOSIDED))
         return false;
@@ -1422,24 +1419,24 @@ int EV_DoDonut(Line *line)
 
         if(P_Iteratep(sec, DMU_LINE, findFirstTwosided, &params))
         {
-            ring = (Sector *)P_GetPtrp(params.foundLine, DMU_BACK_SECTOR);
+            ring = Line_BackSector(params.foundLine);
             if(ring == sec)
             {
-                ring = (Sector *)P_GetPtrp(params.foundLine, DMU_FRONT_SECTOR);
+                ring = Line_FrontSector(params.foundLine);
             }
 
             params.sector = sec;
             params.foundLine = NULL;
             if(P_Iteratep(ring, DMU_LINE, findFirstTwosided, &params))
             {
-                outer = (Sector *)P_GetPtrp(params.foundLine, DMU_BACK_SECTOR);
+                outer = Line_BackSector(params.foundLine);
             }
         }
 
         if(outer && ring)
         {
             // Found both parts of the donut.
-            coord_t destHeight = P_GetDoublep(outer, DMU_FLOOR_HEIGHT);
+            coord_t destHeight = Sector_FloorHeight(outer);
 
             // Spawn rising slime.
             floor_t *floor = (floor_t *)Z_Calloc(sizeof(*floor), PU_MAP, 0);
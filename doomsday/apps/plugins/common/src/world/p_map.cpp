@@ -25,6 +25,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 #include "acs/system.h"
 #include "d_net.h"
 #include "d_netcl.h"
@@ -39,24 +40,16 @@
 #include "player.h"
 #include "p_mapsetup.h"
 
+#include <doomsday/world/TickProfiler>
+
 /*
- * Try move variables:
+ * Try move variables (see CollisionContext):
  */
-static AABoxd tmBox;
-static mobj_t *tmThing;
 dd_bool tmFloatOk; ///< @c true= move would be ok if within "tmFloorZ - tmCeilingZ".
 coord_t tmFloorZ;
 coord_t tmCeilingZ;
-#if __JHEXEN__
-static world_Material *tmFloorMaterial;
-#endif
 dd_bool tmFellDown; // $dropoff_fix
-static coord_t tm[3];
 static coord_t tmDropoffZ;
-#if __JDOOM__ || __JDOOM64__ || __JHERETIC__
-static Line *tmHitLine;
-static int tmUnstuck; ///< $unstuck: used to check unsticking
-#endif
 Line *tmBlockingLine; // $unstuck: blocking line
 #if __JHEXEN__
 mobj_t *tmBlockingMobj;
@@ -67,6 +60,40 @@ mobj_t *tmBlockingMobj;
 Line *tmCeilingLine;
 Line *tmFloorLine;
 
+/**
+ * State of the movement/collision check in progress, passed explicitly to the
+ * check and its iterators. There is only one: the results are the tm* variables
+ * above, and a check started during another one (e.g., by damage, a pickup or a
+ * line special) replaces the mover, position and results of the outer check, as
+ * the playsim expects.
+ */
+struct CollisionContext
+{
+    mobj_t *thing = nullptr;        ///< Mobj being moved.
+    coord_t pos[3] {0, 0, 0};       ///< Position being checked.
+    AABoxd box;                     ///< Bounds of @ref thing at @ref pos.
+
+    dd_bool &floatOk    = tmFloatOk;
+    coord_t &floorZ     = tmFloorZ;
+    coord_t &ceilingZ   = tmCeilingZ;
+    coord_t &dropoffZ   = tmDropoffZ;
+    dd_bool &fellDown   = tmFellDown;
+    Line *&ceilingLine  = tmCeilingLine;
+    Line *&floorLine    = tmFloorLine;
+    Line *&blockingLine = tmBlockingLine;
+#if __JHEXEN__
+    world_Material *floorMaterial = nullptr;
+    mobj_t *&blockingMobj = tmBlockingMobj;
+#else
+    Line *hitLine = nullptr;        ///< Special line to send a Hit event to.
+    int unstuck = 0;                ///< $unstuck: allow escaping from lines.
+#endif
+
+    iterlist_t *&specHits = spechit; ///< Special lines contacted during the check.
+};
+
+static CollisionContext tmContext;
+
 /*
  * Line aim/attack variables:
  */
@@ -120,6 +147,8 @@ dd_bool P_CheckSight(mobj_t const *beholder, mobj_t const *target)
 {
     if(!beholder || !target) return false;
 
+    world::TickProfiler::Scope profile(world::TickProfiler::Sight);
+
     // If either is unlinked, they can't see each other.
     if(!Mobj_Sector(beholder)) return false;
     if(!Mobj_Sector(target)) return false;
@@ -143,6 +172,33 @@ dd_bool P_CheckSight(mobj_t const *beholder, mobj_t const *target)
     return P_CheckLineSight(from, target->origin, 0, target->height, 0);
 }
 
+/**
+ * Collects the mobjs linked in the blockmap cells intersecting @a box that are
+ * within @a range of @a point, in blockmap iteration order (see Mobj_AreaQuery()).
+ * The results are placed in a local buffer so that the caller is free to damage
+ * (and thereby spawn or move) mobjs while processing them.
+ */
+static void collectMobjsInArea(AABoxd const &box, coord_t const point[2], coord_t range,
+                               std::vector<mobjcandidate_t> &found)
+{
+    if(found.size() < 64) found.resize(64);
+    forever
+    {
+        VALIDCOUNT++;
+        int const count = Mobj_AreaQuery(&box, point, range, found.data(), int(found.size()));
+        bool const complete = (count <= int(found.size()));
+        found.resize(count);
+        if(complete) return;
+        // The buffer was too small; try again.
+    }
+}
+
+/// @return  @c true if @a mo has been removed from the map during this tick.
+static inline bool isRemovedMobj(mobj_t const *mo)
+{
+    return mo->thinker.function == (thinkfunc_t) -1;
+}
+
 angle_t P_AimAtPoint2(coord_t const from[], coord_t const to[], dd_bool shadowed)
 {
     angle_t angle = M_PointToAngle2(from, to);
@@ -159,31 +215,25 @@ angle_t P_AimAtPoint(coord_t const from[], coord_t const to[])
     return P_AimAtPoint2(from, to, false/* not shadowed*/);
 }
 
-struct pit_stompthing_params_t
+struct stompthing_params_t
 {
     mobj_t *stompMobj; ///< Mobj doing the stomping.
     vec2d_t location;  ///< Map space point being stomped.
     bool alwaysStomp;  ///< Disable per-type/monster stomp exclussions.
 };
 
-/// @return  Non-zero when the first unstompable mobj is found; otherwise @c 0.
-static int PIT_StompThing(mobj_t *mo, void *context)
+/**
+ * @param mo  Mobj within stomping range (see P_TeleportMove()).
+ *
+ * @return  @c true if @a mo is unstompable (i.e., the stomp should be aborted).
+ */
+static bool stompThing(mobj_t *mo, stompthing_params_t const &parm)
 {
-    pit_stompthing_params_t &parm = *static_cast<pit_stompthing_params_t *>(context);
-
     // Don't ever attempt to stomp oneself.
     if(mo == parm.stompMobj) return false;
     // ...or non-shootables.
     if(!(mo->flags & MF_SHOOTABLE)) return false;
 
-    // Out of range?
-    coord_t const dist = mo->radius + parm.stompMobj->radius;
-    if(fabs(mo->origin[VX] - parm.location[VX]) >= dist ||
-       fabs(mo->origin[VY] - parm.location[VY]) >= dist)
-    {
-        return false;
-    }
-
     if(!parm.alwaysStomp)
     {
         // Is "this" mobj allowed to stomp?
@@ -203,7 +253,7 @@ static int PIT_StompThing(mobj_t *mo, void *context)
     // Stomp!
     P_DamageMobj(mo, parm.stompMobj, parm.stompMobj, 10000, true);
 
-    return false; // Continue iteration.
+    return false;
 }
 
 dd_bool P_TeleportMove(mobj_t *mobj, coord_t x, coord_t y, dd_bool alwaysStomp)
@@ -213,7 +263,7 @@ dd_bool P_TeleportMove(mobj_t *mobj, coord_t x, coord_t y, dd_bool alwaysStomp)
     IterList_Clear(spechit); /// @todo necessary? -ds
 
     // Attempt to stomp any mobjs in the way.
-    pit_stompthing_params_t parm;
+    stompthing_params_t parm;
     parm.stompMobj = mobj;
     V2d_Set(parm.location, x, y);
     parm.alwaysStomp = CPP_BOOL(alwaysStomp);
@@ -221,10 +271,17 @@ dd_bool P_TeleportMove(mobj_t *mobj, coord_t x, coord_t y, dd_bool alwaysStomp)
     coord_t const dist = mobj->radius + MAXRADIUS;
     AABoxd const box(x - dist, y - dist, x + dist, y + dist);
 
-    VALIDCOUNT++;
-    if(Mobj_BoxIterator(&box, PIT_StompThing, &parm))
+    // Only mobjs overlapping the stomper at the destination are in range.
+    std::vector<mobjcandidate_t> inRange;
+    collectMobjsInArea(box, parm.location, mobj->radius, inRange);
+    for(mobjcandidate_t const &cand : inRange)
     {
-        return false;
+        if(isRemovedMobj(cand.mobj)) continue;
+
+        if(stompThing(cand.mobj, parm))
+        {
+            return false;
+        }
     }
 
     // The destination is clear.
@@ -233,8 +290,8 @@ dd_bool P_TeleportMove(mobj_t *mobj, coord_t x, coord_t y, dd_bool alwaysStomp)
     mobj->origin[VY] = parm.location[VY];
     P_MobjLink(mobj);
 
-    mobj->floorZ     = P_GetDoublep(Mobj_Sector(mobj), DMU_FLOOR_HEIGHT);
-    mobj->ceilingZ   = P_GetDoublep(Mobj_Sector(mobj), DMU_CEILING_HEIGHT);
+    mobj->floorZ     = Sector_FloorHeight(Mobj_Sector(mobj));
+    mobj->ceilingZ   = Sector_CeilingHeight(Mobj_Sector(mobj));
 #if !__JHEXEN__
     mobj->dropOffZ   = mobj->floorZ;
 #endif
@@ -276,7 +333,7 @@ static int PIT_CrossLine(Line *line, void *context)
 
     if((P_GetIntp(line, DMU_FLAGS) & DDLF_BLOCKING) ||
        (P_ToXLine(line)->flags & ML_BLOCKMONSTERS) ||
-       (!P_GetPtrp(line, DMU_FRONT_SECTOR) || !P_GetPtrp(line, DMU_BACK_SECTOR)))
+       (!Line_FrontSector(line) || !Line_BackSector(line)))
     {
         AABoxd *aaBox = (AABoxd *)P_GetPtrp(line, DMU_BOUNDING_BOX);
 
@@ -360,24 +417,26 @@ static int untouched(Line *line, mobj_t *mobj)
 }
 #endif
 
-static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
+static int PIT_CheckThing(mobj_t *thing, void *context)
 {
+    CollisionContext &ctx = *static_cast<CollisionContext *>(context);
+
     // Don't clip against oneself.
-    if(thing == tmThing)
+    if(thing == ctx.thing)
     {
         return false;
     }
 
 #if __JHEXEN__
     // Don't clip on something we are stood on.
-    if(thing == tmThing->onMobj)
+    if(thing == ctx.thing->onMobj)
     {
         return false;
     }
 #endif
 
     if(!(thing->flags & (MF_SOLID | MF_SPECIAL | MF_SHOOTABLE)) ||
-       P_MobjIsCamera(thing) || P_MobjIsCamera(tmThing))
+       P_MobjIsCamera(thing) || P_MobjIsCamera(ctx.thing))
     {
         return false;
     }
@@ -385,11 +444,11 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 #if !__JHEXEN__
     // Player only.
     dd_bool overlap = false;
-    if(tmThing->player && !FEQUAL(tm[VZ], DDMAXFLOAT) &&
-       (cfg.moveCheckZ || (tmThing->flags2 & MF2_PASSMOBJ)))
+    if(ctx.thing->player && !FEQUAL(ctx.pos[VZ], DDMAXFLOAT) &&
+       (cfg.moveCheckZ || (ctx.thing->flags2 & MF2_PASSMOBJ)))
     {
-        if((thing->origin[VZ] > tm[VZ] + tmThing->height) ||
-           (thing->origin[VZ] + thing->height < tm[VZ]))
+        if((thing->origin[VZ] > ctx.pos[VZ] + ctx.thing->height) ||
+           (thing->origin[VZ] + thing->height < ctx.pos[VZ]))
         {
             return false; // Under or over it.
         }
@@ -398,9 +457,9 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
     }
 #endif
 
-    coord_t blockdist = thing->radius + tmThing->radius;
-    if(fabs(thing->origin[VX] - tm[VX]) >= blockdist ||
-       fabs(thing->origin[VY] - tm[VY]) >= blockdist)
+    coord_t blockdist = thing->radius + ctx.thing->radius;
+    if(fabs(thing->origin[VX] - ctx.pos[VX]) >= blockdist ||
+       fabs(thing->origin[VY] - ctx.pos[VY]) >= blockdist)
     {
         return false; // Didn't hit thing.
     }
@@ -408,13 +467,13 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
     if(IS_CLIENT)
     {
         // On clientside, missiles don't collide with mobjs.
-        if(tmThing->ddFlags & DDMF_MISSILE)
+        if(ctx.thing->ddFlags & DDMF_MISSILE)
         {
             return false;
         }
 
         // Players can't hit their own clmobjs.
-        if(tmThing->player && ClPlayer_ClMobj(tmThing->player - players) == thing)
+        if(ctx.thing->player && ClPlayer_ClMobj(ctx.thing->player - players) == thing)
         {
             return false;
         }
@@ -428,24 +487,24 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 */
 
 #if __JHEXEN__
-    tmBlockingMobj = thing;
+    ctx.blockingMobj = thing;
 #endif
 
 #if __JHEXEN__
-    if(tmThing->flags2 & MF2_PASSMOBJ)
+    if(ctx.thing->flags2 & MF2_PASSMOBJ)
 #else
-    if(!tmThing->player && (tmThing->flags2 & MF2_PASSMOBJ))
+    if(!ctx.thing->player && (ctx.thing->flags2 & MF2_PASSMOBJ))
 #endif
     {
         // Check if a mobj passed over/under another object.
 #if __JHERETIC__
-        if((tmThing->type == MT_IMP || tmThing->type == MT_WIZARD) &&
+        if((ctx.thing->type == MT_IMP || ctx.thing->type == MT_WIZARD) &&
            (thing->type == MT_IMP || thing->type == MT_WIZARD))
         {
             return true; // Don't let imps/wizards fly over other imps/wizards.
         }
 #elif __JHEXEN__
-        if(tmThing->type == MT_BISHOP && thing->type == MT_BISHOP)
+        if(ctx.thing->type == MT_BISHOP && thing->type == MT_BISHOP)
         {
             return true; // Don't let bishops fly over other bishops.
         }
@@ -453,8 +512,8 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
         if(!(thing->flags & MF_SPECIAL))
         {
-            if(tmThing->origin[VZ] > thing->origin[VZ] + thing->height ||
-               tmThing->origin[VZ] + tmThing->height < thing->origin[VZ])
+            if(ctx.thing->origin[VZ] > thing->origin[VZ] + thing->height ||
+               ctx.thing->origin[VZ] + ctx.thing->height < thing->origin[VZ])
             {
                 return false; // Over/under thing.
             }
@@ -462,12 +521,12 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
     }
 
     // Check for skulls slamming into things.
-    if((tmThing->flags & MF_SKULLFLY) && (thing->flags & MF_SOLID))
+    if((ctx.thing->flags & MF_SKULLFLY) && (thing->flags & MF_SOLID))
     {
 #if __JHEXEN__
-        tmBlockingMobj = 0;
+        ctx.blockingMobj = 0;
 
-        if(tmThing->type == MT_MINOTAUR)
+        if(ctx.thing->type == MT_MINOTAUR)
         {
             // Slamming minotaurs shouldn't move non-creatures.
             if(!(thing->flags & MF_COUNTKILL))
@@ -475,9 +534,9 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                 return true;
             }
         }
-        else if(tmThing->type == MT_HOLY_FX)
+        else if(ctx.thing->type == MT_HOLY_FX)
         {
-            if((thing->flags & MF_SHOOTABLE) && thing != tmThing->target)
+            if((thing->flags & MF_SHOOTABLE) && thing != ctx.thing->target)
             {
                 if(IS_NETGAME && !gfw_Rule(deathmatch) && thing->player)
                 {
@@ -487,14 +546,14 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                 if((thing->flags2 & MF2_REFLECTIVE) &&
                    (thing->player || (thing->flags2 & MF2_BOSS)))
                 {
-                    tmThing->tracer = tmThing->target;
-                    tmThing->target = thing;
+                    ctx.thing->tracer = ctx.thing->target;
+                    ctx.thing->target = thing;
                     return false;
                 }
 
                 if(thing->flags & MF_COUNTKILL || thing->player)
                 {
-                    tmThing->tracer = thing;
+                    ctx.thing->tracer = thing;
                 }
 
                 if(P_Random() < 96)
@@ -504,14 +563,14 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     {
                         damage = 3;
                         // Ghost burns out faster when attacking players/bosses.
-                        tmThing->health -= 6;
+                        ctx.thing->health -= 6;
                     }
 
-                    P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+                    P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
                     if(P_Random() < 128)
                     {
-                        P_SpawnMobj(MT_HOLY_PUFF, tmThing->origin, P_Random() << 24, 0);
-                        S_StartSound(SFX_SPIRIT_ATTACK, tmThing);
+                        P_SpawnMobj(MT_HOLY_PUFF, ctx.thing->origin, P_Random() << 24, 0);
+                        S_StartSound(SFX_SPIRIT_ATTACK, ctx.thing);
 
                         if((thing->flags & MF_COUNTKILL) && P_Random() < 128 &&
                            !S_IsPlaying(SFX_PUPPYBEAT, thing))
@@ -528,7 +587,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
                 if(thing->health <= 0)
                 {
-                    tmThing->tracer = 0;
+                    ctx.thing->tracer = 0;
                 }
             }
 
@@ -536,7 +595,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         }
 #endif
 
-        int damage = tmThing->damage;
+        int damage = ctx.thing->damage;
 #if __JDOOM__
         /// @attention Kludge:
         /// Older save versions did not serialize the damage property,
@@ -544,20 +603,20 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         /// @fixme Do this during map state deserialization.
         if(damage == DDMAXINT)
         {
-            damage = tmThing->info->damage;
+            damage = ctx.thing->info->damage;
         }
 #endif
 
         damage *= (P_Random() % 8) + 1;
-        P_DamageMobj(thing, tmThing, tmThing, damage, false);
+        P_DamageMobj(thing, ctx.thing, ctx.thing, damage, false);
 
-        tmThing->flags &= ~MF_SKULLFLY;
-        tmThing->mom[MX] = tmThing->mom[MY] = tmThing->mom[MZ] = 0;
+        ctx.thing->flags &= ~MF_SKULLFLY;
+        ctx.thing->mom[MX] = ctx.thing->mom[MY] = ctx.thing->mom[MZ] = 0;
 
 #if __JHERETIC__ || __JHEXEN__
-        P_MobjChangeState(tmThing, P_GetState(mobjtype_t(tmThing->type), SN_SEE));
+        P_MobjChangeState(ctx.thing, P_GetState(mobjtype_t(ctx.thing->type), SN_SEE));
 #else
-        P_MobjChangeState(tmThing, P_GetState(mobjtype_t(tmThing->type), SN_SPAWN));
+        P_MobjChangeState(ctx.thing, P_GetState(mobjtype_t(ctx.thing->type), SN_SPAWN));
 #endif
 
         return true; // Stop moving.
@@ -565,21 +624,21 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
 #if __JHEXEN__
     // Check for blasted thing running into another
-    if((tmThing->flags2 & MF2_BLASTED) && (thing->flags & MF_SHOOTABLE))
+    if((ctx.thing->flags2 & MF2_BLASTED) && (thing->flags & MF_SHOOTABLE))
     {
         if(!(thing->flags2 & MF2_BOSS) && (thing->flags & MF_COUNTKILL))
         {
-            thing->mom[MX] += tmThing->mom[MX];
-            thing->mom[MY] += tmThing->mom[MY];
+            thing->mom[MX] += ctx.thing->mom[MX];
+            thing->mom[MY] += ctx.thing->mom[MY];
 
-            NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX], tmThing->mom[VY], 0);
+            NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX], ctx.thing->mom[VY], 0);
 
             if((thing->mom[MX] + thing->mom[MY]) > 3)
             {
-                P_DamageMobj(thing, tmThing, tmThing,
-                             (tmThing->info->mass / 100) + 1, false);
+                P_DamageMobj(thing, ctx.thing, ctx.thing,
+                             (ctx.thing->info->mass / 100) + 1, false);
 
-                P_DamageMobj(tmThing, thing, thing,
+                P_DamageMobj(ctx.thing, thing, thing,
                              ((thing->info->mass / 100) + 1) >> 2, false);
             }
 
@@ -589,7 +648,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 #endif
 
     // Missiles can hit other things.
-    if(tmThing->flags & MF_MISSILE)
+    if(ctx.thing->flags & MF_MISSILE)
     {
 #if __JHEXEN__
         // Check for a non-shootable mobj.
@@ -599,35 +658,35 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         }
 #else
         // Check for passing through a ghost.
-        if((thing->flags & MF_SHADOW) && (tmThing->flags2 & MF2_THRUGHOST))
+        if((thing->flags & MF_SHADOW) && (ctx.thing->flags2 & MF2_THRUGHOST))
         {
             return false;
         }
 #endif
 
         // See if it went over / under.
-        if(tmThing->origin[VZ] > thing->origin[VZ] + thing->height ||
-           tmThing->origin[VZ] + tmThing->height < thing->origin[VZ])
+        if(ctx.thing->origin[VZ] > thing->origin[VZ] + thing->height ||
+           ctx.thing->origin[VZ] + ctx.thing->height < thing->origin[VZ])
         {
             return false;
         }
 
 #if __JHEXEN__
-        if(tmThing->flags2 & MF2_FLOORBOUNCE)
+        if(ctx.thing->flags2 & MF2_FLOORBOUNCE)
         {
-            return !(tmThing->target == thing || !(thing->flags & MF_SOLID));
+            return !(ctx.thing->target == thing || !(thing->flags & MF_SOLID));
         }
 
-        if(tmThing->type == MT_LIGHTNING_FLOOR || tmThing->type == MT_LIGHTNING_CEILING)
+        if(ctx.thing->type == MT_LIGHTNING_FLOOR || ctx.thing->type == MT_LIGHTNING_CEILING)
         {
-            if((thing->flags & MF_SHOOTABLE) && thing != tmThing->target)
+            if((thing->flags & MF_SHOOTABLE) && thing != ctx.thing->target)
             {
                 if(thing->info->mass != DDMAXINT)
                 {
-                    thing->mom[MX] += tmThing->mom[MX] / 16;
-                    thing->mom[MY] += tmThing->mom[MY] / 16;
+                    thing->mom[MX] += ctx.thing->mom[MX] / 16;
+                    thing->mom[MY] += ctx.thing->mom[MY] / 16;
 
-                    NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX] / 16, tmThing->mom[MY] / 16, 0);
+                    NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX] / 16, ctx.thing->mom[MY] / 16, 0);
                 }
 
                 if((!thing->player && !(thing->flags2 & MF2_BOSS)) ||
@@ -636,16 +695,16 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     // Lightning does more damage to centaurs.
                     if(thing->type == MT_CENTAUR || thing->type == MT_CENTAURLEADER)
                     {
-                        P_DamageMobj(thing, tmThing, tmThing->target, 9, false);
+                        P_DamageMobj(thing, ctx.thing, ctx.thing->target, 9, false);
                     }
                     else
                     {
-                        P_DamageMobj(thing, tmThing, tmThing->target, 3, false);
+                        P_DamageMobj(thing, ctx.thing, ctx.thing->target, 3, false);
                     }
 
-                    if(!S_IsPlaying(SFX_MAGE_LIGHTNING_ZAP, tmThing))
+                    if(!S_IsPlaying(SFX_MAGE_LIGHTNING_ZAP, ctx.thing))
                     {
-                        S_StartSound(SFX_MAGE_LIGHTNING_ZAP, tmThing);
+                        S_StartSound(SFX_MAGE_LIGHTNING_ZAP, ctx.thing);
                     }
 
                     if((thing->flags & MF_COUNTKILL) && P_Random() < 64 &&
@@ -660,34 +719,34 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     }
                 }
 
-                tmThing->health--;
-                if(tmThing->health <= 0 || thing->health <= 0)
+                ctx.thing->health--;
+                if(ctx.thing->health <= 0 || thing->health <= 0)
                 {
                     return true;
                 }
 
-                if(tmThing->type == MT_LIGHTNING_FLOOR)
+                if(ctx.thing->type == MT_LIGHTNING_FLOOR)
                 {
-                    if(tmThing->lastEnemy && !tmThing->lastEnemy->tracer)
+                    if(ctx.thing->lastEnemy && !ctx.thing->lastEnemy->tracer)
                     {
-                        tmThing->lastEnemy->tracer = thing;
+                        ctx.thing->lastEnemy->tracer = thing;
                     }
                 }
-                else if(!tmThing->tracer)
+                else if(!ctx.thing->tracer)
                 {
-                    tmThing->tracer = thing;
+                    ctx.thing->tracer = thing;
                 }
             }
 
             return false; // Lightning zaps through all sprites.
         }
 
-        if(tmThing->type == MT_LIGHTNING_ZAP)
+        if(ctx.thing->type == MT_LIGHTNING_ZAP)
         {
-            if((thing->flags & MF_SHOOTABLE) && thing != tmThing->target &&
-               tmThing->lastEnemy)
+            if((thing->flags & MF_SHOOTABLE) && thing != ctx.thing->target &&
+               ctx.thing->lastEnemy)
             {
-                mobj_t *lmo = tmThing->lastEnemy;
+                mobj_t *lmo = ctx.thing->lastEnemy;
 
                 if(lmo->type == MT_LIGHTNING_FLOOR)
                 {
@@ -707,7 +766,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                 }
             }
         }
-        else if(tmThing->type == MT_MSTAFF_FX2 && thing != tmThing->target)
+        else if(ctx.thing->type == MT_MSTAFF_FX2 && thing != ctx.thing->target)
         {
             if(!thing->player && !(thing->flags2 & MF2_BOSS))
             {
@@ -719,7 +778,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     break;
 
                 default:
-                    P_DamageMobj(thing, tmThing, tmThing->target, 10, false);
+                    P_DamageMobj(thing, ctx.thing, ctx.thing->target, 10, false);
                     return false;
                 }
             }
@@ -728,15 +787,15 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
         // Don't hit same species as originator.
 #if __JDOOM__ || __JDOOM64__
-        if(tmThing->target &&
-           (tmThing->target->type == thing->type ||
-           (tmThing->target->type == MT_KNIGHT && thing->type == MT_BRUISER) ||
-           (tmThing->target->type == MT_BRUISER && thing->type == MT_KNIGHT)))
+        if(ctx.thing->target &&
+           (ctx.thing->target->type == thing->type ||
+           (ctx.thing->target->type == MT_KNIGHT && thing->type == MT_BRUISER) ||
+           (ctx.thing->target->type == MT_BRUISER && thing->type == MT_KNIGHT)))
 #else
-        if(tmThing->target && tmThing->target->type == thing->type)
+        if(ctx.thing->target && ctx.thing->target->type == thing->type)
 #endif
         {
-            if(thing == tmThing->target)
+            if(thing == ctx.thing->target)
             {
                 return false;
             }
@@ -761,7 +820,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             return !!(thing->flags & MF_SOLID); // Didn't do any damage.
         }
 
-        if(tmThing->flags2 & MF2_RIP)
+        if(ctx.thing->flags2 & MF2_RIP)
         {
 #if __JHEXEN__
             if(!(thing->flags & MF_NOBLOOD) &&
@@ -771,14 +830,14 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             if(!(thing->flags & MF_NOBLOOD))
 #endif
             {   // Ok to spawn some blood.
-                P_RipperBlood(tmThing);
+                P_RipperBlood(ctx.thing);
             }
 
 #if __JHERETIC__
-            S_StartSound(SFX_RIPSLOP, tmThing);
+            S_StartSound(SFX_RIPSLOP, ctx.thing);
 #endif
 
-            int damage = tmThing->damage;
+            int damage = ctx.thing->damage;
 #if __JDOOM__
             /// @attention Kludge:
             /// Older save versions did not serialize the damage property,
@@ -786,41 +845,41 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             /// @fixme Do this during map state deserialization.
             if(damage == DDMAXINT)
             {
-                damage = tmThing->info->damage;
+                damage = ctx.thing->info->damage;
             }
 #endif
 
             damage *= (P_Random() & 3) + 2;
-            P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+            P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
 
-            if((thing->flags2 & MF2_PUSHABLE) && !(tmThing->flags2 & MF2_CANNOTPUSH))
+            if((thing->flags2 & MF2_PUSHABLE) && !(ctx.thing->flags2 & MF2_CANNOTPUSH))
             {
                 // Push thing
-                thing->mom[MX] += tmThing->mom[MX] / 4;
-                thing->mom[MY] += tmThing->mom[MY] / 4;
-                NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX]/4, tmThing->mom[MY]/4, 0);
+                thing->mom[MX] += ctx.thing->mom[MX] / 4;
+                thing->mom[MY] += ctx.thing->mom[MY] / 4;
+                NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX]/4, ctx.thing->mom[MY]/4, 0);
             }
 
-            IterList_Clear(spechit);
+            IterList_Clear(ctx.specHits);
             return false;
         }
 
         // Do damage
-        int damage = tmThing->damage;
+        int damage = ctx.thing->damage;
 #if __JDOOM__
         /// @attention Kludge:
         /// Older save versions did not serialize the damage property,
         /// so here we take the damage from the current Thing definition.
         /// @fixme Do this during map state deserialization.
-        if(tmThing->damage == DDMAXINT)
+        if(ctx.thing->damage == DDMAXINT)
         {
-            damage = tmThing->info->damage;
+            damage = ctx.thing->info->damage;
         }
 #endif
 
         damage *= (P_Random() % 8) + 1;
 #if __JDOOM__ || __JDOOM64__
-        P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+        P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
 #else
         if(damage)
         {
@@ -830,17 +889,17 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             if(!(thing->flags & MF_NOBLOOD) &&
                !(thing->flags2 & MF2_REFLECTIVE) &&
                !(thing->flags2 & MF2_INVULNERABLE) &&
-               !(tmThing->type == MT_TELOTHER_FX1) &&
-               !(tmThing->type == MT_TELOTHER_FX2) &&
-               !(tmThing->type == MT_TELOTHER_FX3) &&
-               !(tmThing->type == MT_TELOTHER_FX4) &&
-               !(tmThing->type == MT_TELOTHER_FX5) && (P_Random() < 192))
+               !(ctx.thing->type == MT_TELOTHER_FX1) &&
+               !(ctx.thing->type == MT_TELOTHER_FX2) &&
+               !(ctx.thing->type == MT_TELOTHER_FX3) &&
+               !(ctx.thing->type == MT_TELOTHER_FX4) &&
+               !(ctx.thing->type == MT_TELOTHER_FX5) && (P_Random() < 192))
 # endif
             {
-                P_SpawnBloodSplatter(tmThing->origin[VX], tmThing->origin[VY], tmThing->origin[VZ], thing);
+                P_SpawnBloodSplatter(ctx.thing->origin[VX], ctx.thing->origin[VY], ctx.thing->origin[VZ], thing);
             }
 
-            P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+            P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
         }
 #endif
 
@@ -848,17 +907,17 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         return true;
     }
 
-    if((thing->flags2 & MF2_PUSHABLE) && !(tmThing->flags2 & MF2_CANNOTPUSH))
+    if((thing->flags2 & MF2_PUSHABLE) && !(ctx.thing->flags2 & MF2_CANNOTPUSH))
     {
         // Push thing.
-        coord_t pushImpulse[2] = {tmThing->mom[MX] / 4, tmThing->mom[MY] / 4};
+        coord_t pushImpulse[2] = {ctx.thing->mom[MX] / 4, ctx.thing->mom[MY] / 4};
 
         for (int axis = 0; axis < 2; ++axis)
         {
             // Do not exceed the momentum of the thing doing the pushing.
             if (cfg.common.pushableMomentumLimitedToPusher)
             {
-                coord_t maxIncrement = tmThing->mom[axis] - thing->mom[axis];
+                coord_t maxIncrement = ctx.thing->mom[axis] - thing->mom[axis];
                 if (thing->mom[axis] > 0 && pushImpulse[axis] > 0)
                 {
                     pushImpulse[axis] = de::max(0.0, de::min(pushImpulse[axis], maxIncrement));
@@ -880,59 +939,59 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
     // @fixme Kludge: Always treat blood as a solid.
     dd_bool solid;
-    if(tmThing->type == MT_BLOOD)
+    if(ctx.thing->type == MT_BLOOD)
     {
         solid = true;
     }
     else
     {
         solid = (thing->flags & MF_SOLID) && !(thing->flags & MF_NOCLIP) &&
-                (tmThing->flags & MF_SOLID);
+                (ctx.thing->flags & MF_SOLID);
     }
     // Kludge end.
 
 #if __JHEXEN__
-    if(tmThing->player && tmThing->onMobj && solid)
+    if(ctx.thing->player && ctx.thing->onMobj && solid)
     {
         /// @todo Unify Hexen's onMobj logic with the other games.
 
         // We may be standing on more than one thing.
-        if(tmThing->origin[VZ] > thing->origin[VZ] + thing->height - 24)
+        if(ctx.thing->origin[VZ] > thing->origin[VZ] + thing->height - 24)
         {
             // Stepping up on this is possible.
-            tmFloorZ = MAX_OF(tmFloorZ, thing->origin[VZ] + thing->height);
+            ctx.floorZ = MAX_OF(ctx.floorZ, thing->origin[VZ] + thing->height);
             solid = false;
         }
     }
 #endif
 
     // Check for special pickup.
-    if((thing->flags & MF_SPECIAL) && (tmThing->flags & MF_PICKUP))
+    if((thing->flags & MF_SPECIAL) && (ctx.thing->flags & MF_PICKUP))
     {
-        P_TouchSpecialMobj(thing, tmThing); // Can remove thing.
+        P_TouchSpecialMobj(thing, ctx.thing); // Can remove thing.
     }
 #if !__JHEXEN__
     else if(overlap && solid)
     {
         // How are we positioned, allow step up?
-        if(!(thing->flags & MF_CORPSE) && tm[VZ] > thing->origin[VZ] + thing->height - 24)
+        if(!(thing->flags & MF_CORPSE) && ctx.pos[VZ] > thing->origin[VZ] + thing->height - 24)
         {
-            tmThing->onMobj = thing;
-            if(thing->origin[VZ] + thing->height > tmFloorZ)
+            ctx.thing->onMobj = thing;
+            if(thing->origin[VZ] + thing->height > ctx.floorZ)
             {
-                tmFloorZ = thing->origin[VZ] + thing->height;
+                ctx.floorZ = thing->origin[VZ] + thing->height;
             }
             return false;
         }
     }
-    else if(!tmThing->player && solid)
+    else if(!ctx.thing->player && solid)
     {
         // A non-player object is contacting a solid object.
-        if(cfg.allowMonsterFloatOverBlocking && (tmThing->flags & MF_FLOAT) && !thing->player)
+        if(cfg.allowMonsterFloatOverBlocking && (ctx.thing->flags & MF_FLOAT) && !thing->player)
         {
             coord_t top = thing->origin[VZ] + thing->height;
-            tmThing->onMobj = thing;
-            tmFloorZ = MAX_OF(tmFloorZ, top);
+            ctx.thing->onMobj = thing;
+            ctx.floorZ = MAX_OF(ctx.floorZ, top);
             return false;
         }
     }
@@ -942,13 +1001,15 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 }
 
 /**
- * Adjusts tmFloorZ and tmCeilingZ as lines are contacted.
+ * Adjusts the floor and ceiling heights of the context as lines are contacted.
  */
-static int PIT_CheckLine(Line *ld, void * /*context*/)
+static int PIT_CheckLine(Line *ld, void *context)
 {
+    CollisionContext &ctx = *static_cast<CollisionContext *>(context);
+
     AABoxd const *aaBox = (AABoxd *)P_GetPtrp(ld, DMU_BOUNDING_BOX);
-    if(tmBox.minX >= aaBox->maxX || tmBox.minY >= aaBox->maxY ||
-       tmBox.maxX <= aaBox->minX || tmBox.maxY <= aaBox->minY)
+    if(ctx.box.minX >= aaBox->maxX || ctx.box.minY >= aaBox->maxY ||
+       ctx.box.maxX <= aaBox->minX || ctx.box.maxY <= aaBox->minY)
     {
         return false;
     }
@@ -958,9 +1019,9 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
      * collision testing -- the rest of the playsim uses coord_t, and we don't
      * want conflicting results (e.g., getting stuck in tight spaces).
      */
-    if(Mobj_IsPlayer(tmThing) && !Mobj_IsVoodooDoll(tmThing))
+    if(Mobj_IsPlayer(ctx.thing) && !Mobj_IsVoodooDoll(ctx.thing))
     {
-        if(Line_BoxOnSide(ld, &tmBox)) // double precision floats
+        if(Line_BoxOnSide(ld, &ctx.box)) // double precision floats
         {
             return false;
         }
@@ -968,7 +1029,7 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     else
     {
         // Fixed-precision math gives better compatibility with vanilla DOOM.
-        if(Line_BoxOnSide_FixedPrecision(ld, &tmBox))
+        if(Line_BoxOnSide_FixedPrecision(ld, &ctx.box))
         {
             return false;
         }
@@ -978,24 +1039,24 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     xline_t *xline = P_ToXLine(ld);
 
 #if !__JHEXEN__
-    tmThing->wallHit = true;
+    ctx.thing->wallHit = true;
 
     // A Hit event will be sent to special lines.
     if(xline->special)
     {
-        tmHitLine = ld;
+        ctx.hitLine = ld;
     }
 #endif
 
-    if(!P_GetPtrp(ld, DMU_BACK_SECTOR)) // One sided line.
+    if(!Line_BackSector(ld)) // One sided line.
     {
 #if __JHEXEN__
-        if(tmThing->flags2 & MF2_BLASTED)
+        if(ctx.thing->flags2 & MF2_BLASTED)
         {
-            P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+            P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
         }
 
-        checkForPushSpecial(ld, 0, tmThing);
+        checkForPushSpecial(ld, 0, ctx.thing);
         return true;
 #else
         coord_t d1[2];
@@ -1014,62 +1075,62 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
          *       are only 8 units apart could be crossed in either order.
          */
 
-        tmBlockingLine = ld;
-        return !(tmUnstuck && !untouched(ld, tmThing) &&
-            ((tm[VX] - tmThing->origin[VX]) * d1[1]) >
-            ((tm[VY] - tmThing->origin[VY]) * d1[0]));
+        ctx.blockingLine = ld;
+        return !(ctx.unstuck && !untouched(ld, ctx.thing) &&
+            ((ctx.pos[VX] - ctx.thing->origin[VX]) * d1[1]) >
+            ((ctx.pos[VY] - ctx.thing->origin[VY]) * d1[0]));
 #endif
     }
 
     /// @todo Will never pass this test due to above. Is the previous check
     ///       supposed to qualify player mobjs only?
 #if __JHERETIC__
-    if(!P_GetPtrp(ld, DMU_BACK_SECTOR)) // one sided line
+    if(!Line_BackSector(ld)) // one sided line
     {
         // Missiles can trigger impact specials
-        if((tmThing->flags & MF_MISSILE) && xline->special)
+        if((ctx.thing->flags & MF_MISSILE) && xline->special)
         {
-            IterList_PushBack(spechit, ld);
+            IterList_PushBack(ctx.specHits, ld);
         }
         return true;
     }
 #endif
 
-    if(!(tmThing->flags & MF_MISSILE))
+    if(!(ctx.thing->flags & MF_MISSILE))
     {
         // Explicitly blocking everything?
         if(P_GetIntp(ld, DMU_FLAGS) & DDLF_BLOCKING)
         {
 #if __JHEXEN__
-            if(tmThing->flags2 & MF2_BLASTED)
+            if(ctx.thing->flags2 & MF2_BLASTED)
             {
-                P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+                P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
             }
 
-            checkForPushSpecial(ld, 0, tmThing);
+            checkForPushSpecial(ld, 0, ctx.thing);
             return true;
 #else
             // $unstuck: allow escape.
-            return !(tmUnstuck && !untouched(ld, tmThing));
+            return !(ctx.unstuck && !untouched(ld, ctx.thing));
 #endif
         }
 
         // Block monsters only?
 #if __JHEXEN__
-        if(!tmThing->player && tmThing->type != MT_CAMERA &&
+        if(!ctx.thing->player && ctx.thing->type != MT_CAMERA &&
            (xline->flags & ML_BLOCKMONSTERS))
 #elif __JHERETIC__
-        if(!tmThing->player && tmThing->type != MT_POD &&
+        if(!ctx.thing->player && ctx.thing->type != MT_POD &&
            (xline->flags & ML_BLOCKMONSTERS))
 #else
-        if(!tmThing->player &&
+        if(!ctx.thing->player &&
            (xline->flags & ML_BLOCKMONSTERS))
 #endif
         {
 #if __JHEXEN__
-            if(tmThing->flags2 & MF2_BLASTED)
+            if(ctx.thing->flags2 & MF2_BLASTED)
             {
-                P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+                P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
             }
 #endif
             return true;
@@ -1077,51 +1138,52 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     }
 
 #if __JDOOM64__
-    if((tmThing->flags & MF_MISSILE) && (xline->flags & ML_BLOCKALL))
+    if((ctx.thing->flags & MF_MISSILE) && (xline->flags & ML_BLOCKALL))
     {
         // $unstuck: allow escape.
-        return !(tmUnstuck && !untouched(ld, tmThing));
+        return !(ctx.unstuck && !untouched(ld, ctx.thing));
     }
 #endif
 
     LineOpening opening; Line_Opening(ld, &opening);
 
     // Adjust floor / ceiling heights.
-    if(opening.top < tmCeilingZ)
+    if(opening.top < ctx.ceilingZ)
     {
-        tmCeilingZ    = opening.top;
-        tmCeilingLine = ld;
+        ctx.ceilingZ    = opening.top;
+        ctx.ceilingLine = ld;
 #if !__JHEXEN__
-        tmBlockingLine     = ld;
+        ctx.blockingLine     = ld;
 #endif
     }
-    if(opening.bottom > tmFloorZ)
+    if(opening.bottom > ctx.floorZ)
     {
-        tmFloorZ    = opening.bottom;
-        tmFloorLine = ld;
+        ctx.floorZ    = opening.bottom;
+        ctx.floorLine = ld;
 #if !__JHEXEN__
-        tmBlockingLine   = ld;
+        ctx.blockingLine   = ld;
 #endif
     }
-    if(opening.lowFloor < tmDropoffZ)
+    if(opening.lowFloor < ctx.dropoffZ)
     {
-        tmDropoffZ  = opening.lowFloor;
+        ctx.dropoffZ  = opening.lowFloor;
     }
 
     // If contacted a special line, add it to the list.
     if(P_ToXLine(ld)->special)
     {
-        IterList_PushBack(spechit, ld);
+        IterList_PushBack(ctx.specHits, ld);
     }
 
 #if !__JHEXEN__
-    tmThing->wallHit = false;
+    ctx.thing->wallHit = false;
 #endif
 
     return false; // Continue iteration.
 }
 
-dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
+static dd_bool checkPosition(CollisionContext &ctx, mobj_t *thing, coord_t x, coord_t y,
+                             coord_t z)
 {
 #if defined(__JHERETIC__)
     if (thing->type != MT_POD) // vanilla onMobj behavior for pods
@@ -1133,34 +1195,34 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
 #endif
     thing->wallHit = false;
 
-    tmThing         = thing;
-    V3d_Set(tm, x, y, z);
-    tmBox           = AABoxd(tm[VX] - tmThing->radius, tm[VY] - tmThing->radius,
-                             tm[VX] + tmThing->radius, tm[VY] + tmThing->radius);
+    ctx.thing = thing;
+    V3d_Set(ctx.pos, x, y, z);
+    ctx.box = AABoxd(ctx.pos[VX] - thing->radius, ctx.pos[VY] - thing->radius,
+                     ctx.pos[VX] + thing->radius, ctx.pos[VY] + thing->radius);
 #if !__JHEXEN__
-    tmHitLine       = 0;
+    ctx.hitLine = 0;
 #endif
 
     // The base floor/ceiling is from the BSP leaf that contains the point.
     // Any contacted lines the step closer together will adjust them.
-    Sector *newSector = Sector_AtPoint_FixedPrecision(tm);
+    Sector *newSector = Sector_AtPoint_FixedPrecision(ctx.pos);
 
-    tmCeilingLine   = tmFloorLine = 0;
-    tmFloorZ        = tmDropoffZ = P_GetDoublep(newSector, DMU_FLOOR_HEIGHT);
-    tmCeilingZ      = P_GetDoublep(newSector, DMU_CEILING_HEIGHT);
+    ctx.ceilingLine   = ctx.floorLine = 0;
+    ctx.floorZ        = ctx.dropoffZ = Sector_FloorHeight(newSector);
+    ctx.ceilingZ      = Sector_CeilingHeight(newSector);
 #if __JHEXEN__
-    tmFloorMaterial = (world_Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
+    ctx.floorMaterial = (world_Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
 #else
-    tmBlockingLine  = 0;
-    tmUnstuck       = Mobj_IsPlayer(thing) && !Mobj_IsVoodooDoll(thing);
+    ctx.blockingLine  = 0;
+    ctx.unstuck       = Mobj_IsPlayer(thing) && !Mobj_IsVoodooDoll(thing);
 #endif
 
-    IterList_Clear(spechit);
+    IterList_Clear(ctx.specHits);
 
-    if(tmThing->flags & MF_NOCLIP)
+    if(thing->flags & MF_NOCLIP)
     {
 #if __JHEXEN__
-        if(!(tmThing->flags & MF_SKULLFLY))
+        if(!(thing->flags & MF_SKULLFLY))
         {
             return true;
         }
@@ -1173,7 +1235,7 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
 
     // Check things first, possibly picking things up;
 #if __JHEXEN__
-    tmBlockingMobj = 0;
+    ctx.blockingMobj = 0;
 #endif
 
     // The camera goes through all objects.
@@ -1184,10 +1246,10 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
          * into mapblocks based on their origin point and can overlap adjacent
          * blocks by up to MAXRADIUS units.
          */
-        AABoxd tmBoxExpanded(tmBox.minX - MAXRADIUS, tmBox.minY - MAXRADIUS,
-                             tmBox.maxX + MAXRADIUS, tmBox.maxY + MAXRADIUS);
+        AABoxd boxExpanded(ctx.box.minX - MAXRADIUS, ctx.box.minY - MAXRADIUS,
+                           ctx.box.maxX + MAXRADIUS, ctx.box.maxY + MAXRADIUS);
 
-        if(Mobj_BoxIterator(&tmBoxExpanded, PIT_CheckThing, 0))
+        if(Mobj_BoxIterator(&boxExpanded, PIT_CheckThing, &ctx))
         {
             return false;
         }
@@ -1203,7 +1265,7 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
     }
 
 #if __JHEXEN__
-    if(tmThing->flags & MF_NOCLIP)
+    if(ctx.thing->flags & MF_NOCLIP)
     {
         return true;
     }
@@ -1211,10 +1273,15 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
 
     // Check lines.
 #if __JHEXEN__
-    tmBlockingMobj = 0;
+    ctx.blockingMobj = 0;
 #endif
 
-    return !Line_BoxIterator(&tmBox, LIF_ALL, PIT_CheckLine, 0);
+    return !Line_BoxIterator(&ctx.box, LIF_ALL, PIT_CheckLine, &ctx);
+}
+
+dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
+{
+    return checkPosition(tmContext, thing, x, y, z);
 }
 
 dd_bool P_CheckPosition(mobj_t *thing, coord_t const pos[3])
@@ -1234,20 +1301,20 @@ dd_bool Mobj_IsRemotePlayer(mobj_t *mo)
 }
 
 #if __JDOOM64__ || __JHERETIC__
-static void checkMissileImpact(mobj_t &mobj)
+static void checkMissileImpact(CollisionContext &ctx, mobj_t &mobj)
 {
     if(IS_CLIENT) return;
 
     if(!(mobj.flags & MF_MISSILE)) return;
     if(!mobj.target || !mobj.target->player) return;
 
-    if(IterList_Empty(spechit)) return;
+    if(IterList_Empty(ctx.specHits)) return;
 
-    IterList_SetIteratorDirection(spechit, ITERLIST_BACKWARD);
-    IterList_RewindIterator(spechit);
+    IterList_SetIteratorDirection(ctx.specHits, ITERLIST_BACKWARD);
+    IterList_RewindIterator(ctx.specHits);
 
     Line *line;
-    while((line = (Line *)IterList_MoveIterator(spechit)) != 0)
+    while((line = (Line *)IterList_MoveIterator(ctx.specHits)) != 0)
     {
         P_ActivateLine(line, mobj.target, 0, SPAC_IMPACT);
     }
@@ -1259,41 +1326,41 @@ static void checkMissileImpact(mobj_t &mobj)
  * MF_TELEPORT is set. $dropoff_fix
  */
 #if __JHEXEN__
-static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y)
+static dd_bool tryMove(CollisionContext &ctx, mobj_t *thing, coord_t x, coord_t y)
 #else
-static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
+static dd_bool tryMove(CollisionContext &ctx, mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #endif
 {
     dd_bool const isRemotePlayer = Mobj_IsRemotePlayer(thing);
 
-    // $dropoff_fix: tmFellDown.
-    tmFloatOk  = false;
+    // $dropoff_fix: fellDown.
+    ctx.floatOk  = false;
 #if !__JHEXEN__
-    tmFellDown = false;
+    ctx.fellDown = false;
 #endif
 
 #if __JHEXEN__
-    if(!P_CheckPositionXY(thing, x, y))
+    if(!checkPosition(ctx, thing, x, y, DDMAXFLOAT))
 #else
-    if(!P_CheckPositionXYZ(thing, x, y, thing->origin[VZ]))
+    if(!checkPosition(ctx, thing, x, y, thing->origin[VZ]))
 #endif
     {
 #if __JHEXEN__
-        if(!tmBlockingMobj || tmBlockingMobj->player || !thing->player)
+        if(!ctx.blockingMobj || ctx.blockingMobj->player || !thing->player)
         {
             goto pushline;
         }
-        else if(tmBlockingMobj->origin[VZ] + tmBlockingMobj->height - thing->origin[VZ] > 24 ||
-                (P_GetDoublep(Mobj_Sector(tmBlockingMobj), DMU_CEILING_HEIGHT) -
-                 (tmBlockingMobj->origin[VZ] + tmBlockingMobj->height) < thing->height) ||
-                (tmCeilingZ - (tmBlockingMobj->origin[VZ] + tmBlockingMobj->height) <
+        else if(ctx.blockingMobj->origin[VZ] + ctx.blockingMobj->height - thing->origin[VZ] > 24 ||
+                (Sector_CeilingHeight(Mobj_Sector(ctx.blockingMobj)) -
+                 (ctx.blockingMobj->origin[VZ] + ctx.blockingMobj->height) < thing->height) ||
+                (ctx.ceilingZ - (ctx.blockingMobj->origin[VZ] + ctx.blockingMobj->height) <
                  thing->height))
         {
             goto pushline;
         }
 #else
 #  if __JHERETIC__
-        checkMissileImpact(*thing);
+        checkMissileImpact(ctx, *thing);
 #  endif
         // Would we hit another thing or a solid wall?
         if(!thing->onMobj || thing->wallHit)
@@ -1304,15 +1371,15 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
     if(!(thing->flags & MF_NOCLIP))
     {
 #if __JHEXEN__
-        if(tmCeilingZ - tmFloorZ < thing->height)
+        if(ctx.ceilingZ - ctx.floorZ < thing->height)
         {   // Doesn't fit.
             goto pushline;
         }
 
-        tmFloatOk = true;
+        ctx.floatOk = true;
 
         if(!(thing->flags & MF_TELEPORT) &&
-           tmCeilingZ - thing->origin[VZ] < thing->height &&
+           ctx.ceilingZ - thing->origin[VZ] < thing->height &&
            thing->type != MT_LIGHTNING_CEILING && !(thing->flags2 & MF2_FLY))
         {
             // Mobj must lower itself to fit.
@@ -1320,19 +1387,19 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
         }
 #else
         // Possibly allow escape if otherwise stuck.
-        dd_bool ret = (tmUnstuck &&
-            !(tmCeilingLine && untouched(tmCeilingLine, tmThing)) &&
-            !(tmFloorLine   && untouched(tmFloorLine, tmThing)));
+        dd_bool ret = (ctx.unstuck &&
+            !(ctx.ceilingLine && untouched(ctx.ceilingLine, ctx.thing)) &&
+            !(ctx.floorLine   && untouched(ctx.floorLine, ctx.thing)));
 
-        if(tmCeilingZ - tmFloorZ < thing->height)
+        if(ctx.ceilingZ - ctx.floorZ < thing->height)
         {
             return ret; // Doesn't fit.
         }
 
         // Mobj must lower to fit.
-        tmFloatOk = true;
+        ctx.floatOk = true;
         if(!(thing->flags & MF_TELEPORT) && !(thing->flags2 & MF2_FLY) &&
-           tmCeilingZ - thing->origin[VZ] < thing->height)
+           ctx.ceilingZ - thing->origin[VZ] < thing->height)
         {
             return ret;
         }
@@ -1345,24 +1412,24 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 # endif
             )
         {
-            if(!isRemotePlayer && tmFloorZ - thing->origin[VZ] > 24)
+            if(!isRemotePlayer && ctx.floorZ - thing->origin[VZ] > 24)
             {
 # if __JHERETIC__
-                checkMissileImpact(*thing);
+                checkMissileImpact(ctx, *thing);
 # endif
                 return ret;
             }
         }
 # if __JHERETIC__
-        if((thing->flags & MF_MISSILE) && tmFloorZ > thing->origin[VZ])
+        if((thing->flags & MF_MISSILE) && ctx.floorZ > thing->origin[VZ])
         {
-            checkMissileImpact(*thing);
+            checkMissileImpact(ctx, *thing);
         }
 # endif
 #endif
         if(thing->flags2 & MF2_FLY)
         {
-            if(thing->origin[VZ] + thing->height > tmCeilingZ)
+            if(thing->origin[VZ] + thing->height > ctx.ceilingZ)
             {
                 thing->mom[MZ] = -8;
 #if __JHEXEN__
@@ -1371,8 +1438,8 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
                 return false;
 #endif
             }
-            else if(thing->origin[VZ] < tmFloorZ &&
-                    tmFloorZ - tmDropoffZ > 24)
+            else if(thing->origin[VZ] < ctx.floorZ &&
+                    ctx.floorZ - ctx.dropoffZ > 24)
             {
                 thing->mom[MZ] = 8;
 #if __JHEXEN__
@@ -1388,7 +1455,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
            // The Minotaur floor fire (MT_MNTRFX2) can step up any amount
            && thing->type != MT_MNTRFX2 && thing->type != MT_LIGHTNING_FLOOR
            && !isRemotePlayer
-           && tmFloorZ - thing->origin[VZ] > 24)
+           && ctx.floorZ - thing->origin[VZ] > 24)
         {
             goto pushline;
         }
@@ -1396,7 +1463,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 
 #if __JHEXEN__
         if(!(thing->flags & (MF_DROPOFF | MF_FLOAT)) &&
-           (tmFloorZ - tmDropoffZ > 24) &&
+           (ctx.floorZ - ctx.dropoffZ > 24) &&
            !(thing->flags2 & MF2_BLASTED))
         {
             // Can't move over a dropoff unless it's been blasted.
@@ -1415,29 +1482,29 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
             // Dropoff height limit.
             if(cfg.avoidDropoffs)
             {
-                if(tmFloorZ - tmDropoffZ > 24)
+                if(ctx.floorZ - ctx.dropoffZ > 24)
                 {
                     return false; // Don't stand over dropoff.
                 }
             }
             else
             {
-                coord_t floorZ = tmFloorZ;
+                coord_t floorZ = ctx.floorZ;
 
                 if(thing->onMobj)
                 {
                     // Thing is stood on something so use our z position as the floor.
-                    floorZ = (thing->origin[VZ] > tmFloorZ? thing->origin[VZ] : tmFloorZ);
+                    floorZ = (thing->origin[VZ] > ctx.floorZ? thing->origin[VZ] : ctx.floorZ);
                 }
 
                 if(!dropoff)
                 {
-                    if(thing->floorZ - floorZ > 24 || thing->dropOffZ - tmDropoffZ > 24)
+                    if(thing->floorZ - floorZ > 24 || thing->dropOffZ - ctx.dropoffZ > 24)
                         return false;
                 }
                 else
                 {
-                    tmFellDown = !(thing->flags & MF_NOGRAVITY) && thing->origin[VZ] - floorZ > 24;
+                    ctx.fellDown = !(thing->flags & MF_NOGRAVITY) && thing->origin[VZ] - floorZ > 24;
                 }
             }
         }
@@ -1447,10 +1514,10 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
         /// @todo D64 Mother demon fire attack.
         if(!(thing->flags & MF_TELEPORT) /*&& thing->type != MT_SPAWNFIRE*/
             && !isRemotePlayer
-            && tmFloorZ - thing->origin[VZ] > 24)
+            && ctx.floorZ - thing->origin[VZ] > 24)
         {
             // Too big a step up
-            checkMissileImpact(*thing);
+            checkMissileImpact(ctx, *thing);
             return false;
         }
 #endif
@@ -1458,8 +1525,8 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #if __JHEXEN__
         // Must stay within a sector of a certain floor type?
         if((thing->flags2 & MF2_CANTLEAVEFLOORPIC) &&
-           (tmFloorMaterial != P_GetPtrp(Mobj_Sector(thing), DMU_FLOOR_MATERIAL) ||
-            !FEQUAL(tmFloorZ, thing->origin[VZ])))
+           (ctx.floorMaterial != P_GetPtrp(Mobj_Sector(thing), DMU_FLOOR_MATERIAL) ||
+            !FEQUAL(ctx.floorZ, thing->origin[VZ])))
         {
             return false;
         }
@@ -1468,7 +1535,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #if !__JHEXEN__
         // $dropoff: prevent falling objects from going up too many steps.
         if(!thing->player && (thing->intFlags & MIF_FALLING) &&
-           tmFloorZ - thing->origin[VZ] > (thing->mom[MX] * thing->mom[MX]) +
+           ctx.floorZ - thing->origin[VZ] > (thing->mom[MX] * thing->mom[MX]) +
                                           (thing->mom[MY] * thing->mom[MY]))
         {
             return false;
@@ -1483,10 +1550,10 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 
     thing->origin[VX] = x;
     thing->origin[VY] = y;
-    thing->floorZ     = tmFloorZ;
-    thing->ceilingZ   = tmCeilingZ;
+    thing->floorZ     = ctx.floorZ;
+    thing->ceilingZ   = ctx.ceilingZ;
 #if __JDOOM__ || __JDOOM64__ || __JHERETIC__
-    thing->dropOffZ   = tmDropoffZ; // $dropoff_fix: keep track of dropoffs.
+    thing->dropOffZ   = ctx.dropoffZ; // $dropoff_fix: keep track of dropoffs.
 #endif
 
     P_MobjLink(thing);
@@ -1495,7 +1562,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
     {
         thing->floorClip = 0;
 
-        if(FEQUAL(thing->origin[VZ], P_GetDoublep(Mobj_Sector(thing), DMU_FLOOR_HEIGHT)))
+        if(FEQUAL(thing->origin[VZ], Sector_FloorHeight(Mobj_Sector(thing))))
         {
             terraintype_t const *tt = P_MobjFloorTerrain(thing);
             if(tt->flags & TTF_FLOORCLIP)
@@ -1509,7 +1576,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
     if(!(thing->flags & (MF_TELEPORT | MF_NOCLIP)))
     {
         Line *line;
-        while((line = (Line *)IterList_Pop(spechit)) != 0)
+        while((line = (Line *)IterList_Pop(ctx.specHits)) != 0)
         {
             // See if the line was crossed.
             if(P_ToXLine(line)->special)
@@ -1536,7 +1603,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 
                     if(!IS_CLIENT && thing->player)
                     {
-                        App_Log(DE2_DEV_MAP_VERBOSE, "P_TryMove2: Mobj %i crossing line %i from %f,%f to %f,%f",
+                        App_Log(DE2_DEV_MAP_VERBOSE, "tryMove: Mobj %i crossing line %i from %f,%f to %f,%f",
                                 thing->thinker.id, P_ToIndex(line),
                                 oldPos[VX], oldPos[VY],
                                 thing->origin[VX], thing->origin[VY]);
@@ -1555,16 +1622,16 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
   pushline:
     if(!(thing->flags & (MF_TELEPORT | MF_NOCLIP)))
     {
-        if(tmThing->flags2 & MF2_BLASTED)
+        if(ctx.thing->flags2 & MF2_BLASTED)
         {
-            P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+            P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
         }
 
-        IterList_SetIteratorDirection(spechit, ITERLIST_BACKWARD);
-        IterList_RewindIterator(spechit);
+        IterList_SetIteratorDirection(ctx.specHits, ITERLIST_BACKWARD);
+        IterList_RewindIterator(ctx.specHits);
 
         Line *line;
-        while((line = (Line *)IterList_MoveIterator(spechit)) != 0)
+        while((line = (Line *)IterList_MoveIterator(ctx.specHits)) != 0)
         {
             // See if the line was crossed.
             int side = Line_PointOnSide(line, thing->origin) < 0;
@@ -1581,17 +1648,21 @@ dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y)
 dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff, dd_bool slide)
 #endif
 {
+    world::TickProfiler::Scope profile(world::TickProfiler::Movement);
+
+    CollisionContext &ctx = tmContext;
+
 #if __JHEXEN__
-    return P_TryMove2(thing, x, y);
+    return tryMove(ctx, thing, x, y);
 #else
     // $dropoff_fix
-    dd_bool res = P_TryMove2(thing, x, y, dropoff);
+    dd_bool res = tryMove(ctx, thing, x, y, dropoff);
 
-    if(!res && tmHitLine)
+    if(!res && ctx.hitLine)
     {
         // Move not possible, see if the thing hit a line and send a Hit
         // event to it.
-        XL_HitLine(tmHitLine, Line_PointOnSide(tmHitLine, thing->origin) < 0,
+        XL_HitLine(ctx.hitLine, Line_PointOnSide(ctx.hitLine, thing->origin) < 0,
                    thing);
     }
 
@@ -1748,7 +1819,7 @@ static int PTR_ShootTraverse(Intercept const *icpt, void *context)
         Line *line = icpt->line;
         xline_t *xline = P_ToXLine(line);
 
-        Sector *backSec = (Sector *)P_GetPtrp(line, DMU_BACK_SECTOR);
+        Sector *backSec = Line_BackSector(line);
 
         if(!backSec || !(xline->flags & ML_TWOSIDED))
         {
@@ -1776,20 +1847,20 @@ static int PTR_ShootTraverse(Intercept const *icpt, void *context)
         // Crosses a two sided line.
         Interceptor_AdjustOpening(icpt->trace, line);
 
-        frontSec = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR);
+        frontSec = Line_FrontSector(line);
 
         dist = parm.range * icpt->distance;
         slope = 0;
-        if(!FEQUAL(P_GetDoublep(frontSec, DMU_FLOOR_HEIGHT),
-                   P_GetDoublep(backSec,  DMU_FLOOR_HEIGHT)))
+        if(!FEQUAL(Sector_FloorHeight(frontSec),
+                   Sector_FloorHeight(backSec)))
         {
             slope = (Interceptor_Opening(icpt->trace)->bottom - tracePos[VZ]) / dist;
 
             if(slope > aimSlope) goto hitline;
         }
 
-        if(!FEQUAL(P_GetDoublep(frontSec, DMU_CEILING_HEIGHT),
-                   P_GetDoublep(backSec,  DMU_CEILING_HEIGHT)))
+        if(!FEQUAL(Sector_CeilingHeight(frontSec),
+                   Sector_CeilingHeight(backSec)))
         {
             slope = (Interceptor_Opening(icpt->trace)->top - tracePos[VZ]) / dist;
 
@@ -1813,16 +1884,16 @@ static int PTR_ShootTraverse(Intercept const *icpt, void *context)
             // surface, no puff must be shown.
             if((P_GetIntp(P_GetPtrp(frontSec, DMU_CEILING_MATERIAL),
                           DMU_FLAGS) & MATF_SKYMASK) &&
-               (pos[VZ] > P_GetDoublep(frontSec, DMU_CEILING_HEIGHT) ||
-                pos[VZ] > P_GetDoublep(backSec,  DMU_CEILING_HEIGHT)))
+               (pos[VZ] > Sector_CeilingHeight(frontSec) ||
+                pos[VZ] > Sector_CeilingHeight(backSec)))
             {
                 return true;
             }
 
             if((P_GetIntp(P_GetPtrp(backSec, DMU_FLOOR_MATERIAL),
                           DMU_FLAGS) & MATF_SKYMASK) &&
-               (pos[VZ] < P_GetDoublep(frontSec, DMU_FLOOR_HEIGHT) ||
-                pos[VZ] < P_GetDoublep(backSec,  DMU_FLOOR_HEIGHT)))
+               (pos[VZ] < Sector_FloorHeight(frontSec) ||
+                pos[VZ] < Sector_FloorHeight(backSec)))
             {
                 return true;
             }
@@ -1842,8 +1913,8 @@ static int PTR_ShootTraverse(Intercept const *icpt, void *context)
             vec3d_t stepv   = { d[VX] / step, d[VY] / step, d[VZ] / step };
 
             // Backtrack until we find a non-empty sector.
-            coord_t cFloor = P_GetDoublep(contact, DMU_FLOOR_HEIGHT);
-            coord_t cCeil  = P_GetDoublep(contact, DMU_CEILING_HEIGHT);
+            coord_t cFloor = Sector_FloorHeight(contact);
+            coord_t cCeil  = Sector_CeilingHeight(contact);
             while(cCeil <= cFloor && contact != originSector)
             {
                 d[VX] -= 8 * stepv[VX];
@@ -2042,8 +2113,8 @@ static int PTR_AimTraverse(Intercept const *icpt, void * /*context*/)
         Sector *backSec, *frontSec;
 
         if(!(P_ToXLine(line)->flags & ML_TWOSIDED) ||
-           !(frontSec = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR)) ||
-           !(backSec  = (Sector *)P_GetPtrp(line, DMU_BACK_SECTOR)))
+           !(frontSec = Line_FrontSector(line)) ||
+           !(backSec  = Line_BackSector(line)))
         {
             return !(Line_PointOnSide(line, tracePos) < 0);
         }
@@ -2056,10 +2127,10 @@ static int PTR_AimTraverse(Intercept const *icpt, void * /*context*/)
         }
 
         coord_t dist   = attackRange * icpt->distance;
-        coord_t fFloor = P_GetDoublep(frontSec, DMU_FLOOR_HEIGHT);
-        coord_t fCeil  = P_GetDoublep(frontSec, DMU_CEILING_HEIGHT);
-        coord_t bFloor = P_GetDoublep(backSec, DMU_FLOOR_HEIGHT);
-        coord_t bCeil  = P_GetDoublep(backSec, DMU_CEILING_HEIGHT);
+        coord_t fFloor = Sector_FloorHeight(frontSec);
+        coord_t fCeil  = Sector_CeilingHeight(frontSec);
+        coord_t bFloor = Sector_FloorHeight(backSec);
+        coord_t bCeil  = Sector_CeilingHeight(backSec);
 
         coord_t slope;
         if(!FEQUAL(fFloor, bFloor))
@@ -2278,7 +2349,7 @@ void P_LineAttack(mobj_t *t1, angle_t angle, coord_t distance, coord_t slope,
     }
 }
 
-struct pit_radiusattack_params_t
+struct radiusattack_params_t
 {
     mobj_t *source;     ///< Mobj which caused the attack.
     mobj_t *bomb;       ///< Epicenter of the attack.
@@ -2289,10 +2360,15 @@ struct pit_radiusattack_params_t
 #endif
 };
 
-static int PIT_RadiusAttack(mobj_t *thing, void *context)
+/**
+ * Determines whether @a thing can be afflicted by the radius attack, ignoring
+ * line of sight.
+ *
+ * @param dist  Distance from the epicenter is written here.
+ */
+static bool isRadiusAttackVictim(mobj_t const *thing, radiusattack_params_t const &parm,
+                                 coord_t &dist)
 {
-    pit_radiusattack_params_t &parm = *static_cast<pit_radiusattack_params_t *>(context);
-
     if(!(thing->flags & MF_SHOOTABLE))
     {
         return false;
@@ -2322,7 +2398,7 @@ static int PIT_RadiusAttack(mobj_t *thing, void *context)
                       fabs(thing->origin[VY] - parm.bomb->origin[VY]),
                       fabs((thing->origin[VZ] + thing->height / 2) - parm.bomb->origin[VZ]) };
 
-    coord_t dist = (delta[VX] > delta[VY]? delta[VX] : delta[VY]);
+    dist = (delta[VX] > delta[VY]? delta[VX] : delta[VY]);
 #if __JHEXEN__
     if(!cfg.common.netNoMaxZRadiusAttack)
     {
@@ -2336,23 +2412,7 @@ static int PIT_RadiusAttack(mobj_t *thing, void *context)
 #endif
 
     dist = MAX_OF(dist - thing->radius, 0);
-    if(dist >= parm.distance)
-    {
-        return false; // Out of range.
-    }
-
-    // Must be in direct path.
-    if(P_CheckSight(thing, parm.bomb))
-    {
-        int damage = (parm.damage * (parm.distance - dist) / parm.distance) + 1;
-#if __JHEXEN__
-        if(thing->player) damage /= 4;
-#endif
-
-        P_DamageMobj(thing, parm.bomb, parm.source, damage, false);
-    }
-
-    return false;
+    return dist < parm.distance; // Out of range?
 }
 
 #if __JHEXEN__
@@ -2365,7 +2425,7 @@ void P_RadiusAttack(mobj_t *bomb, mobj_t *source, int damage, int distance)
     AABoxd const box(bomb->origin[VX] - dist, bomb->origin[VY] - dist,
                      bomb->origin[VX] + dist, bomb->origin[VY] + dist);
 
-    pit_radiusattack_params_t parm;
+    radiusattack_params_t parm;
     parm.bomb          = bomb;
     parm.damage        = damage;
     parm.distance      = distance;
@@ -2381,8 +2441,39 @@ void P_RadiusAttack(mobj_t *bomb, mobj_t *source, int damage, int distance)
     parm.afflictSource = CPP_BOOL(afflictSource);
 #endif
 
-    VALIDCOUNT++;
-    Mobj_BoxIterator(&box, PIT_RadiusAttack, &parm);
+    // The horizontal distance is never larger than the full distance, so
+    // candidates outside the horizontal range can be discarded right away.
+    std::vector<mobjcandidate_t> victims;
+    collectMobjsInArea(box, bomb->origin, distance, victims);
+
+    // Determine the actual victims and their distances from the epicenter.
+    auto out = victims.begin();
+    for(mobjcandidate_t cand : victims)
+    {
+        if(isRadiusAttackVictim(cand.mobj, parm, cand.distance))
+        {
+            *out++ = cand;
+        }
+    }
+    victims.erase(out, victims.end());
+
+    for(mobjcandidate_t const &victim : victims)
+    {
+        mobj_t *thing = victim.mobj;
+
+        // Earlier damage may have changed the situation.
+        if(isRemovedMobj(thing) || !(thing->flags & MF_SHOOTABLE)) continue;
+
+        // Must be in direct path.
+        if(!P_CheckSight(thing, parm.bomb)) continue;
+
+        int damage = (parm.damage * (parm.distance - victim.distance) / parm.distance) + 1;
+#if __JHEXEN__
+        if(thing->player) damage /= 4;
+#endif
+
+        P_DamageMobj(thing, parm.bomb, parm.source, damage, false);
+    }
 }
 
 static int PTR_UseTraverse(Intercept const *icpt, void *context)
@@ -2516,7 +2607,7 @@ static int PTR_SlideTraverse(Intercept const *icpt, void *context)
 
     Line *line = icpt->line;
     if(!(P_ToXLine(line)->flags & ML_TWOSIDED) ||
-       !P_GetPtrp(line, DMU_FRONT_SECTOR) || !P_GetPtrp(line, DMU_BACK_SECTOR))
+       !Line_FrontSector(line) || !Line_BackSector(line))
     {
         if(Line_PointOnSide(line, parm.slideMobj->origin) < 0)
         {
@@ -2684,10 +2775,90 @@ void P_SlideMove(mobj_t *mo)
 
 struct pit_changesector_params_t
 {
-    int crushDamage;  ///< Damage amount;
+    int crushDamage;     ///< Damage amount;
     bool noFit;
+    int plane;           ///< Moved plane (PLN_*), or -1 to adjust all touching mobjs.
+    coord_t lowHeight;   ///< Lower of the old and new heights of the moved plane.
+    coord_t highHeight;  ///< Higher of the old and new heights of the moved plane.
 };
 
+/**
+ * Determines whether moving a plane between the heights given in @a parm may
+ * affect @a thing. The floor of a mobj is the highest of the floors it touches,
+ * the ceiling the lowest of the ceilings (and the dropoff the lowest floor), so
+ * a plane that stays clear of these on both sides of the move does not change
+ * them.
+ *
+ * Mobjs that don't fit in their current opening are always adjusted so that
+ * crushing and blocked movers behave as before. The same goes for mobjs whose
+ * position check has side effects (pickups, impacts, pushes), and for mobjs
+ * standing on other mobjs: their floor is the top of the mobj below, which
+ * may itself be carried by the plane.
+ *
+ * The -fullplanecheck option disables the filtering so that every touching mobj
+ * is adjusted. The results should be identical either way, which can be
+ * verified by comparing the -benchtics state hashes (see benchhash.py).
+ */
+static bool changeAffectsMobj(mobj_t const *thing, pit_changesector_params_t const &parm)
+{
+    static bool const fullCheck = CPP_BOOL(CommandLine_Exists("-fullplanecheck"));
+
+    if(fullCheck || parm.plane < 0 || P_MobjIsCamera(thing))
+    {
+        return true;
+    }
+
+    if(thing->flags & (MF_PICKUP | MF_MISSILE | MF_SKULLFLY))
+    {
+        return true;
+    }
+#if __JHEXEN__
+    if(thing->flags2 & (MF2_BLASTED | MF2_PUSHWALL | MF2_IMPACT))
+    {
+        return true;
+    }
+#endif
+    if(!(thing->flags2 & MF2_CANNOTPUSH) && (NON_ZERO(thing->mom[MX]) || NON_ZERO(thing->mom[MY])))
+    {
+        return true; // May push other mobjs.
+    }
+
+    if(thing->ceilingZ - thing->floorZ < thing->height)
+    {
+        return true;
+    }
+
+    bool const onfloor = (thing->origin[VZ] == thing->floorZ);
+    if(!onfloor && thing->origin[VZ] + thing->height > thing->ceilingZ)
+    {
+        return true;
+    }
+#if !__JHEXEN__
+    if(onfloor && (thing->intFlags & MIF_FALLING) && thing->gear >= MAXGEAR)
+    {
+        return true;
+    }
+#endif
+
+    // The floor may come from a mobj rather than a sector (see PIT_CheckThing).
+    if(thing->onMobj || thing->floorZ > Sector_FloorHeight(Mobj_Sector(thing)))
+    {
+        return true;
+    }
+
+    if(parm.plane == PLN_FLOOR)
+    {
+#if !__JHEXEN__
+        if(parm.lowHeight <= thing->dropOffZ)
+        {
+            return true;
+        }
+#endif
+        return parm.highHeight >= thing->floorZ;
+    }
+    return parm.lowHeight <= thing->ceilingZ;
+}
+
 /// @return  Always @c false for use as an interation callback.
 static int PIT_ChangeSector(mobj_t *thing, void *context)
 {
@@ -2705,6 +2876,12 @@ static int PIT_ChangeSector(mobj_t *thing, void *context)
         return false;
     }
 
+    // Skip mobjs not affected by the plane movement.
+    if(!changeAffectsMobj(thing, parm))
+    {
+        return false;
+    }
+
     // Update the Z position of the mobj and determine whether it physically
     // fits in the opening between floor and ceiling.
     if(!P_MobjIsCamera(thing))
@@ -2835,8 +3012,10 @@ static int PIT_ChangeSector(mobj_t *thing, void *context)
     return false;
 }
 
-dd_bool P_ChangeSector(Sector *sector, int crush)
+static dd_bool changeSector(Sector *sector, int crush, int plane, coord_t oldHeight)
 {
+    world::TickProfiler::Scope profile(world::TickProfiler::Planes);
+
     pit_changesector_params_t parm;
     parm.noFit       = false;
 #if __JHEXEN__
@@ -2844,13 +3023,36 @@ dd_bool P_ChangeSector(Sector *sector, int crush)
 #else
     parm.crushDamage = crush > 0? 10 : 0;
 #endif
+    parm.plane       = plane;
+    parm.lowHeight   = parm.highHeight = oldHeight;
+    if(plane >= 0)
+    {
+        coord_t const height = (plane == PLN_FLOOR? Sector_FloorHeight(sector)
+                                                  : Sector_CeilingHeight(sector));
+        parm.lowHeight  = MIN_OF(oldHeight, height);
+        parm.highHeight = MAX_OF(oldHeight, height);
+    }
 
     VALIDCOUNT++;
     Sector_TouchingMobjsIterator(sector, PIT_ChangeSector, &parm);
 
+    // Floor and ceiling height changes are shown in the automap.
+    P_NotifyAutomapSectorChanged(sector);
+
     return parm.noFit;
 }
 
+dd_bool P_ChangeSector(Sector *sector, int crush)
+{
+    return changeSector(sector, crush, -1, 0);
+}
+
+dd_bool P_ChangeSectorPlane(Sector *sector, int crush, int plane, coord_t oldHeight)
+{
+    DENG2_ASSERT(plane == PLN_FLOOR || plane == PLN_CEILING);
+    return changeSector(sector, crush, plane, oldHeight);
+}
+
 void P_HandleSectorHeightChange(int sectorIdx)
 {
     P_ChangeSector((Sector *)P_ToPtr(DMU_SECTOR, sectorIdx), false /*don't crush*/);
@@ -2875,35 +3077,6 @@ dd_bool P_TestMobjLocation(mobj_t *mo)
 #endif
 
 #if __JHEXEN__
-static int PIT_ThrustStompThing(mobj_t *thing, void *context)
-{
-    mobj_t *tsThing = static_cast<mobj_t *>(context);
-
-    // Don't clip against self.
-    if(thing == tsThing)
-    {
-        return false;
-    }
-
-    if(!(thing->flags & MF_SHOOTABLE))
-    {
-        return false;
-    }
-
-    coord_t blockdist = thing->radius + tsThing->radius;
-    if(fabs(thing->origin[VX] - tsThing->origin[VX]) >= blockdist ||
-       fabs(thing->origin[VY] - tsThing->origin[VY]) >= blockdist ||
-       (thing->origin[VZ] > tsThing->origin[VZ] + tsThing->height))
-    {
-        return false; // Didn't hit it.
-    }
-
-    P_DamageMobj(thing, tsThing, tsThing, 10001, false);
-    tsThing->args[1] = 1; // Mark thrust thing as bloody.
-
-    return false;
-}
-
 void P_ThrustSpike(mobj_t *mobj)
 {
     if(!mobj) return;
@@ -2912,8 +3085,25 @@ void P_ThrustSpike(mobj_t *mobj)
     AABoxd const box(mobj->origin[VX] - radius, mobj->origin[VY] - radius,
                      mobj->origin[VX] + radius, mobj->origin[VY] + radius);
 
-    VALIDCOUNT++;
-    Mobj_BoxIterator(&box, PIT_ThrustStompThing, mobj);
+    std::vector<mobjcandidate_t> inRange;
+    collectMobjsInArea(box, mobj->origin, mobj->radius, inRange);
+    for(mobjcandidate_t const &cand : inRange)
+    {
+        mobj_t *thing = cand.mobj;
+
+        // Don't clip against self.
+        if(thing == mobj) continue;
+
+        if(isRemovedMobj(thing) || !(thing->flags & MF_SHOOTABLE)) continue;
+
+        if(thing->origin[VZ] > mobj->origin[VZ] + mobj->height)
+        {
+            continue; // Didn't hit it.
+        }
+
+        P_DamageMobj(thing, mobj, mobj, 10001, false);
+        mobj->args[1] = 1; // Mark thrust thing as bloody.
+    }
 }
 
 struct pit_checkonmobjz_params_t
@@ -3102,8 +3292,8 @@ mobj_t *P_CheckOnMobj(mobj_t *mo)
 
     Sector *newSector = Sector_AtPoint_FixedPrecision(mo->origin);
 
-    tmFloorZ        = tmDropoffZ = P_GetDoublep(newSector, DMU_FLOOR_HEIGHT);
-    tmCeilingZ      = P_GetDoublep(newSector, DMU_CEILING_HEIGHT);
+    tmFloorZ        = tmDropoffZ = Sector_FloorHeight(newSector);
+    tmCeilingZ      = Sector_CeilingHeight(newSector);
     tmFloorMaterial = (Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
 
     IterList_Clear(spechit);*/
@@ -3144,7 +3334,7 @@ static int PTR_BounceTraverse(Intercept const *icpt, void *context)
     ptr_boucetraverse_params_t &parm = *static_cast<ptr_boucetraverse_params_t *>(context);
 
     Line *line = icpt->line;
-    if(!P_GetPtrp(line, DMU_FRONT_SECTOR) || !P_GetPtrp(line, DMU_BACK_SECTOR))
+    if(!Line_FrontSector(line) || !Line_BackSector(line))
     {
         if(Line_PointOnSide(line, parm.bounceMobj->origin) < 0)
         {
@@ -3286,6 +3476,7 @@ static int PTR_PuzzleItemTraverse(Intercept const *icpt, void *context)
                                icpt->line, 0);
         }
         xline->special = 0;
+        P_NotifyAutomapLineChanged(icpt->line);
         parm.activated = true;
 
         // Stop searching.
@@ -3388,6 +3579,12 @@ int P_MobjCount(int type, int tid)
 
     if(tid)
     {
+        if(type == 0)
+        {
+            // Just count TIDs.
+            return P_MobjCountWithTID(tid);
+        }
+
         // Count mobjs by TID.
         int count = 0;
         mobj_t *mo;
@@ -3395,12 +3592,7 @@ int P_MobjCount(int type, int tid)
 
         while((mo = P_FindMobjFromTID(tid, &searcher)))
         {
-            if(type == 0)
-            {
-                // Just count TIDs.
-                count++;
-            }
-            else if(moType == mo->type)
+            if(moType == mo->type)
             {
                 // Don't count dead monsters.
                 if((mo->flags & MF_COUNTKILL) && mo->health <= 0)
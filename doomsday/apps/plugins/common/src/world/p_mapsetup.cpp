@@ -100,6 +100,32 @@ void P_SetLineAutomapVisibility(int player, int lineIdx, dd_bool visible)
     }
 }
 
+void P_NotifyAutomapLineChanged(Line *line)
+{
+    if(!line || P_IsDummy(line)) return;
+
+    for(int i = 0; i < MAXPLAYERS; ++i)
+    {
+        if(auto *automap = ST_TryFindAutomapWidget(i))
+        {
+            automap->lineAppearanceChanged(*line);
+        }
+    }
+}
+
+void P_NotifyAutomapSectorChanged(Sector *sector)
+{
+    if(!sector || P_IsDummy(sector)) return;
+
+    for(int i = 0; i < MAXPLAYERS; ++i)
+    {
+        if(auto *automap = ST_TryFindAutomapWidget(i))
+        {
+            automap->sectorAppearanceChanged(*sector);
+        }
+    }
+}
+
 xsector_t *P_ToXSector(Sector *sector)
 {
     if(!sector) return NULL;
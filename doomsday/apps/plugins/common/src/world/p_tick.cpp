@@ -33,6 +33,8 @@
 #include "r_common.h"
 #include "r_special.h"
 
+#include <doomsday/world/TickProfiler>
+
 using namespace common;
 
 int mapTime;
@@ -73,7 +75,10 @@ void P_DoTick()
        !Get(DD_PLAYBACK) && mapTime > 1)
         return;
 
-    Thinker_Run();
+    {
+        world::TickProfiler::Scope profile(world::TickProfiler::Thinkers);
+        Thinker_Run();
+    }
 
 #if __JDOOM__ || __JDOOM64__ || __JHERETIC__
     // Extended lines and sectors.
@@ -44,10 +44,39 @@
 #include "p_sound.h"
 #include "p_switch.h"
 
+#include <doomsday/world/TickProfiler>
+#include <QHash>
+#include <set>
+
 using namespace de;
 
 #define XLTIMER_STOPPED 1    // Timer stopped.
 
+/// Indices of the lines whose XG type has a given act tag (in ascending order).
+static QHash<int, std::set<int>> linesByActTag;
+
+static void indexLineActTag(Line *line, int actTag, bool insert)
+{
+    // Dummy lines are never traversed by reference.
+    if(P_IsDummy(line)) return;
+
+    int const index = P_ToIndex(line);
+    if(insert)
+    {
+        linesByActTag[actTag].insert(index);
+    }
+    else
+    {
+        auto found = linesByActTag.find(actTag);
+        if(found == linesByActTag.end()) return;
+        found.value().erase(index);
+        if(found.value().empty())
+        {
+            linesByActTag.erase(found);
+        }
+    }
+}
+
 #define EVTYPESTR(evtype) (evtype == XLE_CHAIN? "CHAIN" \
         : evtype == XLE_CROSS? "CROSS" \
         : evtype == XLE_USE? "USE" \
@@ -913,18 +942,24 @@ void XL_SetLineType(Line *line, int id)
     if(XL_GetType(id))
     {
         xline->special = id;
+        P_NotifyAutomapLineChanged(line);
 
         // Allocate memory for the line type data.
         if(!xline->xg)
         {
             xline->xg = (xgline_t *)Z_Calloc(sizeof(xgline_t), PU_MAP, 0);
         }
+        else
+        {
+            indexLineActTag(line, xline->xg->info.actTag, false);
+        }
 
         // Init the extended line state.
         xline->xg->disabled    = false;
         xline->xg->timer       = 0;
         xline->xg->tickerTimer = 0;
         std::memcpy(&xline->xg->info, &typebuffer, sizeof(linetype_t));
+        indexLineActTag(line, xline->xg->info.actTag, true);
 
         // Initial active state.
         xline->xg->active      = (typebuffer.flags & LTF_ACTIVE) != 0;
@@ -959,6 +994,7 @@ void XL_SetLineType(Line *line, int id)
 void XL_Init()
 {
     dummyThing.Thinker::zap();
+    linesByActTag.clear();
 
     // Clients rely on the server, they don't do XG themselves.
     if(IS_CLIENT) return;
@@ -999,8 +1035,8 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
     if(refType == LPREF_NONE)
         return false; // This is not a reference!
 
-    Sector *frontSec = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR);
-    Sector *backSec  = (Sector *)P_GetPtrp(line, DMU_BACK_SECTOR);
+    Sector *frontSec = Line_FrontSector(line);
+    Sector *backSec  = Line_BackSector(line);
 
     // References to a single plane
     if(refType == LPREF_MY_FLOOR || refType == LPREF_MY_CEILING)
@@ -1087,30 +1123,40 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
             }
         }
     }
-    else
+    else if(refType == LPREF_ACT_TAGGED_FLOORS ||
+            refType == LPREF_ACT_TAGGED_CEILINGS)
     {
-        for(int i = 0; i < numsectors; ++i)
+        // Use the act tag index (speed). Copied because the callback may
+        // change the types of the sectors being traversed.
+        std::set<int> const tagged = XS_SectorsWithActTag(ref);
+        for(int index : tagged)
         {
-            Sector *sec     = (Sector *)P_ToPtr(DMU_SECTOR, i);
+            Sector *sec     = (Sector *)P_ToPtr(DMU_SECTOR, index);
             xsector_t *xsec = P_ToXSector(sec);
 
-            if(refType == LPREF_ALL_FLOORS || refType == LPREF_ALL_CEILINGS)
+            // Still tagged?
+            if(xsec->xg && xsec->xg->info.actTag == ref)
             {
-                if(!func(sec, refType == LPREF_ALL_CEILINGS, data,
+                if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
                          context, activator))
                 {
                     return false;
                 }
             }
+        }
+    }
+    else
+    {
+        for(int i = 0; i < numsectors; ++i)
+        {
+            Sector *sec     = (Sector *)P_ToPtr(DMU_SECTOR, i);
 
-            if((refType == LPREF_ACT_TAGGED_FLOORS ||
-                refType == LPREF_ACT_TAGGED_CEILINGS) && xsec->xg &&
-                xsec->xg->info.actTag == ref)
+            if(refType == LPREF_ALL_FLOORS || refType == LPREF_ALL_CEILINGS)
             {
-                if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
-                   context, activator))
+                if(!func(sec, refType == LPREF_ALL_CEILINGS, data,
+                         context, activator))
                 {
-                   return false;
+                    return false;
                 }
             }
 
@@ -1247,20 +1293,20 @@ int XL_TraverseLines(Line* line, int rtype, int ref, void* data,
             }
         }
     }
-    else
+    else if(reftype == LREF_ACT_TAGGED)
     {
-        for(i = 0; i < numlines; ++i)
+        // Use the act tag index (speed). Copied because the callback may
+        // change the types of the lines being traversed.
+        auto const found = linesByActTag.constFind(ref);
+        if(found != linesByActTag.constEnd())
         {
-            iter = (Line *)P_ToPtr(DMU_LINE, i);
-            if(reftype == LREF_ALL)
-            {
-                if(!func(iter, true, data, context, activator))
-                    return false;
-            }
-            else if(reftype == LREF_ACT_TAGGED)
+            std::set<int> const tagged = found.value();
+            for(int index : tagged)
             {
+                iter = (Line *)P_ToPtr(DMU_LINE, index);
                 xline_t *xl = P_ToXLine(iter);
 
+                // Still tagged?
                 if(xl->xg && xl->xg->info.actTag == ref)
                 {
                     if(!func(iter, true, data, context, activator))
@@ -1269,6 +1315,15 @@ int XL_TraverseLines(Line* line, int rtype, int ref, void* data,
             }
         }
     }
+    else if(reftype == LREF_ALL)
+    {
+        for(i = 0; i < numlines; ++i)
+        {
+            iter = (Line *)P_ToPtr(DMU_LINE, i);
+            if(!func(iter, true, data, context, activator))
+                return false;
+        }
+    }
     return true;
 }
 
@@ -1772,7 +1827,7 @@ int XLTrav_ChangeWallMaterial(Line *line, dd_bool /*ceiling*/, void * /*context*
     world_Material *mat = 0;
     if(info->iparm[4] && (P_GetPtrp(side, DMU_MIDDLE_MATERIAL) || info->iparm[6]))
     {
-        if(!P_GetPtrp(line, DMU_BACK_SECTOR) && info->iparm[4] == -1)
+        if(!Line_BackSector(line) && info->iparm[4] == -1)
             mat = 0;
         else
             mat = (world_Material *)P_ToPtr(DMU_MATERIAL, info->iparm[4]);
@@ -1917,8 +1972,8 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     //newV1 = (Vertex *)P_GetPtrp(newLine, DMU_VERTEX0);
     newV2 = (Vertex *)P_GetPtrp(newLine, DMU_VERTEX1);
     P_GetDoublepv(newLine, DMU_DXY, newLineDelta);
-    newFrontSec = (Sector *)P_GetPtrp(newLine, DMU_FRONT_SECTOR);
-    newBackSec  = (Sector *)P_GetPtrp(newLine, DMU_BACK_SECTOR);
+    newFrontSec = Line_FrontSector(newLine);
+    newBackSec  = Line_BackSector(newLine);
 
     // i2: 1 = Spawn Fog
     // i3: Sound = Sound to play
@@ -1963,8 +2018,8 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     c = FIX2FLT(finecosine[angle >> ANGLETOFINESHIFT]);
 
     // Whether walking towards first side of exit line steps down
-    if(P_GetDoublep(newFrontSec, DMU_FLOOR_HEIGHT) <
-       P_GetDoublep(newBackSec, DMU_FLOOR_HEIGHT))
+    if(Sector_FloorHeight(newFrontSec) <
+       Sector_FloorHeight(newBackSec))
         stepDown = true;
     else
         stepDown = false;
@@ -2018,9 +2073,9 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     // level at the exit is measured as the higher of the two floor heights
     // at the exit line.
     if(stepDown)
-        mobj->origin[VZ] = newPos[VZ] + P_GetDoublep(newFrontSec, DMU_FLOOR_HEIGHT);
+        mobj->origin[VZ] = newPos[VZ] + Sector_FloorHeight(newFrontSec);
     else
-        mobj->origin[VZ] = newPos[VZ] + P_GetDoublep(newBackSec, DMU_FLOOR_HEIGHT);
+        mobj->origin[VZ] = newPos[VZ] + Sector_FloorHeight(newBackSec);
 
     // Rotate mobj's orientation according to difference in line angles.
     mobj->angle += angle;
@@ -2038,7 +2093,7 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     {
         mobj->floorClip = 0;
 
-        if(FEQUAL(mobj->origin[VZ], P_GetDoublep(Mobj_Sector(mobj), DMU_FLOOR_HEIGHT)))
+        if(FEQUAL(mobj->origin[VZ], Sector_FloorHeight(Mobj_Sector(mobj))))
         {
             terraintype_t const *tt = P_MobjFloorTerrain(mobj);
             if(tt->flags & TTF_FLOORCLIP)
@@ -2417,7 +2472,7 @@ void XL_ActivateLine(dd_bool activating, linetype_t *info, Line *line, int siden
 
         if(info->actSound)
         {
-            S_SectorSound((Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR), info->actSound);
+            S_SectorSound(Line_FrontSector(line), info->actSound);
         }
 
         // Change the texture of the line if asked to.
@@ -2439,7 +2494,7 @@ void XL_ActivateLine(dd_bool activating, linetype_t *info, Line *line, int siden
 
         if(info->deactSound)
         {
-            S_SectorSound((Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR), info->deactSound);
+            S_SectorSound(Line_FrontSector(line), info->deactSound);
         }
 
         // Change the texture of the line if asked to.
@@ -2841,10 +2896,10 @@ void XL_DoChain(Line *line, int chain, dd_bool activating, mobj_t *actThing)
 
     xdummyLineDef->xg = (xgline_t *)Z_Calloc(sizeof(xgline_t), PU_MAP, 0);
 
-    P_SetPtrp(dummyLineDef, DMU_FRONT_SECTOR, P_GetPtrp(line, DMU_FRONT_SECTOR));
+    P_SetPtrp(dummyLineDef, DMU_FRONT_SECTOR, Line_FrontSector(line));
     if(0 != P_GetPtrp(line, DMU_BACK))
     {
-        P_SetPtrp(dummyLineDef, DMU_BACK_SECTOR, P_GetPtrp(line, DMU_BACK_SECTOR));
+        P_SetPtrp(dummyLineDef, DMU_BACK_SECTOR, Line_BackSector(line));
     }
 
     LOG_MAP_MSG_XGDEVONLY2("Line %i, chained type %i", P_ToIndex(line) << chain);
@@ -2870,6 +2925,8 @@ void XL_Thinker(void *xlThinkerPtr)
     DENG2_ASSERT(xlThinkerPtr);
     LOG_AS("XL_Thinker");
 
+    world::TickProfiler::Scope profile(world::TickProfiler::XG);
+
     xlthinker_t *xl = static_cast<xlthinker_t *>(xlThinkerPtr);
     Line *line      = xl->line;
 
@@ -3060,6 +3117,8 @@ void XL_Update(void)
     int i;
     xline_t *xline;
 
+    linesByActTag.clear();
+
     // It's all PU_MAP memory, so we can just lose it.
     for(i = 0; i < numlines; ++i)
     {
@@ -46,8 +46,33 @@
 #include "p_terraintype.h"
 #include "p_tick.h"
 
+#include <doomsday/world/TickProfiler>
+#include <QHash>
+
 #define MAX_VALS        128
 
+/// Indices of the sectors whose XG type has a given act tag (in ascending order).
+static QHash<int, std::set<int>> sectorsByActTag;
+
+static void indexSectorActTag(Sector *sec, int actTag, bool insert)
+{
+    int const index = P_ToIndex(sec);
+    if(insert)
+    {
+        sectorsByActTag[actTag].insert(index);
+    }
+    else
+    {
+        auto found = sectorsByActTag.find(actTag);
+        if(found == sectorsByActTag.end()) return;
+        found.value().erase(index);
+        if(found.value().empty())
+        {
+            sectorsByActTag.erase(found);
+        }
+    }
+}
+
 #define SIGN(x)         ((x)>0? 1 : (x)<0? -1 : 0)
 
 #define ISFUNC(fn)      (fn->func && fn->func[fn->pos])
@@ -235,8 +260,8 @@ int C_DECL XLTrav_LineAngle(Line* line, dd_bool dummy, void* context,
     Sector* sec = (Sector *) context;
     coord_t d1[2];
 
-    if(P_GetPtrp(line, DMU_FRONT_SECTOR) != sec &&
-       P_GetPtrp(line, DMU_BACK_SECTOR)  != sec)
+    if(Line_FrontSector(line) != sec &&
+       Line_BackSector(line)  != sec)
         return true; // Wrong sector, keep looking.
 
     P_GetDoublepv(line, DMU_DXY, d1);
@@ -291,10 +316,15 @@ void XS_SetSectorType(Sector *sec, int special)
         {
             xsec->xg = (xgsector_t *) Z_Malloc(sizeof(xgsector_t), PU_MAP, 0);
         }
+        else
+        {
+            indexSectorActTag(sec, xsec->xg->info.actTag, false);
+        }
         de::zapPtr(xsec->xg);
 
         // Get the type info.
         std::memcpy(&xsec->xg->info, &secType, sizeof(secType));
+        indexSectorActTag(sec, secType.actTag, true);
 
         // Init the state.
         xgsector_t *xg     = xsec->xg;
@@ -365,6 +395,10 @@ void XS_SetSectorType(Sector *sec, int special)
         Thinker_Iterate((thinkfunc_t) XS_Thinker, destroyXSThinker, sec);
 
         // Free previously allocated XG data.
+        if(xsec->xg)
+        {
+            indexSectorActTag(sec, xsec->xg->info.actTag, false);
+        }
         Z_Free(xsec->xg); xsec->xg = nullptr;
 
         // Just set it, then. Must be a standard sector type...
@@ -379,6 +413,8 @@ void XS_Init()
     /*  // Clients rely on the server, they don't do XG themselves.
     if(IS_CLIENT) return; */
 
+    sectorsByActTag.clear();
+
     if(numsectors <= 0) return;
 
     for(int i = 0; i < numsectors; ++i)
@@ -388,8 +424,8 @@ void XS_Init()
 
         P_GetFloatpv(sec, DMU_COLOR, xsec->origRGB);
 
-        xsec->SP_floororigheight = P_GetDoublep(sec, DMU_FLOOR_HEIGHT);
-        xsec->SP_ceilorigheight  = P_GetDoublep(sec, DMU_CEILING_HEIGHT);
+        xsec->SP_floororigheight = Sector_FloorHeight(sec);
+        xsec->SP_ceilorigheight  = Sector_CeilingHeight(sec);
         xsec->origLight = P_GetFloatp(sec, DMU_LIGHT_LEVEL);
 
         // Initialize XG data for this sector.
@@ -469,8 +505,8 @@ void XS_MoverStopped(xgplanemover_t *mover, dd_bool done)
 void XS_PlaneMover(xgplanemover_t *mover)
 {
     DENG2_ASSERT(mover && mover->sector);
-    coord_t ceil    = P_GetDoublep(mover->sector, DMU_CEILING_HEIGHT);
-    coord_t floor   = P_GetDoublep(mover->sector, DMU_FLOOR_HEIGHT);
+    coord_t ceil    = Sector_CeilingHeight(mover->sector);
+    coord_t floor   = Sector_FloorHeight(mover->sector);
     xsector_t *xsec = P_ToXSector(mover->sector);
     dd_bool docrush = (mover->flags & PMF_CRUSH) != 0;
     dd_bool follows = (mover->flags & PMF_OTHER_FOLLOWS) != 0;
@@ -566,13 +602,13 @@ void XS_PlaneMover(xgplanemover_t *mover)
         {
             // Make sure both the planes are where we started from.
             if((!mover->ceiling || follows) &&
-               !FEQUAL(P_GetDoublep(mover->sector, DMU_FLOOR_HEIGHT), floor))
+               !FEQUAL(Sector_FloorHeight(mover->sector), floor))
             {
                 T_MovePlane(mover->sector, mover->speed, floor, docrush, false, -dir);
             }
 
             if((mover->ceiling || follows) &&
-               !FEQUAL(P_GetDoublep(mover->sector, DMU_CEILING_HEIGHT), ceil))
+               !FEQUAL(Sector_CeilingHeight(mover->sector), ceil))
             {
                 T_MovePlane(mover->sector, mover->speed, ceil, docrush, true, -dir);
             }
@@ -739,8 +775,8 @@ int XS_TextureHeight(Line* line, int part)
     Side* side;
     int snum = 0;
     int minfloor = 0, maxfloor = 0, maxceil = 0;
-    Sector* front = (Sector *) P_GetPtrp(line, DMU_FRONT_SECTOR);
-    Sector* back  = (Sector *) P_GetPtrp(line, DMU_BACK_SECTOR);
+    Sector* front = Line_FrontSector(line);
+    Sector* back  = Line_BackSector(line);
     dd_bool twosided = front && back;
     world_Material* mat;
 
@@ -869,6 +905,13 @@ Sector *XS_FindTagged(int tag)
     return NULL;
 }
 
+std::set<int> const &XS_SectorsWithActTag(int tag)
+{
+    static std::set<int> const none;
+    auto const found = sectorsByActTag.constFind(tag);
+    return found != sectorsByActTag.constEnd()? found.value() : none;
+}
+
 /**
  * Returns a pointer to the first sector with the specified act tag.
  */
@@ -876,53 +919,16 @@ Sector *XS_FindActTagged(int tag)
 {
     LOG_AS("XS_FindActTagged");
 
-    int k;
-    int foundcount = 0;
-    int retsectorid = 0;
-    Sector *sec, *retsector;
-    xsector_t *xsec;
-
-    retsector = NULL;
+    std::set<int> const &tagged = XS_SectorsWithActTag(tag);
+    if(tagged.empty()) return NULL;
 
-    for(k = 0; k < numsectors; ++k)
+    if(xgDev && tagged.size() > 1)
     {
-        sec = (Sector *) P_ToPtr(DMU_SECTOR, k);
-        xsec = P_ToXSector(sec);
-        if(xsec->xg)
-        {
-            if(xsec->xg->info.actTag == tag)
-            {
-                if(xgDev)
-                {
-                    if(foundcount == 0)
-                    {
-                        retsector = sec;
-                        retsectorid = k;
-                    }
-                }
-                else
-                {
-                    return sec;
-                }
-
-                foundcount++;
-            }
-        }
+        LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
+        LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", *tagged.begin());
     }
 
-    if(xgDev)
-    {
-        if(foundcount > 1)
-        {
-            LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
-            LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", retsectorid);
-        }
-
-        if(retsector)
-            return retsector;
-    }
-
-    return NULL;
+    return (Sector *) P_ToPtr(DMU_SECTOR, *tagged.begin());
 }
 
 #define FSETHF_MIN          0x1 // Get min. If not set, get max.
@@ -986,7 +992,7 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
 
     // Init the values to the current sector's floor.
     if(height)
-        *height = P_GetDoublep(sector, DMU_FLOOR_HEIGHT);
+        *height = Sector_FloorHeight(sector);
     if(mat)
         *mat = (world_Material*) P_GetPtrp(sector, DMU_FLOOR_MATERIAL);
     if(planeSector)
@@ -1083,14 +1089,14 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
             ref == SPREF_LINE_ACT_TAGGED_FLOOR)
         {
             if(height)
-                *height = P_GetDoublep(iter, DMU_FLOOR_HEIGHT);
+                *height = Sector_FloorHeight(iter);
             if(mat)
                 *mat = (world_Material*) P_GetPtrp(iter, DMU_FLOOR_MATERIAL);
         }
         else
         {
             if(height)
-                *height = P_GetDoublep(iter, DMU_CEILING_HEIGHT);
+                *height = Sector_CeilingHeight(iter);
             if(mat)
                 *mat = (world_Material*) P_GetPtrp(iter, DMU_CEILING_MATERIAL);
         }
@@ -1105,14 +1111,14 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
         if(!actline)
             return false;
 
-        frontsector = (Sector *) P_GetPtrp(actline, DMU_FRONT_SECTOR);
+        frontsector = Line_FrontSector(actline);
 
         if(!frontsector)
             return false;
 
         // Actline's front floor.
         if(height)
-            *height = P_GetDoublep(frontsector, DMU_FLOOR_HEIGHT);
+            *height = Sector_FloorHeight(frontsector);
         if(mat)
             *mat = (world_Material*) P_GetPtrp(frontsector, DMU_FLOOR_MATERIAL);
         if(planeSector)
@@ -1127,14 +1133,14 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
         if(!actline)
             return false;
 
-        backsector = (Sector *) P_GetPtrp(actline, DMU_BACK_SECTOR);
+        backsector = Line_BackSector(actline);
 
         if(!backsector)
             return false;
 
         // Actline's back floor.
         if(height)
-            *height = P_GetDoublep(backsector, DMU_FLOOR_HEIGHT);
+            *height = Sector_FloorHeight(backsector);
         if(mat)
             *mat = (world_Material*) P_GetPtrp(backsector, DMU_FLOOR_MATERIAL);
         if(planeSector)
@@ -1150,14 +1156,14 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
         if(!actline)
             return false;
 
-        frontsector = (Sector *) P_GetPtrp(actline, DMU_FRONT_SECTOR);
+        frontsector = Line_FrontSector(actline);
 
         if(!frontsector)
             return false;
 
         // Actline's front ceiling.
         if(height)
-            *height = P_GetDoublep(frontsector, DMU_CEILING_HEIGHT);
+            *height = Sector_CeilingHeight(frontsector);
         if(mat)
             *mat = (world_Material *) P_GetPtrp(frontsector, DMU_CEILING_MATERIAL);
         if(planeSector)
@@ -1172,14 +1178,14 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
         if(!actline)
             return false;
 
-        backsector = (Sector *) P_GetPtrp(actline, DMU_BACK_SECTOR);
+        backsector = Line_BackSector(actline);
 
         if(!backsector)
             return false;
 
         // Actline's back ceiling.
         if(height)
-            *height = P_GetDoublep(backsector, DMU_CEILING_HEIGHT);
+            *height = Sector_CeilingHeight(backsector);
         if(mat)
             *mat = (world_Material *) P_GetPtrp(backsector, DMU_CEILING_MATERIAL);
         if(planeSector)
@@ -1208,7 +1214,7 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
     if(ref == SPREF_CURRENT_FLOOR)
     {
         if(height)
-            *height = P_GetDoublep(sector, DMU_FLOOR_HEIGHT);
+            *height = Sector_FloorHeight(sector);
         if(mat)
             *mat = (world_Material *) P_GetPtrp(sector, DMU_FLOOR_MATERIAL);
         return true;
@@ -1217,7 +1223,7 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
     if(ref == SPREF_CURRENT_CEILING)
     {
         if(height)
-            *height = P_GetDoublep(sector, DMU_CEILING_HEIGHT);
+            *height = Sector_CeilingHeight(sector);
         if(mat)
             *mat = (world_Material *) P_GetPtrp(sector, DMU_CEILING_MATERIAL);
         return true;
@@ -1282,28 +1288,28 @@ dd_bool XS_GetPlane(Line* actline, Sector* sector, int ref, int* refdata,
     else if(ref == SPREF_NEXT_HIGHEST_CEILING)
     {
         otherSec = P_FindSectorSurroundingNextHighestCeiling(sector,
-                        P_GetDoublep(sector, DMU_CEILING_HEIGHT), &otherHeight);
+                        Sector_CeilingHeight(sector), &otherHeight);
         if(otherSec)
             otherMat = (world_Material *) P_GetPtrp(otherSec, DMU_CEILING_MATERIAL);
     }
     else if(ref == SPREF_NEXT_HIGHEST_FLOOR)
     {
         otherSec = P_FindSectorSurroundingNextHighestFloor(sector,
-                        P_GetDoublep(sector, DMU_FLOOR_HEIGHT), &otherHeight);
+                        Sector_FloorHeight(sector), &otherHeight);
         if(otherSec)
             otherMat = (world_Material *) P_GetPtrp(otherSec, DMU_FLOOR_MATERIAL);
     }
     else if(ref == SPREF_NEXT_LOWEST_CEILING)
     {
         otherSec = P_FindSectorSurroundingNextLowestCeiling(sector,
-                        P_GetDoublep(sector, DMU_CEILING_HEIGHT), &otherHeight);
+                        Sector_CeilingHeight(sector), &otherHeight);
         if(otherSec)
             otherMat = (world_Material *) P_GetPtrp(otherSec, DMU_CEILING_MATERIAL);
     }
     else if(ref == SPREF_NEXT_LOWEST_FLOOR)
     {
         otherSec = P_FindSectorSurroundingNextLowestFloor(sector,
-                        P_GetDoublep(sector, DMU_FLOOR_HEIGHT), &otherHeight);
+                        Sector_FloorHeight(sector), &otherHeight);
         if(otherSec)
             otherMat = (world_Material *) P_GetPtrp(otherSec, DMU_FLOOR_MATERIAL);
     }
@@ -1608,11 +1614,11 @@ int spreadBuild(void *ptr, void *context)
     spreadbuildparams_t *params = (spreadbuildparams_t*) context;
     Sector              *frontSec, *backSec;
 
-    frontSec = (Sector *) P_GetPtrp(li, DMU_FRONT_SECTOR);
+    frontSec = Line_FrontSector(li);
     if(!frontSec || frontSec != params->baseSec)
         return false;
 
-    backSec = (Sector *) P_GetPtrp(li, DMU_BACK_SECTOR);
+    backSec = Line_BackSector(li);
     if(!backSec)
         return false;
 
@@ -1725,11 +1731,11 @@ int findBuildNeighbor(void* ptr, void* context)
     Sector*             frontSec, *backSec;
     int                 idx;
 
-    frontSec = (Sector *) P_GetPtrp(li, DMU_FRONT_SECTOR);
+    frontSec = Line_FrontSector(li);
     if(!frontSec || frontSec != params->baseSec)
         return false;
 
-    backSec = (Sector *) P_GetPtrp(li, DMU_BACK_SECTOR);
+    backSec = Line_BackSector(li);
     if(!backSec)
         return false;
 
@@ -1985,14 +1991,14 @@ int C_DECL XSTrav_SectorLight(Sector* sector, dd_bool /*ceiling*/,
 
         case LIGHTREF_MY:
             {
-            Sector *frontSec = (Sector *) P_GetPtrp(line, DMU_FRONT_SECTOR);
+            Sector *frontSec = Line_FrontSector(line);
             lightLevel = P_GetFloatp(frontSec, DMU_LIGHT_LEVEL);
             }
             break;
 
         case LIGHTREF_BACK:
             {
-            Sector *backSec = (Sector *) P_GetPtrp(line, DMU_BACK_SECTOR);
+            Sector *backSec = Line_BackSector(line);
             if(backSec)
                 lightLevel = P_GetFloatp(backSec, DMU_LIGHT_LEVEL);
             }
@@ -2052,14 +2058,14 @@ int C_DECL XSTrav_SectorLight(Sector* sector, dd_bool /*ceiling*/,
         {
         case LIGHTREF_MY:
             {
-            Sector *sector = (Sector *) P_GetPtrp(line, DMU_FRONT_SECTOR);
+            Sector *sector = Line_FrontSector(line);
 
             P_GetFloatpv(sector, DMU_COLOR, usergb);
             break;
             }
         case LIGHTREF_BACK:
             {
-            Sector *sector = (Sector *) P_GetPtrp(line, DMU_BACK_SECTOR);
+            Sector *sector = Line_BackSector(line);
 
             if(sector)
                 P_GetFloatpv(sector, DMU_COLOR, usergb);
@@ -2211,8 +2217,8 @@ int C_DECL XSTrav_Teleport(Sector* sector, dd_bool /*ceiling*/, void* /*context*
 
         memcpy(oldpos, thing->origin, sizeof(thing->origin));
         oldAngle = thing->angle;
-        thfloorz = P_GetDoublep(Mobj_Sector(thing), DMU_FLOOR_HEIGHT);
-        thceilz  = P_GetDoublep(Mobj_Sector(thing), DMU_CEILING_HEIGHT);
+        thfloorz = Sector_FloorHeight(Mobj_Sector(thing));
+        thceilz  = Sector_CeilingHeight(Mobj_Sector(thing));
         aboveFloor = thing->origin[VZ] - thfloorz;
 
         // Players get special consideration
@@ -2303,7 +2309,7 @@ int C_DECL XSTrav_Teleport(Sector* sector, dd_bool /*ceiling*/, void* /*context*
         {
             thing->floorClip = 0;
 
-            if(FEQUAL(thing->origin[VZ], P_GetDoublep(Mobj_Sector(thing), DMU_FLOOR_HEIGHT)))
+            if(FEQUAL(thing->origin[VZ], Sector_FloorHeight(Mobj_Sector(thing))))
             {
                 terraintype_t const *tt = P_MobjFloorTerrain(thing);
                 if(tt->flags & TTF_FLOORCLIP)
@@ -2754,12 +2760,12 @@ static dd_bool checkChainRequirements(Sector* sec, mobj_t* mo, int ch,
     {
     case XSCE_FLOOR:
         // Is it touching the floor?
-        if(mo->origin[VZ] > P_GetDoublep(sec, DMU_FLOOR_HEIGHT))
+        if(mo->origin[VZ] > Sector_FloorHeight(sec))
             return false;
 
     case XSCE_CEILING:
         // Is it touching the ceiling?
-        if(mo->origin[VZ] + mo->height < P_GetDoublep(sec, DMU_CEILING_HEIGHT))
+        if(mo->origin[VZ] + mo->height < Sector_CeilingHeight(sec))
             return false;
 
     default:
@@ -2814,8 +2820,8 @@ void P_ApplyWind(mobj_t *mo, Sector *sec)
        ((info->flags & STF_MONSTER_WIND) && (mo->flags & MF_COUNTKILL)) ||
        ((info->flags & STF_MISSILE_WIND) && (mo->flags & MF_MISSILE)))
     {
-        coord_t thfloorz = P_GetDoublep(Mobj_Sector(mo), DMU_FLOOR_HEIGHT);
-        coord_t thceilz  = P_GetDoublep(Mobj_Sector(mo), DMU_CEILING_HEIGHT);
+        coord_t thfloorz = Sector_FloorHeight(Mobj_Sector(mo));
+        coord_t thceilz  = Sector_CeilingHeight(Mobj_Sector(mo));
 
         if(!(info->flags & (STF_FLOOR_WIND | STF_CEILING_WIND)) ||
            ((info->flags & STF_FLOOR_WIND) && mo->origin[VZ] <= thfloorz) ||
@@ -2874,6 +2880,8 @@ void XS_Thinker(void *xsThinker)
 
     if(!xsector) return; // Not an xsector? Most perculiar...
 
+    world::TickProfiler::Scope profile(world::TickProfiler::XG);
+
     xg = xsector->xg;
     if(!xg) return; // Not an extended sector.
 
@@ -3045,6 +3053,8 @@ void XS_Update(void)
     int i;
     xsector_t  *xsec;
 
+    sectorsByActTag.clear();
+
     // It's all PU_MAP memory, so we can just lose it.
     for(i = 0; i < numsectors; ++i)
     {
@@ -3132,8 +3142,8 @@ D_CMD(MovePlane)
         return false;
     }
 
-    floorheight   = P_GetDoublep(sector, DMU_FLOOR_HEIGHT);
-    ceilingheight = P_GetDoublep(sector, DMU_CEILING_HEIGHT);
+    floorheight   = Sector_FloorHeight(sector);
+    ceilingheight = Sector_CeilingHeight(sector);
 
     // No more arguments?
     if(argc == p)
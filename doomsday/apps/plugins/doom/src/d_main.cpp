@@ -279,6 +279,7 @@ void D_PreInit()
     cfg.common.confirmQuickGameSave = true;
     cfg.common.confirmRebornLoad = true;
     cfg.common.loadLastSaveOnReborn = false;
+    cfg.common.backgroundGameSave = true;
 
     cfg.maxSkulls = true;
     cfg.allowSkullsInWalls = false;
@@ -214,6 +214,7 @@ void H_PreInit()
     cfg.common.confirmQuickGameSave = true;
     cfg.common.confirmRebornLoad = true;
     cfg.common.loadLastSaveOnReborn = false;
+    cfg.common.backgroundGameSave = true;
 
     cfg.monstersStuckInDoors = false;
     cfg.avoidDropoffs = true;
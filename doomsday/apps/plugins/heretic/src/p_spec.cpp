@@ -202,25 +202,32 @@ dd_bool P_ActivateLine(Line *ld, mobj_t *mo, int side, int actType)
     // Clients do not activate lines.
     if(IS_CLIENT) return false;
 
+    dd_bool activated = false;
     switch(actType)
     {
     case SPAC_CROSS:
         P_CrossSpecialLine(ld, side, mo);
-        return true;
+        activated = true;
+        break;
 
     case SPAC_USE:
-        return P_UseSpecialLine(mo, ld, side);
+        activated = P_UseSpecialLine(mo, ld, side);
+        break;
 
     case SPAC_IMPACT:
         P_ShootSpecialLine(mo, ld);
-        return true;
+        activated = true;
+        break;
 
     default:
         DENG2_ASSERT(!"P_ActivateLine: Unknown activation type");
         break;
     }
 
-    return false;
+    // The special of the line may have changed.
+    P_NotifyAutomapLineChanged(ld);
+
+    return activated;
 }
 
 /**
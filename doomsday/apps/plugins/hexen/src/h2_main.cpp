@@ -193,6 +193,7 @@ void X_PreInit()
     cfg.common.confirmQuickGameSave = true;
     cfg.common.confirmRebornLoad = true;
     cfg.common.loadLastSaveOnReborn = false;
+    cfg.common.backgroundGameSave = true;
 
     cfg.common.hudFog = 5;
     cfg.common.menuSlam = true;
@@ -605,6 +605,9 @@ dd_bool P_ActivateLine(Line *line, mobj_t *mo, int side, int activationType)
         xline->special = 0;
     }
 
+    // The special of the line may have changed (also by the special itself).
+    P_NotifyAutomapLineChanged(line);
+
     if((lineActivation == SPAC_USE || lineActivation == SPAC_IMPACT) &&
        buttonSuccess)
     {
@@ -56,8 +56,9 @@ void T_FloorWaggle(waggle_t *waggle)
         if((waggle->scale -= waggle->scaleDelta) <= 0)
         {
             // Remove.
+            coord_t const oldHeight = Sector_FloorHeight(waggle->sector);
             P_SetDoublep(waggle->sector, DMU_FLOOR_HEIGHT, waggle->originalHeight);
-            P_ChangeSector(waggle->sector, 1 /*crush damage*/);
+            P_ChangeSectorPlane(waggle->sector, 1 /*crush damage*/, PLN_FLOOR, oldHeight);
             P_ToXSector(waggle->sector)->specialData = nullptr;
             P_NotifySectorFinished(P_ToXSector(waggle->sector)->tag);
             Thinker_Remove(&waggle->thinker);
@@ -69,10 +70,11 @@ void T_FloorWaggle(waggle_t *waggle)
     waggle->accumulator += waggle->accDelta;
     coord_t fh = waggle->originalHeight +
         FLOATBOBOFFSET(((int) waggle->accumulator) & 63) * waggle->scale;
+    coord_t const oldHeight = Sector_FloorHeight(waggle->sector);
     P_SetDoublep(waggle->sector, DMU_FLOOR_HEIGHT, fh);
     P_SetDoublep(waggle->sector, DMU_FLOOR_TARGET_HEIGHT, fh);
     P_SetFloatp(waggle->sector, DMU_FLOOR_SPEED, 0);
-    P_ChangeSector(waggle->sector, 1 /*crush damage*/);
+    P_ChangeSectorPlane(waggle->sector, 1 /*crush damage*/, PLN_FLOOR, oldHeight);
 }
 
 void waggle_s::write(MapStateWriter *msw) const
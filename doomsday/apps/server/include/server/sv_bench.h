@@ -0,0 +1,67 @@
+/** @file sv_bench.h  Benchmarking the world simulation.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef SERVER_BENCH_H
+#define SERVER_BENCH_H
+
+#include <de/NativePath>
+
+#ifndef __cplusplus
+#  error "server/sv_bench.h requires C++"
+#endif
+
+/**
+ * Runs game tics in the current map as fast as possible and reports the time
+ * spent in each subsystem of the world simulation. Frame deltas are generated
+ * after every tic even if there are no clients.
+ *
+ * The results are written as JSON to @a outputPath, or to the log if the path
+ * is empty. They include a hash of the final state of the map's mobjs, which
+ * can be compared between runs to verify that the simulation is deterministic
+ * (see build/scripts/benchhash.py).
+ *
+ * @param tics        Number of tics to run.
+ * @param outputPath  Destination for the results.
+ * @param stir        Push the map's solid mobjs around once per second, so that
+ *                    movement and collisions are exercised without players.
+ *
+ * @return @c true, if the benchmark was run.
+ */
+bool Sv_RunBenchmark(int tics, de::NativePath const &outputPath, bool stir = false);
+
+/**
+ * Traces paths between random points of the current map, like hitscan attacks
+ * do, and reports the time spent. Every intercept along the paths is visited.
+ * The same paths are traced on every run.
+ *
+ * @param traces      Number of paths to trace.
+ * @param outputPath  Destination for the results (see Sv_RunBenchmark()).
+ *
+ * @return @c true, if the benchmark was run.
+ */
+bool Sv_RunTraceBenchmark(int traces, de::NativePath const &outputPath);
+
+/**
+ * Runs the benchmark requested with the -benchtics or -benchtraces option once
+ * a map has been loaded, and then quits. Called periodically.
+ */
+void Sv_CheckCommandLineBenchmark();
+
+void Sv_BenchRegister();
+
+#endif // SERVER_BENCH_H
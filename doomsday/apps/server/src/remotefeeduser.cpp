@@ -19,6 +19,7 @@
 #include "remotefeeduser.h"
 
 #include <de/Async>
+#include <de/ByteArrayFile>
 #include <de/FileSystem>
 #include <de/Folder>
 #include <de/Message>
@@ -30,14 +31,53 @@ DENG2_PIMPL(RemoteFeedUser)
 {
     using QueryId = RemoteFeedQueryPacket::Id;
 
+    static dsize const CHUNK_SIZE  = 128 * 1024;     ///< Data in one file contents packet.
+    static dsize const SEND_WINDOW = 4 * CHUNK_SIZE; ///< Maximum amount of buffered output.
+
+    /**
+     * File being sent to the user. Byte array files are read a chunk at a time
+     * while the transfer progresses; other files are read into memory in full.
+     */
     struct Transfer
     {
         QueryId queryId;
+        String path;        ///< Streamed source file (if empty, contents are in @a data).
         Block data;
+        duint64 size = 0;
         duint64 position = 0;
+        bool started = false;
 
         Transfer(QueryId id = 0) : queryId(id)
         {}
+
+        bool isComplete() const
+        {
+            return started && position >= size;
+        }
+
+        RemoteFeedFileContentsPacket *nextChunk()
+        {
+            std::unique_ptr<RemoteFeedFileContentsPacket> packet(new RemoteFeedFileContentsPacket);
+            packet->setId(queryId);
+            packet->setFileSize(size);
+            packet->setStartOffset(position);
+
+            dsize const len = dsize(position < size? de::min(duint64(CHUNK_SIZE), size - position) : 0);
+            if (path.isEmpty())
+            {
+                packet->setData(data.mid(position, len));
+            }
+            else
+            {
+                Block chunk(len);
+                FS::locate<File const>(path).target().as<ByteArrayFile>()
+                        .get(position, chunk.data(), len);
+                packet->setData(chunk);
+            }
+            position += len;
+            started = true;
+            return packet.release();
+        }
     };
 
     std::unique_ptr<Socket> socket;
@@ -52,7 +92,11 @@ DENG2_PIMPL(RemoteFeedUser)
         socket->setRetainOrder(false);
 
         QObject::connect(s, &Socket::messagesReady, [this] () { receiveMessages(); });
-        QObject::connect(s, &Socket::allSent, [this] () { continueFileTransfers(); });
+        QObject::connect(s, &Socket::bytesSent, [this] (dsize buffered)
+        {
+            // Keep the send window filled.
+            if (buffered < SEND_WINDOW / 2) continueFileTransfers();
+        });
         QObject::connect(s, &Socket::disconnected, [this] ()
         {
             DENG2_FOR_PUBLIC_AUDIENCE(Disconnect, i)
@@ -105,49 +149,53 @@ DENG2_PIMPL(RemoteFeedUser)
         }
     }
 
+    /**
+     * Sends file contents until the amount of buffered output reaches the send
+     * window. Queued transfers take turns so that one large file does not hold
+     * up the others.
+     */
     void continueFileTransfers()
     {
         DENG2_ASSERT_IN_MAIN_THREAD();
-        try
-        {
-            if (socket->bytesBuffered() > 0) return; // Too soon.
 
+        while (socket->bytesBuffered() < SEND_WINDOW)
+        {
             std::unique_ptr<RemoteFeedFileContentsPacket> response;
-
-            // Send the next block of the first file in the transfer queue.
             {
                 DENG2_GUARD(transfers);
 
                 if (transfers.value.isEmpty()) return;
 
-                response.reset(new RemoteFeedFileContentsPacket);
-
-                dsize const blockSize = 128 * 1024;
-                auto &xfer = transfers.value.front();
-
-                response->setId(xfer.queryId);
-                response->setFileSize(xfer.data.size());
-                response->setStartOffset(xfer.position);
-                response->setData(xfer.data.mid(xfer.position, blockSize));
-
-                xfer.position += response->data().size();
-                if (xfer.position >= xfer.data.size())
+                Transfer xfer = transfers.value.takeFirst();
+                try
+                {
+                    response.reset(xfer.nextChunk());
+                }
+                catch (Error const &er)
                 {
-                    // That was all.
-                    transfers.value.pop_front();
+                    LOG_NET_ERROR("Error during file transfer of %s to %s: %s")
+                            << xfer.path
+                            << socket->peerAddress().asText()
+                            << er.asText();
+                    continue;
+                }
+                if (!xfer.isComplete())
+                {
+                    // Continue after the other queued transfers.
+                    transfers.value.push_back(xfer);
                 }
             }
-
-            if (response)
+            try
             {
                 socket->sendPacket(*response);
             }
-        }
-        catch (Error const &er)
-        {
-            LOG_NET_ERROR("Error during file transfer to %s: %s")
-                    << socket->peerAddress().asText()
-                    << er.asText();
+            catch (Error const &er)
+            {
+                LOG_NET_ERROR("Error during file transfer to %s: %s")
+                        << socket->peerAddress().asText()
+                        << er.asText();
+                return;
+            }
         }
     }
 
@@ -181,15 +229,26 @@ DENG2_PIMPL(RemoteFeedUser)
                 Transfer xfer(query.id());
                 if (auto const *file = FS::tryLocate<File const>(query.path()))
                 {
-                    *file >> xfer.data;
+                    if (is<ByteArrayFile>(file->target()))
+                    {
+                        xfer.path = file->path();
+                        xfer.size = file->target().size();
+                    }
+                    else
+                    {
+                        *file >> xfer.data;
+                        xfer.size = xfer.data.size();
+                    }
+                    xfer.position = de::min(query.startOffset(), xfer.size);
                 }
                 else
                 {
                     LOG_NET_WARNING("%s not found!") << query.path();
                 }
-                LOG_NET_MSG("New file transfer: %s size:%i")
+                LOG_NET_MSG("New file transfer: %s size:%i start:%i")
                         << query.path()
-                        << xfer.data.size();
+                        << xfer.size
+                        << xfer.position;
                 DENG2_GUARD(transfers);
                 transfers.value.push_back(xfer);
                 break; }
@@ -0,0 +1,315 @@
+/** @file sv_bench.cpp  Benchmarking the world simulation.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de_base.h"
+#include "server/sv_bench.h"
+#include "server/sv_pool.h"
+
+#include <de/App>
+#include <de/CommandLine>
+#include <de/Log>
+#include <de/Time>
+#include <de/Writer>
+#include <de/data/json.h>
+#include <de/timer.h>
+#include <doomsday/console/cmd.h>
+#include <doomsday/world/TickProfiler>
+#include <QFile>
+#include <algorithm>
+#include <random>
+
+#include "dd_main.h"
+#include "dd_loop.h"
+#include "sys_system.h"
+#include "world/interceptor.h"
+#include "world/map.h"
+#include "world/p_object.h"
+#include "world/thinkers.h"
+
+using namespace de;
+using world::TickProfiler;
+
+static int const     STIR_INTERVAL = TICSPERSEC; ///< Tics between pushes (see stirMobjs()).
+static ddouble const STIR_MOMENTUM = 8;          ///< Maximum push per axis.
+
+/**
+ * Returns all the mobjs of the current map in the order of their thinker IDs, so
+ * that the order does not depend on how the thinkers are stored.
+ */
+static QVector<mobj_t *> mobjsById()
+{
+    QVector<mobj_t *> mobjs;
+    App_World().map().thinkers().forAll(reinterpret_cast<thinkfunc_t>(gx.MobjThinker), 0x1,
+                                        [&mobjs] (thinker_t *th)
+    {
+        mobjs << reinterpret_cast<mobj_t *>(th);
+        return LoopContinue;
+    });
+    std::sort(mobjs.begin(), mobjs.end(), [] (mobj_t const *a, mobj_t const *b) {
+        return a->thinker.id < b->thinker.id;
+    });
+    return mobjs;
+}
+
+/**
+ * Computes a hash of the state of all mobjs in the current map. Runs of the same
+ * number of tics in the same map must produce the same hash, so it can be used to
+ * check that changes to the playsim keep it deterministic.
+ */
+static String mobjStateHash()
+{
+    Block data;
+    Writer writer(data);
+    for (mobj_t const *mob : mobjsById())
+    {
+        writer << dint32(mob->thinker.id)
+               << mob->origin[VX] << mob->origin[VY] << mob->origin[VZ]
+               << mob->mom[MX]    << mob->mom[MY]    << mob->mom[MZ]
+               << duint32(mob->angle) << dint32(mob->tics) << dint32(mob->health);
+    }
+    return data.md5Hash().asHexadecimalText();
+}
+
+/**
+ * Pushes all solid mobjs (other than players and missiles) in random directions.
+ * Without players, most monsters would stay idle and the map's collision code
+ * would hardly be exercised. The pushes are the same on every run.
+ */
+static void stirMobjs(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<ddouble> push(-STIR_MOMENTUM, STIR_MOMENTUM);
+    for (mobj_t *mob : mobjsById())
+    {
+        if (!(mob->ddFlags & DDMF_SOLID) || (mob->ddFlags & DDMF_MISSILE) || mob->dPlayer)
+        {
+            continue;
+        }
+        mob->mom[MX] += push(rng);
+        mob->mom[MY] += push(rng);
+    }
+}
+
+/**
+ * Writes benchmark results as JSON to @a outputPath, or to the log if the path is
+ * empty.
+ */
+static bool writeResults(Record const &results, NativePath const &outputPath)
+{
+    Block const json = composeJSON(results);
+    if (outputPath.isEmpty())
+    {
+        LOG_MAP_MSG("%s") << json.constData();
+        return true;
+    }
+
+    QFile file(outputPath);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate) || file.write(json) != json.size())
+    {
+        LOG_MAP_ERROR("Failed to write benchmark results to %s") << outputPath.pretty();
+        return false;
+    }
+    LOG_MAP_NOTE("Benchmark results written to %s") << outputPath.pretty();
+    return true;
+}
+
+bool Sv_RunBenchmark(int tics, NativePath const &outputPath, bool stir)
+{
+    LOG_AS("Sv_RunBenchmark");
+
+    if (!App_World().hasMap())
+    {
+        LOG_MAP_ERROR("A map must be loaded for benchmarking");
+        return false;
+    }
+
+    String const mapId = App_World().map().id();
+    LOG_MAP_NOTE("Running %i tics in %s%s...") << tics << mapId
+            << (stir? " while stirring mobjs" : "");
+
+    TickProfiler::reset();
+    TickProfiler::setEnabled(true);
+
+    std::mt19937 rng(1);
+    Time startedAt;
+    for (int i = 0; i < tics; ++i)
+    {
+        if (stir && i % STIR_INTERVAL == 0)
+        {
+            stirMobjs(rng);
+        }
+        Loop_RunFixedTics(1);
+        Sv_GenerateFrameDeltas();
+    }
+    TimeSpan const elapsed = startedAt.since();
+
+    TickProfiler::setEnabled(false);
+
+    Record results;
+    results.set("map", mapId);
+    results.set("tics", tics);
+    results.set("stir", stir);
+    results.set("seconds", double(elapsed));
+    results.set("ticsPerSecond", elapsed > 0? tics / double(elapsed) : 0.0);
+    results.add("sections", new Record(TickProfiler::results()));
+    results.set("mobjStateHash", mobjStateHash());
+    results.set("mobjPools", App_World().map().thinkers().poolInfo());
+
+    for (int i = 0; i < TickProfiler::SectionCount; ++i)
+    {
+        auto const sec = TickProfiler::Section(i);
+        LOG_MAP_MSG("%8s: %8.2f ms (%.4f ms/tic) in %i calls")
+                << TickProfiler::sectionName(sec)
+                << TickProfiler::seconds(sec) * 1000
+                << TickProfiler::seconds(sec) * 1000 / de::max(1, tics)
+                << TickProfiler::count(sec);
+    }
+    LOG_MAP_NOTE("Total: %.2f ms (%.1f tics/s)") << elapsed * 1000 << results.getd("ticsPerSecond");
+    LOG_MAP_MSG("Mobj state hash: %s") << results.gets("mobjStateHash");
+    LOG_MAP_VERBOSE("Mobj pools:\n%s") << results.gets("mobjPools");
+
+    return writeResults(results, outputPath);
+}
+
+static int countIntercept(Intercept const *, void *context)
+{
+    ++*static_cast<dint64 *>(context);
+    return false; // Continue the trace.
+}
+
+bool Sv_RunTraceBenchmark(int traces, NativePath const &outputPath)
+{
+    LOG_AS("Sv_RunTraceBenchmark");
+
+    if (!App_World().hasMap())
+    {
+        LOG_MAP_ERROR("A map must be loaded for benchmarking");
+        return false;
+    }
+
+    world::Map const &map = App_World().map();
+    AABoxd const &bounds = map.bounds();
+    LOG_MAP_NOTE("Tracing %i paths in %s...") << traces << map.id();
+
+    // The same paths are traced on every run.
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<ddouble> randomX(bounds.minX, bounds.maxX);
+    std::uniform_real_distribution<ddouble> randomY(bounds.minY, bounds.maxY);
+
+    QVector<Vector2d> points;
+    points.reserve(2 * traces);
+    for (int i = 0; i < 2 * traces; ++i)
+    {
+        ddouble const x = randomX(rng);
+        points << Vector2d(x, randomY(rng));
+    }
+
+    dint64 intercepts = 0;
+    Time startedAt;
+    for (int i = 0; i < traces; ++i)
+    {
+        Interceptor(countIntercept, points[2*i], points[2*i + 1], PTF_ALL, &intercepts)
+                .trace(map);
+    }
+    TimeSpan const elapsed = startedAt.since();
+
+    Record results;
+    results.set("map", map.id());
+    results.set("traces", traces);
+    results.set("intercepts", ddouble(intercepts));
+    results.set("seconds", double(elapsed));
+    results.set("tracesPerSecond", elapsed > 0? traces / double(elapsed) : 0.0);
+
+    LOG_MAP_NOTE("Total: %.2f ms (%.1f traces/s, %.1f intercepts per trace)")
+            << elapsed * 1000 << results.getd("tracesPerSecond")
+            << intercepts / double(de::max(1, traces));
+
+    return writeResults(results, outputPath);
+}
+
+void Sv_CheckCommandLineBenchmark()
+{
+    static bool checked = false;
+
+    if (checked || !App_World().hasMap()) return;
+    checked = true;
+
+    CommandLine &cmdLine = App::commandLine();
+    int const ticsPos   = cmdLine.check("-benchtics", 1);
+    int const tracesPos = cmdLine.check("-benchtraces", 1);
+    if (ticsPos || tracesPos)
+    {
+        NativePath outputPath;
+        if (int outPos = cmdLine.check("-benchout", 1))
+        {
+            cmdLine.makeAbsolutePath(outPos + 1);
+            outputPath = cmdLine.at(outPos + 1);
+        }
+        if (tracesPos)
+        {
+            Sv_RunTraceBenchmark(cmdLine.at(tracesPos + 1).toInt(), outputPath);
+        }
+        else
+        {
+            Sv_RunBenchmark(cmdLine.at(ticsPos + 1).toInt(), outputPath,
+                            cmdLine.has("-benchstir"));
+        }
+        Sys_Quit();
+    }
+}
+
+/**
+ * Console command for benchmarking the current map: benchtics (tics) [(file)]
+ * (The -benchstir option also applies to the command.)
+ */
+D_CMD(BenchTics)
+{
+    DENG2_UNUSED(src);
+
+    int const tics = String(argv[1]).toInt();
+    if (tics <= 0)
+    {
+        LOG_SCR_ERROR("Number of tics must be positive");
+        return false;
+    }
+    return Sv_RunBenchmark(tics, argc > 2? NativePath(argv[2]) : NativePath(),
+                           App::commandLine().has("-benchstir"));
+}
+
+/**
+ * Console command for benchmarking path traces: benchtraces (count) [(file)]
+ */
+D_CMD(BenchTraces)
+{
+    DENG2_UNUSED(src);
+
+    int const traces = String(argv[1]).toInt();
+    if (traces <= 0)
+    {
+        LOG_SCR_ERROR("Number of traces must be positive");
+        return false;
+    }
+    return Sv_RunTraceBenchmark(traces, argc > 2? NativePath(argv[2]) : NativePath());
+}
+
+void Sv_BenchRegister()
+{
+    C_CMD("benchtics",   "i",  BenchTics);
+    C_CMD("benchtics",   "is", BenchTics);
+    C_CMD("benchtraces", "i",  BenchTraces);
+    C_CMD("benchtraces", "is", BenchTraces);
+}
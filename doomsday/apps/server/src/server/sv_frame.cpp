@@ -26,6 +26,7 @@
 #include "world/p_players.h"
 
 #include <de/LogBuffer>
+#include <de/PackedWriter>
 #include <cmath>
 
 using namespace de;
@@ -50,6 +51,10 @@ using namespace de;
 // If movement is faster than this, we'll adjust the place of the point.
 #define MOM_FAST_LIMIT      (127)
 
+// Upper limit for the size of a single written delta (in practice, mobj deltas
+// are the largest at less than 100 bytes).
+#define MAX_DELTA_SIZE      1024
+
 void Sv_SendFrame(dint playerNumber);
 
 dint allowFrames;
@@ -164,9 +169,9 @@ void Sv_Shutdown()
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WriteMobjDelta(const void* deltaPtr)
+void Sv_WriteMobjDelta(PackedWriter &writer, void const *deltaPtr)
 {
     auto const *delta  = reinterpret_cast<mobjdelta_t const *>(deltaPtr);
     dt_mobj_t const *d = &delta->mo;
@@ -238,13 +243,13 @@ void Sv_WriteMobjDelta(const void* deltaPtr)
     DENG2_ASSERT((df & 0xffff) != 0);    // don't write empty deltas
 
     // First the mobj ID number and flags.
-    Writer_WriteUInt16(::msgWriter, delta->delta.id);
-    Writer_WriteUInt16(::msgWriter, df & 0xffff);
+    writer.writeUInt16(delta->delta.id);
+    writer.writeUInt16(df & 0xffff);
 
     // More flags?
     if (df & MDF_MORE_FLAGS)
     {
-        Writer_WriteByte(::msgWriter, moreFlags);
+        writer.writeByte(moreFlags);
     }
 
     // Coordinates with three bytes.
@@ -252,128 +257,128 @@ void Sv_WriteMobjDelta(const void* deltaPtr)
     {
         fixed_t vx = FLT2FIX(d->origin[VX]);
 
-        Writer_WriteInt16(::msgWriter, vx >> FRACBITS);
-        Writer_WriteByte(::msgWriter, vx >> 8);
+        writer.writeInt16(vx >> FRACBITS);
+        writer.writeByte(vx >> 8);
     }
     if (df & MDF_ORIGIN_Y)
     {
         fixed_t vy = FLT2FIX(d->origin[VY]);
 
-        Writer_WriteInt16(::msgWriter, vy >> FRACBITS);
-        Writer_WriteByte(::msgWriter, vy >> 8);
+        writer.writeInt16(vy >> FRACBITS);
+        writer.writeByte(vy >> 8);
     }
 
     if (df & MDF_ORIGIN_Z)
     {
         fixed_t vz = FLT2FIX(d->origin[VZ]);
-        Writer_WriteInt16(::msgWriter, vz >> FRACBITS);
-        Writer_WriteByte(::msgWriter, vz >> 8);
+        writer.writeInt16(vz >> FRACBITS);
+        writer.writeByte(vz >> 8);
 
-        Writer_WriteFloat(::msgWriter, d->floorZ);
-        Writer_WriteFloat(::msgWriter, d->ceilingZ);
+        writer.writeFloat(d->floorZ);
+        writer.writeFloat(d->ceilingZ);
     }
 
     // Momentum using 8.8 fixed point.
     if (df & MDF_MOM_X)
     {
         fixed_t mx = FLT2FIX(d->mom[MX]);
-        Writer_WriteInt16(::msgWriter, moreFlags & MDFE_FAST_MOM ? FIXED10_6(mx) : FIXED8_8(mx));
+        writer.writeInt16(moreFlags & MDFE_FAST_MOM ? FIXED10_6(mx) : FIXED8_8(mx));
     }
 
     if (df & MDF_MOM_Y)
     {
         fixed_t my = FLT2FIX(d->mom[MY]);
-        Writer_WriteInt16(::msgWriter, moreFlags & MDFE_FAST_MOM ? FIXED10_6(my) : FIXED8_8(my));
+        writer.writeInt16(moreFlags & MDFE_FAST_MOM ? FIXED10_6(my) : FIXED8_8(my));
     }
 
     if (df & MDF_MOM_Z)
     {
         fixed_t mz = FLT2FIX(d->mom[MZ]);
-        Writer_WriteInt16(::msgWriter, moreFlags & MDFE_FAST_MOM ? FIXED10_6(mz) : FIXED8_8(mz));
+        writer.writeInt16(moreFlags & MDFE_FAST_MOM ? FIXED10_6(mz) : FIXED8_8(mz));
     }
 
     // Angles with 16-bit accuracy.
     if (df & MDF_ANGLE)
-        Writer_WriteInt16(::msgWriter, d->angle >> 16);
+        writer.writeInt16(d->angle >> 16);
 
     if (df & MDF_SELECTOR)
-        Writer_WritePackedUInt16(::msgWriter, d->selector);
+        writer.writePackedUInt16(d->selector);
     if (df & MDF_SELSPEC)
-        Writer_WriteByte(::msgWriter, d->selector >> 24);
+        writer.writeByte(d->selector >> 24);
 
     if (df & MDF_STATE)
     {
         DENG2_ASSERT(d->state != 0);
-        Writer_WritePackedUInt16(::msgWriter, ::runtimeDefs.states.indexOf(d->state));
+        writer.writePackedUInt16(::runtimeDefs.states.indexOf(d->state));
     }
 
     if (df & MDF_FLAGS)
     {
-        Writer_WriteUInt32(::msgWriter, d->ddFlags & DDMF_PACK_MASK);
-        Writer_WriteUInt32(::msgWriter, d->flags);
-        Writer_WriteUInt32(::msgWriter, d->flags2);
-        Writer_WriteUInt32(::msgWriter, d->flags3);
+        writer.writeUInt32(d->ddFlags & DDMF_PACK_MASK);
+        writer.writeUInt32(d->flags);
+        writer.writeUInt32(d->flags2);
+        writer.writeUInt32(d->flags3);
     }
 
     if (df & MDF_HEALTH)
-        Writer_WriteInt32(::msgWriter, d->health);
+        writer.writeInt32(d->health);
 
     if (df & MDF_RADIUS)
-        Writer_WriteFloat(::msgWriter, d->radius);
+        writer.writeFloat(d->radius);
 
     if (df & MDF_HEIGHT)
-        Writer_WriteFloat(::msgWriter, d->height);
+        writer.writeFloat(d->height);
 
     if (df & MDF_FLOORCLIP)
-        Writer_WriteFloat(::msgWriter, d->floorClip);
+        writer.writeFloat(d->floorClip);
 
     if (df & MDFC_TRANSLUCENCY)
-        Writer_WriteByte(::msgWriter, d->translucency);
+        writer.writeByte(d->translucency);
 
     if (df & MDFC_FADETARGET)
-        Writer_WriteByte(::msgWriter, byte( d->visTarget + 1 ));
+        writer.writeByte(byte( d->visTarget + 1 ));
 
     if (df & MDFC_TYPE)
-        Writer_WriteInt32(::msgWriter, d->type);
+        writer.writeInt32(d->type);
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WritePlayerDelta(void const *deltaPtr)
+void Sv_WritePlayerDelta(PackedWriter &writer, void const *deltaPtr)
 {
     auto const *delta    = reinterpret_cast<playerdelta_t const *>(deltaPtr);
     dt_player_t const *d = &delta->player;
     dint df              = delta->delta.flags;
 
     // First the player number. Upper three bits contain flags.
-    Writer_WriteByte(::msgWriter, delta->delta.id | (df >> 8));
+    writer.writeByte(delta->delta.id | (df >> 8));
 
     // Flags. What elements are included in the delta?
-    Writer_WriteByte(::msgWriter, df & 0xff);
+    writer.writeByte(df & 0xff);
 
     if (df & PDF_MOBJ)
-        Writer_WriteUInt16(::msgWriter, d->mobj);
+        writer.writeUInt16(d->mobj);
     if (df & PDF_FORWARDMOVE)
-        Writer_WriteByte(::msgWriter, d->forwardMove);
+        writer.writeByte(d->forwardMove);
     if (df & PDF_SIDEMOVE)
-        Writer_WriteByte(::msgWriter, d->sideMove);
+        writer.writeByte(d->sideMove);
     /*if (df & PDF_ANGLE)
-        Writer_WriteByte(::msgWriter, d->angle >> 24);*/
+        writer.writeByte(d->angle >> 24);*/
     if (df & PDF_TURNDELTA)
-        Writer_WriteByte(::msgWriter, (d->turnDelta * 16) >> 24);
+        writer.writeByte((d->turnDelta * 16) >> 24);
     if (df & PDF_FRICTION)
-        Writer_WriteByte(::msgWriter, FLT2FIX(d->friction) >> 8);
+        writer.writeByte(FLT2FIX(d->friction) >> 8);
     if (df & PDF_EXTRALIGHT)
     {
         // Three bits is enough for fixedcolormap.
         dint const cmap = de::clamp(0, d->fixedColorMap, 7);
         // Write the five upper bytes of extraLight.
-        Writer_WriteByte(::msgWriter, cmap | (d->extraLight & 0xf8));
+        writer.writeByte(cmap | (d->extraLight & 0xf8));
     }
     if (df & PDF_FILTER)
     {
-        Writer_WriteUInt32(::msgWriter, d->filter);
+        writer.writeUInt32(d->filter);
         LOGDEV_NET_XVERBOSE_DEBUGONLY("Sv_WritePlayerDelta: Plr %i, filter %08x", delta->delta.id << d->filter);
     }
     if (df & PDF_PSPRITES)       // Only set if there's something to write.
@@ -384,38 +389,38 @@ void Sv_WritePlayerDelta(void const *deltaPtr)
             dint const flags       = df >> (16 + i * 8);
 
             // First the flags.
-            Writer_WriteByte(::msgWriter, flags);
+            writer.writeByte(flags);
             if (flags & PSDF_STATEPTR)
             {
-                Writer_WritePackedUInt16(::msgWriter, psp.statePtr ? (::runtimeDefs.states.indexOf(psp.statePtr) + 1) : 0);
+                writer.writePackedUInt16(psp.statePtr ? (::runtimeDefs.states.indexOf(psp.statePtr) + 1) : 0);
             }
             /*if (flags & PSDF_LIGHT)
             {
                 dint const light = de::clamp(0, psp.light * 255, 255);
-                Writer_WriteByte(::msgWriter, light);
+                writer.writeByte(light);
             }*/
             if (flags & PSDF_ALPHA)
             {
                 dint const alpha = de::clamp(0.f, psp.alpha * 255, 255.f);
-                Writer_WriteByte(::msgWriter, alpha);
+                writer.writeByte(alpha);
             }
             if (flags & PSDF_STATE)
             {
-                Writer_WriteByte(::msgWriter, psp.state);
+                writer.writeByte(psp.state);
             }
             if (flags & PSDF_OFFSET)
             {
-                Writer_WriteByte(::msgWriter, CLAMPED_CHAR(psp.offset[VX] / 2));
-                Writer_WriteByte(::msgWriter, CLAMPED_CHAR(psp.offset[VY] / 2));
+                writer.writeByte(CLAMPED_CHAR(psp.offset[VX] / 2));
+                writer.writeByte(CLAMPED_CHAR(psp.offset[VY] / 2));
             }
         }
     }
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WriteSectorDelta(void const *deltaPtr)
+void Sv_WriteSectorDelta(PackedWriter &writer, void const *deltaPtr)
 {
     auto const *delta    = reinterpret_cast<sectordelta_t const *>(deltaPtr);
     dt_sector_t const *d = &delta->sector;
@@ -447,123 +452,123 @@ void Sv_WriteSectorDelta(void const *deltaPtr)
     }
 
     // Sector number first.
-    Writer_WriteUInt16(::msgWriter, delta->delta.id);
+    writer.writeUInt16(delta->delta.id);
 
     // Flags.
-    Writer_WritePackedUInt32(::msgWriter, df);
+    writer.writePackedUInt32(df);
 
     if (df & SDF_FLOOR_MATERIAL)
-        Writer_WritePackedUInt16(::msgWriter, Sv_IdForMaterial(d->planes[PLN_FLOOR].surface.material));
+        writer.writePackedUInt16(Sv_IdForMaterial(d->planes[PLN_FLOOR].surface.material));
     if (df & SDF_CEILING_MATERIAL)
-        Writer_WritePackedUInt16(::msgWriter, Sv_IdForMaterial(d->planes[PLN_CEILING].surface.material));
+        writer.writePackedUInt16(Sv_IdForMaterial(d->planes[PLN_CEILING].surface.material));
     if (df & SDF_LIGHT)
     {
         // Must fit into a byte.
         auto lightlevel = dint( 255.0f * d->lightLevel );
         lightlevel = (lightlevel < 0 ? 0 : lightlevel > 255 ? 255 : lightlevel);
 
-        Writer_WriteByte(::msgWriter, byte( lightlevel ));
+        writer.writeByte(byte( lightlevel ));
     }
     if (df & SDF_FLOOR_HEIGHT)
     {
-        Writer_WriteInt16(::msgWriter, FLT2FIX(d->planes[PLN_FLOOR].height) >> 16);
+        writer.writeInt16(FLT2FIX(d->planes[PLN_FLOOR].height) >> 16);
     }
     if (df & SDF_CEILING_HEIGHT)
     {
         LOGDEV_NET_XVERBOSE_DEBUGONLY("Sv_WriteSectorDelta: (%i) Absolute ceiling height=%f",
                                      delta->delta.id << d->planes[PLN_CEILING].height);
 
-        Writer_WriteInt16(::msgWriter, FLT2FIX(d->planes[PLN_CEILING].height) >> 16);
+        writer.writeInt16(FLT2FIX(d->planes[PLN_CEILING].height) >> 16);
     }
     if (df & SDF_FLOOR_TARGET)
-        Writer_WriteInt16(::msgWriter, FLT2FIX(d->planes[PLN_FLOOR].target) >> 16);
+        writer.writeInt16(FLT2FIX(d->planes[PLN_FLOOR].target) >> 16);
     if (df & SDF_FLOOR_SPEED)    // 7.1/4.4 fixed-point
-        Writer_WriteByte(::msgWriter, floorSpd);
+        writer.writeByte(floorSpd);
     if (df & SDF_CEILING_TARGET)
-        Writer_WriteInt16(::msgWriter, FLT2FIX(d->planes[PLN_CEILING].target) >> 16);
+        writer.writeInt16(FLT2FIX(d->planes[PLN_CEILING].target) >> 16);
     if (df & SDF_CEILING_SPEED)  // 7.1/4.4 fixed-point
-        Writer_WriteByte(::msgWriter, ceilSpd);
+        writer.writeByte(ceilSpd);
     if (df & SDF_COLOR_RED)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->rgb[0] ));
+        writer.writeByte(byte( 255 * d->rgb[0] ));
     if (df & SDF_COLOR_GREEN)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->rgb[1] ));
+        writer.writeByte(byte( 255 * d->rgb[1] ));
     if (df & SDF_COLOR_BLUE)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->rgb[2] ));
+        writer.writeByte(byte( 255 * d->rgb[2] ));
 
     if (df & SDF_FLOOR_COLOR_RED)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->planes[PLN_FLOOR].surface.rgba[0] ));
+        writer.writeByte(byte( 255 * d->planes[PLN_FLOOR].surface.rgba[0] ));
     if (df & SDF_FLOOR_COLOR_GREEN)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->planes[PLN_FLOOR].surface.rgba[1] ));
+        writer.writeByte(byte( 255 * d->planes[PLN_FLOOR].surface.rgba[1] ));
     if (df & SDF_FLOOR_COLOR_BLUE)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->planes[PLN_FLOOR].surface.rgba[2] ));
+        writer.writeByte(byte( 255 * d->planes[PLN_FLOOR].surface.rgba[2] ));
 
     if (df & SDF_CEIL_COLOR_RED)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->planes[PLN_CEILING].surface.rgba[0] ));
+        writer.writeByte(byte( 255 * d->planes[PLN_CEILING].surface.rgba[0] ));
     if (df & SDF_CEIL_COLOR_GREEN)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->planes[PLN_CEILING].surface.rgba[1] ));
+        writer.writeByte(byte( 255 * d->planes[PLN_CEILING].surface.rgba[1] ));
     if (df & SDF_CEIL_COLOR_BLUE)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->planes[PLN_CEILING].surface.rgba[2] ));
+        writer.writeByte(byte( 255 * d->planes[PLN_CEILING].surface.rgba[2] ));
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WriteSideDelta(void const *deltaPtr)
+void Sv_WriteSideDelta(PackedWriter &writer, void const *deltaPtr)
 {
     auto const *delta  = (sidedelta_t const *) deltaPtr;
     dt_side_t const *d = &delta->side;
     dint            df = delta->delta.flags;
 
     // Side number first.
-    Writer_WriteUInt16(::msgWriter, delta->delta.id);
+    writer.writeUInt16(delta->delta.id);
 
     // Flags.
-    Writer_WritePackedUInt32(::msgWriter, df);
+    writer.writePackedUInt32(df);
 
     if (df & SIDF_TOP_MATERIAL)
-        Writer_WritePackedUInt16(::msgWriter, Sv_IdForMaterial(d->top.material));
+        writer.writePackedUInt16(Sv_IdForMaterial(d->top.material));
     if (df & SIDF_MID_MATERIAL)
-        Writer_WritePackedUInt16(::msgWriter, Sv_IdForMaterial(d->middle.material));
+        writer.writePackedUInt16(Sv_IdForMaterial(d->middle.material));
     if (df & SIDF_BOTTOM_MATERIAL)
-        Writer_WritePackedUInt16(::msgWriter, Sv_IdForMaterial(d->bottom.material));
+        writer.writePackedUInt16(Sv_IdForMaterial(d->bottom.material));
 
     if (df & SIDF_LINE_FLAGS)
-        Writer_WriteByte(::msgWriter, d->lineFlags);
+        writer.writeByte(d->lineFlags);
 
     if (df & SIDF_TOP_COLOR_RED)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->top.rgba[0] ));
+        writer.writeByte(byte( 255 * d->top.rgba[0] ));
     if (df & SIDF_TOP_COLOR_GREEN)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->top.rgba[1] ));
+        writer.writeByte(byte( 255 * d->top.rgba[1] ));
     if (df & SIDF_TOP_COLOR_BLUE)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->top.rgba[2] ));
+        writer.writeByte(byte( 255 * d->top.rgba[2] ));
 
     if (df & SIDF_MID_COLOR_RED)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->middle.rgba[0] ));
+        writer.writeByte(byte( 255 * d->middle.rgba[0] ));
     if (df & SIDF_MID_COLOR_GREEN)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->middle.rgba[1] ));
+        writer.writeByte(byte( 255 * d->middle.rgba[1] ));
     if (df & SIDF_MID_COLOR_BLUE)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->middle.rgba[2] ));
+        writer.writeByte(byte( 255 * d->middle.rgba[2] ));
     if (df & SIDF_MID_COLOR_ALPHA)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->middle.rgba[3] ));
+        writer.writeByte(byte( 255 * d->middle.rgba[3] ));
 
     if (df & SIDF_BOTTOM_COLOR_RED)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->bottom.rgba[0] ));
+        writer.writeByte(byte( 255 * d->bottom.rgba[0] ));
     if (df & SIDF_BOTTOM_COLOR_GREEN)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->bottom.rgba[1] ));
+        writer.writeByte(byte( 255 * d->bottom.rgba[1] ));
     if (df & SIDF_BOTTOM_COLOR_BLUE)
-        Writer_WriteByte(::msgWriter, byte( 255 * d->bottom.rgba[2] ));
+        writer.writeByte(byte( 255 * d->bottom.rgba[2] ));
 
     if (df & SIDF_MID_BLENDMODE)
-        Writer_WriteInt32(::msgWriter, d->middle.blendMode);
+        writer.writeInt32(d->middle.blendMode);
 
     if (df & SIDF_FLAGS)
-        Writer_WriteByte(::msgWriter, d->flags);
+        writer.writeByte(d->flags);
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WritePolyDelta(void const *deltaPtr)
+void Sv_WritePolyDelta(PackedWriter &writer, void const *deltaPtr)
 {
     auto const  *delta = (polydelta_t const *) deltaPtr;
     dt_poly_t const *d = &delta->po;
@@ -577,36 +582,36 @@ void Sv_WritePolyDelta(void const *deltaPtr)
     }
 
     // Poly number first.
-    Writer_WritePackedUInt16(::msgWriter, delta->delta.id);
+    writer.writePackedUInt16(delta->delta.id);
 
     // Flags.
-    Writer_WriteByte(::msgWriter, df & 0xff);
+    writer.writeByte(df & 0xff);
 
     if (df & PODF_DEST_X)
-        Writer_WriteFloat(::msgWriter, d->dest[VX]);
+        writer.writeFloat(d->dest[VX]);
     if (df & PODF_DEST_Y)
-        Writer_WriteFloat(::msgWriter, d->dest[VY]);
+        writer.writeFloat(d->dest[VY]);
     if (df & PODF_SPEED)
-        Writer_WriteFloat(::msgWriter, d->speed);
+        writer.writeFloat(d->speed);
     if (df & PODF_DEST_ANGLE)
-        Writer_WriteInt16(::msgWriter, d->destAngle >> 16);
+        writer.writeInt16(d->destAngle >> 16);
     if (df & PODF_ANGSPEED)
-        Writer_WriteInt16(::msgWriter, d->angleSpeed >> 16);
+        writer.writeInt16(d->angleSpeed >> 16);
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WriteSoundDelta(void const *deltaPtr)
+void Sv_WriteSoundDelta(PackedWriter &writer, void const *deltaPtr)
 {
     auto const *delta = (sounddelta_t const *) deltaPtr;
     dint           df = delta->delta.flags;
 
     // This is either the sound ID, emitter ID or sector index.
-    Writer_WriteUInt16(::msgWriter, delta->delta.id);
+    writer.writeUInt16(delta->delta.id);
 
     // First the flags byte.
-    Writer_WriteByte(::msgWriter, df & 0xff);
+    writer.writeByte(df & 0xff);
 
     switch (delta->delta.type)
     {
@@ -615,7 +620,7 @@ void Sv_WriteSoundDelta(void const *deltaPtr)
     case DT_SIDE_SOUND:
     case DT_POLY_SOUND:
         // The sound ID.
-        Writer_WriteUInt16(::msgWriter, delta->sound);
+        writer.writeUInt16(delta->sound);
         break;
 
     default: break;
@@ -627,16 +632,16 @@ void Sv_WriteSoundDelta(void const *deltaPtr)
         if (delta->volume > 1)
         {
             // Very loud indeed.
-            Writer_WriteByte(::msgWriter, 255);
+            writer.writeByte(255);
         }
         else if (delta->volume <= 0)
         {
             // Silence.
-            Writer_WriteByte(::msgWriter, 0);
+            writer.writeByte(0);
         }
         else
         {
-            Writer_WriteByte(::msgWriter, delta->volume * 127 + 0.5f);
+            writer.writeByte(delta->volume * 127 + 0.5f);
         }
     }
 }
@@ -644,7 +649,7 @@ void Sv_WriteSoundDelta(void const *deltaPtr)
 /**
  * Write the type and possibly the set number (for Unacked deltas).
  */
-void Sv_WriteDeltaHeader(byte type, delta_t const *delta)
+void Sv_WriteDeltaHeader(PackedWriter &writer, byte type, delta_t const *delta)
 {
 #ifdef DENG2_DEBUG
     if (type >= NUM_DELTA_TYPES)
@@ -663,7 +668,7 @@ void Sv_WriteDeltaHeader(byte type, delta_t const *delta)
         type |= DT_RESENT;
     }
 
-    Writer_WriteByte(::msgWriter, type);
+    writer.writeByte(type);
 
     // Include the set number?
     if (type & DT_RESENT)
@@ -672,26 +677,26 @@ void Sv_WriteDeltaHeader(byte type, delta_t const *delta)
         // received the set this delta belongs to, it means the delta has
         // already been received. This is needed in the situation where the
         // ack is lost or delayed.
-        Writer_WriteByte(::msgWriter, delta->set);
+        writer.writeByte(delta->set);
 
         // Also send the unique ID of this delta. If the client has already
         // received a delta with this ID, the delta is discarded. This is
         // needed in the situation where the set is lost.
-        Writer_WriteByte(::msgWriter, delta->resend);
+        writer.writeByte(delta->resend);
     }
 }
 
 /**
- * The delta is written to the message buffer.
+ * The delta is written to @a writer.
  */
-void Sv_WriteDelta(delta_t const *delta)
+void Sv_WriteDelta(PackedWriter &writer, delta_t const *delta)
 {
     DENG2_ASSERT(delta);
 
 #ifdef _NETDEBUG
     // Extra length field in debug builds.
-    dint const lengthOffset = Msg_Offset();
-    Msg_WriteLong(0);
+    dsize const lengthOffset = writer.size();
+    writer.writeInt32(0);
 #endif
 
     // Null mobj deltas are special.
@@ -700,8 +705,8 @@ void Sv_WriteDelta(delta_t const *delta)
         if (delta->flags & MDFC_NULL)
         {
             // This'll be the entire delta. No more data is needed.
-            Sv_WriteDeltaHeader(DT_NULL_MOBJ, delta);
-            Writer_WriteUInt16(::msgWriter, delta->id);
+            Sv_WriteDeltaHeader(writer, DT_NULL_MOBJ, delta);
+            writer.writeUInt16(delta->id);
 #ifdef _NETDEBUG
             goto writeDeltaLength;
 #else
@@ -711,24 +716,24 @@ void Sv_WriteDelta(delta_t const *delta)
     }
 
     // First the type of the delta.
-    Sv_WriteDeltaHeader(delta->type, delta);
+    Sv_WriteDeltaHeader(writer, delta->type, delta);
 
     switch (delta->type)
     {
     //case DT_LUMP:   Sv_WriteLumpDelta(delta);   break;
 
-    case DT_MOBJ:   Sv_WriteMobjDelta(delta);   break;
-    case DT_PLAYER: Sv_WritePlayerDelta(delta); break;
-    case DT_SECTOR: Sv_WriteSectorDelta(delta); break;
-    case DT_SIDE:   Sv_WriteSideDelta(delta);   break;
-    case DT_POLY:   Sv_WritePolyDelta(delta);   break;
+    case DT_MOBJ:   Sv_WriteMobjDelta(writer, delta);   break;
+    case DT_PLAYER: Sv_WritePlayerDelta(writer, delta); break;
+    case DT_SECTOR: Sv_WriteSectorDelta(writer, delta); break;
+    case DT_SIDE:   Sv_WriteSideDelta(writer, delta);   break;
+    case DT_POLY:   Sv_WritePolyDelta(writer, delta);   break;
 
     case DT_SOUND:
     case DT_MOBJ_SOUND:
     case DT_SECTOR_SOUND:
     case DT_SIDE_SOUND:
     case DT_POLY_SOUND:
-        Sv_WriteSoundDelta(delta);
+        Sv_WriteSoundDelta(writer, delta);
         break;
 
     default: App_Error("Sv_WriteDelta: Unknown delta type %i.\n", delta->type);
@@ -737,10 +742,10 @@ void Sv_WriteDelta(delta_t const *delta)
 #ifdef _NETDEBUG
 writeDeltaLength:
     // Update the length of the delta.
-    dint endOffset = Msg_Offset();
-    Msg_SetOffset(lengthOffset);
-    Msg_WriteLong(endOffset - lengthOffset);
-    Msg_SetOffset(endOffset);
+    dsize const endOffset = writer.size();
+    writer.rewind(lengthOffset);
+    writer.writeInt32(dint32(endOffset - lengthOffset));
+    writer.rewind(endOffset);
 #endif
 }
 
@@ -807,18 +812,22 @@ void Sv_SendFrame(dint plrNum)
         maxFrameSize = MAX_FIRST_FRAME_SIZE;
     }
 
-    // If this is the first frame after a map change, use the special
-    // first frame packet type.
-    Msg_Begin(pool->isFirst ? PSV_FIRST_FRAME2 : PSV_FRAME2);
+    // The frame is composed in a local buffer and copied to the message in one
+    // go. There is room for one maximum-size delta past the size limit.
+    static dbyte frameBuffer[MAX_FIRST_FRAME_SIZE + MAX_DELTA_SIZE];
+    PackedWriter writer(frameBuffer, sizeof(frameBuffer));
+
+    // The limit includes the packet type, which is not in the buffer.
+    maxFrameSize -= 1;
 
     // First send the gameTime of this frame.
-    Writer_WriteFloat(::msgWriter, ::gameTime);
+    writer.writeFloat(::gameTime);
 
     // Keep writing until the maximum size is reached.
     delta_t *delta;
-    size_t lastStart;
+    dsize lastStart;
     while ((delta = Sv_PoolQueueExtract(pool)) != nullptr &&
-          (lastStart = Writer_Size(::msgWriter)) < maxFrameSize)
+          (lastStart = writer.size()) < maxFrameSize)
     {
         byte const oldResend = pool->resendDealer;
 
@@ -830,10 +839,10 @@ void Sv_SendFrame(dint plrNum)
             delta->resend = Sv_GetNewResendID(pool);
         }
 
-        Sv_WriteDelta(delta);
+        Sv_WriteDelta(writer, delta);
 
         // Did we go over the limit?
-        if (Writer_Size(::msgWriter) > maxFrameSize)
+        if (writer.hasOverflowed() || writer.size() > maxFrameSize)
         {
             /*
             // Time to see if BWR needs to be adjusted.
@@ -844,7 +853,7 @@ void Sv_SendFrame(dint plrNum)
             */
 
             // Cancel the last delta.
-            Writer_SetPos(::msgWriter, lastStart);
+            writer.rewind(lastStart);
 
             // Restore the resend dealer.
             if (oldResend)
@@ -864,6 +873,10 @@ void Sv_SendFrame(dint plrNum)
         }
     }
 
+    // If this is the first frame after a map change, use the special
+    // first frame packet type.
+    Msg_Begin(pool->isFirst ? PSV_FIRST_FRAME2 : PSV_FRAME2);
+    Writer_Write(::msgWriter, writer.data(), writer.size());
     Msg_End();
 
     Net_SendBuffer(plrNum, 0);
@@ -29,6 +29,7 @@
 #include <de/timer.h>
 #include <de/vector1.h>
 #include <de/LogBuffer>
+#include <doomsday/world/TickProfiler>
 #include "def_main.h"  // Def_SameStateSequence
 
 #include "network/net_main.h"
@@ -2447,6 +2448,8 @@ void Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber, dd_bool doUpdate)
  */
 void Sv_GenerateFrameDeltas(void)
 {
+    world::TickProfiler::Scope profile(world::TickProfiler::Deltas);
+
     // Generate new deltas for all clients and update the world register.
     Sv_GenerateNewDeltas(&worldRegister, -1, true);
 }
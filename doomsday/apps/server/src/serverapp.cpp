@@ -175,6 +175,13 @@ DENG2_PIMPL(ServerApp)
         printf(" -iwad (dir)  Set directory containing IWAD files.\n");
         printf(" -file (f)    Load one or more PWAD files at startup.\n");
         printf(" -game (id)   Set game to load at startup.\n");
+        printf(" -benchtics (n)  Run n tics in the startup map as fast as possible,\n"
+               "                 report the timing of the world simulation, and quit.\n");
+        printf(" -benchstir      Push mobjs around during -benchtics, so that movement\n"
+               "                 and collisions are exercised without players.\n");
+        printf(" -benchtraces (n) Trace n paths across the startup map, report the\n"
+               "                 timing, and quit.\n");
+        printf(" -benchout (f)   Write the benchmark results as JSON to file f.\n");
         printf(" --version    Print current version.\n");
         printf("For more options and information, see \"man doomsday-server\".\n");
     }
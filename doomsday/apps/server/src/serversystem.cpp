@@ -35,6 +35,7 @@
 #include "remoteuser.h"
 #include "remotefeeduser.h"
 
+#include "server/sv_bench.h"
 #include "server/sv_def.h"
 #include "server/sv_frame.h"
 
@@ -317,6 +318,8 @@ void ServerSystem::timeChanged(Clock const &clock)
 
     Loop_RunTics();
 
+    Sv_CheckCommandLineBenchmark();
+
     // Update clients at regular intervals.
     Sv_TransmitFrame();
 
@@ -378,6 +381,8 @@ void Server_Register()
     C_VAR_CHARPTR("net-ip-address", &nptIPAddress, 0, 0, 0);
     C_VAR_INT    ("net-ip-port",    &nptIPPort, CVF_NO_MAX, 0, 0);
 
+    Sv_BenchRegister();
+
 #ifdef _DEBUG
     C_CMD("netfreq", NULL, NetFreqs);
 #endif
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#
+# Checks that the world simulation stays deterministic. Runs the dedicated
+# server's tick benchmark (-benchtics) on a map and compares the resulting mobj
+# state hash against a recorded one, or against another build of the server.
+#
+# Record the hashes with a known good build:
+#   benchhash.py --server path/to/doomsday-server --game doom2 --map MAP01 \
+#                --tics 3500 --stir --record hashes.json
+#
+# Check a later build against them (exits with status 1 on mismatch):
+#   benchhash.py --server path/to/doomsday-server --game doom2 --map MAP01 \
+#                --tics 3500 --stir --check hashes.json
+#
+# Or compare two builds directly. The speed of both runs is printed as well,
+# including the time spent in the thinkers:
+#   benchhash.py --server new/doomsday-server --baseline old/doomsday-server \
+#                --game doom2 --map MAP01 --tics 3500 --stir
+#
+# Or compare the same build with extra options given to the baseline run, e.g.,
+# a map from makeliftmap.py with and without filtering the mobjs touched by
+# moving planes:
+#   benchhash.py --server path/to/doomsday-server --baseline-args=-fullplanecheck \
+#                --game doom2 --map MAP01 --stir --file liftmap.wad
+#
+# Both builds must support the options used (-benchstir was added after
+# -benchtics).
+
+import argparse, json, os, shlex, subprocess, sys, tempfile
+
+
+def run_benchmark(server, args, extra_args=[]):
+    """Runs the benchmark with the given server executable and returns the
+    results as a dictionary."""
+    fd, out_path = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    try:
+        cmd = [server, '-game', args.game, '-warp', args.map,
+               '-benchtics', str(args.tics), '-benchout', out_path]
+        if args.stir:
+            cmd.append('-benchstir')
+        if args.iwad:
+            cmd += ['-iwad', args.iwad]
+        if args.file:
+            cmd += ['-file'] + args.file
+        cmd += extra_args
+        print('Running:', ' '.join(cmd))
+        subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+        with open(out_path) as f:
+            text = f.read()
+        if not text:
+            sys.exit('%s did not write any benchmark results' % server)
+        return json.loads(text)
+    finally:
+        os.remove(out_path)
+
+
+def timing(result):
+    """Summarizes the speed of a benchmark run: all tics, and the thinkers
+    alone (Thinker_Run in the game plugin)."""
+    tics = max(1, result['tics'])
+    thinkers = result['sections']['thinkers']['seconds'] * 1000 / tics
+    return '%.1f tics/s, thinkers %.4f ms/tic' % (result['ticsPerSecond'], thinkers)
+
+
+def case_key(args):
+    key = '%s/%s/%i' % (args.game, args.map, args.tics)
+    if args.stir:
+        key += '/stir'
+    for name in args.file or []:
+        key += '/' + os.path.basename(name)
+    return key
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare world simulation state hashes.')
+    parser.add_argument('--server', required=True, help='doomsday-server executable')
+    parser.add_argument('--baseline', help='another doomsday-server to compare against')
+    parser.add_argument('--baseline-args', default='',
+                        help='extra options for the baseline run (e.g., -fullplanecheck)')
+    parser.add_argument('--game', required=True, help='game identifier (e.g., doom2)')
+    parser.add_argument('--map', required=True, help='map to run (e.g., MAP01)')
+    parser.add_argument('--tics', type=int, default=35 * 60, help='number of tics to run')
+    parser.add_argument('--stir', action='store_true', help='push mobjs around (-benchstir)')
+    parser.add_argument('--iwad', help='directory containing the IWAD files')
+    parser.add_argument('--file', nargs='*', help='PWAD files to load')
+    group = parser.add_mutually_exclusive_group()
+    group.add_argument('--record', metavar='HASHES', help='store the hash in a JSON file')
+    group.add_argument('--check', metavar='HASHES', help='compare with a hash in a JSON file')
+    args = parser.parse_args()
+
+    key = case_key(args)
+    result = run_benchmark(args.server, args)
+    state_hash = result['mobjStateHash']
+    print('%s: %s (%s)' % (key, state_hash, timing(result)))
+
+    if args.record:
+        hashes = {}
+        if os.path.exists(args.record):
+            with open(args.record) as f:
+                hashes = json.load(f)
+        hashes[key] = state_hash
+        with open(args.record, 'w') as f:
+            json.dump(hashes, f, indent=4, sort_keys=True)
+            f.write('\n')
+        print('Recorded in', args.record)
+        return 0
+
+    if args.check:
+        with open(args.check) as f:
+            expected = json.load(f).get(key)
+        if expected is None:
+            sys.exit('No recorded hash for %s in %s' % (key, args.check))
+    elif args.baseline or args.baseline_args:
+        baseline = run_benchmark(args.baseline or args.server, args,
+                                 shlex.split(args.baseline_args))
+        expected = baseline['mobjStateHash']
+        print('Baseline: %s (%s)' % (expected, timing(baseline)))
+    else:
+        return 0
+
+    if state_hash != expected:
+        print('MISMATCH: expected %s' % expected)
+        return 1
+    print('OK')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
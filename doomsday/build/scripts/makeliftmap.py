@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#
+# Writes a small Doom format PWAD for checking how moving planes affect mobjs
+# standing on other mobjs. The map has a lift in the middle of a room with a
+# ledge next to it. Barrels stand on the lift and imps on the ledge; when the
+# things are pushed around (-benchstir), the imps step onto the barrels and the
+# barrels trigger the lift (the lift lines are "WR lift, monsters too").
+#
+# The engine builds the BSP and blockmap itself, so only the basic map data
+# lumps are written.
+#
+# Usage:
+#   makeliftmap.py liftmap.wad [--map MAP01]
+#
+# Then compare the hashes with and without filtering the mobjs touched by the
+# moving planes:
+#   benchhash.py --server path/to/doomsday-server --baseline-args=-fullplanecheck \
+#                --game doom2 --map MAP01 --stir --file liftmap.wad
+
+import argparse, struct
+
+WALL = b'STARTAN3'
+FLOOR = b'FLOOR4_8'
+CEILING = b'CEIL3_5'
+
+ML_BLOCKING = 1
+ML_TWOSIDED = 4
+LIFT_SPECIAL = 88 # WR lift, also monsters.
+LIFT_TAG = 1
+
+OUTER, LIFT, LEDGE = 0, 1, 2
+
+# (floor, ceiling, tag)
+SECTORS = [(0, 192, 0), (64, 192, LIFT_TAG), (96, 192, 0)]
+
+VERTEXES = [(0, 0), (1024, 0), (1024, 1024), (0, 1024),
+            (384, 384), (640, 384), (640, 512), (640, 640), (384, 640), (384, 512)]
+
+# (v1, v2, front sector, back sector or None, special)
+LINES = [(0, 3, OUTER, None, 0),
+         (3, 2, OUTER, None, 0),
+         (2, 1, OUTER, None, 0),
+         (1, 0, OUTER, None, 0),
+         (4, 9, LIFT, OUTER, LIFT_SPECIAL),
+         (9, 6, LIFT, LEDGE, LIFT_SPECIAL),
+         (6, 5, LIFT, OUTER, LIFT_SPECIAL),
+         (5, 4, LIFT, OUTER, LIFT_SPECIAL),
+         (9, 8, LEDGE, OUTER, 0),
+         (8, 7, LEDGE, OUTER, 0),
+         (7, 6, LEDGE, OUTER, 0)]
+
+PLAYER1_START, BARREL, IMP = 1, 2035, 3001
+
+# (x, y, angle, type)
+THINGS = [(128, 128, 0, PLAYER1_START),
+          (448, 448, 0, BARREL), (512, 448, 0, BARREL), (576, 448, 0, BARREL),
+          (512, 320, 0, BARREL), (320, 448, 0, BARREL), (704, 448, 0, BARREL),
+          (448, 576, 270, IMP), (512, 576, 270, IMP), (576, 576, 270, IMP),
+          (448, 704, 270, IMP), (576, 704, 270, IMP)]
+
+SKILL_ALL = 7
+
+
+def name8(name):
+    return name.ljust(8, b'\0')
+
+
+def map_lumps():
+    things = b''.join(struct.pack('<5h', x, y, angle, kind, SKILL_ALL)
+                      for x, y, angle, kind in THINGS)
+
+    linedefs, sidedefs = b'', b''
+    side_count = 0
+    for v1, v2, front, back, special in LINES:
+        sides = [front] if back is None else [front, back]
+        for sector in sides:
+            if back is None:
+                textures = name8(b'-') + name8(b'-') + name8(WALL)
+            else:
+                textures = name8(WALL) + name8(WALL) + name8(b'-')
+            sidedefs += struct.pack('<2h', 0, 0) + textures + struct.pack('<h', sector)
+        flags = ML_BLOCKING if back is None else ML_TWOSIDED
+        tag = LIFT_TAG if special else 0
+        back_side = side_count + 1 if back is not None else -1
+        linedefs += struct.pack('<7h', v1, v2, flags, special, tag, side_count, back_side)
+        side_count += len(sides)
+
+    vertexes = b''.join(struct.pack('<2h', x, y) for x, y in VERTEXES)
+    sectors = b''.join(struct.pack('<2h', floor, ceil) + name8(FLOOR) + name8(CEILING) +
+                       struct.pack('<3h', 160, 0, tag)
+                       for floor, ceil, tag in SECTORS)
+
+    return [(b'THINGS', things), (b'LINEDEFS', linedefs), (b'SIDEDEFS', sidedefs),
+            (b'VERTEXES', vertexes), (b'SECTORS', sectors)]
+
+
+def write_wad(path, lumps):
+    data, directory = b'', b''
+    offset = 12
+    for name, content in lumps:
+        directory += struct.pack('<2i', offset if content else 0, len(content)) + name8(name)
+        data += content
+        offset += len(content)
+    with open(path, 'wb') as f:
+        f.write(b'PWAD' + struct.pack('<2i', len(lumps), offset))
+        f.write(data)
+        f.write(directory)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Write a test map with things stacked on a lift.')
+    parser.add_argument('output', help='PWAD file to write')
+    parser.add_argument('--map', default='MAP01', help='map lump name (e.g., MAP01 or E1M1)')
+    args = parser.parse_args()
+
+    write_wad(args.output, [(args.map.upper().encode('ascii'), b'')] + map_lumps())
+    print('Wrote', args.output)
+
+
+if __name__ == '__main__':
+    main()
@@ -27,6 +27,8 @@
 #include <de/Lockable>
 #include <de/shell/ILineWrapping>
 
+#include <QPair>
+
 namespace de {
 
 /**
@@ -36,6 +38,10 @@ namespace de {
  *
  * Supports indentation of lines, as marked in the RichFormat.
  *
+ * The wrapped lines of each paragraph are kept in a cache, so wrapping a text
+ * again after it has been edited or appended to only processes the paragraphs
+ * that have changed.
+ *
  * @par Thread-safety
  *
  * FontLineWrapping locks itself automatically when any of its methods are
@@ -78,6 +84,7 @@ public:
 
     bool isEmpty() const;
     String const &text() const;
+    Font::RichFormat const &format() const;
     shell::WrappedLine line(int index) const;
     int width() const;
     int height() const;
@@ -143,6 +150,18 @@ public:
      */
     Image rasterizedSegment(int line, int segment) const;
 
+    typedef QPair<int, int> LineSegment; ///< Line index and segment on the line.
+
+    /**
+     * Returns rasterized versions of several segments. Segments that have not
+     * been rasterized previously are rasterized in parallel in worker threads.
+     *
+     * @param segments  Segments to rasterize.
+     *
+     * @return Images in the same order as @a segments.
+     */
+    QVector<Image> rasterizedSegments(QVector<LineSegment> const &segments) const;
+
 private:
     DENG2_PRIVATE(d)
 };
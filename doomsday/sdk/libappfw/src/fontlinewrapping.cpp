@@ -23,8 +23,11 @@
 #include "de/FontLineWrapping"
 #include "de/BaseGuiApp"
 #include <de/Image>
+#include <de/TaskPool>
 
+#include <QHash>
 #include <QMap>
+#include <QThread>
 #include <atomic>
 
 namespace de {
@@ -65,6 +68,56 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
     typedef QVector<Line *> Lines;
     Lines lines;
 
+    /**
+     * Identifies the wrapping of a paragraph, i.e., a range of text ending in a
+     * newline. Besides the content and the available width, the result depends on
+     * the indentation and tab stop in effect when the paragraph begins.
+     */
+    struct ParagraphKey
+    {
+        String text;            ///< Including the terminating newline.
+        duint32 formatHash;
+        int maxWidth;
+        int fontHeight;
+        int indent;
+        QVector<int> prevIndents;
+        int tabStop;
+
+        bool operator == (ParagraphKey const &other) const
+        {
+            return formatHash  == other.formatHash
+                && maxWidth    == other.maxWidth
+                && fontHeight  == other.fontHeight
+                && indent      == other.indent
+                && tabStop     == other.tabStop
+                && prevIndents == other.prevIndents
+                && text        == other.text;
+        }
+
+        friend uint qHash(ParagraphKey const &key)
+        {
+            return ::qHash(key.text) ^ key.formatHash ^ ::qHash(key.maxWidth)
+                 ^ ::qHash(key.indent * 31 + key.tabStop);
+        }
+    };
+
+    /**
+     * Previously wrapped lines of a paragraph. Ranges are relative to the start of
+     * the paragraph.
+     */
+    struct WrappedParagraph
+    {
+        QVector<Line> lines;
+        int indent;             ///< Indentation state after the paragraph.
+        QVector<int> prevIndents;
+        int tabStop;
+    };
+    typedef QHash<ParagraphKey, WrappedParagraph> ParagraphCache;
+
+    /// Paragraphs of the latest wrapping. When the text is edited or appended to,
+    /// only the changed paragraphs need to be wrapped again.
+    ParagraphCache paragraphCache;
+
     struct RasterizedLine {
         QVector<Image> segmentImages;
     };
@@ -315,12 +368,24 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
      */
     Lines wrapRange(Rangei const &rangeToWrap, int maxWidth, int subsequentMaxWidth = 0,
                     int initialIndent = 0)
+    {
+        indent  = initialIndent;
+        tabStop = 0;
+
+        return continueWrapping(rangeToWrap, maxWidth, subsequentMaxWidth);
+    }
+
+    /**
+     * Wraps the range onto one or more lines, starting with the current indent
+     * and tab stop.
+     *
+     * @return The produced wrapped lines. Caller gets ownership.
+     */
+    Lines continueWrapping(Rangei const &rangeToWrap, int maxWidth, int subsequentMaxWidth = 0)
     {
         int const MIN_LINE_WIDTH = roundi(150.f * DENG2_BASE_GUI_APP->pixelRatio().value());
         bool const isTabbed = (subsequentMaxWidth > 0);
 
-        indent    = initialIndent;
-        tabStop   = 0;
         int begin = rangeToWrap.start;
 
         Lines wrappedLines;
@@ -417,6 +482,110 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
         return wrappedLines;
     }
 
+    duint32 formatHash(Rangei const &range) const
+    {
+        duint32 hash = 0;
+        Font::RichFormatRef rich = format.subRange(range);
+        Font::RichFormat::Iterator iter(rich);
+        while (iter.hasNext())
+        {
+            iter.next();
+            // Colors do not affect wrapping.
+            hash = hash * 31 + duint32(iter.range().start);
+            hash = hash * 31 + duint32(iter.range().end);
+            hash = hash * 31 + duint32(100 * iter.sizeFactor());
+            hash = hash * 31 + duint32(iter.weight());
+            hash = hash * 31 + duint32(iter.style());
+            hash = hash * 31 + duint32(iter.tabStop());
+            hash = hash * 31 + (iter.markIndent()? 1 : 0) + (iter.resetIndent()? 2 : 0);
+        }
+        return hash;
+    }
+
+    /**
+     * Wraps the text one paragraph at a time. Paragraphs that were already wrapped
+     * identically during the previous call are copied from the cache. The produced
+     * lines are appended to @em lines.
+     */
+    void wrapParagraphs()
+    {
+        ParagraphCache wrapped;
+
+        indent  = 0;
+        tabStop = 0;
+
+        int const fontHeight = font->height().valuei();
+        int pos = 0;
+        while (pos < text.size())
+        {
+            checkCancel();
+
+            // The terminating newline belongs to the paragraph.
+            Rangei const para(pos, de::min(untilNextNewline(pos).end + 1, text.size()));
+
+            ParagraphKey key;
+            key.text        = rangeText(para);
+            key.formatHash  = formatHash(para);
+            key.maxWidth    = maxWidth;
+            key.fontHeight  = fontHeight;
+            key.indent      = indent;
+            key.prevIndents = prevIndents;
+            key.tabStop     = tabStop;
+
+            auto found = wrapped.constFind(key);
+            if (found == wrapped.constEnd())
+            {
+                found = paragraphCache.constFind(key);
+                if (found != paragraphCache.constEnd())
+                {
+                    found = wrapped.insert(key, found.value());
+                }
+            }
+            if (found != wrapped.constEnd())
+            {
+                WrappedParagraph const &cached = found.value();
+                foreach (Line const &cachedLine, cached.lines)
+                {
+                    Line *line = new Line(cachedLine);
+                    line->line.range = cachedLine.line.range + para.start;
+                    for (LineInfo::Segment &seg : line->info.segs)
+                    {
+                        seg.range = seg.range + para.start;
+                    }
+                    lines << line;
+                }
+                indent      = cached.indent;
+                prevIndents = cached.prevIndents;
+                tabStop     = cached.tabStop;
+            }
+            else
+            {
+                Lines const paraLines = continueWrapping(para, maxWidth);
+                lines << paraLines;
+
+                WrappedParagraph result;
+                foreach (Line const *line, paraLines)
+                {
+                    Line relative(*line);
+                    relative.line.range = line->line.range - para.start;
+                    for (LineInfo::Segment &seg : relative.info.segs)
+                    {
+                        seg.range = seg.range - para.start;
+                    }
+                    result.lines << relative;
+                }
+                result.indent      = indent;
+                result.prevIndents = prevIndents;
+                result.tabStop     = tabStop;
+                wrapped.insert(key, result);
+            }
+            pos = para.end;
+        }
+
+        // Paragraphs no longer present in the text are forgotten.
+        paragraphCache = wrapped;
+    }
+
     Rangei findNextTabbedRange(int startLine) const
     {
         for (int i = startLine + 1; i < lines.size(); ++i)
@@ -527,6 +696,7 @@ void FontLineWrapping::setFont(Font const &font)
     DENG2_GUARD(this);
 
     d->font = &font;
+    d->paragraphCache.clear();
 }
 
 Font const &FontLineWrapping::font() const
@@ -619,7 +789,7 @@ void FontLineWrapping::wrapTextToWidth(String const &text, Font::RichFormat cons
     else
     {
         // Doesn't have tabs -- just wrap it without any extra processing.
-        d->lines = d->wrapRange(Rangei(0, text.size()), maxWidth);
+        d->wrapParagraphs();
     }
 
     if (d->lines.isEmpty())
@@ -658,6 +828,13 @@ String const &FontLineWrapping::text() const
     return d->text;
 }
 
+Font::RichFormat const &FontLineWrapping::format() const
+{
+    DENG2_GUARD(this);
+
+    return d->format;
+}
+
 WrappedLine FontLineWrapping::line(int index) const
 {
     DENG2_GUARD(this);
@@ -815,6 +992,52 @@ Image FontLineWrapping::rasterizedSegment(int line, int segment) const
     return d->rasterizeSegment(lineInfo(line).segs.at(segment));
 }
 
+QVector<Image> FontLineWrapping::rasterizedSegments(QVector<LineSegment> const &segments) const
+{
+    DENG2_GUARD(this);
+
+    QVector<Image> images(segments.size());
+    QVector<int> pending;
+
+    // Use the previously rasterized images when available.
+    for (int i = 0; i < segments.size(); ++i)
+    {
+        int const line = segments.at(i).first;
+        if (line < d->rasterized.size() && !d->rasterized.at(line).segmentImages.isEmpty())
+        {
+            images[i] = d->rasterized.at(line).segmentImages.at(segments.at(i).second);
+        }
+        else
+        {
+            pending << i;
+        }
+    }
+    if (pending.isEmpty()) return images;
+
+    // The wrapping remains locked, so the workers can access the private data freely.
+    Image *output = images.data();
+    std::atomic_int next(0);
+    auto rasterize = [this, &segments, &pending, output, &next] ()
+    {
+        for (int i = next++; i < pending.size(); i = next++)
+        {
+            LineSegment const &ls = segments.at(pending.at(i));
+            output[pending.at(i)] = d->rasterizeSegment(d->lines.at(ls.first)->info.segs.at(ls.second));
+        }
+    };
+
+    TaskPool helpers;
+    int const helperCount = de::min(QThread::idealThreadCount() - 1, pending.size() - 1);
+    for (int i = 0; i < helperCount; ++i)
+    {
+        helpers.start(rasterize, TaskPool::HighPriority);
+    }
+    rasterize();
+    helpers.waitForDone();
+
+    return images;
+}
+
 //---------------------------------------------------------------------------------------
 
 int FontLineWrapping::LineInfo::highestTabStop() const
@@ -18,7 +18,9 @@
 
 #include "de/GLTextComposer"
 
+#include <QHash>
 #include <QList>
+#include <QSet>
 
 namespace de {
 
@@ -26,6 +28,173 @@ using namespace ui;
 
 static Rangei const MAX_VISIBLE_RANGE(0, 0x7fffffff);
 
+namespace internal
+{
+    /**
+     * Rasterized segments are shared by all composers that use the same atlas.
+     * Identical strings (e.g., menu labels and log entry prefixes) are rasterized
+     * and allocated only once, and released when no composer needs them.
+     *
+     * Fonts are identified by their unique ID rather than their address, which
+     * may be reused after a font is deleted. Fonts are re-initialized in place
+     * when the UI scale changes, so the point size is part of the key. Entries
+     * of deleted atlases are forgotten.
+     */
+    struct SharedSegments : public Lockable
+                          , DENG2_OBSERVES(Deletable, Deletion)
+    {
+        struct Key
+        {
+            Atlas const *atlas;
+            Id::Type fontId;
+            dfloat fontSize;
+            String text;
+            duint32 formatHash;
+            Vector4ub color;
+
+            bool operator == (Key const &other) const
+            {
+                return atlas      == other.atlas
+                    && fontId     == other.fontId
+                    && fontSize   == other.fontSize
+                    && formatHash == other.formatHash
+                    && color      == other.color
+                    && text       == other.text;
+            }
+
+            friend uint qHash(Key const &key)
+            {
+                return ::qHash(key.text) ^ key.formatHash ^ key.fontId;
+            }
+        };
+
+        struct Entry
+        {
+            Id id;
+            int refCount;
+        };
+
+        QHash<Key, Entry> entries;
+        QHash<Id, Key> keys;
+        QSet<Atlas const *> observedAtlases;
+
+        /**
+         * Looks up a previously allocated segment and adds a reference to it.
+         *
+         * @return Allocation, or Id::None if the segment must be rasterized.
+         */
+        Id acquire(Atlas &atlas, Key const &key)
+        {
+            DENG2_GUARD(this);
+
+            auto found = entries.find(key);
+            if (found == entries.end()) return Id::None;
+
+            if (!atlas.contains(found.value().id))
+            {
+                // The atlas has been cleared since.
+                keys.remove(found.value().id);
+                entries.erase(found);
+                return Id::None;
+            }
+            found.value().refCount++;
+            return found.value().id;
+        }
+
+        Id add(Atlas &atlas, Key const &key, Image const &image)
+        {
+            DENG2_GUARD(this);
+
+            Id const id = atlas.alloc(image);
+            if (!id.isNone())
+            {
+                entries.insert(key, Entry{ id, 1 });
+                keys.insert(id, key);
+
+                if (!observedAtlases.contains(&atlas))
+                {
+                    observedAtlases.insert(&atlas);
+                    atlas.audienceForDeletion += this;
+                }
+            }
+            return id;
+        }
+
+        void release(Atlas &atlas, Id const &id)
+        {
+            DENG2_GUARD(this);
+
+            auto found = keys.find(id);
+            if (found != keys.end())
+            {
+                auto entry = entries.find(found.value());
+                if (entry != entries.end() && entry.value().id == id)
+                {
+                    if (--entry.value().refCount > 0) return;
+                    entries.erase(entry);
+                }
+                keys.erase(found);
+            }
+            atlas.release(id);
+        }
+
+        void objectWasDeleted(Deletable *deleted)
+        {
+            DENG2_GUARD(this);
+
+            for (auto iter = keys.begin(); iter != keys.end(); )
+            {
+                if (static_cast<Deletable const *>(iter.value().atlas) == deleted)
+                {
+                    entries.remove(iter.value());
+                    iter = keys.erase(iter);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+            for (auto iter = observedAtlases.begin(); iter != observedAtlases.end(); )
+            {
+                if (static_cast<Deletable const *>(*iter) == deleted)
+                {
+                    iter = observedAtlases.erase(iter);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+        }
+    };
+
+    static SharedSegments &sharedSegments()
+    {
+        static SharedSegments shared;
+        return shared;
+    }
+
+    /// Hash of the formatting that affects the appearance of rasterized text.
+    static duint32 formatHash(Font::RichFormatRef const &format)
+    {
+        duint32 hash = 0;
+        Font::RichFormat::Iterator iter(format);
+        while (iter.hasNext())
+        {
+            iter.next();
+            Font::RichFormat::IStyle::Color const color = iter.color();
+            hash = hash * 31 + duint32(iter.range().start);
+            hash = hash * 31 + duint32(iter.range().end);
+            hash = hash * 31 + duint32(100 * iter.sizeFactor());
+            hash = hash * 31 + duint32(iter.weight());
+            hash = hash * 31 + duint32(iter.style());
+            hash = hash * 31 + (duint32(color.x) | (duint32(color.y) << 8) |
+                                (duint32(color.z) << 16) | (duint32(color.w) << 24));
+        }
+        return hash;
+    }
+}
+
 DENG2_PIMPL(GLTextComposer)
 {
     Font const *font = nullptr;
@@ -95,7 +264,7 @@ DENG2_PIMPL(GLTextComposer)
         {
             if (!ln.segs[i].id.isNone())
             {
-                atlas->release(ln.segs[i].id);
+                internal::sharedSegments().release(*atlas, ln.segs[i].id);
                 ln.segs[i].id = Id::None;
             }
         }
@@ -153,6 +322,23 @@ DENG2_PIMPL(GLTextComposer)
 
         bool changed = false;
 
+        // The color is white unless a style is defined.
+        Vector4ub fgColor(255, 255, 255, 255);
+        if (format.hasStyle())
+        {
+            fgColor = format.style().richStyleColor(Font::RichFormat::NormalColor);
+        }
+
+        // Segments that are not available in the shared cache are rasterized
+        // all at once after all the lines have been checked.
+        QVector<FontLineWrapping::LineSegment> toRasterize;
+        QVector<internal::SharedSegments::Key> rasterKeys;
+        QHash<internal::SharedSegments::Key, int> rasterIndices;
+        struct PendingSegment { int line; int seg; int rasterIndex; };
+        QVector<PendingSegment> pendingSegs;
+
+        auto &shared = internal::sharedSegments();
+
         const int wrapsHeight = wraps->height();
         for (int i = 0; i < wrapsHeight; ++i)
         {
@@ -190,18 +376,28 @@ DENG2_PIMPL(GLTextComposer)
                 seg.text = segmentText(k, info);
                 if (isLineVisible(i) && seg.range.size() > 0)
                 {
-                    // The color is white unless a style is defined.
-                    Vector4ub fgColor(255, 255, 255, 255);
+                    //qDebug() << "allocating" << seg.text << seg.range.asText();
 
-                    if (format.hasStyle())
+                    internal::SharedSegments::Key key;
+                    key.atlas      = atlas;
+                    key.fontId     = font->id();
+                    key.fontSize   = font->pointSize();
+                    key.text       = wraps->text().substr(seg.range);
+                    key.formatHash = internal::formatHash(wraps->format().subRange(seg.range));
+                    key.color      = fgColor;
+
+                    seg.id = shared.acquire(*atlas, key);
+                    if (seg.id.isNone())
                     {
-                        fgColor = format.style().richStyleColor(Font::RichFormat::NormalColor);
+                        auto found = rasterIndices.constFind(key);
+                        if (found == rasterIndices.constEnd())
+                        {
+                            found = rasterIndices.insert(key, toRasterize.size());
+                            toRasterize << FontLineWrapping::LineSegment(i, k);
+                            rasterKeys << key;
+                        }
+                        pendingSegs << PendingSegment{ i, k, found.value() };
                     }
-
-                    //qDebug() << "allocating" << seg.text << seg.range.asText();
-
-                    Image const segmentImage = wraps->rasterizedSegment(i, k);
-                    seg.id = atlas->alloc(segmentImage.multiplied(fgColor));
                 }
                 line.segs << seg;
             }
@@ -209,6 +405,33 @@ DENG2_PIMPL(GLTextComposer)
             DENG2_ASSERT(line.segs.size() == info.segs.size());
         }
 
+        if (!toRasterize.isEmpty())
+        {
+            QVector<Image> const images = wraps->rasterizedSegments(toRasterize);
+            QVector<Id> rasterIds;
+            for (int i = 0; i < images.size(); ++i)
+            {
+                rasterIds << shared.add(*atlas, rasterKeys.at(i), images.at(i).multiplied(fgColor));
+            }
+
+            // The first segment gets the reference added above; the others are
+            // duplicates within these lines.
+            QVector<bool> isReferenced(images.size(), false);
+            for (PendingSegment const &pending : pendingSegs)
+            {
+                Id &id = lines[pending.line].segs[pending.seg].id;
+                if (!isReferenced.at(pending.rasterIndex))
+                {
+                    id = rasterIds.at(pending.rasterIndex);
+                    isReferenced[pending.rasterIndex] = true;
+                }
+                else
+                {
+                    id = shared.acquire(*atlas, rasterKeys.at(pending.rasterIndex));
+                }
+            }
+        }
+
         // Remove the excess lines.
         while (lines.size() > wraps->height())
         {
@@ -42,6 +42,12 @@ static DotPath const ID_THIN_ROUND_CORNERS  = "GuiRootWidget.frame.thin";
 static DotPath const ID_BOLD_ROUND_CORNERS  = "GuiRootWidget.frame.bold";
 static DotPath const ID_DOT                 = "GuiRootWidget.dot";
 
+/// Number of shared atlas allocations that may be moved during one update.
+static int const ATLAS_MOVES_PER_UPDATE = 8;
+
+/// The shared atlas is compacted only when this much of its used area is free.
+static float const ATLAS_COMPACT_FRAGMENTATION = .25f;
+
 #ifdef DENG2_QT_5_0_OR_NEWER
 #  define DPI_SCALED(x)       ((x) * DENG2_BASE_GUI_APP->pixelRatio().value())
 #else
@@ -166,7 +172,7 @@ DENG2_PIMPL(GuiRootWidget)
         if (atlas.isNull() || atlas->totalSize() == Atlas::Size())
         {
             window->glActivate();
-            atlas.reset(AtlasTexture::newWithKdTreeAllocator(
+            atlas.reset(AtlasTexture::newWithSkylineAllocator(
                             Atlas::BackingStore | Atlas::AllowDefragment,
                             GLTexture::maximumSize().min(GLTexture::Size(4096, 4096))));
             uTexAtlas = *atlas;
@@ -428,6 +434,14 @@ void GuiRootWidget::update()
         // Allow GL operations.
         window().glActivate();
 
+        // Counter fragmentation of the shared atlas a little at a time. Moving
+        // allocations makes widgets update their geometry, so this is not done
+        // unless a significant amount of space is wasted.
+        if (d->atlas && d->atlas->fragmentation() > ATLAS_COMPACT_FRAGMENTATION)
+        {
+            d->atlas->compact(ATLAS_MOVES_PER_UPDATE);
+        }
+
         RootWidget::update();
         d->focusIndicator->update();
     }
@@ -106,6 +106,15 @@ public:
          */
         ClearHotStorageWhenBankDestroyed = 0x4,
 
+        /**
+         * Items loaded from source are immediately serialized into the hot
+         * storage, too, without waiting for them to be unloaded. This is useful
+         * if loading from source is much more expensive than deserializing:
+         * the serialized copy is then available for later loads, including
+         * ones in future sessions.
+         */
+        SerializeWhenLoadedFromSource = 0x8,
+
         DefaultFlags = SingleThread | DisableHotStorage
     };
     Q_DECLARE_FLAGS(Flags, Flag)
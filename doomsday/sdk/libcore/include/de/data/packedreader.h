@@ -0,0 +1,207 @@
+/** @file packedreader.h  Inlined reader for packed little-endian data.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDENG2_PACKEDREADER_H
+#define LIBDENG2_PACKEDREADER_H
+
+#include "../libcore.h"
+
+#include <cstring>
+
+namespace de {
+
+/**
+ * Reads values written with PackedWriter (or Writer1 without type checking)
+ * from a memory buffer.
+ *
+ * All methods are inlined and PackedReader never allocates memory. Reading
+ * past the end of the buffer does not raise an error. Instead, the reader
+ * enters an underflow state: it moves to the end of the buffer and returns
+ * zero for all further reads. The caller should check hasUnderflowed() after
+ * reading a complete message, so that malformed input can be rejected.
+ *
+ * @ingroup data
+ */
+class PackedReader
+{
+public:
+    /**
+     * @param data  Source buffer. Must remain valid while reading.
+     * @param size  Size of @a data in bytes.
+     */
+    PackedReader(dbyte const *data, dsize size)
+        : _data(data)
+        , _size(size)
+    {}
+
+    dbyte const *data() const { return _data; }
+
+    dsize size() const { return _size; }
+
+    /// Returns the current read position.
+    dsize pos() const { return _pos; }
+
+    dsize bytesLeft() const { return _size - _pos; }
+
+    bool atEnd() const { return _pos >= _size; }
+
+    /**
+     * Determines if an attempt was made to read past the end of the buffer.
+     */
+    bool hasUnderflowed() const { return _underflow; }
+
+    /**
+     * Moves the read position. Also clears the underflow state.
+     */
+    void setPos(dsize pos)
+    {
+        DENG2_ASSERT(pos <= _size);
+        _pos       = pos;
+        _underflow = false;
+    }
+
+    dbyte readByte()
+    {
+        return available(1)? _data[_pos++] : 0;
+    }
+
+    dchar readChar() { return dchar(readByte()); }
+
+    duint16 readUInt16()
+    {
+        if (!available(2)) return 0;
+        dbyte const *p = _data + _pos;
+        _pos += 2;
+        return duint16(p[0] | (p[1] << 8));
+    }
+
+    dint16 readInt16() { return dint16(readUInt16()); }
+
+    duint32 readUInt32()
+    {
+        if (!available(4)) return 0;
+        dbyte const *p = _data + _pos;
+        _pos += 4;
+        return duint32(p[0]) | (duint32(p[1]) << 8) | (duint32(p[2]) << 16) | (duint32(p[3]) << 24);
+    }
+
+    dint32 readInt32() { return dint32(readUInt32()); }
+
+    dfloat readFloat()
+    {
+        duint32 const bits = readUInt32();
+        dfloat v;
+        std::memcpy(&v, &bits, 4);
+        return v;
+    }
+
+    /**
+     * Reads @a len bytes to @a buffer. If there is not enough data left,
+     * @a buffer is filled with zeros.
+     */
+    void read(void *buffer, dsize len)
+    {
+        if (!len) return;
+        if (available(len))
+        {
+            std::memcpy(buffer, _data + _pos, len);
+            _pos += len;
+        }
+        else
+        {
+            std::memset(buffer, 0, len);
+        }
+    }
+
+    /**
+     * Reads a 15-bit unsigned integer written with PackedWriter::writePackedUInt16().
+     */
+    duint16 readPackedUInt16()
+    {
+        duint16 pack = readByte();
+        if (pack & 0x80)
+        {
+            pack &= ~0x80;
+            pack |= readByte() << 7;
+        }
+        return pack;
+    }
+
+    /**
+     * Reads a variable length integer written with PackedWriter::writePackedUInt32().
+     */
+    duint32 readPackedUInt32()
+    {
+        duint32 value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            if (!available(1)) return 0;
+            dbyte const pack = _data[_pos++];
+            value |= duint32(pack & 0x7f) << shift;
+            if (!(pack & 0x80)) return value;
+        }
+        // Too many bytes; this is not a valid value.
+        _underflow = true;
+        _pos       = _size;
+        return 0;
+    }
+
+    /**
+     * Reads @a count values written with PackedWriter::writePackedUInt32Array().
+     */
+    void readPackedUInt32Array(duint32 *values, dsize count)
+    {
+        for (dsize i = 0; i < count; ++i) values[i] = readPackedUInt32();
+    }
+
+    /**
+     * Reads @a count values written with PackedWriter::writeDeltaArray().
+     */
+    void readDeltaArray(dint32 *values, dsize count)
+    {
+        duint32 prev = 0;
+        for (dsize i = 0; i < count; ++i)
+        {
+            duint32 const zigzag = readPackedUInt32();
+            prev += (zigzag >> 1) ^ (0u - (zigzag & 1));
+            values[i] = dint32(prev);
+        }
+    }
+
+private:
+    inline bool available(dsize len)
+    {
+        if (len > _size - _pos)
+        {
+            _underflow = true;
+            _pos       = _size;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    dbyte const *_data;
+    dsize        _size;
+    dsize        _pos       = 0;
+    bool         _underflow = false;
+};
+
+} // namespace de
+
+#endif // LIBDENG2_PACKEDREADER_H
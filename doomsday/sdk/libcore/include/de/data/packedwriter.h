@@ -0,0 +1,257 @@
+/** @file packedwriter.h  Inlined writer for packed little-endian data.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDENG2_PACKEDWRITER_H
+#define LIBDENG2_PACKEDWRITER_H
+
+#include "../libcore.h"
+
+#include <cstring>
+
+namespace de {
+
+/**
+ * Writes values into a caller-provided memory buffer in little-endian byte
+ * order. Intended for building network messages and other packets where lots
+ * of small values are written in a tight loop.
+ *
+ * All methods are inlined. PackedWriter never allocates memory: when the
+ * buffer runs out, the writer enters an overflow state where all further
+ * writes are ignored. The caller is expected to check hasOverflowed() once
+ * after writing is complete, instead of checking each individual value.
+ *
+ * The format is compatible with Writer1 (without type checking): for example,
+ * writePackedUInt16() and writePackedUInt32() produce the same bytes as the
+ * corresponding Writer_* functions. The array methods use 7-bit variable
+ * length integers, which can be read with PackedReader.
+ *
+ * @ingroup data
+ */
+class PackedWriter
+{
+public:
+    /**
+     * @param buffer    Destination buffer.
+     * @param capacity  Size of @a buffer in bytes.
+     */
+    PackedWriter(dbyte *buffer, dsize capacity)
+        : _data(buffer)
+        , _capacity(capacity)
+    {}
+
+    dbyte const *data() const { return _data; }
+
+    /// Returns the number of bytes written so far.
+    dsize size() const { return _pos; }
+
+    dsize capacity() const { return _capacity; }
+
+    dsize bytesLeft() const { return _capacity - _pos; }
+
+    /**
+     * Determines if any of the written values did not fit in the buffer. The
+     * contents of the buffer should not be used in this case.
+     */
+    bool hasOverflowed() const { return _overflow; }
+
+    /**
+     * Moves the write position back to an earlier position, discarding the
+     * bytes written after it. Also clears the overflow state.
+     *
+     * @param pos  Position to return to (see size()).
+     */
+    void rewind(dsize pos)
+    {
+        DENG2_ASSERT(pos <= _capacity);
+        _pos      = pos;
+        _overflow = false;
+    }
+
+    PackedWriter &writeByte(dbyte v)
+    {
+        if (reserve(1)) _data[_pos++] = v;
+        return *this;
+    }
+
+    PackedWriter &writeChar(dchar v) { return writeByte(dbyte(v)); }
+
+    PackedWriter &writeUInt16(duint16 v)
+    {
+        if (reserve(2))
+        {
+            dbyte *p = _data + _pos;
+            p[0] = dbyte(v);
+            p[1] = dbyte(v >> 8);
+            _pos += 2;
+        }
+        return *this;
+    }
+
+    PackedWriter &writeInt16(dint16 v) { return writeUInt16(duint16(v)); }
+
+    PackedWriter &writeUInt32(duint32 v)
+    {
+        if (reserve(4))
+        {
+            dbyte *p = _data + _pos;
+            p[0] = dbyte(v);
+            p[1] = dbyte(v >> 8);
+            p[2] = dbyte(v >> 16);
+            p[3] = dbyte(v >> 24);
+            _pos += 4;
+        }
+        return *this;
+    }
+
+    PackedWriter &writeInt32(dint32 v) { return writeUInt32(duint32(v)); }
+
+    PackedWriter &writeFloat(dfloat v)
+    {
+        duint32 bits;
+        std::memcpy(&bits, &v, 4);
+        return writeUInt32(bits);
+    }
+
+    PackedWriter &write(void const *data, dsize len)
+    {
+        if (len && reserve(len))
+        {
+            std::memcpy(_data + _pos, data, len);
+            _pos += len;
+        }
+        return *this;
+    }
+
+    /**
+     * Writes a 15-bit unsigned integer using one or two bytes.
+     */
+    PackedWriter &writePackedUInt16(duint16 v)
+    {
+        DENG2_ASSERT(!(v & 0x8000));
+        if (v < 0x80)
+        {
+            return writeByte(dbyte(v));
+        }
+        if (reserve(2))
+        {
+            _data[_pos++] = dbyte(0x80 | (v & 0x7f));
+            _data[_pos++] = dbyte(v >> 7); // Highest bit is lost.
+        }
+        return *this;
+    }
+
+    /**
+     * Writes a 32-bit unsigned integer using 1...5 bytes. Each byte holds 7
+     * bits of the value, lowest bits first; the high bit is set if more bytes
+     * follow.
+     */
+    PackedWriter &writePackedUInt32(duint32 v)
+    {
+        if (reserve(varintSize(v)))
+        {
+            putVarint(v);
+        }
+        return *this;
+    }
+
+    /**
+     * Writes an array of unsigned integers as variable length integers (see
+     * writePackedUInt32()). The count is not included in the output.
+     */
+    PackedWriter &writePackedUInt32Array(duint32 const *values, dsize count)
+    {
+        if (bytesLeft() >= count * MAX_VARINT_SIZE)
+        {
+            // Everything fits even in the worst case.
+            for (dsize i = 0; i < count; ++i) putVarint(values[i]);
+        }
+        else
+        {
+            for (dsize i = 0; i < count; ++i) writePackedUInt32(values[i]);
+        }
+        return *this;
+    }
+
+    /**
+     * Writes an array of signed integers as differences between consecutive
+     * elements (the first element is relative to zero). The differences are
+     * zigzag encoded so that small negative differences are also small, and
+     * written as variable length integers. Slowly changing values, such as
+     * sorted identifiers or coordinates along a path, compress to about one
+     * byte per element. The count is not included in the output.
+     */
+    PackedWriter &writeDeltaArray(dint32 const *values, dsize count)
+    {
+        bool const unchecked = (bytesLeft() >= count * MAX_VARINT_SIZE);
+        duint32 prev = 0;
+        for (dsize i = 0; i < count; ++i)
+        {
+            duint32 const delta  = duint32(values[i]) - prev;
+            duint32 const zigzag = (delta << 1) ^ (0u - (delta >> 31));
+            if (unchecked) putVarint(zigzag); else writePackedUInt32(zigzag);
+            prev = duint32(values[i]);
+        }
+        return *this;
+    }
+
+    /**
+     * Returns the number of bytes needed for @a v as a variable length integer.
+     */
+    static dsize varintSize(duint32 v)
+    {
+        return v < (1u << 7)?  1 :
+               v < (1u << 14)? 2 :
+               v < (1u << 21)? 3 :
+               v < (1u << 28)? 4 : 5;
+    }
+
+    static dsize const MAX_VARINT_SIZE = 5;
+
+private:
+    inline bool reserve(dsize len)
+    {
+        if (len > _capacity - _pos)
+        {
+            // All subsequent writes will fail, too.
+            _overflow = true;
+            _pos      = _capacity;
+            return false;
+        }
+        return true;
+    }
+
+    inline void putVarint(duint32 v)
+    {
+        while (v >= 0x80)
+        {
+            _data[_pos++] = dbyte(0x80 | (v & 0x7f));
+            v >>= 7;
+        }
+        _data[_pos++] = dbyte(v);
+    }
+
+private:
+    dbyte *_data;
+    dsize  _capacity;
+    dsize  _pos      = 0;
+    bool   _overflow = false;
+};
+
+} // namespace de
+
+#endif // LIBDENG2_PACKEDWRITER_H
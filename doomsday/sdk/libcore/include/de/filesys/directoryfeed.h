@@ -93,6 +93,21 @@ public:
     Feed *newSubFeed(String const &name);
 
 public:
+    /**
+     * Loads a snapshot of native directory listings. When populating, directories
+     * whose modification time matches the snapshot are not listed again. The
+     * snapshot is updated as directories are populated.
+     *
+     * @param snapshotPath  Native path of the snapshot file. Also used by
+     *                      saveSnapshot().
+     */
+    static void loadSnapshot(NativePath const &snapshotPath);
+
+    /**
+     * Saves the directory listing snapshot, if it has changed since it was loaded.
+     */
+    static void saveSnapshot();
+
     /**
      * Changes the native working directory.
      *
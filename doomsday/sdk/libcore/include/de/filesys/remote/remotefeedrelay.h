@@ -81,9 +81,21 @@ public:
                                         String folderPath,
                                         FileMetadata metadataReceived);
 
+    /**
+     * Requests the contents of a file from a repository. The contents are received
+     * in chunks via the callback.
+     *
+     * @param repository        Repository address.
+     * @param filePath          Path of the file in the repository.
+     * @param contentsReceived  Called when a chunk has been received.
+     * @param startOffset       Offset where the contents should begin. Used for
+     *                          resuming a partial download. Repositories that do not
+     *                          support resuming send the contents from the start.
+     */
     Request<FileContents> fetchFileContents(String const &repository,
                                             String filePath,
-                                            FileContents contentsReceived);
+                                            FileContents contentsReceived,
+                                            duint64 startOffset = 0);
 
     QNetworkAccessManager &network();
 
@@ -232,6 +232,14 @@ signals:
     void error(QString errorMessage);
     void allSent();
 
+    /**
+     * Emitted when buffered outgoing data has been written to the socket.
+     *
+     * @param bytesStillBuffered  Amount of data still waiting to be sent out
+     *                            (see bytesBuffered()).
+     */
+    void bytesSent(de::dsize bytesStillBuffered);
+
 public slots:
     void socketDisconnected();
     void socketError(QAbstractSocket::SocketError socketError);
@@ -200,6 +200,7 @@ DENG2_PIMPL(App)
 
     ~Impl()
     {
+        DirectoryFeed::saveSnapshot();
         metaBank.reset();
 
         if (errorSink)
@@ -308,8 +309,11 @@ DENG2_PIMPL(App)
         // Metadata for files.
         metaBank.reset(new MetadataBank);
 
-        // Populate the file system (blocking).
+        // Populate the file system (blocking). Native directories that have not
+        // changed since the previous run do not need to be listed again.
+        DirectoryFeed::loadSnapshot(self().nativeHomePath() / "cache" / "directories.snapshot");
         fs.root().populate(Folder::PopulateFullTree);
+        DirectoryFeed::saveSnapshot();
 
         // Ensure known subfolders exist:
         // - /home/configs is used by de::Profiles.
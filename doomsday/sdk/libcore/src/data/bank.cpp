@@ -172,7 +172,16 @@ DENG2_PIMPL(Bank)
             switch (cache->format())
             {
             case Cache::Source:
-                loadFromSource();
+                if (serial)
+                {
+                    // A serialized copy was made when the item was loaded
+                    // from source previously; it is still usable.
+                    loadFromSerialized();
+                }
+                else
+                {
+                    loadFromSource();
+                }
                 break;
 
             case Cache::Serialized:
@@ -202,6 +211,33 @@ DENG2_PIMPL(Bank)
             {
                 // Put the loaded data into the memory cache.
                 setData(loaded.take());
+
+                if (bank->d->flags.testFlag(SerializeWhenLoadedFromSource))
+                {
+                    serializeToHotStorage();
+                }
+            }
+        }
+
+        /**
+         * Writes a serialized copy of the in-memory data into the hot storage
+         * while keeping the item in its current cache.
+         */
+        void serializeToHotStorage()
+        {
+            if (!bank->d->serialCache || !data->asSerializable()) return;
+
+            try
+            {
+                Time startedAt;
+                serialize(bank->d->serialCache->path());
+                LOG_XVERBOSE("Serialized \"%s\" in %.2f seconds",
+                             path(bank->d->sepChar) << startedAt.since());
+            }
+            catch (Error const &er)
+            {
+                LOG_WARNING("Failed to serialize \"%s\" to hot storage:\n")
+                        << path(bank->d->sepChar) << er.asText();
             }
         }
 
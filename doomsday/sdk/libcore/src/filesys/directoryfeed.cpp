@@ -21,16 +21,145 @@
 #include "de/Folder"
 #include "de/NativeFile"
 #include "de/FS"
+#include "de/Guard"
 #include "de/Date"
 #include "de/App"
+#include "de/Reader"
+#include "de/Writer"
 
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 
 namespace de {
 
 static String const fileStatusSuffix = ".doomsday_file_status";
 
+namespace internal {
+
+/**
+ * Snapshot of native directory listings. The entries of a directory only change
+ * when the directory's modification time changes, so a directory that has not
+ * been modified since it was last listed does not need to be listed again.
+ * The snapshot can be saved and reused in later sessions.
+ */
+struct DirectorySnapshot : public Lockable
+{
+    struct Entry
+    {
+        String name;
+        bool isFolder;
+    };
+    typedef QList<Entry> Entries;
+
+    struct Listing
+    {
+        Time modifiedAt;
+        Entries entries;
+    };
+
+    NativePath path;                 ///< Where the snapshot is saved.
+    QHash<String, Listing> listings; ///< Key is directory path and listing options.
+    bool changed = false;
+
+    bool find(String const &key, Time const &modifiedAt, Entries &entries) const
+    {
+        DENG2_GUARD(this);
+        auto found = listings.constFind(key);
+        if (found != listings.constEnd() && found.value().modifiedAt == modifiedAt)
+        {
+            entries = found.value().entries;
+            return true;
+        }
+        return false;
+    }
+
+    void update(String const &key, Time const &modifiedAt, Entries const &entries)
+    {
+        // A recently modified directory may still change within the resolution
+        // of the file system's timestamps.
+        if (modifiedAt.since() < 2.0) return;
+
+        DENG2_GUARD(this);
+        listings.insert(key, Listing { modifiedAt, entries });
+        changed = true;
+    }
+
+    void load(NativePath const &snapshotPath)
+    {
+        DENG2_GUARD(this);
+
+        path = snapshotPath;
+        listings.clear();
+        changed = false;
+
+        QFile f(path);
+        if (!f.open(QFile::ReadOnly)) return;
+        try
+        {
+            Block const data(f.readAll());
+            Reader reader(data);
+            reader.withHeader();
+            duint32 count;
+            reader >> count;
+            for (duint32 i = 0; i < count; ++i)
+            {
+                String key;
+                Listing listing;
+                duint32 entryCount;
+                reader >> key >> listing.modifiedAt >> entryCount;
+                for (duint32 k = 0; k < entryCount; ++k)
+                {
+                    Entry entry;
+                    dbyte isFolder;
+                    reader >> entry.name >> isFolder;
+                    entry.isFolder = (isFolder != 0);
+                    listing.entries << entry;
+                }
+                listings.insert(key, listing);
+            }
+        }
+        catch (Error const &er)
+        {
+            LOG_RES_WARNING("Ignoring directory snapshot %s: %s")
+                    << path.pretty() << er.asText();
+            listings.clear();
+        }
+    }
+
+    void save()
+    {
+        DENG2_GUARD(this);
+
+        if (path.isEmpty() || !changed) return;
+
+        Block data;
+        Writer writer(data);
+        writer.withHeader() << duint32(listings.size());
+        for (auto i = listings.constBegin(); i != listings.constEnd(); ++i)
+        {
+            writer << i.key() << i.value().modifiedAt
+                   << duint32(i.value().entries.size());
+            for (Entry const &entry : i.value().entries)
+            {
+                writer << entry.name << dbyte(entry.isFolder);
+            }
+        }
+
+        NativePath::createPath(path.fileNamePath());
+        QFile f(path);
+        if (f.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            f.write(data);
+            changed = false;
+        }
+    }
+};
+
+static DirectorySnapshot directorySnapshot;
+
+} // namespace internal
+
 DENG2_PIMPL_NOREF(DirectoryFeed)
 {
     NativePath nativePath;
@@ -98,18 +227,34 @@ Feed::PopulatedFiles DirectoryFeed::populate(Folder const &folder)
     {
         dirFlags |= QDir::Dirs;
     }
+
+    // Reuse the previous listing if the directory is unchanged.
+    using Snapshot = internal::DirectorySnapshot;
+    String const snapshotKey = d->nativePath.toString() + "|" + nameFilters.join(";") +
+                               (d->mode.testFlag(PopulateNativeSubfolders)? "|dirs" : "");
+    Time const dirModifiedAt = QFileInfo(d->nativePath).lastModified();
+    Snapshot::Entries entries;
+    if (!internal::directorySnapshot.find(snapshotKey, dirModifiedAt, entries))
+    {
+        foreach (QFileInfo entry, dir.entryInfoList(nameFilters, dirFlags))
+        {
+            entries << Snapshot::Entry { entry.fileName(), entry.isDir() };
+        }
+        internal::directorySnapshot.update(snapshotKey, dirModifiedAt, entries);
+    }
+
     PopulatedFiles populated;
-    foreach (QFileInfo entry, dir.entryInfoList(nameFilters, dirFlags))
+    for (Snapshot::Entry const &entry : entries)
     {
-        if (entry.isDir())
+        if (entry.isFolder)
         {
-            populateSubFolder(folder, entry.fileName());
+            populateSubFolder(folder, entry.name);
         }
         else
         {
-            if (!entry.fileName().endsWith(fileStatusSuffix)) // ignore meta files
+            if (!entry.name.endsWith(fileStatusSuffix)) // ignore meta files
             {
-                populateFile(folder, entry.fileName(), populated);
+                populateFile(folder, entry.name, populated);
             }
         }
     }
@@ -280,6 +425,16 @@ void DirectoryFeed::changeWorkingDir(NativePath const &nativePath)
     }
 }
 
+void DirectoryFeed::loadSnapshot(NativePath const &snapshotPath) // static
+{
+    internal::directorySnapshot.load(snapshotPath);
+}
+
+void DirectoryFeed::saveSnapshot() // static
+{
+    internal::directorySnapshot.save();
+}
+
 File::Status DirectoryFeed::fileStatus(NativePath const &nativePath)
 {
     QFileInfo info(nativePath);
@@ -106,6 +106,142 @@ DENG2_PIMPL(Folder)
         }
         folder.destroyAllFiles();
     }
+
+    /**
+     * Populates the folder. If @a treePool is given, subfolders of a full-tree
+     * population are populated in parallel as tasks of the pool.
+     */
+    void populate(PopulationBehaviors behavior, TaskPool *treePool)
+    {
+        fileSystem().changeBusyLevel(+1);
+
+        LOG_AS("Folder");
+        {
+            DENG2_GUARD_FOR(self(), G);
+
+            // Prune the existing files first.
+            QMutableMapIterator<String, File *> iter(contents);
+            while (iter.hasNext())
+            {
+                iter.next();
+
+                // By default we will NOT prune if there are no feeds attached to the folder.
+                // In this case the files were probably created manually, so we shouldn't
+                // touch them.
+                bool mustPrune = false;
+
+                File *file = iter.value();
+                if (file->mode() & DontPrune)
+                {
+                    // Skip this one, it should be kept as-is until manually deleted.
+                    continue;
+                }
+                Feed *originFeed = file->originFeed();
+
+                // If the file has a designated feed, ask it about pruning.
+                if (originFeed && originFeed->prune(*file))
+                {
+                    LOG_RES_XVERBOSE("Pruning \"%s\" due to origin feed %s", file->path() << originFeed->description());
+                    mustPrune = true;
+                }
+                else if (!originFeed)
+                {
+                    // There is no designated feed, ask all feeds of this folder.
+                    // If even one of the feeds thinks that the file is out of date,
+                    // it will be pruned.
+                    for (Feeds::iterator f = feeds.begin(); f != feeds.end(); ++f)
+                    {
+                        if ((*f)->prune(*file))
+                        {
+                            LOG_RES_XVERBOSE("Pruning %s due to non-origin feed %s", file->path() << (*f)->description());
+                            mustPrune = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (mustPrune)
+                {
+                    // It needs to go.
+                    file->setParent(nullptr);
+                    iter.remove();
+                    delete file;
+                }
+            }
+        }
+
+        auto populationTask = [this, behavior, treePool]() {
+            Feed::PopulatedFiles newFiles;
+
+            // Populate with new/updated ones.
+            for (int i = feeds.size() - 1; i >= 0; --i)
+            {
+                newFiles.append(feeds.at(i)->populate(self()));
+            }
+
+            // Insert and index all new files atomically.
+            {
+                DENG2_GUARD_FOR(self(), G);
+                for (File *i : newFiles)
+                {
+                    if (i)
+                    {
+                        std::unique_ptr<File> file(i);
+                        if (!contents.contains(i->name().toLower()))
+                        {
+                            add(file.release());
+                            fileSystem().index(*i);
+                        }
+                    }
+                }
+                newFiles.clear();
+            }
+
+            if (behavior & PopulateFullTree)
+            {
+                // Call populate on subfolders.
+                for (Folder *folder : subfolders())
+                {
+                    if (treePool)
+                    {
+                        treePool->start([folder, behavior, treePool] () {
+                            folder->d->populate(behavior | PopulateCalledRecursively, treePool);
+                        });
+                    }
+                    else
+                    {
+                        folder->populate(behavior | PopulateCalledRecursively);
+                    }
+                }
+            }
+
+            fileSystem().changeBusyLevel(-1);
+        };
+
+        if (internal::enableBackgroundPopulation)
+        {
+            if (behavior & PopulateAsync)
+            {
+                internal::populateTasks.start(populationTask, TaskPool::MediumPriority);
+            }
+            else
+            {
+                populationTask();
+            }
+        }
+        else
+        {
+            // Only synchronous population is enabled.
+            populationTask();
+
+            // Each population gets an individual notification since they're done synchronously.
+            // However, only notify once a full hierarchy of populations has finished.
+            if (!(behavior & PopulateCalledRecursively))
+            {
+                internal::populationNotifier.notify();
+            }
+        }
+    }
 };
 
 Folder::Folder(String const &name) : File(name), d(new Impl(this))
@@ -211,124 +347,20 @@ void Folder::clear()
 
 void Folder::populate(PopulationBehaviors behavior)
 {
-    fileSystem().changeBusyLevel(+1);
-
-    LOG_AS("Folder");
+    if (internal::enableBackgroundPopulation &&
+        behavior.testFlag(PopulateFullTree) &&
+        !(behavior & (PopulateAsync | PopulateCalledRecursively)) &&
+        App::inMainThread())
     {
-        DENG2_GUARD(this);
-
-        // Prune the existing files first.
-        QMutableMapIterator<String, File *> iter(d->contents);
-        while (iter.hasNext())
-        {
-            iter.next();
-
-            // By default we will NOT prune if there are no feeds attached to the folder.
-            // In this case the files were probably created manually, so we shouldn't
-            // touch them.
-            bool mustPrune = false;
-
-            File *file = iter.value();
-            if (file->mode() & DontPrune)
-            {
-                // Skip this one, it should be kept as-is until manually deleted.
-                continue;
-            }
-            Feed *originFeed = file->originFeed();
-
-            // If the file has a designated feed, ask it about pruning.
-            if (originFeed && originFeed->prune(*file))
-            {
-                LOG_RES_XVERBOSE("Pruning \"%s\" due to origin feed %s", file->path() << originFeed->description());
-                mustPrune = true;
-            }
-            else if (!originFeed)
-            {
-                // There is no designated feed, ask all feeds of this folder.
-                // If even one of the feeds thinks that the file is out of date,
-                // it will be pruned.
-                for (Feeds::iterator f = d->feeds.begin(); f != d->feeds.end(); ++f)
-                {
-                    if ((*f)->prune(*file))
-                    {
-                        LOG_RES_XVERBOSE("Pruning %s due to non-origin feed %s", file->path() << (*f)->description());
-                        mustPrune = true;
-                        break;
-                    }
-                }
-            }
-
-            if (mustPrune)
-            {
-                // It needs to go.
-                file->setParent(nullptr);
-                iter.remove();
-                delete file;
-            }
-        }
-    }
-
-    auto populationTask = [this, behavior]() {
-        Feed::PopulatedFiles newFiles;
-
-        // Populate with new/updated ones.
-        for (int i = d->feeds.size() - 1; i >= 0; --i)
-        {
-            newFiles.append(d->feeds.at(i)->populate(*this));
-        }
-
-        // Insert and index all new files atomically.
-        {
-            DENG2_GUARD(this);
-            for (File *i : newFiles)
-            {
-                if (i)
-                {
-                    std::unique_ptr<File> file(i);
-                    if (!d->contents.contains(i->name().toLower()))
-                    {
-                        d->add(file.release());
-                        fileSystem().index(*i);
-                    }
-                }
-            }
-            newFiles.clear();
-        }
-
-        if (behavior & PopulateFullTree)
-        {
-            // Call populate on subfolders.
-            for (Folder *folder : d->subfolders())
-            {
-                folder->populate(behavior | PopulateCalledRecursively);
-            }
-        }
-
-        fileSystem().changeBusyLevel(-1);
-    };
-
-    if (internal::enableBackgroundPopulation)
-    {
-        if (behavior & PopulateAsync)
-        {
-            internal::populateTasks.start(populationTask, TaskPool::MediumPriority);
-        }
-        else
-        {
-            populationTask();
-        }
+        // The caller is blocked until the whole tree is ready, so the subfolders
+        // can be populated in parallel.
+        TaskPool treePool;
+        d->populate(behavior, &treePool);
+        treePool.waitForDone();
     }
     else
     {
-        // Only synchronous population is enabled.
-        populationTask();
-
-        // Each population gets an individual notification since they're done synchronously.
-        // However, only notify once a full hierarchy of populations has finished.
-        if (!(behavior & PopulateCalledRecursively))
-        {
-            internal::populationNotifier.notify();
-        }
+        d->populate(behavior, nullptr);
     }
 }
 
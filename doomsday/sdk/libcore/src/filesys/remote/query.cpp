@@ -25,8 +25,9 @@ Query::Query(Request<FileMetadata> req, String path)
     : path(path), fileMetadata(req)
 {}
 
-Query::Query(Request<FileContents> req, String path)
-    : path(path), fileContents(req)
+Query::Query(Request<FileContents> req, String path, duint64 startOffset)
+    : path(path), startOffset(startOffset), fileContents(req)
+    , receivedBytes(startOffset)
 {}
 
 bool Query::isValid() const
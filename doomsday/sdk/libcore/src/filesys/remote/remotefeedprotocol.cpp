@@ -42,6 +42,11 @@ void RemoteFeedQueryPacket::setPath(String const &path)
     _path = path;
 }
 
+void RemoteFeedQueryPacket::setStartOffset(duint64 offset)
+{
+    _startOffset = offset;
+}
+
 RemoteFeedQueryPacket::Query RemoteFeedQueryPacket::query() const
 {
     return _query;
@@ -52,16 +57,28 @@ String RemoteFeedQueryPacket::path() const
     return _path;
 }
 
+duint64 RemoteFeedQueryPacket::startOffset() const
+{
+    return _startOffset;
+}
+
 void RemoteFeedQueryPacket::operator >> (Writer &to) const
 {
     IdentifiedPacket::operator >> (to);
-    to << duint8(_query) << _path;
+    to << duint8(_query) << _path << _startOffset;
 }
 
 void RemoteFeedQueryPacket::operator << (Reader &from)
 {
     IdentifiedPacket::operator << (from);
     from.readAs<duint8>(_query) >> _path;
+
+    // Older versions do not include the start offset.
+    _startOffset = 0;
+    if (!from.atEnd())
+    {
+        from >> _startOffset;
+    }
 }
 
 Packet *RemoteFeedQueryPacket::fromBlock(Block const &block)
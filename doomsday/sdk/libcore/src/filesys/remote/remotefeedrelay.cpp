@@ -176,7 +176,8 @@ RemoteFeedRelay::fetchFileList(String const &repository, String folderPath, File
 }
 
 Request<FileContents>
-RemoteFeedRelay::fetchFileContents(String const &repository, String filePath, FileContents contentsReceived)
+RemoteFeedRelay::fetchFileContents(String const &repository, String filePath,
+                                   FileContents contentsReceived, duint64 startOffset)
 {
     DENG2_ASSERT(d->repositories.contains(repository));
 
@@ -187,7 +188,7 @@ RemoteFeedRelay::fetchFileContents(String const &repository, String filePath, Fi
         // The repository sockets are handled in the main thread.
         auto *repo = d->repositories[repository];
         request.reset(new Request<FileContents>::element_type(contentsReceived));
-        repo->sendQuery(Query(request, filePath));
+        repo->sendQuery(Query(request, filePath, startOffset));
         done.post();
     });
     done.wait();
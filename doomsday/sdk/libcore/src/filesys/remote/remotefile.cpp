@@ -19,6 +19,7 @@
 #include "de/RemoteFile"
 
 #include "de/App"
+#include "de/ByteArrayFile"
 #include "de/DirectoryFeed"
 #include "de/FileSystem"
 #include "de/RecordValue"
@@ -38,8 +39,9 @@ DENG2_PIMPL(RemoteFile)
     String remotePath;
     Block remoteMetaId;
     String repositoryAddress; // If empty, use feed's repository.
-    Block buffer;
     Request<FileContents> fetching;
+    SafePtr<File> partial;           ///< Received contents (contiguous from the start).
+    QMap<duint64, Block> outOfOrder; ///< Chunks received ahead of the partial contents.
 
     Impl(Public *i) : Base(i) {}
 
@@ -59,6 +61,100 @@ DENG2_PIMPL(RemoteFile)
         return path / hex + "_" + original.fileName();
     }
 
+    /**
+     * Path of the partially downloaded contents. The cache path includes the
+     * remote meta ID (hash of the contents), so a partial file with the same name
+     * can be resumed.
+     */
+    String partialPath() const
+    {
+        return cachePath() + ".part";
+    }
+
+    /**
+     * Opens the file for partially downloaded contents, creating it if needed.
+     *
+     * @return Number of bytes already downloaded.
+     */
+    duint64 openPartial()
+    {
+        String const fn = partialPath();
+        Folder &cacheFolder = FS::get().makeFolder(fn.fileNamePath());
+        if (File *existing = cacheFolder.tryLocate<File>(fn.fileName()))
+        {
+            if (existing->size() <= self().size())
+            {
+                existing->setMode(File::Write);
+                partial.reset(existing);
+                return existing->size();
+            }
+        }
+        partial.reset(&cacheFolder.replaceFile(fn.fileName()));
+        return 0;
+    }
+
+    /**
+     * Writes a received chunk to the partial file. Chunks are always written
+     * contiguously so that the size of the partial file tells where to resume;
+     * chunks that arrive ahead of time are kept in memory until then.
+     */
+    void receiveChunk(duint64 startOffset, Block const &chunk)
+    {
+        if (!partial) throw OutputError("RemoteFile::receiveChunk", "Partial file missing");
+
+        if (startOffset < partial->size())
+        {
+            if (startOffset > 0 || chunk.isEmpty()) return; // Already have this.
+
+            // The repository is sending the entire file from the start.
+            partial->clear();
+            outOfOrder.clear();
+        }
+        if (startOffset > partial->size())
+        {
+            outOfOrder.insert(startOffset, chunk);
+            return;
+        }
+        *partial << chunk;
+        while (!outOfOrder.isEmpty() && outOfOrder.firstKey() <= partial->size())
+        {
+            duint64 const at    = outOfOrder.firstKey();
+            Block const   ahead = outOfOrder.take(at);
+            if (at + ahead.size() > partial->size())
+            {
+                *partial << Block(ahead.mid(partial->size() - at));
+            }
+        }
+    }
+
+    /**
+     * Copies the completed download from the partial file to the cache file,
+     * a piece at a time.
+     */
+    File &finishPartial()
+    {
+        DENG2_ASSERT(partial);
+
+        String const fn = cachePath();
+        Folder &cacheFolder = FS::get().makeFolder(fn.fileNamePath());
+        File &data = cacheFolder.replaceFile(fn);
+
+        auto const &source = partial->as<ByteArrayFile>();
+        dsize const pieceSize = 1024 * 1024;
+        Block piece;
+        for (dsize pos = 0; pos < source.size(); pos += piece.size())
+        {
+            piece.resize(de::min(pieceSize, source.size() - pos));
+            source.get(pos, piece.data(), piece.size());
+            data << piece;
+        }
+        data.flush();
+
+        partial.reset();
+        cacheFolder.tryDestroyFile(partialPath().fileName());
+        return data;
+    }
+
     void findCachedFile(bool requireExists = true)
     {
         if (!self().isBroken()) return;
@@ -147,7 +243,15 @@ void RemoteFile::download()
         return;
     }
 
-    LOG_NET_MSG("Requesting download of \"%s\"") << name();
+    duint64 const resumeAt = d->openPartial();
+    if (resumeAt > 0)
+    {
+        LOG_NET_MSG("Resuming download of \"%s\" at %i bytes") << name() << resumeAt;
+    }
+    else
+    {
+        LOG_NET_MSG("Requesting download of \"%s\"") << name();
+    }
 
     d->fetching = filesys::RemoteFeedRelay::get().fetchFileContents
             (d->repository(),
@@ -160,27 +264,17 @@ void RemoteFile::download()
             i->downloadProgress(*this, remainingBytes);
         }
 
-        // Keep received data in a buffer.
-        if (d->buffer.size() < remainingBytes)
-        {
-            d->buffer.resize(remainingBytes);
-        }
-
-        d->buffer.set(startOffset, chunk.data(), chunk.size());
+        // Received data is written directly to the partial file.
+        d->receiveChunk(startOffset, chunk);
 
         // When fully transferred, the file can be cached locally and interpreted.
         if (remainingBytes == 0)
         {
-            LOG_NET_MSG("\"%s\" downloaded (%i bytes)") << name() << d->buffer.size();
-
             d->fetching = nullptr;
 
-            String const fn = d->cachePath();
-            Folder &cacheFolder = FS::get().makeFolder(fn.fileNamePath());
-            File &data = cacheFolder.replaceFile(fn);
-            data << d->buffer;
-            d->buffer.clear();
-            data.flush();
+            File &data = d->finishPartial();
+
+            LOG_NET_MSG("\"%s\" downloaded (%i bytes)") << name() << data.size();
 
             // Override the last modified time.
             {
@@ -204,7 +298,8 @@ void RemoteFile::download()
             // Now this RemoteFile can become the source of an interpreted file,
             // which replaces the RemoteFile within the parent folder.
         }
-    });
+    },
+    resumeAt);
 }
 
 void RemoteFile::cancelDownload()
@@ -213,7 +308,13 @@ void RemoteFile::cancelDownload()
     {
         d->fetching->cancel();
         d->fetching = nullptr;
-        d->buffer.clear();
+        d->outOfOrder.clear();
+        if (d->partial)
+        {
+            // The partial contents are kept so the download can be resumed.
+            d->partial->flush();
+            d->partial.reset();
+        }
         setState(NotReady);
     }
 }
@@ -221,7 +322,9 @@ void RemoteFile::cancelDownload()
 void RemoteFile::deleteCache()
 {
     setState(NotReady);
+    d->partial.reset();
     FS::get().root().tryDestroyFile(d->cachePath());
+    FS::get().root().tryDestroyFile(d->partialPath());
 }
 
 IIStream const &RemoteFile::operator >> (IByteArray &bytes) const
@@ -190,6 +190,15 @@ void WebHostedLink::transmit(Query const &query)
 
     DENG2_ASSERT(query.fileContents);
 
+    if (query.startOffset)
+    {
+        // Partial downloads are not resumed; the whole file is sent from the start.
+        if (Query *pending = findQuery(query.id))
+        {
+            pending->receivedBytes = 0;
+        }
+    }
+
     String url = address();
     QNetworkRequest req(url.concatenateRelativePath(query.path));
     qDebug() << req.url().toString();
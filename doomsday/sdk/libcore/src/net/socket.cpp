@@ -759,6 +759,8 @@ void Socket::bytesWereWritten(qint64 bytes)
     d->bytesToBeWritten -= bytes;
     DENG2_ASSERT(d->bytesToBeWritten >= 0);
 
+    emit bytesSent(dsize(d->bytesToBeWritten));
+
     if (d->bytesToBeWritten == 0)
     {
         emit allSent();
@@ -137,6 +137,21 @@ public:
          */
         virtual bool optimize() = 0;
 
+        /**
+         * Attempts to move an allocation to a better place, where it leaves more
+         * contiguous free space. This is used for incremental defragmentation.
+         * The default implementation does not move anything.
+         *
+         * @param id    Allocation to move.
+         * @param rect  New rectangle of the allocation is returned here.
+         *
+         * @return @c true, if the allocation was moved.
+         */
+        virtual bool relocate(Id const &id, Rectanglei &rect) {
+            DENG2_UNUSED2(id, rect);
+            return false;
+        }
+
         virtual int  count() const = 0;
         virtual Ids  ids() const = 0;
         virtual void rect(Id const &id, Rectanglei &rect) const = 0;
@@ -233,6 +248,32 @@ public:
 
     bool contains(Id const &id) const override;
 
+    /**
+     * Defragments the atlas incrementally by moving a limited number of allocations
+     * to better places, if the allocator supports relocation. A compaction pass
+     * goes through the allocations once, starting from the bottom-most ones, and
+     * each call continues the pass where the previous one stopped. Does nothing
+     * if no allocations have been released since a pass that moved nothing.
+     * Requires BackingStore.
+     *
+     * Reposition audience is notified if anything was moved, so users of the atlas
+     * should only compact when needed (see fragmentation()).
+     *
+     * @param maxMoves  Maximum number of allocations to move.
+     *
+     * @return Number of allocations moved.
+     */
+    int compact(int maxMoves);
+
+    /**
+     * Returns the fraction of free space in the used part of the atlas, i.e., above
+     * the bottom edge of the lowest allocation. The value is cached until the
+     * allocations change.
+     *
+     * @return Fragmentation between 0 and 1.
+     */
+    float fragmentation() const;
+
     /**
      * Request committing the backing store to the physical atlas storage.
      * This does nothing if there are no changes in the atlas.
@@ -49,6 +49,13 @@ public:
     static AtlasTexture *newWithKdTreeAllocator(Atlas::Flags const &flags = DefaultFlags,
                                                 Atlas::Size const &totalSize = Atlas::Size());
 
+    /**
+     * Constructs an AtlasTexture with a SkylineAtlasAllocator, which supports
+     * incremental defragmentation with Atlas::compact().
+     */
+    static AtlasTexture *newWithSkylineAllocator(Atlas::Flags const &flags = DefaultFlags,
+                                                 Atlas::Size const &totalSize = Atlas::Size());
+
     void clear();
 
 protected:
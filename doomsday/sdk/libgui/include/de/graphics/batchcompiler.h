@@ -0,0 +1,224 @@
+/** @file batchcompiler.h  Utility for compiling primitives into indexed batches.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBGUI_BATCHCOMPILER_H
+#define LIBGUI_BATCHCOMPILER_H
+
+#include <QVector>
+#include <de/libcore.h>
+
+namespace de {
+
+/**
+ * Utility for compiling a sequence of primitives into a single indexed vertex
+ * array that can be drawn with one draw call.
+ *
+ * Each primitive belongs to a batch that has a state (e.g., matrices and bound
+ * textures). When a batch is begun with a state equal to the state of the
+ * previous batch, the two are merged and the primitives share the same batch
+ * index. Quads, triangle fans, and triangle strips are converted to indexed
+ * triangles, so all of them can be drawn with a single draw call.
+ *
+ * BatchCompiler does not access GL, so it can be used headless.
+ *
+ * @par Requirements
+ * StateType must be copyable and have an equality operator.
+ *
+ * @ingroup gl
+ */
+template <typename VertexType, typename StateType>
+class BatchCompiler
+{
+public:
+    typedef duint32             Index;
+    typedef QVector<VertexType> Vertices;
+    typedef QVector<Index>      Indices;
+    typedef QVector<StateType>  States;
+
+    enum Primitive {
+        Points,         ///< One index per vertex.
+        Triangles,
+        TriangleStrip,
+        TriangleFan,
+        Quads           ///< Each quad becomes two triangles.
+    };
+
+public:
+    BatchCompiler(int maxBatches = 16)
+        : _maxBatches(maxBatches)
+    {}
+
+    void setMaxBatches(int maxBatches)
+    {
+        DENG2_ASSERT(maxBatches > 0);
+        _maxBatches = maxBatches;
+    }
+
+    int maxBatches() const { return _maxBatches; }
+
+    /**
+     * Removes all batches, vertices, and indices. Memory allocated for the
+     * arrays is retained.
+     */
+    void clear()
+    {
+        _states.clear();
+        _vertices.clear();
+        _indices.clear();
+        _mergeCount = 0;
+        _primitiveCount = 0;
+        _primFirst = 0;
+        _primLength = 0;
+    }
+
+    bool isEmpty() const { return _states.isEmpty(); }
+
+    /**
+     * Determines if a batch using @a state can be begun without clearing the
+     * compiler first. This is always possible if the batch can be merged with
+     * the previous one.
+     */
+    bool canBegin(StateType const &state) const
+    {
+        return _states.isEmpty() || _states.last() == state || _states.size() < _maxBatches;
+    }
+
+    /**
+     * Begins a new batch. If @a state equals the state of the previous batch,
+     * the batches are merged.
+     *
+     * @param state  State of the batch.
+     *
+     * @return Index of the batch that subsequent primitives belong to.
+     */
+    int beginBatch(StateType const &state)
+    {
+        DENG2_ASSERT(canBegin(state));
+        if (!_states.isEmpty() && _states.last() == state)
+        {
+            ++_mergeCount;
+        }
+        else
+        {
+            _states.append(state);
+        }
+        return _states.size() - 1;
+    }
+
+    /**
+     * Begins a new primitive in the current batch. Vertices of the previous
+     * primitive are not connected to the new one.
+     */
+    void beginPrimitive(Primitive primitive)
+    {
+        DENG2_ASSERT(!_states.isEmpty());
+        _primitive  = primitive;
+        _primFirst  = Index(_vertices.size());
+        _primLength = 0;
+        ++_primitiveCount;
+    }
+
+    /**
+     * Adds a vertex to the current primitive. Indices are generated as soon as
+     * the vertex completes a point or triangle.
+     */
+    void add(VertexType const &vertex)
+    {
+        Index const idx = Index(_vertices.size());
+        _vertices.append(vertex);
+        ++_primLength;
+
+        switch (_primitive)
+        {
+        case Points:
+            _indices << idx;
+            break;
+
+        case Triangles:
+            if (_primLength % 3 == 0)
+            {
+                _indices << idx - 2 << idx - 1 << idx;
+            }
+            break;
+
+        case TriangleStrip:
+            if (_primLength >= 3)
+            {
+                // Every other triangle has its winding reversed.
+                if (_primLength % 2)
+                {
+                    _indices << idx - 2 << idx - 1 << idx;
+                }
+                else
+                {
+                    _indices << idx - 1 << idx - 2 << idx;
+                }
+            }
+            break;
+
+        case TriangleFan:
+            if (_primLength >= 3)
+            {
+                _indices << _primFirst << idx - 1 << idx;
+            }
+            break;
+
+        case Quads:
+            // Triangles 0-1-2 and 0-2-3.
+            if (_primLength % 4 == 0)
+            {
+                _indices << idx - 3 << idx - 2 << idx - 1
+                         << idx - 3 << idx - 1 << idx;
+            }
+            break;
+        }
+    }
+
+    int batchCount() const { return _states.size(); }
+
+    /**
+     * Returns the number of batches that were merged with the batch preceding
+     * them.
+     */
+    int mergeCount() const { return _mergeCount; }
+
+    int primitiveCount() const { return _primitiveCount; }
+
+    StateType const &batchState(int batchIndex) const { return _states.at(batchIndex); }
+
+    States const &states() const { return _states; }
+
+    Vertices const &vertices() const { return _vertices; }
+
+    Indices const &indices() const { return _indices; }
+
+private:
+    int       _maxBatches;
+    States    _states;
+    Vertices  _vertices;
+    Indices   _indices;
+    Primitive _primitive      = Triangles;
+    Index     _primFirst      = 0;
+    int       _primLength     = 0;
+    int       _mergeCount     = 0;
+    int       _primitiveCount = 0;
+};
+
+} // namespace de
+
+#endif // LIBGUI_BATCHCOMPILER_H
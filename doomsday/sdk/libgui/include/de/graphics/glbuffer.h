@@ -270,6 +270,7 @@ class LIBGUI_PUBLIC GLBuffer : public Asset
 {
 public:
     typedef duint16 Index;
+    typedef duint32 LongIndex; ///< For buffers with more vertices than Index can address.
     typedef QVector<Index> Indices;
     typedef QVector<Rangeui> DrawRanges;
 
@@ -284,6 +285,8 @@ public:
 
     void setIndices(gl::Primitive primitive, dsize count, Index const *indices, gl::Usage usage);
 
+    void setIndices(gl::Primitive primitive, dsize count, LongIndex const *indices, gl::Usage usage);
+
     void setIndices(gl::Primitive primitive, Indices const &indices, gl::Usage usage);
 
     void setData(void const *data, dsize dataSize, gl::Usage usage);
@@ -327,6 +330,8 @@ public:
 
     GLuint glName() const;
 
+    GLuint glIndexName() const;
+
     static duint drawCount();
     static void resetDrawCount();
 
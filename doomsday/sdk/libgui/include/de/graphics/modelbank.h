@@ -32,6 +32,9 @@ namespace de {
  * Loads model files using background tasks, as model files may contain large
  * amounts of geometry and preprocessing operations may be involved.
  *
+ * Each model is baked into the hot storage right after it has been imported, so
+ * later loads of an unchanged model file skip the importer entirely.
+ *
  * @todo Consider refactoring so that the Data items are derived from
  * ModelDrawable.
  */
@@ -85,6 +88,7 @@ public:
 
 protected:
     IData *loadFromSource(ISource &source);
+    IData *newData();
 
 private:
     DENG2_PRIVATE(d)
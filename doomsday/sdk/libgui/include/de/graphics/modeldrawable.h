@@ -27,6 +27,8 @@
 #include <de/AtlasTexture>
 #include <de/Vector>
 #include <de/Animation>
+#include <de/Reader>
+#include <de/Writer>
 
 #include <QBitArray>
 #include <QVariant>
@@ -81,6 +83,9 @@ public:
     /// An error occurred during the loading of the model data. @ingroup errors
     DENG2_ERROR(LoadError);
 
+    /// The operation requires a loaded model. @ingroup errors
+    DENG2_ERROR(StateError);
+
     /// There was a shader program related problem. @ingroup errors
     DENG2_ERROR(ProgramError);
 
@@ -426,6 +431,25 @@ public:
      */
     void load(File const &file);
 
+    /**
+     * Loads a model from its baked form written previously by bake(). This is
+     * much faster than load() because no importing or postprocessing is needed.
+     *
+     * @param sourcePath  Path of the original model file. Texture paths in the
+     *                    materials are relative to this.
+     * @param from        Reader positioned at the baked data.
+     */
+    void loadBaked(String const &sourcePath, Reader &from);
+
+    /**
+     * Writes the loaded model data in a compact binary form that can be later
+     * restored with loadBaked(). Only the imported model data is included;
+     * GL resources and animation state are not.
+     *
+     * @param to  Writer.
+     */
+    void bake(Writer &to) const;
+
     /**
      * Finds the id of an animation that has the name @a name. Note that
      * animation names are optional.
@@ -20,6 +20,7 @@
 #define LIBGUI_FONT_H
 
 #include <de/libcore.h>
+#include <de/Id>
 #include <de/Rule>
 #include <de/Rectangle>
 #include <de/String>
@@ -278,6 +279,12 @@ public:
 
     void initialize(const QFont &font);
 
+    /**
+     * Returns the unique identifier of the font. Unlike the address of the font
+     * object, the identifier is never reused by another font.
+     */
+    Id id() const;
+
     /**
      * Determines the size of the given line of text, i.e., how large an area
      * is covered by the glyphs. (0,0) is at the baseline, left edge of the
@@ -337,6 +344,12 @@ public:
     Rule const &descent() const;
     Rule const &lineSpacing() const;
 
+    /**
+     * Returns the point size of the font. The size changes when the font is
+     * re-initialized, for instance when the UI is scaled.
+     */
+    dfloat pointSize() const;
+
 private:
     DENG2_PRIVATE(d)
 };
@@ -39,6 +39,10 @@ DENG2_PIMPL(Atlas)
     bool needCommit;
     bool needFullCommit;
     bool mayDefrag;
+    bool mayCompact = false;
+    QList<Id::Type> compactOrder;   ///< Remaining candidates of the compaction pass.
+    bool compactAgain = false;      ///< Another pass may be useful after this one.
+    mutable float fragmentation = -1; ///< Cached; negative when out of date.
     QList<Rectanglei> changedAreas;
     Time fullReportedAt;
 
@@ -135,6 +139,62 @@ DENG2_PIMPL(Atlas)
         return float(usedPx) / float(totalPx);
     }
 
+    float freeBelowExtent() const
+    {
+        if (fragmentation >= 0) return fragmentation;
+
+        fragmentation = 0;
+        if (!allocator) return 0;
+
+        // Free space between the top of the atlas and the lowest allocation.
+        duint usedPx = 0;
+        int extent = 0;
+        foreach (Rectanglei const &alloc, allocator->allocs().values())
+        {
+            usedPx += alloc.width() * alloc.height();
+            extent = de::max(extent, alloc.bottom() + margin);
+        }
+        if (extent > 0)
+        {
+            duint const extentPx = totalSize.x * de::min(duint(extent), totalSize.y);
+            fragmentation = 1.f - de::min(1.f, float(usedPx) / float(extentPx));
+        }
+        return fragmentation;
+    }
+
+    /**
+     * Starts a new compaction pass. Allocations furthest from the top are the
+     * best candidates for moving, so they are tried first.
+     */
+    void beginCompactPass()
+    {
+        typedef std::pair<int, Id::Type> Candidate;
+        QList<Candidate> candidates;
+        IAllocator::Allocations const allocs = allocator->allocs();
+        for (auto i = allocs.constBegin(); i != allocs.constEnd(); ++i)
+        {
+            if (!deferred.contains(i.key()))
+            {
+                candidates << Candidate(-i.value().bottom(), i.key());
+            }
+        }
+        qSort(candidates);
+
+        compactOrder.clear();
+        for (Candidate const &cand : candidates)
+        {
+            compactOrder << cand.second;
+        }
+        compactAgain = false;
+    }
+
+    /// All allocations may have moved, so compaction has to start over.
+    void layoutReset()
+    {
+        compactOrder.clear();
+        fragmentation = -1;
+    }
+
     /**
      * Submits the image to the backing store, or commits it if no backing
      * store is available.
@@ -270,6 +330,7 @@ DENG2_PIMPL(Atlas)
         backing = defragged;
         markFullyChanged();
         mayDefrag = false;
+        layoutReset();
 
         DENG2_FOR_PUBLIC_AUDIENCE2(Reposition, i)
         {
@@ -352,6 +413,7 @@ void Atlas::clear()
         d->markFullyChanged();
     }
     d->mayDefrag = false;
+    d->layoutReset();
 }
 
 void Atlas::setTotalSize(Size const &totalSize)
@@ -359,6 +421,7 @@ void Atlas::setTotalSize(Size const &totalSize)
     DENG2_GUARD(this);
 
     d->totalSize = totalSize;
+    d->layoutReset();
 
     if (d->allocator)
     {
@@ -408,6 +471,7 @@ Id Atlas::alloc(Image const &image, Id const &chosenId)
     {
         // Defragmenting may again be helpful.
         d->mayDefrag = true;
+        d->fragmentation = -1;
 
         if (!d->usingDeferredMode())
         {
@@ -448,7 +512,62 @@ void Atlas::release(Id const &id)
     d->allocator->release(id);
 
     // Defragmenting may help us again.
-    d->mayDefrag = true;
+    d->mayDefrag     = true;
+    d->mayCompact    = true;
+    d->compactAgain  = true;
+    d->fragmentation = -1;
+    d->compactOrder.removeOne(id);
+}
+
+int Atlas::compact(int maxMoves)
+{
+    DENG2_GUARD(this);
+
+    if (!d->allocator || !d->hasBacking() || !d->mayCompact) return 0;
+
+    if (d->compactOrder.isEmpty())
+    {
+        d->beginCompactPass();
+    }
+
+    // The number of relocation attempts is also limited.
+    int moved = 0;
+    for (int i = 0; i < 4 * maxMoves && moved < maxMoves && !d->compactOrder.isEmpty(); ++i)
+    {
+        Id const id = d->compactOrder.takeFirst();
+        Rectanglei oldRect, newRect;
+        d->allocator->rect(id, oldRect);
+        if (d->allocator->relocate(id, newRect))
+        {
+            // Old and new places never overlap.
+            d->backing.fill(newRect.expanded(d->margin), Image::Color(0, 0, 0, 0));
+            d->backing.draw(d->backing.subImage(oldRect), newRect.topLeft);
+            d->markAsChanged(newRect);
+            ++moved;
+        }
+    }
+
+    if (d->compactOrder.isEmpty() && !moved && !d->compactAgain)
+    {
+        // Nothing to do until something is released.
+        d->mayCompact = false;
+    }
+    if (!moved) return 0;
+
+    d->compactAgain  = true;
+    d->fragmentation = -1;
+
+    DENG2_FOR_AUDIENCE2(Reposition, i)
+    {
+        i->atlasContentRepositioned(*this);
+    }
+    return moved;
+}
+
+float Atlas::fragmentation() const
+{
+    DENG2_GUARD(this);
+    return d->freeBelowExtent();
 }
 
 bool Atlas::contains(Id const &id) const
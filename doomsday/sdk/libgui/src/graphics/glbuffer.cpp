@@ -133,6 +133,7 @@ DENG2_PIMPL(GLBuffer)
     GLuint           idxName         = 0;
     dsize            count           = 0;
     dsize            idxCount        = 0;
+    GLenum           idxType         = GL_UNSIGNED_SHORT;
     DrawRanges       defaultRange; ///< All vertices.
     Primitive        prim  = Points;
     AttribSpecs      specs{nullptr, 0};
@@ -206,6 +207,38 @@ DENG2_PIMPL(GLBuffer)
         }
     }
 
+    void setIndices(Primitive primitive, dsize count, void const *indices,
+                    GLenum type, Usage usage)
+    {
+        prim     = primitive;
+        idxCount = count;
+        idxType  = type;
+
+        defaultRange.clear();
+        defaultRange.append(Rangeui(0, count));
+
+        if (indices && count)
+        {
+            allocArray();
+            allocIndices();
+
+            auto &GL = LIBGUI_GL;
+            GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idxName);
+            GL.glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(count * indexSize()),
+                            indices, glUsage(usage));
+            GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        else
+        {
+            releaseIndices();
+        }
+    }
+
+    dsize indexSize() const
+    {
+        return idxType == GL_UNSIGNED_INT? sizeof(LongIndex) : sizeof(Index);
+    }
+
     static GLenum glUsage(Usage u)
     {
         switch (u)
@@ -399,27 +432,12 @@ void GLBuffer::setVertices(Primitive primitive, dsize count, void const *data, d
 
 void GLBuffer::setIndices(Primitive primitive, dsize count, Index const *indices, Usage usage)
 {
-    d->prim     = primitive;
-    d->idxCount = count;
-
-    d->defaultRange.clear();
-    d->defaultRange.append(Rangeui(0, count));
-
-    if (indices && count)
-    {
-        d->allocArray();
-        d->allocIndices();
+    d->setIndices(primitive, count, indices, GL_UNSIGNED_SHORT, usage);
+}
 
-        auto &GL = LIBGUI_GL;
-        GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, d->idxName);
-        GL.glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(count * sizeof(Index)),
-                        indices, Impl::glUsage(usage));
-        GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    }
-    else
-    {
-        d->releaseIndices();
-    }
+void GLBuffer::setIndices(Primitive primitive, dsize count, LongIndex const *indices, Usage usage)
+{
+    d->setIndices(primitive, count, indices, GL_UNSIGNED_INT, usage);
 }
 
 void GLBuffer::setIndices(Primitive primitive, Indices const &indices, Usage usage)
@@ -490,8 +508,8 @@ void GLBuffer::draw(DrawRanges const *ranges) const
         for (Rangeui const &range : (ranges? *ranges : d->defaultRange))
         {
             GL.glDrawElements(Impl::glPrimitive(d->prim),
-                              range.size(), GL_UNSIGNED_SHORT,
-                              (void const *) dintptr(range.start * 2));
+                              range.size(), d->idxType,
+                              (void const *) dintptr(range.start * d->indexSize()));
             LIBGUI_ASSERT_GL_OK();
         }
         GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -530,7 +548,7 @@ void GLBuffer::drawWithIndices(GLBuffer const &indexBuffer) const
     GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.d->idxName);
     GL.glDrawElements(Impl::glPrimitive(indexBuffer.d->prim),
                       GLsizei(indexBuffer.d->idxCount),
-                      GL_UNSIGNED_SHORT, nullptr);
+                      indexBuffer.d->idxType, nullptr);
     LIBGUI_ASSERT_GL_OK();
     GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
@@ -581,8 +599,8 @@ void GLBuffer::drawInstanced(GLBuffer const &instanceAttribs, duint first, dint
 
         GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, d->idxName);
         DENG2_ASSERT(GLProgram::programInUse()->validate());
-        GL.glDrawElementsInstanced(Impl::glPrimitive(d->prim), count, GL_UNSIGNED_SHORT,
-                                   reinterpret_cast<void const *>(dintptr(first * 2)),
+        GL.glDrawElementsInstanced(Impl::glPrimitive(d->prim), count, d->idxType,
+                                   reinterpret_cast<void const *>(dintptr(first * d->indexSize())),
                                    GLsizei(instanceAttribs.count()));
         LIBGUI_ASSERT_GL_OK();
         GL.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -628,6 +646,11 @@ GLuint GLBuffer::glName() const
     return d->name;
 }
 
+GLuint GLBuffer::glIndexName() const
+{
+    return d->idxName;
+}
+
 duint GLBuffer::drawCount() // static
 {
     return drawCounter;
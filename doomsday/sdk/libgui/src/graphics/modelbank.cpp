@@ -19,6 +19,8 @@
 #include "de/ModelBank"
 #include <de/App>
 #include <de/Folder>
+#include <de/Reader>
+#include <de/Writer>
 
 namespace de {
 
@@ -32,19 +34,50 @@ DENG2_PIMPL(ModelBank)
         String path; ///< Path to a model file.
 
         Source(String const &sourcePath) : path(sourcePath) {}
+
+        Time modifiedAt() const
+        {
+            return App::rootFolder().locate<File>(path).status().modifiedAt;
+        }
     };
 
-    /// Loaded model instance.
-    struct Data : public IData
+    /**
+     * Loaded model instance. When serialized, the model is written in its baked
+     * form so that it can be restored from hot storage without importing the
+     * model file again.
+     */
+    struct Data : public IData, public ISerializable
     {
+        String path;
         std::unique_ptr<ModelDrawable> model;
         std::unique_ptr<IUserData> userData;
 
-        Data(ModelDrawable *model, String const &path)
-            : model(model)
+        Data(ModelDrawable *model) : model(model) {}
+
+        Data(ModelDrawable *model, String const &sourcePath)
+            : path(sourcePath)
+            , model(model)
         {
             model->load(App::rootFolder().locate<File>(path));
         }
+
+        ISerializable *asSerializable()
+        {
+            return this;
+        }
+
+        // Implements ISerializable.
+        void operator >> (Writer &to) const
+        {
+            to << path;
+            model->bake(to);
+        }
+
+        void operator << (Reader &from)
+        {
+            from >> path;
+            model->loadBaked(path, from);
+        }
     };
 
     Impl(Public *i, Constructor c)
@@ -54,7 +87,7 @@ DENG2_PIMPL(ModelBank)
 };
 
 ModelBank::ModelBank(Constructor modelConstructor)
-    : Bank("ModelBank", BackgroundThread)
+    : Bank("ModelBank", BackgroundThread | SerializeWhenLoadedFromSource, "/home/cache/models")
     , d(new Impl(this, modelConstructor))
 {}
 
@@ -90,4 +123,9 @@ Bank::IData *ModelBank::loadFromSource(ISource &source)
                               source.as<Impl::Source>().path);
 }
 
+Bank::IData *ModelBank::newData()
+{
+    return new Impl::Data(d->modelConstructor());
+}
+
 } // namespace de
@@ -23,6 +23,7 @@
 #include <de/Animation>
 #include <de/App>
 #include <de/ByteArrayFile>
+#include <de/ByteRefArray>
 #include <de/Folder>
 #include <de/GLBuffer>
 #include <de/GLProgram>
@@ -184,6 +185,335 @@ struct DefaultImageLoader : public ModelDrawable::IImageLoader
 
 static DefaultImageLoader defaultImageLoader;
 
+/**
+ * Compact binary representation of an imported scene ("baked" model). Contains
+ * the same data that Assimp produces after postprocessing, so that a previously
+ * imported model can be restored without running the importer again.
+ *
+ * Vertex and key arrays are stored as raw native-endian blocks. Baked scenes are
+ * only kept in the local hot storage, so they never move between machines.
+ */
+struct BakedScene
+{
+    static duint32 const MAGIC   = 0x424b4d44; // "DMKB"
+    static duint32 const VERSION = 1;
+
+    template <typename Type>
+    static void writeArray(Writer &to, Type const *elems, duint32 count)
+    {
+        bool const present = (elems != nullptr);
+        to << dbyte(present);
+        if (present && count)
+        {
+            to.writeBytes(ByteRefArray(elems, sizeof(Type) * count));
+        }
+    }
+
+    template <typename Type>
+    static Type *readArray(Reader &from, duint32 count)
+    {
+        dbyte present;
+        from >> present;
+        if (!present) return nullptr;
+        Type *elems = new Type[count];
+        if (count)
+        {
+            ByteRefArray ref(elems, sizeof(Type) * count);
+            from.readBytes(ref.size(), ref);
+        }
+        return elems;
+    }
+
+    static void writeString(Writer &to, aiString const &str)
+    {
+        to << String(str.C_Str());
+    }
+
+    static void readString(Reader &from, aiString &str)
+    {
+        String text;
+        from >> text;
+        str.Set(text.toStdString());
+    }
+
+    static void writeMatrix(Writer &to, aiMatrix4x4 const &mat)
+    {
+        to.writeBytes(ByteRefArray(&mat, sizeof(mat)));
+    }
+
+    static void readMatrix(Reader &from, aiMatrix4x4 &mat)
+    {
+        ByteRefArray ref(&mat, sizeof(mat));
+        from.readBytes(ref.size(), ref);
+    }
+
+    static void writeNode(Writer &to, aiNode const &node)
+    {
+        writeString(to, node.mName);
+        writeMatrix(to, node.mTransformation);
+        to << duint32(node.mNumMeshes);
+        writeArray(to, node.mMeshes, node.mNumMeshes);
+        to << duint32(node.mNumChildren);
+        for (duint i = 0; i < node.mNumChildren; ++i)
+        {
+            writeNode(to, *node.mChildren[i]);
+        }
+    }
+
+    static aiNode *readNode(Reader &from, aiNode *parent)
+    {
+        std::unique_ptr<aiNode> node(new aiNode);
+        node->mParent = parent;
+        readString(from, node->mName);
+        readMatrix(from, node->mTransformation);
+        from >> node->mNumMeshes;
+        node->mMeshes = readArray<unsigned int>(from, node->mNumMeshes);
+        duint32 childCount;
+        from >> childCount;
+        if (childCount)
+        {
+            node->mChildren = new aiNode *[childCount];
+            for (duint i = 0; i < childCount; ++i)
+            {
+                node->mChildren[i] = readNode(from, node.get());
+                node->mNumChildren = i + 1;
+            }
+        }
+        return node.release();
+    }
+
+    static void writeMesh(Writer &to, aiMesh const &mesh)
+    {
+        writeString(to, mesh.mName);
+        to << duint32(mesh.mPrimitiveTypes)
+           << duint32(mesh.mMaterialIndex)
+           << duint32(mesh.mNumVertices)
+           << duint32(mesh.mNumUVComponents[0]);
+        writeArray(to, mesh.mVertices,         mesh.mNumVertices);
+        writeArray(to, mesh.mNormals,          mesh.mNumVertices);
+        writeArray(to, mesh.mTangents,         mesh.mNumVertices);
+        writeArray(to, mesh.mBitangents,       mesh.mNumVertices);
+        writeArray(to, mesh.mColors[0],        mesh.mNumVertices);
+        writeArray(to, mesh.mTextureCoords[0], mesh.mNumVertices);
+
+        // Faces are stored as a single index array.
+        to << duint32(mesh.mNumFaces);
+        for (duint i = 0; i < mesh.mNumFaces; ++i)
+        {
+            aiFace const &face = mesh.mFaces[i];
+            to << duint32(face.mNumIndices);
+            writeArray(to, face.mIndices, face.mNumIndices);
+        }
+
+        to << duint32(mesh.mNumBones);
+        for (duint i = 0; i < mesh.mNumBones; ++i)
+        {
+            aiBone const &bone = *mesh.mBones[i];
+            writeString(to, bone.mName);
+            writeMatrix(to, bone.mOffsetMatrix);
+            to << duint32(bone.mNumWeights);
+            writeArray(to, bone.mWeights, bone.mNumWeights);
+        }
+    }
+
+    static aiMesh *readMesh(Reader &from)
+    {
+        std::unique_ptr<aiMesh> mesh(new aiMesh);
+        readString(from, mesh->mName);
+        from >> mesh->mPrimitiveTypes
+             >> mesh->mMaterialIndex
+             >> mesh->mNumVertices
+             >> mesh->mNumUVComponents[0];
+        mesh->mVertices         = readArray<aiVector3D>(from, mesh->mNumVertices);
+        mesh->mNormals          = readArray<aiVector3D>(from, mesh->mNumVertices);
+        mesh->mTangents         = readArray<aiVector3D>(from, mesh->mNumVertices);
+        mesh->mBitangents       = readArray<aiVector3D>(from, mesh->mNumVertices);
+        mesh->mColors[0]        = readArray<aiColor4D> (from, mesh->mNumVertices);
+        mesh->mTextureCoords[0] = readArray<aiVector3D>(from, mesh->mNumVertices);
+
+        from >> mesh->mNumFaces;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (duint i = 0; i < mesh->mNumFaces; ++i)
+        {
+            aiFace &face = mesh->mFaces[i];
+            from >> face.mNumIndices;
+            face.mIndices = readArray<unsigned int>(from, face.mNumIndices);
+        }
+
+        duint32 boneCount;
+        from >> boneCount;
+        if (boneCount)
+        {
+            mesh->mBones = new aiBone *[boneCount];
+            for (duint i = 0; i < boneCount; ++i)
+            {
+                aiBone *bone = mesh->mBones[i] = new aiBone;
+                mesh->mNumBones = i + 1;
+                readString(from, bone->mName);
+                readMatrix(from, bone->mOffsetMatrix);
+                from >> bone->mNumWeights;
+                bone->mWeights = readArray<aiVertexWeight>(from, bone->mNumWeights);
+            }
+        }
+        return mesh.release();
+    }
+
+    static void writeMaterial(Writer &to, aiMaterial const &material)
+    {
+        to << duint32(material.mNumProperties);
+        for (duint i = 0; i < material.mNumProperties; ++i)
+        {
+            aiMaterialProperty const &prop = *material.mProperties[i];
+            writeString(to, prop.mKey);
+            to << duint32(prop.mSemantic)
+               << duint32(prop.mIndex)
+               << duint32(prop.mType)
+               << Block(prop.mData, prop.mDataLength);
+        }
+    }
+
+    static aiMaterial *readMaterial(Reader &from)
+    {
+        std::unique_ptr<aiMaterial> material(new aiMaterial);
+        duint32 count;
+        from >> count;
+        for (duint i = 0; i < count; ++i)
+        {
+            aiString key;
+            duint32 semantic, index, type;
+            Block data;
+            readString(from, key);
+            from >> semantic >> index >> type >> data;
+            material->AddBinaryProperty(data.constData(), unsigned(data.size()),
+                                        key.C_Str(), semantic, index,
+                                        aiPropertyTypeInfo(type));
+        }
+        return material.release();
+    }
+
+    static void writeAnimation(Writer &to, aiAnimation const &anim)
+    {
+        writeString(to, anim.mName);
+        to << ddouble(anim.mDuration)
+           << ddouble(anim.mTicksPerSecond)
+           << duint32(anim.mNumChannels);
+        for (duint i = 0; i < anim.mNumChannels; ++i)
+        {
+            aiNodeAnim const &chan = *anim.mChannels[i];
+            writeString(to, chan.mNodeName);
+            to << duint32(chan.mPreState)
+               << duint32(chan.mPostState)
+               << duint32(chan.mNumPositionKeys)
+               << duint32(chan.mNumRotationKeys)
+               << duint32(chan.mNumScalingKeys);
+            writeArray(to, chan.mPositionKeys, chan.mNumPositionKeys);
+            writeArray(to, chan.mRotationKeys, chan.mNumRotationKeys);
+            writeArray(to, chan.mScalingKeys,  chan.mNumScalingKeys);
+        }
+    }
+
+    static aiAnimation *readAnimation(Reader &from)
+    {
+        std::unique_ptr<aiAnimation> anim(new aiAnimation);
+        readString(from, anim->mName);
+        duint32 channelCount;
+        from >> anim->mDuration >> anim->mTicksPerSecond >> channelCount;
+        if (channelCount)
+        {
+            anim->mChannels = new aiNodeAnim *[channelCount];
+            for (duint i = 0; i < channelCount; ++i)
+            {
+                aiNodeAnim *chan = anim->mChannels[i] = new aiNodeAnim;
+                anim->mNumChannels = i + 1;
+                readString(from, chan->mNodeName);
+                duint32 pre, post;
+                from >> pre >> post
+                     >> chan->mNumPositionKeys
+                     >> chan->mNumRotationKeys
+                     >> chan->mNumScalingKeys;
+                chan->mPreState  = aiAnimBehaviour(pre);
+                chan->mPostState = aiAnimBehaviour(post);
+                chan->mPositionKeys = readArray<aiVectorKey>(from, chan->mNumPositionKeys);
+                chan->mRotationKeys = readArray<aiQuatKey>  (from, chan->mNumRotationKeys);
+                chan->mScalingKeys  = readArray<aiVectorKey>(from, chan->mNumScalingKeys);
+            }
+        }
+        return anim.release();
+    }
+
+    static void write(Writer &to, aiScene const &scene)
+    {
+        to << duint32(MAGIC) << duint32(VERSION)
+           << duint32(scene.mFlags)
+           << duint32(scene.mNumMeshes)
+           << duint32(scene.mNumMaterials)
+           << duint32(scene.mNumAnimations);
+        for (duint i = 0; i < scene.mNumMeshes; ++i)
+        {
+            writeMesh(to, *scene.mMeshes[i]);
+        }
+        for (duint i = 0; i < scene.mNumMaterials; ++i)
+        {
+            writeMaterial(to, *scene.mMaterials[i]);
+        }
+        for (duint i = 0; i < scene.mNumAnimations; ++i)
+        {
+            writeAnimation(to, *scene.mAnimations[i]);
+        }
+        writeNode(to, *scene.mRootNode);
+    }
+
+    /**
+     * Reconstructs a scene. The counts of the scene's arrays are only incremented
+     * as elements are read, so a partially read scene can be safely deleted if
+     * the data turns out to be truncated.
+     */
+    static aiScene *read(Reader &from)
+    {
+        duint32 magic, version;
+        from >> magic >> version;
+        if (magic != MAGIC || version != VERSION)
+        {
+            throw ModelDrawable::LoadError("BakedScene::read",
+                                           "Unknown baked model format");
+        }
+
+        std::unique_ptr<aiScene> scene(new aiScene);
+        duint32 meshCount, materialCount, animCount;
+        from >> scene->mFlags >> meshCount >> materialCount >> animCount;
+
+        if (meshCount)
+        {
+            scene->mMeshes = new aiMesh *[meshCount];
+            for (duint i = 0; i < meshCount; ++i)
+            {
+                scene->mMeshes[i] = readMesh(from);
+                scene->mNumMeshes = i + 1;
+            }
+        }
+        if (materialCount)
+        {
+            scene->mMaterials = new aiMaterial *[materialCount];
+            for (duint i = 0; i < materialCount; ++i)
+            {
+                scene->mMaterials[i] = readMaterial(from);
+                scene->mNumMaterials = i + 1;
+            }
+        }
+        if (animCount)
+        {
+            scene->mAnimations = new aiAnimation *[animCount];
+            for (duint i = 0; i < animCount; ++i)
+            {
+                scene->mAnimations[i] = readAnimation(from);
+                scene->mNumAnimations = i + 1;
+            }
+        }
+        scene->mRootNode = readNode(from, nullptr);
+        return scene.release();
+    }
+};
+
 } // namespace internal
 using namespace internal;
 
@@ -298,6 +628,7 @@ DENG2_PIMPL(ModelDrawable)
     ImpIOSystem *importerIoSystem; // not owned
     Assimp::Importer importer;
     aiScene const *scene { nullptr };
+    std::unique_ptr<aiScene> bakedScene; ///< Scene restored from baked data (instead of importer).
 
     Vector3f minPoint; ///< Bounds in default pose.
     Vector3f maxPoint;
@@ -692,6 +1023,34 @@ DENG2_PIMPL(ModelDrawable)
 
         scene = glData.scene = importer.GetScene();
 
+        initScene();
+    }
+
+    void loadBaked(String const &path, Reader &from)
+    {
+        LOG_GL_MSG("Loading baked model of %s") << path;
+
+        scene = glData.scene = nullptr;
+        sourcePath = path;
+
+        bakedScene.reset(BakedScene::read(from));
+        scene = glData.scene = bakedScene.get();
+
+        initScene();
+    }
+
+    void bake(Writer &to) const
+    {
+        if (!scene)
+        {
+            throw StateError("ModelDrawable::bake", "No model has been loaded");
+        }
+        BakedScene::write(to, *scene);
+    }
+
+    /// Prepares the lookups and bounds of a newly imported or restored scene.
+    void initScene()
+    {
         initBones();
 
         globalInverse = convertMatrix(scene->mRootNode->mTransformation).inverse();
@@ -768,6 +1127,7 @@ DENG2_PIMPL(ModelDrawable)
         sourcePath.clear();
         defaultPasses.clear();
         importer.FreeScene();
+        bakedScene.reset();
         scene = glData.scene = nullptr;
     }
 
@@ -1477,6 +1837,21 @@ void ModelDrawable::load(File const &file)
     d->import(file);
 }
 
+void ModelDrawable::loadBaked(String const &sourcePath, Reader &from)
+{
+    LOG_AS("ModelDrawable");
+
+    // Get rid of all existing data.
+    clear();
+
+    d->loadBaked(sourcePath, from);
+}
+
+void ModelDrawable::bake(Writer &to) const
+{
+    d->bake(to);
+}
+
 void ModelDrawable::clear()
 {
     glDeinit();
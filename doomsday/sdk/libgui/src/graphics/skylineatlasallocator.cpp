@@ -0,0 +1,511 @@
+/** @file skylineatlasallocator.cpp  Skyline based atlas allocator.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/SkylineAtlasAllocator"
+
+#include <QList>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace de {
+
+DENG2_PIMPL(SkylineAtlasAllocator)
+{
+    /// Horizontal span of the skyline. The segments are contiguous and ordered
+    /// from left to right. @a y is the top of the free space below the skyline.
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+    typedef std::vector<Segment> Skyline;
+
+    /**
+     * Free areas below the skyline. Areas that share a full edge are merged so that
+     * released space can be reused for larger allocations.
+     */
+    struct FreeSpace
+    {
+        typedef std::multimap<int, Rectanglei> Rects; ///< Ordered by height.
+        typedef std::map<std::pair<int, int>, Rects::iterator> Corners;
+
+        Rects rects;
+        Corners topLeft;
+        Corners topRight;
+        Corners bottomLeft;
+
+        void clear()
+        {
+            rects.clear();
+            topLeft.clear();
+            topRight.clear();
+            bottomLeft.clear();
+        }
+
+        void insert(Rectanglei const &area)
+        {
+            if (area.isNull()) return;
+            auto i = rects.insert(std::make_pair(int(area.height()), area));
+            topLeft   [std::make_pair(area.left(),  area.top())]    = i;
+            topRight  [std::make_pair(area.right(), area.top())]    = i;
+            bottomLeft[std::make_pair(area.left(),  area.bottom())] = i;
+        }
+
+        void erase(Rects::iterator i)
+        {
+            Rectanglei const &area = i->second;
+            topLeft   .erase(std::make_pair(area.left(),  area.top()));
+            topRight  .erase(std::make_pair(area.right(), area.top()));
+            bottomLeft.erase(std::make_pair(area.left(),  area.bottom()));
+            rects.erase(i);
+        }
+
+        /**
+         * Removes the free areas that can be combined with @a area.
+         *
+         * @return Combined area.
+         */
+        Rectanglei merged(Rectanglei area)
+        {
+            auto merge = [this, &area] (Corners const &corners, int x, int y, bool sideBySide) -> bool
+            {
+                auto found = corners.find(std::make_pair(x, y));
+                if (found == corners.end()) return false;
+                Rectanglei const other = found->second->second;
+                if (sideBySide? other.height() != area.height()
+                              : other.width()  != area.width()) return false;
+                erase(found->second);
+                area = area | other;
+                return true;
+            };
+            while (merge(topLeft,    area.right(), area.top(),    true)  ||
+                   merge(topRight,   area.left(),  area.top(),    true)  ||
+                   merge(topLeft,    area.left(),  area.bottom(), false) ||
+                   merge(bottomLeft, area.left(),  area.top(),    false)) {}
+            return area;
+        }
+    };
+
+    struct Placement {
+        Rectanglei area;
+        int segment = -1;        ///< Index of the skyline segment, or -1 if not used.
+        FreeSpace::Rects::iterator free;
+    };
+
+    Atlas::Size size;
+    int margin = 0;
+    Allocations allocs;
+    Skyline skyline;
+    FreeSpace freeSpace;
+
+    Impl(Public *i) : Base(i) {}
+
+    void reset()
+    {
+        allocs.clear();
+        freeSpace.clear();
+        skyline.clear();
+        // Margin is included only in the bottom/right edges of allocations.
+        skyline.push_back(Segment{ margin, margin, int(size.x) - margin });
+    }
+
+    /// The area reserved for an allocation, including the margin.
+    Rectanglei areaOf(Rectanglei const &rect) const
+    {
+        return rect.adjusted(Vector2i(), Vector2i(margin, margin));
+    }
+
+    /**
+     * Finds the first free rectangle where an allocation fits. The rectangles are
+     * checked starting from the smallest sufficient height. Rectangles that are
+     * tall enough but too narrow are skipped one at a time, so in the worst case
+     * this is linear in the number of free rectangles.
+     */
+    bool findFreeRect(Vector2i const &allocSize, Placement &place)
+    {
+        for (auto i = freeSpace.rects.lower_bound(allocSize.y); i != freeSpace.rects.end(); ++i)
+        {
+            if (int(i->second.width()) >= allocSize.x)
+            {
+                place.segment = -1;
+                place.free    = i;
+                place.area    = Rectanglei(i->second.left(), i->second.top(),
+                                           allocSize.x, allocSize.y);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Determines the top edge of an allocation placed at the beginning of a
+     * skyline segment.
+     *
+     * @return Top edge, or -1 if the allocation does not fit.
+     */
+    int fitOnSkyline(int index, Vector2i const &allocSize) const
+    {
+        int const x = skyline[index].x;
+        if (x + allocSize.x > int(size.x)) return -1;
+
+        int y = 0;
+        for (int i = index; i < int(skyline.size()) && skyline[i].x < x + allocSize.x; ++i)
+        {
+            y = de::max(y, skyline[i].y);
+        }
+        if (y + allocSize.y > int(size.y)) return -1;
+        return y;
+    }
+
+    /**
+     * Finds the topmost place on the skyline where an allocation fits. Among equal
+     * positions, the leftmost one is chosen.
+     */
+    bool findOnSkyline(Vector2i const &allocSize, Placement &place) const
+    {
+        int bestBottom = -1;
+        for (int i = 0; i < int(skyline.size()); ++i)
+        {
+            int const y = fitOnSkyline(i, allocSize);
+            if (y >= 0 && (bestBottom < 0 || y + allocSize.y < bestBottom))
+            {
+                bestBottom    = y + allocSize.y;
+                place.segment = i;
+                place.area    = Rectanglei(skyline[i].x, y, allocSize.x, allocSize.y);
+            }
+        }
+        return bestBottom >= 0;
+    }
+
+    /**
+     * Finds a place for an allocation, choosing the better (lower bottom edge) of
+     * the best free rectangle and the best skyline position.
+     */
+    bool find(Vector2i const &allocSize, Placement &place)
+    {
+        Placement onFree, onSkyline;
+        bool const freeFound    = findFreeRect(allocSize, onFree);
+        bool const skylineFound = findOnSkyline(allocSize, onSkyline);
+
+        if (freeFound && (!skylineFound || onFree.area.bottom() <= onSkyline.area.bottom()))
+        {
+            place = onFree;
+            return true;
+        }
+        if (skylineFound)
+        {
+            place = onSkyline;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Replaces the skyline within a horizontal span with a single segment.
+     */
+    void setSkylineSpan(int x, int width, int y)
+    {
+        int const end = x + width;
+        Skyline updated;
+        updated.reserve(skyline.size() + 2);
+        bool inserted = false;
+        for (Segment const &seg : skyline)
+        {
+            int const segEnd = seg.x + seg.width;
+            if (segEnd <= x || seg.x >= end)
+            {
+                if (!inserted && seg.x >= end)
+                {
+                    updated.push_back(Segment{ x, y, width });
+                    inserted = true;
+                }
+                updated.push_back(seg);
+                continue;
+            }
+            // The segment overlaps the span; keep the parts outside it.
+            if (seg.x < x)
+            {
+                updated.push_back(Segment{ seg.x, seg.y, x - seg.x });
+            }
+            if (!inserted)
+            {
+                updated.push_back(Segment{ x, y, width });
+                inserted = true;
+            }
+            if (segEnd > end)
+            {
+                updated.push_back(Segment{ end, seg.y, segEnd - end });
+            }
+        }
+        if (!inserted)
+        {
+            updated.push_back(Segment{ x, y, width });
+        }
+
+        // Merge neighbors of equal height.
+        skyline.clear();
+        for (Segment const &seg : updated)
+        {
+            if (!skyline.empty() && skyline.back().y == seg.y)
+            {
+                skyline.back().width += seg.width;
+            }
+            else
+            {
+                skyline.push_back(seg);
+            }
+        }
+    }
+
+    void occupy(Placement const &place)
+    {
+        Rectanglei const &area = place.area;
+
+        if (place.segment < 0)
+        {
+            // Split the remainder of the free rectangle along the longer edge.
+            Rectanglei const free = place.free->second;
+            freeSpace.erase(place.free);
+
+            int const extraWidth  = free.width()  - area.width();
+            int const extraHeight = free.height() - area.height();
+            if (extraWidth > extraHeight)
+            {
+                freeArea(Rectanglei(area.right(), free.top(), extraWidth, free.height()));
+                freeArea(Rectanglei(free.left(), area.bottom(), area.width(), extraHeight));
+            }
+            else
+            {
+                freeArea(Rectanglei(area.right(), free.top(), extraWidth, area.height()));
+                freeArea(Rectanglei(free.left(), area.bottom(), free.width(), extraHeight));
+            }
+        }
+        else
+        {
+            // Space left under the allocation can be used later.
+            for (int i = place.segment;
+                 i < int(skyline.size()) && skyline[i].x < area.right(); ++i)
+            {
+                Segment const &seg = skyline[i];
+                if (seg.y < area.top())
+                {
+                    int const right = de::min(seg.x + seg.width, area.right());
+                    freeArea(Rectanglei(seg.x, seg.y, right - seg.x, area.top() - seg.y));
+                }
+            }
+            setSkylineSpan(area.left(), area.width(), area.bottom());
+        }
+    }
+
+    /**
+     * Returns an area back to free space. If the area is on top of the skyline, the
+     * skyline is lowered instead.
+     */
+    void freeArea(Rectanglei const &freed)
+    {
+        if (freed.isNull()) return;
+
+        Rectanglei const area = freeSpace.merged(freed);
+        bool onTop = true;
+        for (Segment const &seg : skyline)
+        {
+            if (seg.x + seg.width <= area.left() || seg.x >= area.right()) continue;
+            if (seg.y != area.bottom())
+            {
+                onTop = false;
+                break;
+            }
+        }
+        if (onTop)
+        {
+            setSkylineSpan(area.left(), area.width(), area.top());
+        }
+        else
+        {
+            freeSpace.insert(area);
+        }
+    }
+
+    Id allocate(Atlas::Size const &allocSize, Rectanglei &rect, Id const &knownId)
+    {
+        Placement found;
+        if (!find(Vector2i(int(allocSize.x) + margin, int(allocSize.y) + margin), found))
+        {
+            return Id::None;
+        }
+        occupy(found);
+
+        Id const id = (knownId.isNone()? Id() : knownId);
+
+        // Remove the margin for the actual allocated rectangle.
+        rect = found.area.adjusted(Vector2i(), Vector2i(-margin, -margin));
+        allocs.insert(id, rect);
+        return id;
+    }
+
+    void release(Id const &id)
+    {
+        Rectanglei const area = areaOf(allocs.take(id));
+        if (allocs.isEmpty())
+        {
+            reset();
+            return;
+        }
+        freeArea(area);
+    }
+
+    bool relocate(Id const &id, Rectanglei &rect)
+    {
+        Rectanglei const current = areaOf(allocs[id]);
+
+        // The current area is still reserved, so the new place cannot overlap it.
+        Placement found;
+        if (!find(Vector2i(int(current.width()), int(current.height())), found) ||
+            found.area.bottom() >= current.bottom())
+        {
+            return false;
+        }
+        occupy(found);
+        freeArea(current);
+
+        rect = found.area.adjusted(Vector2i(), Vector2i(-margin, -margin));
+        allocs[id] = rect;
+        return true;
+    }
+
+    struct ContentSize {
+        Id::Type id;
+        duint height;
+        duint width;
+
+        ContentSize(Id const &allocId, Vector2ui const &size)
+            : id(allocId), height(size.y), width(size.x) {}
+
+        // Sort descending by height, then by width.
+        bool operator < (ContentSize const &other) const {
+            if (height == other.height) return width > other.width;
+            return height > other.height;
+        }
+    };
+
+    bool optimize()
+    {
+        QList<ContentSize> descending;
+        DENG2_FOR_EACH(Allocations, i, allocs)
+        {
+            descending.append(ContentSize(i.key(), i.value().size()));
+        }
+        qSort(descending);
+
+        Allocations const oldAllocs  = allocs;
+        Skyline const     oldSkyline = skyline;
+        FreeSpace         oldFreeSpace;
+        std::swap(oldFreeSpace, freeSpace); // iterators remain valid
+
+        /*
+         * Attempt to optimize space usage by placing the tallest allocations
+         * first.
+         */
+        reset();
+        for (ContentSize const &iter : descending)
+        {
+            Rectanglei newRect;
+            if (allocate(oldAllocs[iter.id].size(), newRect, iter.id).isNone())
+            {
+                // Could not find a place for this any more; keep the old layout.
+                allocs  = oldAllocs;
+                skyline = oldSkyline;
+                std::swap(oldFreeSpace, freeSpace);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+SkylineAtlasAllocator::SkylineAtlasAllocator() : d(new Impl(this))
+{}
+
+void SkylineAtlasAllocator::setMetrics(Atlas::Size const &totalSize, int margin)
+{
+    DENG2_ASSERT(d->allocs.isEmpty());
+
+    d->size   = totalSize;
+    d->margin = margin;
+
+    d->reset();
+}
+
+void SkylineAtlasAllocator::clear()
+{
+    d->reset();
+}
+
+Id SkylineAtlasAllocator::allocate(Atlas::Size const &size, Rectanglei &rect,
+                                   Id const &knownId)
+{
+    return d->allocate(size, rect, knownId);
+}
+
+void SkylineAtlasAllocator::release(Id const &id)
+{
+    DENG2_ASSERT(d->allocs.contains(id));
+
+    d->release(id);
+}
+
+bool SkylineAtlasAllocator::optimize()
+{
+    return d->optimize();
+}
+
+bool SkylineAtlasAllocator::relocate(Id const &id, Rectanglei &rect)
+{
+    DENG2_ASSERT(d->allocs.contains(id));
+
+    return d->relocate(id, rect);
+}
+
+int SkylineAtlasAllocator::count() const
+{
+    return d->allocs.size();
+}
+
+Atlas::Ids SkylineAtlasAllocator::ids() const
+{
+    Atlas::Ids ids;
+    foreach (Id const &id, d->allocs.keys())
+    {
+        ids.insert(id);
+    }
+    return ids;
+}
+
+void SkylineAtlasAllocator::rect(Id const &id, Rectanglei &rect) const
+{
+    DENG2_ASSERT(d->allocs.contains(id));
+    rect = d->allocs[id];
+}
+
+SkylineAtlasAllocator::Allocations SkylineAtlasAllocator::allocs() const
+{
+    return d->allocs;
+}
+
+} // namespace de
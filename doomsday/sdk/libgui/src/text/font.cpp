@@ -78,6 +78,7 @@ namespace internal
     {
         PlatformFont font;
         QHash<internal::FontParams, PlatformFont *> fontMods;
+        QHash<QPair<PlatformFont const *, ushort>, int> glyphAdvances;
 
         ~ThreadFonts() {
             qDeleteAll(fontMods);
@@ -95,6 +96,7 @@ static QThreadStorage<QHash<Font *, internal::ThreadFonts>> fontsForThread;
 
 DENG2_PIMPL(Font)
 {
+    Id id;
     QFont referenceFont;
     internal::ThreadFonts *threadFonts = nullptr;
 
@@ -159,6 +161,7 @@ DENG2_PIMPL(Font)
             // Size has changed, re-initialize the font.
             qDeleteAll(tf.fontMods);
             tf.fontMods.clear();
+            tf.glyphAdvances.clear();
         }
         hash[thisPublic].font = PlatformFont(referenceFont);
         return hash[thisPublic];
@@ -266,6 +269,24 @@ DENG2_PIMPL(Font)
         // No alterations applied.
         return plat.font;
     }
+
+    /**
+     * Returns the advance width of a single character. Line wrapping measures text
+     * one character at a time, so the widths are cached for each platform font.
+     */
+    int glyphAdvance(PlatformFont const &font, QChar ch)
+    {
+        auto &advances = getThreadFonts().glyphAdvances;
+        auto const key = qMakePair(&font, ch.unicode());
+        auto found = advances.constFind(key);
+        if (found != advances.constEnd())
+        {
+            return found.value();
+        }
+        int const width = font.width(String(1, ch));
+        advances.insert(key, width);
+        return width;
+    }
 };
 
 Font::Font() : d(new Impl(this))
@@ -283,6 +304,11 @@ void Font::initialize(const QFont &font)
     d->updateMetrics();
 }
 
+Id Font::id() const
+{
+    return d->id;
+}
+
 Rectanglei Font::measure(String const &textLine) const
 {
     return measure(textLine, RichFormat::fromPlainText(textLine));
@@ -328,7 +354,15 @@ int Font::advanceWidth(String const &textLine, RichFormatRef const &format) cons
         iter.next();
         if (iter.range().isEmpty()) continue;
 
-        advance += d->alteredFont(iter).width(textLine.substr(iter.range()));
+        PlatformFont const &altFont = d->alteredFont(iter);
+        if (iter.range().size() == 1)
+        {
+            advance += d->glyphAdvance(altFont, textLine.at(iter.range().start));
+        }
+        else
+        {
+            advance += altFont.width(textLine.substr(iter.range()));
+        }
     }
     return advance;
 }
@@ -450,4 +484,9 @@ Rule const &Font::lineSpacing() const
     return *d->lineSpacingRule;
 }
 
+dfloat Font::pointSize() const
+{
+    return dfloat(d->referenceFont.pointSizeF());
+}
+
 } // namespace de
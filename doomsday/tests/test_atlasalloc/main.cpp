@@ -0,0 +1,174 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/KdTreeAtlasAllocator>
+#include <de/RowAtlasAllocator>
+#include <de/SkylineAtlasAllocator>
+#include <de/Time>
+
+#include <QDebug>
+#include <memory>
+
+using namespace de;
+
+static Atlas::Size const ATLAS_SIZE(2048, 2048);
+
+/// Deterministic sizes resembling glyphs, text lines, and UI graphics.
+struct SizeGenerator
+{
+    duint32 seed = 1;
+
+    duint32 next()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7fff;
+    }
+
+    Atlas::Size operator () ()
+    {
+        duint32 const kind = next() % 10;
+        if (kind < 6) return Atlas::Size(6 + next() % 24, 12 + next() % 20);   // glyph
+        if (kind < 9) return Atlas::Size(40 + next() % 300, 16 + next() % 10); // text line
+        return Atlas::Size(16 + next() % 112, 16 + next() % 112);              // image
+    }
+};
+
+static float usage(Atlas::IAllocator const &alloc)
+{
+    duint64 used = 0;
+    foreach (Rectanglei const &rect, alloc.allocs().values())
+    {
+        used += rect.area();
+    }
+    return float(used) / float(ATLAS_SIZE.x * ATLAS_SIZE.y);
+}
+
+static bool checkOverlaps(Atlas::IAllocator const &alloc)
+{
+    QList<Rectanglei> const rects = alloc.allocs().values();
+    for (int i = 0; i < rects.size(); ++i)
+    {
+        if (rects[i].left() < 0 || rects[i].top() < 0 ||
+            rects[i].right() > int(ATLAS_SIZE.x) || rects[i].bottom() > int(ATLAS_SIZE.y))
+        {
+            return false;
+        }
+        for (int k = i + 1; k < rects.size(); ++k)
+        {
+            if (rects[i].overlaps(rects[k])) return false;
+        }
+    }
+    return true;
+}
+
+static bool benchmark(char const *name, Atlas::IAllocator &alloc)
+{
+    alloc.setMetrics(ATLAS_SIZE, 1);
+
+    SizeGenerator gen;
+    QList<Id> ids;
+    Rectanglei rect;
+
+    // Fill until the first failure.
+    Time startedAt;
+    for (;;)
+    {
+        Id const id = alloc.allocate(gen(), rect, Id::None);
+        if (id.isNone()) break;
+        ids << id;
+    }
+    TimeSpan const fillTime = startedAt.since();
+    int const fillCount = ids.size();
+    float const fillUsage = usage(alloc);
+
+    // Churn: release a third of the allocations and refill, many times over.
+    int allocated = 0;
+    startedAt = Time();
+    for (int round = 0; round < 20; ++round)
+    {
+        int const target = ids.size();
+        for (int i = target / 3; i > 0; --i)
+        {
+            alloc.release(ids.takeAt(int(gen.next() % duint32(ids.size()))));
+        }
+        for (int failures = 0; ids.size() < target && failures < 20; )
+        {
+            Id const id = alloc.allocate(gen(), rect, Id::None);
+            if (id.isNone())
+            {
+                ++failures;
+                continue;
+            }
+            ids << id;
+            ++allocated;
+        }
+    }
+    TimeSpan const churnTime = startedAt.since();
+    float const churnUsage = usage(alloc);
+
+    // Incremental compaction, in frame-sized steps.
+    int moved = 0;
+    startedAt = Time();
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        int movedThisFrame = 0;
+        foreach (Id const &id, ids)
+        {
+            if (movedThisFrame == 8) break;
+            if (alloc.relocate(id, rect)) ++movedThisFrame;
+        }
+        if (!movedThisFrame) break;
+        moved += movedThisFrame;
+    }
+    TimeSpan const compactTime = startedAt.since();
+    int extra = 0;
+    while (!alloc.allocate(gen(), rect, Id::None).isNone()) ++extra;
+
+    qDebug("%-8s fill: %5i allocs %5.1f%% used %7.2f ms | churn: %6i allocs %5.1f%% used "
+           "%8.2f ms (%.0f allocs/s) | compact: %4i moved %6.2f ms, %i more fit, %5.1f%% used",
+           name, fillCount, fillUsage * 100, fillTime * 1000,
+           allocated, churnUsage * 100, churnTime * 1000, allocated / de::max(1e-6, double(churnTime)),
+           moved, compactTime * 1000, extra, usage(alloc) * 100);
+
+    if (!checkOverlaps(alloc))
+    {
+        qWarning() << name << "produced overlapping or out-of-bounds allocations";
+        return false;
+    }
+    return true;
+}
+
+int main(int, char **)
+{
+    bool ok = true;
+    try
+    {
+        ok &= benchmark("Row",     *std::unique_ptr<Atlas::IAllocator>(new RowAtlasAllocator));
+        ok &= benchmark("KdTree",  *std::unique_ptr<Atlas::IAllocator>(new KdTreeAtlasAllocator));
+        ok &= benchmark("Skyline", *std::unique_ptr<Atlas::IAllocator>(new SkylineAtlasAllocator));
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+        return 1;
+    }
+
+    qDebug() << "Exiting main()...";
+    return ok? 0 : 1;
+}
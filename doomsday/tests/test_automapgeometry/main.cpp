@@ -0,0 +1,170 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hud/automapgeometry.h"
+#include "hud/automapstyle.h"
+
+#include <de/Error>
+#include <QDebug>
+
+using namespace de;
+
+static int s_failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { qWarning() << "Check failed:" << #cond << "at line" << __LINE__; ++s_failures; }
+
+static bool hasVertex(AutomapGeometry::Vertices const &verts, int index, float x, float y)
+{
+    if (index >= verts.size()) return false;
+    dgl_ft2vertex_t const &v = verts.at(index);
+    return fequal(v.pos[0], x) && fequal(v.pos[1], y) &&
+           fequal(v.tex[0], x) && fequal(v.tex[1], y);
+}
+
+static int totalVertexCount(AutomapGeometry const &geom)
+{
+    int count = 0;
+    for (int i = 0; i < NUM_MAP_OBJECTLISTS; ++i)
+    {
+        count += geom.vertices(i).size();
+    }
+    return count;
+}
+
+static void testEmpty()
+{
+    AutomapGeometry geom;
+    CHECK(geom.lineCount() == 0);
+    CHECK(totalVertexCount(geom) == 0);
+
+    geom.resize(3);
+    CHECK(geom.lineCount() == 3);
+    for (int i = 0; i < 3; ++i) CHECK(geom.lineType(i) == -1);
+    CHECK(totalVertexCount(geom) == 0);
+}
+
+static void testLineTypes()
+{
+    AutomapGeometry geom;
+    geom.resize(3);
+
+    geom.setLine(0, MOL_LINEDEF, Vector2d(0, 0), Vector2d(10, 0));
+    geom.setLine(1, MOL_LINEDEF_FLOOR, Vector2d(10, 0), Vector2d(10, 20));
+    CHECK(geom.lineType(0) == MOL_LINEDEF);
+    CHECK(geom.lineType(1) == MOL_LINEDEF_FLOOR);
+    CHECK(geom.lineType(2) == -1);
+
+    CHECK(geom.vertices(MOL_LINEDEF).size() == 2);
+    CHECK(hasVertex(geom.vertices(MOL_LINEDEF), 0, 0, 0));
+    CHECK(hasVertex(geom.vertices(MOL_LINEDEF), 1, 10, 0));
+    CHECK(geom.vertices(MOL_LINEDEF_FLOOR).size() == 2);
+    CHECK(hasVertex(geom.vertices(MOL_LINEDEF_FLOOR), 0, 10, 0));
+    CHECK(hasVertex(geom.vertices(MOL_LINEDEF_FLOOR), 1, 10, 20));
+    CHECK(geom.vertices(MOL_LINEDEF_CEILING).isEmpty());
+
+    // Reclassifying a line moves it to another list, e.g., when a lift has
+    // risen to the height of its neighbor.
+    geom.setLine(1, MOL_LINEDEF_TWOSIDED, Vector2d(10, 0), Vector2d(10, 20));
+    CHECK(geom.vertices(MOL_LINEDEF_FLOOR).isEmpty());
+    CHECK(geom.vertices(MOL_LINEDEF_TWOSIDED).size() == 2);
+    CHECK(geom.vertices(MOL_LINEDEF).size() == 2);
+
+    // Lines that are no longer drawn are removed.
+    geom.setLine(0, -1, Vector2d(0, 0), Vector2d(10, 0));
+    CHECK(geom.lineType(0) == -1);
+    CHECK(geom.vertices(MOL_LINEDEF).isEmpty());
+    CHECK(totalVertexCount(geom) == 2);
+
+    // Zero-length lines are never drawn.
+    geom.setLine(2, MOL_LINEDEF, Vector2d(5, 5), Vector2d(5, 5));
+    CHECK(geom.lineType(2) == -1);
+    CHECK(geom.vertices(MOL_LINEDEF).isEmpty());
+}
+
+static void testNormals()
+{
+    AutomapGeometry geom;
+    geom.resize(1);
+
+    geom.setLine(0, MOL_LINEDEF, Vector2d(0, 0), Vector2d(10, 0), true /*normal*/);
+    auto const &verts = geom.vertices(MOL_LINEDEF);
+    CHECK(verts.size() == 4);
+    CHECK(hasVertex(verts, 0, 0, 0));
+    CHECK(hasVertex(verts, 1, 10, 0));
+    // The tail starts from the middle and points to the right of the line.
+    CHECK(hasVertex(verts, 2, 5, 0));
+    CHECK(hasVertex(verts, 3, 5, -8));
+
+    geom.setLine(0, MOL_LINEDEF, Vector2d(0, 0), Vector2d(10, 0), false);
+    CHECK(geom.vertices(MOL_LINEDEF).size() == 2);
+}
+
+static void testRetained()
+{
+    AutomapGeometry geom;
+    geom.resize(100);
+    for (int i = 0; i < 100; ++i)
+    {
+        geom.setLine(i, i % 2? MOL_LINEDEF : MOL_LINEDEF_CEILING,
+                     Vector2d(i, 0), Vector2d(i, 10));
+    }
+    CHECK(geom.vertices(MOL_LINEDEF).size() == 100);
+    CHECK(geom.vertices(MOL_LINEDEF_CEILING).size() == 100);
+
+    // Setting a line to its current state does not cause a rebuild: the
+    // buffer is shared with the earlier copy.
+    AutomapGeometry::Vertices const before = geom.vertices(MOL_LINEDEF);
+    geom.setLine(1, MOL_LINEDEF, Vector2d(1, 0), Vector2d(1, 10));
+    CHECK(geom.vertices(MOL_LINEDEF).constData() == before.constData());
+
+    // Changing one line rebuilds only the lists it belongs to.
+    AutomapGeometry::Vertices const ceilingBefore = geom.vertices(MOL_LINEDEF_CEILING);
+    geom.setLine(3, MOL_LINEDEF, Vector2d(3, 0), Vector2d(3, 50));
+    CHECK(geom.vertices(MOL_LINEDEF).constData() != before.constData());
+    CHECK(geom.vertices(MOL_LINEDEF_CEILING).constData() == ceilingBefore.constData());
+    CHECK(hasVertex(geom.vertices(MOL_LINEDEF), 3, 3, 50));
+
+    // Resizing resets everything.
+    geom.resize(10);
+    CHECK(geom.lineCount() == 10);
+    CHECK(totalVertexCount(geom) == 0);
+
+    geom.clear();
+    CHECK(geom.lineCount() == 0);
+}
+
+int main(int, char **)
+{
+    try
+    {
+        testEmpty();
+        testLineTypes();
+        testNormals();
+        testRetained();
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+        return 1;
+    }
+
+    qDebug() << "Exiting main()...";
+    return s_failures? 1 : 0;
+}
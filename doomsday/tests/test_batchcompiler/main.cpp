@@ -0,0 +1,192 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/BatchCompiler>
+
+#include <QDebug>
+
+using namespace de;
+
+struct Vertex
+{
+    int id;
+};
+
+/// Stand-in for DGL batch state: a bound texture and a matrix.
+struct State
+{
+    int texture;
+    int matrix;
+
+    bool operator == (State const &other) const
+    {
+        return texture == other.texture && matrix == other.matrix;
+    }
+};
+
+typedef BatchCompiler<Vertex, State> Compiler;
+
+static int s_failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { qWarning() << "Check failed:" << #cond << "at line" << __LINE__; ++s_failures; }
+
+static void addPrimitive(Compiler &comp, Compiler::Primitive prim, int vertexCount)
+{
+    comp.beginPrimitive(prim);
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        comp.add(Vertex{ comp.vertices().size() });
+    }
+}
+
+static bool indicesEqual(Compiler const &comp, QVector<Compiler::Index> const &expected)
+{
+    if (comp.indices() != expected)
+    {
+        QStringList list;
+        for (auto i : comp.indices()) list << QString::number(i);
+        qWarning() << "Unexpected indices:" << list.join(" ");
+        return false;
+    }
+    return true;
+}
+
+static void testTopology()
+{
+    Compiler comp;
+    comp.beginBatch(State{ 1, 0 });
+
+    addPrimitive(comp, Compiler::Quads, 8);
+    CHECK(indicesEqual(comp, { 0, 1, 2, 0, 2, 3,
+                               4, 5, 6, 4, 6, 7 }));
+
+    comp.clear();
+    comp.beginBatch(State{ 1, 0 });
+    addPrimitive(comp, Compiler::TriangleFan, 5);
+    CHECK(indicesEqual(comp, { 0, 1, 2, 0, 2, 3, 0, 3, 4 }));
+
+    comp.clear();
+    comp.beginBatch(State{ 1, 0 });
+    addPrimitive(comp, Compiler::TriangleStrip, 5);
+    CHECK(indicesEqual(comp, { 0, 1, 2, 2, 1, 3, 2, 3, 4 }));
+
+    // Separate strips are not connected to each other.
+    comp.clear();
+    comp.beginBatch(State{ 1, 0 });
+    addPrimitive(comp, Compiler::TriangleStrip, 4);
+    addPrimitive(comp, Compiler::TriangleStrip, 4);
+    CHECK(indicesEqual(comp, { 0, 1, 2, 2, 1, 3,
+                               4, 5, 6, 6, 5, 7 }));
+
+    // Incomplete triangles produce no indices.
+    comp.clear();
+    comp.beginBatch(State{ 1, 0 });
+    addPrimitive(comp, Compiler::Triangles, 5);
+    CHECK(indicesEqual(comp, { 0, 1, 2 }));
+    CHECK(comp.vertices().size() == 5);
+}
+
+static void testMerging()
+{
+    Compiler comp(4);
+
+    // Identical consecutive states share a batch.
+    CHECK(comp.beginBatch(State{ 1, 0 }) == 0);
+    addPrimitive(comp, Compiler::Quads, 4);
+    CHECK(comp.beginBatch(State{ 1, 0 }) == 0);
+    addPrimitive(comp, Compiler::Quads, 4);
+    CHECK(comp.beginBatch(State{ 2, 0 }) == 1);
+    addPrimitive(comp, Compiler::TriangleFan, 4);
+    CHECK(comp.beginBatch(State{ 2, 1 }) == 2);
+    addPrimitive(comp, Compiler::Triangles, 3);
+
+    // Non-consecutive equal states are not merged.
+    CHECK(comp.beginBatch(State{ 1, 0 }) == 3);
+    addPrimitive(comp, Compiler::Quads, 4);
+
+    CHECK(comp.batchCount() == 4);
+    CHECK(comp.mergeCount() == 1);
+    CHECK(comp.primitiveCount() == 5);
+    CHECK(comp.vertices().size() == 19);
+    CHECK(comp.indices().size() == 6 + 6 + 6 + 3 + 6);
+    CHECK(comp.batchState(1).texture == 2);
+
+    // The compiler is full, but merging is still possible.
+    CHECK(!comp.canBegin(State{ 5, 0 }));
+    CHECK(comp.canBegin(State{ 1, 0 }));
+    CHECK(comp.beginBatch(State{ 1, 0 }) == 3);
+    addPrimitive(comp, Compiler::Quads, 4);
+    CHECK(comp.batchCount() == 4);
+    CHECK(comp.mergeCount() == 2);
+
+    comp.clear();
+    CHECK(comp.isEmpty());
+    CHECK(comp.canBegin(State{ 5, 0 }));
+    CHECK(comp.mergeCount() == 0);
+}
+
+static void testHudLikeSequence()
+{
+    // Many small quads drawn with a few alternating textures, as in HUD and
+    // menu drawing. Runs of identical state collapse into single batches.
+    Compiler comp(16);
+    int const texturePattern[] = { 1, 1, 1, 2, 2, 1, 1, 3, 3, 3, 3, 3 };
+    int drawCalls = 0;
+    int sections  = 0;
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        for (int tex : texturePattern)
+        {
+            State const state{ tex, 0 };
+            if (!comp.canBegin(state))
+            {
+                ++drawCalls;
+                comp.clear();
+            }
+            comp.beginBatch(state);
+            addPrimitive(comp, Compiler::Quads, 4);
+            ++sections;
+        }
+    }
+    if (!comp.isEmpty()) ++drawCalls;
+
+    // Without merging, 120 sections would need 8 draws of 16 batches each.
+    // Four runs per pattern repetition fit four repetitions per draw.
+    qDebug() << "Sections:" << sections << "draw calls:" << drawCalls;
+    CHECK(drawCalls == 3);
+}
+
+int main(int, char **)
+{
+    try
+    {
+        testTopology();
+        testMerging();
+        testHudLikeSequence();
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+        return 1;
+    }
+
+    qDebug() << "Exiting main()...";
+    return s_failures? 1 : 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/TextApp>
+#include <de/Time>
+#include <doomsday/filesys/lumpindex.h>
+
+#include <QDebug>
+
+using namespace de;
+
+/**
+ * Lump of a simulated WAD. Each WAD has its own lump directory.
+ */
+class TestLump : public File1
+{
+public:
+    TestLump(File1 &wad, PathTree::Node &node)
+        : File1(nullptr, node.path(), FileInfo(), &wad)
+        , _node(node)
+    {}
+
+    PathTree::Node &directoryNode() const override { return _node; }
+
+private:
+    PathTree::Node &_node;
+};
+
+/**
+ * Simulated WAD file. The files are intentionally never deleted: File1 releases
+ * itself via the Doomsday file system, which is not available here. Files are
+ * loaded in the order of construction (see File1::loadOrderIndex()).
+ */
+struct TestWad
+{
+    File1 *file;
+    PathTree *directory;
+
+    TestWad(String const &name)
+        : file(new File1(nullptr, name, FileInfo()))
+        , directory(new PathTree)
+    {}
+
+    File1 &lump(String const &name)
+    {
+        return *new TestLump(*file, directory->insert(Path(name)));
+    }
+};
+
+static int s_failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { qWarning() << "Check failed:" << #cond << "at line" << __LINE__; ++s_failures; }
+
+static void testFind()
+{
+    TestWad a("a.wad");
+    TestWad b("b.wad");
+    File1 &aOne   = a.lump("ONE.lmp");
+    File1 &aTwo   = a.lump("TWO.lmp");
+    File1 &bOne   = b.lump("ONE.lmp");
+    File1 &bThree = b.lump("THREE.lmp");
+
+    LumpIndex index;
+    index.catalogLump(aOne);
+    index.catalogLump(aTwo);
+    index.catalogLump(bOne);
+    index.catalogLump(bThree);
+
+    CHECK(index.size() == 4);
+    CHECK(index.catalogues(*a.file));
+    CHECK(index.catalogues(*b.file));
+    CHECK(index.findFirst(Path("ONE.lmp")) == 0);
+    CHECK(index.findLast (Path("ONE.lmp")) == 2);
+    CHECK(&index.lump(index.findLast(Path("ONE.lmp"))) == &bOne);
+    CHECK(index.findFirst(Path("one.LMP")) == 0); // Case insensitive.
+    CHECK(index.findFirst(Path("THREE.lmp")) == 3);
+    CHECK(index.findLast (Path("THREE.lmp")) == 3);
+    CHECK(index.findFirst(Path("FOUR.lmp")) == -1);
+    CHECK(index.findLast (Path("FOUR.lmp")) == -1);
+    CHECK(index.findFirst(Path()) == -1);
+    CHECK(index.contains(Path("TWO.lmp")));
+    CHECK(!index.contains(Path("FOUR.lmp")));
+
+    LumpIndex::FoundIndices found;
+    CHECK(index.findAll(Path("ONE.lmp"), found) == 2);
+    CHECK(found == LumpIndex::FoundIndices({ 0, 2 }));
+    CHECK(index.findAll(Path("FOUR.lmp"), found) == 0);
+    CHECK(found.empty());
+}
+
+static void testUniquePaths()
+{
+    TestWad a("a.wad");
+    TestWad b("b.wad");
+    File1 &aFirst  = a.lump("DUP.lmp");
+    File1 &aOther  = a.lump("OTHER.lmp");
+    File1 &bDup    = b.lump("DUP.lmp");
+    File1 &aSecond = a.lump("DUP.lmp");
+
+    LumpIndex index(true /*paths are unique*/);
+    index.catalogLump(aFirst);
+    index.catalogLump(aOther);
+
+    // A file loaded earlier takes precedence.
+    index.catalogLump(bDup);
+    CHECK(index.size() == 2);
+    CHECK(&index.lump(index.findFirst(Path("DUP.lmp"))) == &aFirst);
+    CHECK(!index.catalogues(*b.file));
+
+    // Within the same file, the lump catalogued last is kept.
+    index.catalogLump(aSecond);
+    CHECK(index.size() == 2);
+    CHECK(&index.lump(0) == &aOther);
+    CHECK(&index.lump(1) == &aSecond);
+
+    LumpIndex::FoundIndices found;
+    CHECK(index.findAll(Path("DUP.lmp"), found) == 1);
+    CHECK(index.findFirst(Path("DUP.lmp")) == 1);
+    CHECK(index.findLast (Path("DUP.lmp")) == 1);
+}
+
+static void testPruning()
+{
+    TestWad a("a.wad");
+    TestWad b("b.wad");
+    TestWad c("c.wad");
+    TestWad d("d.wad");
+    File1 &bFirst  = b.lump("B0.lmp");
+    File1 &bSecond = b.lump("B1.lmp");
+    File1 &cFirst  = c.lump("C0.lmp");
+    File1 &cShared = c.lump("A1.lmp");
+    File1 &dFirst  = d.lump("D0.lmp");
+
+    LumpIndex index;
+    index.catalogLump(a.lump("A0.lmp"));
+    index.catalogLump(a.lump("A1.lmp"));
+    index.catalogLump(a.lump("A2.lmp"));
+    index.catalogLump(bFirst);
+    index.catalogLump(bSecond);
+    index.catalogLump(cFirst);
+    index.catalogLump(cShared);
+    CHECK(index.findFirst(Path("A1.lmp")) == 1);
+
+    // The lumps catalogued after the pruned file are renumbered.
+    CHECK(index.pruneByFile(*a.file) == 3);
+    CHECK(index.pruneByFile(*a.file) == 0);
+    CHECK(!index.catalogues(*a.file));
+    CHECK(index.size() == 4);
+    CHECK(&index.lump(0) == &bFirst);
+    CHECK(&index.lump(1) == &bSecond);
+    CHECK(&index.lump(2) == &cFirst);
+    CHECK(&index.lump(3) == &cShared);
+    CHECK(index.findFirst(Path("B0.lmp")) == 0);
+    CHECK(index.findFirst(Path("C0.lmp")) == 2);
+    CHECK(index.findFirst(Path("A0.lmp")) == -1);
+    CHECK(index.findFirst(Path("A1.lmp")) == 3);
+    CHECK(index.findLast (Path("A1.lmp")) == 3);
+
+    index.catalogLump(dFirst);
+    CHECK(index.findFirst(Path("D0.lmp")) == 4);
+
+    CHECK(index.pruneByFile(*b.file) == 2);
+    CHECK(index.findFirst(Path("C0.lmp")) == 0);
+    CHECK(index.findFirst(Path("A1.lmp")) == 1);
+    CHECK(index.findFirst(Path("D0.lmp")) == 2);
+
+    CHECK(index.pruneLump(cFirst));
+    CHECK(!index.pruneLump(cFirst));
+    CHECK(index.size() == 2);
+    CHECK(&index.lump(0) == &cShared);
+    CHECK(&index.lump(1) == &dFirst);
+    CHECK(index.findFirst(Path("D0.lmp")) == 1);
+
+    // Lumps of a file may be catalogued in several separate ranges.
+    TestWad e("e.wad");
+    File1 &eFirst = e.lump("E0.lmp");
+    File1 &eLast  = e.lump("E1.lmp");
+    index.catalogLump(eFirst);
+    index.catalogLump(c.lump("C2.lmp"));
+    index.catalogLump(eLast);
+    CHECK(index.pruneByFile(*c.file) == 2);
+    CHECK(index.size() == 3);
+    CHECK(&index.lump(0) == &dFirst);
+    CHECK(&index.lump(1) == &eFirst);
+    CHECK(&index.lump(2) == &eLast);
+    CHECK(index.findFirst(Path("E1.lmp")) == 2);
+    CHECK(index.findFirst(Path("C2.lmp")) == -1);
+
+    index.clear();
+    CHECK(index.isEmpty());
+    CHECK(index.findFirst(Path("D0.lmp")) == -1);
+}
+
+/**
+ * Catalogues a large number of lumps and looks them up, like what happens when
+ * many WADs are loaded.
+ */
+static void testPerformance()
+{
+    int const WAD_COUNT     = 60;
+    int const LUMPS_PER_WAD = 2000;
+    int const LOOKUPS       = 200;
+
+    QList<TestWad> wads;
+    for (int w = 0; w < WAD_COUNT; ++w)
+    {
+        wads << TestWad(String("bench%1.wad").arg(w));
+    }
+
+    LumpIndex index;
+    Time startedAt;
+    int found = 0;
+
+    // Load the WADs one by one. Each one is followed by lookups, like the ones
+    // that happen while resources are being located.
+    for (int w = 0; w < WAD_COUNT; ++w)
+    {
+        for (int i = 0; i < LUMPS_PER_WAD; ++i)
+        {
+            // Some of the names are shared by all WADs.
+            index.catalogLump(wads[w].lump(i < 100? String("SHARED%1.lmp").arg(i)
+                                                  : String("W%1L%2.lmp").arg(w).arg(i)));
+        }
+        for (int i = 0; i < LOOKUPS; ++i)
+        {
+            if (index.findLast(Path(String("SHARED%1.lmp").arg(i % 100))) >= 0) found++;
+            if (index.contains(Path(String("W%1L%2.lmp").arg(w / 2).arg(100 + i)))) found++;
+        }
+    }
+    TimeSpan const loadTime = startedAt.since();
+    CHECK(index.size() == WAD_COUNT * LUMPS_PER_WAD);
+    CHECK(found == WAD_COUNT * LOOKUPS * 2);
+
+    LumpIndex::FoundIndices all;
+    CHECK(index.findAll(Path("SHARED5.lmp"), all) == WAD_COUNT);
+    CHECK(index.findLast(Path("SHARED5.lmp")) == (WAD_COUNT - 1) * LUMPS_PER_WAD + 5);
+    qDebug() << "Cataloguing and looking up:" << loadTime * 1000 << "ms";
+
+    // Unload one WAD from the middle, and then the rest in reverse load order.
+    startedAt = Time();
+    CHECK(index.pruneByFile(*wads[WAD_COUNT / 2].file) == LUMPS_PER_WAD);
+    CHECK(index.findFirst(Path(String("W%1L100.lmp").arg(WAD_COUNT / 2 + 1))) ==
+          WAD_COUNT / 2 * LUMPS_PER_WAD + 100);
+    for (int w = WAD_COUNT - 1; w >= 0; --w)
+    {
+        index.pruneByFile(*wads[w].file);
+    }
+    qDebug() << "Pruning:" << startedAt.since() * 1000 << "ms";
+    CHECK(index.isEmpty());
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        TextApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        testFind();
+        testUniquePaths();
+        testPruning();
+        testPerformance();
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+        return 1;
+    }
+
+    qDebug() << "Exiting main()...";
+    return s_failures? 1 : 0;
+}
@@ -0,0 +1,414 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/PackedReader>
+#include <de/PackedWriter>
+#include <de/Time>
+#include <de/reader.h>
+#include <de/writer.h>
+
+#include <QDebug>
+#include <QVector>
+#include <cstring>
+
+using namespace de;
+
+/*
+ * Simulated server frames: every tic, each of the 16 players receives a frame
+ * with the deltas of all players, their mobjs, nearby monsters and missiles,
+ * moving sectors, and sounds. The field layout follows the PSV_FRAME2 deltas.
+ */
+
+static int const PLAYER_COUNT    = 16;
+static int const MONSTER_DELTAS  = 48;
+static int const SECTOR_DELTAS   = 4;
+static int const SOUND_DELTAS    = 4;
+static int const TIC_COUNT       = 500;
+static int const FRAME_CAPACITY  = 0x10000;
+
+enum { DT_MOBJ = 0, DT_PLAYER = 1, DT_SECTOR = 2, DT_SOUND = 5 };
+enum { MDF_ORIGIN = 0x7, MDF_MOM = 0x38, MDF_ANGLE = 0x40, MDF_STATE = 0x100,
+       MDF_FLAGS = 0x200, MDF_HEALTH = 0x400 };
+
+struct Random
+{
+    duint32 seed;
+
+    Random(duint32 s) : seed(s) {}
+
+    duint32 next()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7fff;
+    }
+};
+
+/// Adapter for the legacy C writer (see Writer1).
+struct LegacyWriter
+{
+    Writer1 *w;
+
+    LegacyWriter() : w(Writer_NewWithDynamicBuffer(FRAME_CAPACITY)) {}
+    ~LegacyWriter() { Writer_Delete(w); }
+
+    void writeByte(dbyte v)           { Writer_WriteByte(w, v); }
+    void writeUInt16(duint16 v)       { Writer_WriteUInt16(w, v); }
+    void writeInt16(dint16 v)         { Writer_WriteInt16(w, v); }
+    void writeUInt32(duint32 v)       { Writer_WriteUInt32(w, v); }
+    void writeInt32(dint32 v)         { Writer_WriteInt32(w, v); }
+    void writeFloat(dfloat v)         { Writer_WriteFloat(w, v); }
+    void writePackedUInt16(duint16 v) { Writer_WritePackedUInt16(w, v); }
+    void writePackedUInt32(duint32 v) { Writer_WritePackedUInt32(w, v); }
+};
+
+/// Adapter for the legacy C reader (see Reader1).
+struct LegacyReader
+{
+    Reader1 *r;
+
+    LegacyReader(dbyte const *data, dsize size) : r(Reader_NewWithBuffer(data, size)) {}
+    ~LegacyReader() { Reader_Delete(r); }
+
+    bool    atEnd()             { return Reader_AtEnd(r); }
+    dbyte   readByte()          { return Reader_ReadByte(r); }
+    duint16 readUInt16()        { return Reader_ReadUInt16(r); }
+    dint16  readInt16()         { return Reader_ReadInt16(r); }
+    duint32 readUInt32()        { return Reader_ReadUInt32(r); }
+    dint32  readInt32()         { return Reader_ReadInt32(r); }
+    dfloat  readFloat()         { return Reader_ReadFloat(r); }
+    duint16 readPackedUInt16()  { return Reader_ReadPackedUInt16(r); }
+    duint32 readPackedUInt32()  { return Reader_ReadPackedUInt32(r); }
+};
+
+/**
+ * Writes the frame for @a recipient on @a tic. Returns a checksum of the
+ * written values.
+ */
+template <typename WriterType>
+static duint32 writeFrame(WriterType &w, int tic, int recipient)
+{
+    Random rnd(duint32(tic * PLAYER_COUNT + recipient + 1));
+    duint32 sum = 0;
+
+    w.writeFloat(tic / 35.f);
+
+    auto writeMobj = [&w, &rnd, &sum] (duint16 id, bool full)
+    {
+        duint16 const df = MDF_ORIGIN | MDF_MOM | MDF_ANGLE | MDF_STATE |
+                           (full? MDF_FLAGS | MDF_HEALTH : 0);
+        w.writeByte(DT_MOBJ);
+        w.writeUInt16(id);
+        w.writeUInt16(df);
+        sum += id;
+        for (int i = 0; i < 3; ++i)
+        {
+            dint16 const integer = dint16(rnd.next() - 0x4000);
+            dbyte const fraction = dbyte(rnd.next());
+            w.writeInt16(integer);
+            w.writeByte(fraction);
+            sum += duint32(integer) + fraction;
+        }
+        w.writeFloat(-128.f);
+        w.writeFloat(256.f);
+        for (int i = 0; i < 3; ++i)
+        {
+            dint16 const mom = dint16(rnd.next() % 2048 - 1024);
+            w.writeInt16(mom);
+            sum += duint32(mom);
+        }
+        duint16 const angle = duint16(rnd.next());
+        duint16 const state = duint16(rnd.next() % 1200);
+        w.writeInt16(dint16(angle));
+        w.writePackedUInt16(state);
+        sum += angle + state;
+        if (full)
+        {
+            duint32 const flags = rnd.next() << 8;
+            w.writeUInt32(flags);
+            w.writeUInt32(flags ^ 0x100);
+            w.writeUInt32(0);
+            w.writeUInt32(0);
+            w.writeInt32(100);
+            sum += flags + (flags ^ 0x100) + 100;
+        }
+    };
+
+    for (int i = 0; i < PLAYER_COUNT; ++i)
+    {
+        w.writeByte(DT_PLAYER);
+        w.writeByte(dbyte(i));
+        w.writeUInt16(duint16(i + 1)); // Mobj ID.
+        dbyte const forward = dbyte(rnd.next());
+        dbyte const side    = dbyte(rnd.next());
+        duint16 const psp   = duint16(rnd.next() % 800);
+        w.writeByte(forward);
+        w.writeByte(side);
+        w.writePackedUInt16(psp);
+        sum += i + (i + 1) + forward + side + psp;
+
+        writeMobj(duint16(i + 1), i == recipient);
+    }
+    for (int i = 0; i < MONSTER_DELTAS; ++i)
+    {
+        writeMobj(duint16(100 + i * 3 + rnd.next() % 3), i % 8 == 0);
+    }
+    for (int i = 0; i < SECTOR_DELTAS; ++i)
+    {
+        duint16 const id     = duint16(rnd.next() % 900);
+        duint32 const df     = 0x20 | (rnd.next() & 0x40? 0x4000 : 0);
+        dint16 const height  = dint16(rnd.next() % 512 - 256);
+        w.writeByte(DT_SECTOR);
+        w.writeUInt16(id);
+        w.writePackedUInt32(df);
+        w.writeInt16(height);
+        sum += id + df + duint32(height);
+    }
+    for (int i = 0; i < SOUND_DELTAS; ++i)
+    {
+        duint16 const id = duint16(rnd.next() % 300);
+        dbyte const vol  = dbyte(rnd.next() % 128);
+        w.writeByte(DT_SOUND);
+        w.writeUInt16(id);
+        w.writeByte(vol);
+        sum += id + vol;
+    }
+    return sum;
+}
+
+/**
+ * Reads a frame written by writeFrame(). Returns a checksum of the read values.
+ */
+template <typename ReaderType>
+static duint32 readFrame(ReaderType &r)
+{
+    duint32 sum = 0;
+    r.readFloat();
+    while (!r.atEnd())
+    {
+        switch (r.readByte())
+        {
+        case DT_MOBJ: {
+            sum += r.readUInt16();
+            duint16 const df = r.readUInt16();
+            for (int i = 0; i < 3; ++i)
+            {
+                // Sequenced reads: integer part first.
+                duint32 const integer = duint32(r.readInt16());
+                sum += integer + r.readByte();
+            }
+            r.readFloat();
+            r.readFloat();
+            for (int i = 0; i < 3; ++i) sum += duint32(r.readInt16());
+            sum += duint16(r.readInt16());
+            sum += r.readPackedUInt16();
+            if (df & MDF_FLAGS)
+            {
+                sum += r.readUInt32();
+                sum += r.readUInt32();
+                sum += r.readUInt32();
+                sum += r.readUInt32();
+                sum += duint32(r.readInt32());
+            }
+            break; }
+
+        case DT_PLAYER:
+            sum += r.readByte();
+            sum += r.readUInt16();
+            sum += r.readByte();
+            sum += r.readByte();
+            sum += r.readPackedUInt16();
+            break;
+
+        case DT_SECTOR:
+            sum += r.readUInt16();
+            sum += r.readPackedUInt32();
+            sum += duint32(r.readInt16());
+            break;
+
+        case DT_SOUND:
+            sum += r.readUInt16();
+            sum += r.readByte();
+            break;
+
+        default:
+            qWarning() << "Unknown delta type in frame";
+            return 0;
+        }
+    }
+    return sum;
+}
+
+static bool benchmarkFrames()
+{
+    bool ok = true;
+    QVector<dbyte> packedFrame(FRAME_CAPACITY);
+    dsize totalBytes = 0;
+
+    // Legacy writer: a new dynamic buffer per frame, as in Msg_Begin().
+    Time startedAt;
+    for (int tic = 0; tic < TIC_COUNT; ++tic)
+    {
+        for (int plr = 0; plr < PLAYER_COUNT; ++plr)
+        {
+            LegacyWriter w;
+            writeFrame(w, tic, plr);
+            totalBytes += Writer_Size(w.w);
+        }
+    }
+    TimeSpan const legacyWriteTime = startedAt.since();
+
+    startedAt = Time();
+    for (int tic = 0; tic < TIC_COUNT; ++tic)
+    {
+        for (int plr = 0; plr < PLAYER_COUNT; ++plr)
+        {
+            PackedWriter w(packedFrame.data(), dsize(packedFrame.size()));
+            writeFrame(w, tic, plr);
+            if (w.hasOverflowed()) ok = false;
+        }
+    }
+    TimeSpan const packedWriteTime = startedAt.since();
+
+    // Verify that the output is identical and decodes to the same values.
+    for (int tic = 0; tic < TIC_COUNT; tic += 50)
+    {
+        for (int plr = 0; plr < PLAYER_COUNT; ++plr)
+        {
+            LegacyWriter legacy;
+            duint32 const expected = writeFrame(legacy, tic, plr);
+            PackedWriter packed(packedFrame.data(), dsize(packedFrame.size()));
+            writeFrame(packed, tic, plr);
+
+            if (packed.size() != Writer_Size(legacy.w) ||
+                std::memcmp(packed.data(), Writer_Data(legacy.w), packed.size()))
+            {
+                qWarning() << "Frame" << tic << plr << "differs from the legacy encoding";
+                ok = false;
+            }
+
+            PackedReader reader(packed.data(), packed.size());
+            if (readFrame(reader) != expected || reader.hasUnderflowed())
+            {
+                qWarning() << "Frame" << tic << plr << "was not decoded correctly";
+                ok = false;
+            }
+        }
+    }
+
+    // Decoding. Both readers read the same frame repeatedly.
+    PackedWriter frame(packedFrame.data(), dsize(packedFrame.size()));
+    writeFrame(frame, 1, 0);
+    int const decodeCount = TIC_COUNT * PLAYER_COUNT;
+    duint32 legacySum = 0, packedSum = 0;
+
+    startedAt = Time();
+    for (int i = 0; i < decodeCount; ++i)
+    {
+        LegacyReader r(frame.data(), frame.size());
+        legacySum += readFrame(r);
+    }
+    TimeSpan const legacyReadTime = startedAt.since();
+
+    startedAt = Time();
+    for (int i = 0; i < decodeCount; ++i)
+    {
+        PackedReader r(frame.data(), frame.size());
+        packedSum += readFrame(r);
+    }
+    TimeSpan const packedReadTime = startedAt.since();
+
+    if (legacySum != packedSum) ok = false;
+
+    qDebug("%i frames, %.0f bytes per frame on average",
+           TIC_COUNT * PLAYER_COUNT, double(totalBytes) / (TIC_COUNT * PLAYER_COUNT));
+    qDebug("Write: Writer1 %7.2f ms | PackedWriter %7.2f ms (%.1fx)",
+           legacyWriteTime * 1000, packedWriteTime * 1000,
+           double(legacyWriteTime) / de::max(1e-6, double(packedWriteTime)));
+    qDebug("Read:  Reader1 %7.2f ms | PackedReader %7.2f ms (%.1fx)",
+           legacyReadTime * 1000, packedReadTime * 1000,
+           double(legacyReadTime) / de::max(1e-6, double(packedReadTime)));
+    return ok;
+}
+
+static bool testArrays()
+{
+    bool ok = true;
+    dbyte buf[1024];
+
+    // Sorted mobj IDs, as in a frame's mobj deltas.
+    QVector<dint32> ids;
+    Random rnd(7);
+    for (dint32 id = 100; ids.size() < 64; id += 1 + rnd.next() % 6) ids << id;
+    ids << -5 << 0x7fffffff << dint32(0x80000000) << 42;
+
+    PackedWriter w(buf, sizeof(buf));
+    w.writeDeltaArray(ids.constData(), dsize(ids.size()));
+    dsize const deltaSize = w.size();
+
+    QVector<duint32> states;
+    for (int i = 0; i < 64; ++i) states << rnd.next() % 1200;
+    states << 0 << 0xffffffff;
+    w.writePackedUInt32Array(states.constData(), dsize(states.size()));
+    if (w.hasOverflowed()) ok = false;
+
+    PackedReader r(buf, w.size());
+    QVector<dint32> readIds(ids.size());
+    QVector<duint32> readStates(states.size());
+    r.readDeltaArray(readIds.data(), dsize(readIds.size()));
+    r.readPackedUInt32Array(readStates.data(), dsize(readStates.size()));
+    if (readIds != ids || readStates != states || !r.atEnd() || r.hasUnderflowed())
+    {
+        qWarning() << "Array round trip failed";
+        ok = false;
+    }
+
+    // Overflow and underflow are reported, not fatal.
+    PackedWriter small(buf, 3);
+    small.writeUInt16(1).writeUInt16(2).writeByte(3);
+    if (!small.hasOverflowed() || small.size() != 3) ok = false;
+    small.rewind(2);
+    small.writeByte(4);
+    if (small.hasOverflowed() || small.size() != 3) ok = false;
+
+    PackedReader shortReader(buf, 3);
+    shortReader.readUInt16();
+    if (shortReader.readUInt32() != 0 || !shortReader.hasUnderflowed() || !shortReader.atEnd()) ok = false;
+
+    qDebug("Delta array: %i IDs in %i bytes | varint array: %i states in %i bytes",
+           ids.size(), int(deltaSize), states.size(), int(w.size() - deltaSize));
+    return ok;
+}
+
+int main(int, char **)
+{
+    bool ok = true;
+    try
+    {
+        ok &= testArrays();
+        ok &= benchmarkFrames();
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+        return 1;
+    }
+
+    qDebug() << "Exiting main()...";
+    return ok? 0 : 1;
+}